@@ -40,6 +40,7 @@ void AqlFunctionsInternalCache::clear() noexcept {
   _regexCache.clear();
   _likeCache.clear();
   _validatorCache.clear();
+  _dateFormatCache.clear();
 }
 
 icu::RegexMatcher* AqlFunctionsInternalCache::buildRegexMatcher(
@@ -106,6 +107,28 @@ arangodb::ValidatorBase* AqlFunctionsInternalCache::buildValidator(
   return matcherIter->second.get();
 };
 
+basics::DateFormatProgram const* AqlFunctionsInternalCache::buildDateFormat(
+    std::string_view formatString) {
+  // format strings are usually constant within a query, so the cache
+  // will normally contain a single entry
+  _temp.assign(formatString);
+  if (_dateFormatCache.size() >= maxDateFormatCacheSize &&
+      !_dateFormatCache.contains(_temp)) {
+    // the returned programs are only used until the next call, so the
+    // cache can be emptied
+    _dateFormatCache.clear();
+  }
+  auto it =
+      _dateFormatCache
+          .try_emplace(_temp, arangodb::lazyConstruct([&] {
+                         return std::make_unique<
+                             basics::DateFormatProgram const>(formatString);
+                       }))
+          .first;
+
+  return it->second.get();
+}
+
 /// @brief get matcher from cache, or insert a new matcher for the specified
 /// pattern
 icu::RegexMatcher* AqlFunctionsInternalCache::fromCache(
@@ -25,6 +25,7 @@
 
 #include "Aql/AqlValue.h"
 #include "Basics/Common.h"
+#include "Basics/datetime.h"
 #include "VocBase/Validators.h"
 
 #include <unicode/regex.h>
@@ -63,6 +64,15 @@ class AqlFunctionsInternalCache final {
   //                              types without change.
   arangodb::ValidatorBase* buildValidator(VPackSlice validatorDescription);
 
+  /// @brief maximum number of compiled format strings kept in the cache.
+  /// format strings can be data-dependent, so the cache is cleared when
+  /// it gets full
+  static constexpr size_t maxDateFormatCacheSize = 64;
+
+  /// @brief return a compiled DATE_FORMAT format string
+  basics::DateFormatProgram const* buildDateFormat(
+      std::string_view formatString);
+
   /// @brief inspect a LIKE pattern from a string, and remove all
   /// of its escape characters. will stop at the first wildcards found.
   /// returns a pair with the following meaning:
@@ -98,6 +108,10 @@ class AqlFunctionsInternalCache final {
   /// validation.
   std::unordered_map<std::size_t, std::unique_ptr<arangodb::ValidatorBase>>
       _validatorCache;
+  /// @brief cache for compiled format strings (DATE_FORMAT function)
+  std::unordered_map<std::string,
+                     std::unique_ptr<basics::DateFormatProgram const>>
+      _dateFormatCache;
   /// @brief a reusable string object for pattern generation
   std::string _temp;
 };
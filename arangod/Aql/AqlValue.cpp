@@ -124,6 +124,15 @@ uint64_t AqlValue::hash(uint64_t seed) const {
   return 0;
 }
 
+uint64_t AqlValue::fastHash(uint64_t seed) const {
+  AqlValueType t = type();
+  if (t == RANGE) {
+    // must produce the same hash as an array with the same members
+    return hash(seed);
+  }
+  return basics::VelocyPackHelper::fastNormalizedHash(slice(t), seed);
+}
+
 /// @brief whether or not the value contains a none value
 bool AqlValue::isNone() const noexcept {
   switch (type()) {
@@ -371,6 +371,12 @@ struct AqlValue final {
   /// @brief hashes the value
   uint64_t hash(uint64_t seed = 0xdeadbeef) const;
 
+  /// @brief hashes the value for in-memory hash tables, such as the ones
+  /// used by COLLECT and DISTINCT. faster than hash(), but the result is not
+  /// stable across versions, so it must not be persisted or returned to
+  /// users (the HASH() function uses hash())
+  uint64_t fastHash(uint64_t seed = 0xdeadbeef) const;
+
   /// @brief whether or not the value contains a none value
   bool isNone() const noexcept;
 
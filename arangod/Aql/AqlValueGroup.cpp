@@ -43,10 +43,11 @@ size_t AqlValueGroupHash::operator()(const std::vector<AqlValue>& value) const {
 #endif
 
   for (AqlValue const& it : value) {
-    // we must use the slow hash function here, because a value may have
-    // different representations in case its an array/object/number
-    // (calls normalizedHash() internally)
-    hash = it.hash(hash);
+    // the hash must be normalized, because a value may have different
+    // representations in case its an array/object/number. fastHash()
+    // handles numbers and strings directly and only falls back to
+    // normalizedHash() for everything else
+    hash = it.fastHash(hash);
   }
 
   return static_cast<size_t>(hash);
@@ -54,7 +55,7 @@ size_t AqlValueGroupHash::operator()(const std::vector<AqlValue>& value) const {
 
 size_t AqlValueGroupHash::operator()(AqlValue const& value) const {
   uint64_t hash = 0x12345678;
-  return value.hash(hash);
+  return value.fastHash(hash);
 }
 
 size_t AqlValueGroupHash::operator()(
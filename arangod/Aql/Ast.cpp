@@ -37,6 +37,7 @@
 #include "Aql/ModificationOptions.h"
 #include "Aql/Quantifier.h"
 #include "Aql/QueryContext.h"
+#include "Aql/UserFunctionExpression.h"
 #include "Aql/AqlFunctionsInternalCache.h"
 #include "Basics/Arithmetic.h"
 #include "Basics/Exceptions.h"
@@ -1886,6 +1887,20 @@ AstNode* Ast::createNodeFunctionCall(std::string_view functionName,
     }
   } else {
     // user-defined function (UDF)
+    if (hasFlag(AstPropertyFlag::INLINE_USER_FUNCTIONS)) {
+      // a UDF with an AQL expression body is inlined into the query, so it
+      // does not need V8
+      auto function =
+          UserFunctionExpression::lookup(_query.vocbase(), normalized);
+      if (function != nullptr) {
+        AstNode* body = function->inlineCall(*this, arguments);
+        if (body != nullptr) {
+          _containsInlinedUserFunction = true;
+          return body;
+        }
+      }
+    }
+
     if (_query.vocbase().server().hasFeature<V8DealerFeature>() &&
         !_query.vocbase()
              .server()
@@ -69,8 +69,9 @@ using AstPropertiesFlagsType = uint32_t;
 
 /// @brief flags for customizing Ast building process
 enum AstPropertyFlag : AstPropertiesFlagsType {
-  AST_FLAG_DEFAULT = 0x00000000,     // Regular Ast
-  NON_CONST_PARAMETERS = 0x00000001  // Parameters are considered non-const
+  AST_FLAG_DEFAULT = 0x00000000,      // Regular Ast
+  NON_CONST_PARAMETERS = 0x00000001,  // Parameters are considered non-const
+  INLINE_USER_FUNCTIONS = 0x00000002  // Inline AQL expression user functions
 };
 
 /// @brief the AST
@@ -152,6 +153,13 @@ class Ast {
   void setContainsUpsertNode() noexcept;
   void setContainsParallelNode() noexcept;
 
+  /// @brief whether or not calls of user functions were inlined. the
+  /// results of such queries must not be cached, as the function
+  /// definitions can change without the query cache noticing
+  bool containsInlinedUserFunction() const noexcept {
+    return _containsInlinedUserFunction;
+  }
+
   bool canApplyParallelism() const noexcept {
     return _containsParallelNode && !_willUseV8 && !_containsModificationNode;
   }
@@ -686,6 +694,9 @@ class Ast {
   /// @brief query makes use of V8 function(s)
   bool _willUseV8;
 
+  /// @brief calls of user functions were inlined
+  bool _containsInlinedUserFunction{false};
+
   /// @brief special node types that are used often and for which no memory
   /// allocation will be needed. The node types are singletons in an AST,
   /// so they may be referenced from multiple places.
@@ -29,6 +29,7 @@
 #include "Aql/ExecutionPlan.h"
 #include "Aql/QueryContext.h"
 #include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ServerState.h"
 #include "Indexes/Index.h"
@@ -67,7 +68,11 @@ CollectionAccessingNode::CollectionAccessingNode(
   VPackSlice restrictedTo = slice.get("restrictedTo");
 
   if (restrictedTo.isString()) {
-    _restrictedTo = restrictedTo.copyString();
+    _restrictedTo.emplace_back(restrictedTo.copyString());
+  } else if (restrictedTo.isArray()) {
+    for (VPackSlice shard : VPackArrayIterator(restrictedTo)) {
+      _restrictedTo.emplace_back(shard.copyString());
+    }
   }
 }
 
@@ -102,8 +107,15 @@ void CollectionAccessingNode::toVelocyPack(
                 VPackValue(collection()->numberOfShards()));
   }
 
-  if (!_restrictedTo.empty()) {
-    builder.add("restrictedTo", VPackValue(_restrictedTo));
+  if (_restrictedTo.size() == 1) {
+    builder.add("restrictedTo", VPackValue(_restrictedTo.front()));
+  } else if (!_restrictedTo.empty()) {
+    builder.add(VPackValue("restrictedTo"));
+    builder.openArray();
+    for (auto const& shard : _restrictedTo) {
+      builder.add(VPackValue(shard));
+    }
+    builder.close();
   }
 #ifdef USE_ENTERPRISE
   builder.add("isSatellite", VPackValue(isUsedAsSatellite()));
@@ -154,7 +166,14 @@ aql::Collection const* CollectionAccessingNode::collection() const {
 }
 
 void CollectionAccessingNode::restrictToShard(std::string const& shardId) {
-  _restrictedTo = shardId;
+  _restrictedTo.clear();
+  _restrictedTo.emplace_back(shardId);
+}
+
+void CollectionAccessingNode::restrictToShards(
+    std::vector<std::string> shardIds) {
+  TRI_ASSERT(!shardIds.empty());
+  _restrictedTo = std::move(shardIds);
 }
 
 bool CollectionAccessingNode::isRestricted() const {
@@ -162,6 +181,14 @@ bool CollectionAccessingNode::isRestricted() const {
 }
 
 std::string const& CollectionAccessingNode::restrictedShard() const {
+  if (_restrictedTo.size() != 1) {
+    return StaticStrings::Empty;
+  }
+  return _restrictedTo.front();
+}
+
+std::vector<std::string> const& CollectionAccessingNode::restrictedShards()
+    const {
   return _restrictedTo;
 }
 
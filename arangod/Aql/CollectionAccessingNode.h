@@ -27,9 +27,11 @@
 #include "Aql/ExecutionNodeId.h"
 #include "Basics/debugging.h"
 
+#include <algorithm>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 struct TRI_vocbase_t;
 
@@ -69,9 +71,10 @@ class CollectionAccessingNode {
   void collection(aql::Collection const* collection);
 
   void setUsedShard(std::string const& shardName) {
-    // We can only use the shard we are restricted to
+    // We can only use the shards we are restricted to
     TRI_ASSERT(shardName.empty() || _restrictedTo.empty() ||
-               _restrictedTo == shardName);
+               std::find(_restrictedTo.begin(), _restrictedTo.end(),
+                         shardName) != _restrictedTo.end());
     _usedShard = shardName;
   }
 
@@ -83,7 +86,14 @@ class CollectionAccessingNode {
   void restrictToShard(std::string const& shardId);
 
   /**
-   * @brief Check if this Node is restricted to a single Shard (cluster only)
+   * @brief Restrict this Node to a subset of its Shards (cluster only)
+   *
+   * @param shardIds The shards restricted to, must not be empty
+   */
+  void restrictToShards(std::vector<std::string> shardIds);
+
+  /**
+   * @brief Check if this Node is restricted to some Shards (cluster only)
    *
    * @return True if we are restricted, false otherwise
    */
@@ -92,10 +102,18 @@ class CollectionAccessingNode {
   /**
    * @brief Get the Restricted shard for this Node
    *
-   * @return The Shard this node is restricted to
+   * @return The Shard this node is restricted to, if it is restricted to
+   * exactly one shard. An empty string otherwise
    */
   std::string const& restrictedShard() const;
 
+  /**
+   * @brief Get the Restricted shards for this Node
+   *
+   * @return The Shards this node is restricted to, empty if not restricted
+   */
+  std::vector<std::string> const& restrictedShards() const;
+
   /// @brief set the prototype collection when using distributeShardsLike
   void setPrototype(arangodb::aql::Collection const* prototypeCollection,
                     arangodb::aql::Variable const* prototypeOutVariable);
@@ -133,8 +151,8 @@ class CollectionAccessingNode {
  protected:
   aql::CollectionAccess _collectionAccess;
 
-  /// @brief A shard this node is restricted to, may be empty
-  std::string _restrictedTo;
+  /// @brief The shards this node is restricted to, may be empty
+  std::vector<std::string> _restrictedTo;
 
   std::string _usedShard;
 };
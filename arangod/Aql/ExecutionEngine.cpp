@@ -247,6 +247,7 @@ ExecutionEngine::ExecutionEngine(EngineId eId, QueryContext& query,
       _blocks(),
       _root(nullptr),
       _resultRegister(RegisterId::maxRegisterId),
+      _returnedRows(0),
       _initializeCursorCalled(false) {
   TRI_ASSERT(_sharedState != nullptr);
   _blocks.reserve(8);
@@ -630,6 +631,10 @@ auto ExecutionEngine::execute(AqlCallStack const& stack)
   }
 
   auto const res = _root->execute(stack);
+  if (auto const& block = std::get<SharedAqlItemBlockPtr>(res);
+      block != nullptr) {
+    _returnedRows += block->numRows();
+  }
 
   TRI_IF_FAILURE("ExecutionEngine::directKillAfterAQLQueryExecute") {
     _query.debugKillQuery();
@@ -131,6 +131,9 @@ class ExecutionEngine {
   ///  @brief collected execution stats
   void collectExecutionStats(ExecutionStats& other);
 
+  /// @brief number of rows this engine has handed out via execute()
+  uint64_t returnedRows() const noexcept { return _returnedRows; }
+
   bool waitForSatellites(aql::QueryContext& query,
                          Collection const* collection) const;
 
@@ -183,6 +186,9 @@ class ExecutionEngine {
   /// @brief the register the final result of the query is stored in
   RegisterId _resultRegister;
 
+  /// @brief number of rows returned from execute()
+  uint64_t _returnedRows;
+
   /// @brief whether or not initializeCursor was called
   bool _initializeCursorCalled;
 };
@@ -32,6 +32,9 @@ struct TRI_vocbase_t;
 
 namespace arangodb {
 struct ValidatorBase;
+namespace basics {
+class DateFormatProgram;
+}
 namespace transaction {
 class Methods;
 }
@@ -64,6 +67,8 @@ class ExpressionContext {
                                                velocypack::Options const* opts,
                                                bool& isEmptyExpression) = 0;
   virtual arangodb::ValidatorBase* buildValidator(velocypack::Slice) = 0;
+  virtual basics::DateFormatProgram const* buildDateFormat(
+      std::string_view formatString) = 0;
 
   virtual TRI_vocbase_t& vocbase() const = 0;
   virtual transaction::Methods& trx() const = 0;
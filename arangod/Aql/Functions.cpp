@@ -8916,7 +8916,10 @@ AqlValue functions::DateFormat(ExpressionContext* expressionContext,
     return AqlValue(AqlValueHintNull());
   }
 
-  return AqlValue(basics::formatDate(aqlFormatString.slice().copyString(), tp));
+  auto const* program =
+      expressionContext->buildDateFormat(aqlFormatString.slice().stringView());
+  TRI_ASSERT(program != nullptr);
+  return AqlValue(program->execute(tp));
 }
 
 AqlValue functions::ShardId(ExpressionContext* expressionContext,
@@ -325,6 +325,10 @@ struct OptimizerRule {
     // try to restrict fragments to a single shard if possible
     restrictToSingleShardRule,
 
+    // try to restrict fragments on range-sharded collections to the shards
+    // matching the shard key conditions
+    restrictToShardRangesRule,
+
     // turns LENGTH(FOR doc IN collection ... RETURN doc) into an optimized
     // count
     // operation
@@ -32,6 +32,7 @@
 #include "Aql/CollectNode.h"
 #include "Aql/CollectOptions.h"
 #include "Aql/Collection.h"
+#include "Aql/Condition.h"
 #include "Aql/ConditionFinder.h"
 #include "Aql/DocumentProducingNode.h"
 #include "Aql/EnumeratePathsNode.h"
@@ -69,13 +70,17 @@
 #include "Graph/ShortestPathOptions.h"
 #include "Graph/TraverserOptions.h"
 #include "Indexes/Index.h"
+#include "Sharding/ShardingInfo.h"
+#include "Sharding/ShardingStrategyRange.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "Transaction/CountCache.h"
 #include "Transaction/Methods.h"
 #include "Utils/CollectionNameResolver.h"
+#include "VocBase/LogicalCollection.h"
 #include "VocBase/Methods/Collections.h"
 
+#include <optional>
 #include <tuple>
 
 #include <absl/strings/str_cat.h>
@@ -5348,6 +5353,171 @@ void arangodb::aql::restrictToSingleShardRule(
   opt->addPlan(std::move(plan), rule, wasModified);
 }
 
+/// @brief restrict fragments on range-sharded collections to the shards
+/// whose key ranges can match the shard key conditions
+void arangodb::aql::restrictToShardRangesRule(
+    Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+    OptimizerRule const& rule) {
+  TRI_ASSERT(arangodb::ServerState::instance()->isCoordinator());
+  bool wasModified = false;
+
+  if (!plan->getAst()->query().queryOptions().restrictToShards.empty()) {
+    // the user has already restricted the query to some shards
+    opt->addPlan(std::move(plan), rule, wasModified);
+    return;
+  }
+
+  auto const& resolver = plan->getAst()->query().resolver();
+  // co-located collections are grouped by the id of their prototype
+  auto shardGroup = [&resolver](Collection const* collection) {
+    auto const& prototype = collection->distributeShardsLike();
+    DataSourceId id = prototype.empty() ? collection->id()
+                                        : resolver.getCollectionId(prototype);
+    return std::to_string(id.id());
+  };
+
+  // returns the shards of the collection accessed by candidate that can
+  // match, or nothing if the access cannot be restricted
+  auto findMatches =
+      [&plan](ExecutionNode* candidate) -> std::optional<std::vector<bool>> {
+    auto* colNode = dynamic_cast<CollectionAccessingNode*>(candidate);
+    TRI_ASSERT(colNode != nullptr);
+    auto const* collection = colNode->collection();
+    if (colNode->isRestricted() || colNode->isUsedAsSatellite() ||
+        collection->isSmart()) {
+      return std::nullopt;
+    }
+
+    auto logical = collection->getCollection();
+    ShardingInfo const* sharding = logical->shardingInfo();
+    if (sharding == nullptr ||
+        sharding->shardingStrategyName() != ShardingStrategyRange::NAME) {
+      return std::nullopt;
+    }
+
+    VPackSlice splitPoints = sharding->shardSplitPoints();
+    auto shardIds = collection->shardIds();
+    if (splitPoints.isEmptyArray() ||
+        shardIds->size() != splitPoints.length() + 1) {
+      return std::nullopt;
+    }
+
+    auto const* outVariable = ::getOutVariable(candidate);
+    ShardRangeFinder finder(outVariable, sharding->shardKeys()[0],
+                            splitPoints);
+    std::vector<bool> matches(shardIds->size(), true);
+    auto intersect = [&](AstNode const* condition) {
+      auto sub = finder.find(condition);
+      for (size_t i = 0; i < matches.size(); ++i) {
+        matches[i] = matches[i] && sub[i];
+      }
+    };
+
+    if (candidate->getType() == ExecutionNode::INDEX) {
+      auto* indexNode = ExecutionNode::castTo<IndexNode const*>(candidate);
+      for (auto const& index : indexNode->getIndexes()) {
+        // custom analyzers on inverted indexes might be incompatible
+        // with the shard key ranges
+        if (Index::TRI_IDX_TYPE_INVERTED_INDEX == index->type()) {
+          return std::nullopt;
+        }
+      }
+      intersect(indexNode->condition()->root());
+    }
+
+    auto* documentNode = dynamic_cast<DocumentProducingNode*>(candidate);
+    if (documentNode != nullptr && documentNode->hasFilter()) {
+      intersect(documentNode->filter()->node());
+    }
+
+    // FILTERs directly following the collection access in the same
+    // loop restrict it as well
+    for (ExecutionNode* parent = candidate->getFirstParent();
+         parent != nullptr &&
+         (parent->getType() == ExecutionNode::CALCULATION ||
+          parent->getType() == ExecutionNode::FILTER);
+         parent = parent->getFirstParent()) {
+      if (parent->getType() != ExecutionNode::FILTER) {
+        continue;
+      }
+      auto* filterNode = ExecutionNode::castTo<FilterNode const*>(parent);
+      auto* setter = plan->getVarSetBy(filterNode->inVariable()->id);
+      if (setter != nullptr &&
+          setter->getType() == ExecutionNode::CALCULATION) {
+        intersect(ExecutionNode::castTo<CalculationNode const*>(setter)
+                      ->expression()
+                      ->node());
+      }
+    }
+    return matches;
+  };
+
+  containers::SmallVector<ExecutionNode*, 8> nodes;
+  plan->findNodesOfType(nodes, EN::REMOTE, true);
+
+  for (auto& node : nodes) {
+    TRI_ASSERT(node->getType() == ExecutionNode::REMOTE);
+
+    // the accesses of a snippet are restricted per group of co-located
+    // collections. groups with collections that are modified, or accessed
+    // by other nodes, are left alone, as these need all shards
+    ShardRangeRestrictions restrictions;
+    std::vector<std::pair<std::string, CollectionAccessingNode*>> accesses;
+
+    ExecutionNode* current = node->getFirstDependency();
+    while (current != nullptr) {
+      auto const currentType = current->getType();
+      if (currentType == ExecutionNode::INSERT ||
+          currentType == ExecutionNode::UPDATE ||
+          currentType == ExecutionNode::REPLACE ||
+          currentType == ExecutionNode::REMOVE) {
+        restrictions.exclude(shardGroup(
+            ExecutionNode::castTo<ModificationNode const*>(current)
+                ->collection()));
+      } else if (currentType == ExecutionNode::INDEX ||
+                 currentType == ExecutionNode::ENUMERATE_COLLECTION) {
+        auto* colNode = dynamic_cast<CollectionAccessingNode*>(current);
+        TRI_ASSERT(colNode != nullptr);
+        std::string group = shardGroup(colNode->collection());
+        if (auto matches = findMatches(current); matches.has_value()) {
+          restrictions.add(group, *matches);
+          accesses.emplace_back(std::move(group), colNode);
+        } else {
+          restrictions.exclude(group);
+        }
+      } else if (currentType == ExecutionNode::UPSERT ||
+                 currentType == ExecutionNode::REMOTE ||
+                 currentType == ExecutionNode::DISTRIBUTE ||
+                 currentType == ExecutionNode::SINGLETON) {
+        // we reached a new snippet or the end of the plan
+        break;
+      } else if (auto* colNode =
+                     dynamic_cast<CollectionAccessingNode*>(current);
+                 colNode != nullptr) {
+        restrictions.exclude(shardGroup(colNode->collection()));
+      }
+      current = current->getFirstDependency();
+    }
+
+    for (auto& [group, colNode] : accesses) {
+      auto indexes = restrictions.shardIndexes(group);
+      if (indexes.empty()) {
+        continue;
+      }
+      auto shardIds = colNode->collection()->shardIds();
+      std::vector<std::string> shards;
+      for (size_t index : indexes) {
+        TRI_ASSERT(index < shardIds->size());
+        shards.emplace_back((*shardIds)[index]);
+      }
+      colNode->restrictToShards(std::move(shards));
+      wasModified = true;
+    }
+  }
+
+  opt->addPlan(std::move(plan), rule, wasModified);
+}
+
 /// WalkerWorker for undistributeRemoveAfterEnumColl
 class RemoveToEnumCollFinder final
     : public WalkerWorker<ExecutionNode, WalkerUniqueness::NonUnique> {
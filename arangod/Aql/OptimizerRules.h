@@ -211,6 +211,11 @@ void smartJoinsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
 void restrictToSingleShardRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                OptimizerRule const&);
 
+/// @brief restrict fragments on range-sharded collections to the shards
+/// whose key ranges can match the query's shard key conditions
+void restrictToShardRangesRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                               OptimizerRule const&);
+
 /// @brief move collect to the DB servers in cluster
 void collectInClusterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                           OptimizerRule const&);
@@ -39,6 +39,7 @@
 #include "Aql/ProfileLevel.h"
 #include "Aql/QueryCache.h"
 #include "Aql/QueryExecutionState.h"
+#include "Aql/QueryFingerprints.h"
 #include "Aql/QueryList.h"
 #include "Aql/QueryProfile.h"
 #include "Aql/QueryRegistry.h"
@@ -221,6 +222,18 @@ void Query::destroy() {
     }
   }
 
+  // this also accounts queries that failed or were killed before their
+  // execution started, but not explains or query cache hits
+  if (_preparedForExecution && !_queryString.empty() &&
+      (ServerState::instance()->isCoordinator() ||
+       ServerState::instance()->isSingleServer())) {
+    try {
+      trackFingerprint();
+    } catch (...) {
+      // we must not make any exception escape from here!
+    }
+  }
+
   // this will reset _trx, so _trx is invalid after here
   try {
     auto state = cleanupPlanAndEngine(TRI_ERROR_INTERNAL, /*sync*/ true);
@@ -313,6 +326,8 @@ void Query::ensureExecutionTime() noexcept {
 }
 
 void Query::prepareQuery(SerializationFormat format) {
+  _preparedForExecution = true;
+
   try {
     init(/*createProfile*/ true);
 
@@ -532,7 +547,8 @@ ExecutionState Query::execute(QueryResult& queryResult) {
         TRI_ASSERT(_trx != nullptr);
 
         if (useQueryCache && (isModificationQuery() || !_warnings.empty() ||
-                              !_ast->root()->isCacheable())) {
+                              !_ast->root()->isCacheable() ||
+                              _ast->containsInlinedUserFunction())) {
           useQueryCache = false;
         }
 
@@ -742,7 +758,8 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate) {
     logAtStart();
 
     if (useQueryCache && (isModificationQuery() || !_warnings.empty() ||
-                          !_ast->root()->isCacheable())) {
+                          !_ast->root()->isCacheable() ||
+                          _ast->containsInlinedUserFunction())) {
       useQueryCache = false;
     }
 
@@ -1076,7 +1093,8 @@ QueryResult Query::explain() {
 
       // cacheability
       result.cached = (!_queryString.empty() && !isModificationQuery() &&
-                       _warnings.empty() && _ast->root()->isCacheable());
+                       _warnings.empty() && _ast->root()->isCacheable() &&
+                       !_ast->containsInlinedUserFunction());
     }
 
     // technically no need to commit, as we are only explaining here
@@ -1230,7 +1248,12 @@ void Query::init(bool createProfile) {
   enterState(QueryExecutionState::ValueType::INITIALIZATION);
 
   TRI_ASSERT(_ast == nullptr);
-  _ast = std::make_unique<Ast>(*this);
+  // queries are only parsed on coordinators and single servers, which can
+  // look up the definitions of user functions
+  _ast = std::make_unique<Ast>(
+      *this, ServerState::instance()->isDBServer()
+                 ? AstPropertyFlag::AST_FLAG_DEFAULT
+                 : AstPropertyFlag::INLINE_USER_FUNCTIONS);
 }
 
 void Query::registerQueryInTransactionState() {
@@ -1274,6 +1297,36 @@ void Query::logAtStart() {
       << _queryString.extract(maxLength) << "'";
 }
 
+void Query::trackFingerprint() {
+  if (!vocbase().server().hasFeature<QueryRegistryFeature>() ||
+      !_vocbase.queryList()->enabled()) {
+    return;
+  }
+
+  auto* fingerprints =
+      vocbase().server().getFeature<QueryRegistryFeature>().queryFingerprints();
+  if (fingerprints == nullptr) {
+    return;
+  }
+
+  ensureExecutionTime();
+
+  QueryFingerprints::Sample sample;
+  sample.runTime = executionTime();
+  sample.rows = _snippets.empty() ? 0 : rootEngine()->returnedRows();
+  sample.peakMemoryUsage = _resourceMonitor.peak();
+  sample.scannedFull = _execStats.scannedFull;
+  sample.scannedIndex = _execStats.scannedIndex;
+  sample.filtered = _execStats.filtered;
+  sample.writesExecuted = _execStats.writesExecuted;
+  // a query without a result code has neither finished nor failed
+  // regularly, e.g. because its cursor was dropped
+  sample.failed = killed() || !_resultCode.has_value() ||
+                  *_resultCode != TRI_ERROR_NO_ERROR;
+
+  fingerprints->track(_vocbase.name(), _queryString.string(), sample);
+}
+
 void Query::logAtEnd(QueryResult const& queryResult) const {
   if (_queryString.empty()) {
     // nothing to log
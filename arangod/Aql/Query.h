@@ -283,6 +283,9 @@ class Query : public QueryContext, public std::enable_shared_from_this<Query> {
   // log the end of a query (warnings only)
   void logAtEnd(QueryResult const& queryResult) const;
 
+  // account the query's execution to the statistics of its fingerprint
+  void trackFingerprint();
+
   enum class ExecutionPhase { INITIALIZE, EXECUTE, FINALIZE };
 
  protected:
@@ -376,6 +379,10 @@ class Query : public QueryContext, public std::enable_shared_from_this<Query> {
 
   bool _registeredQueryInTrx;
 
+  /// @brief whether the query was prepared for execution, and is thus
+  /// accounted in the query fingerprint statistics when it goes away
+  bool _preparedForExecution = false;
+
 #ifdef ARANGODB_ENABLE_FAILURE_TESTS
   // Intentionally initialized here to not
   // be present in production constructors
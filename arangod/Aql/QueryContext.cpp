@@ -50,7 +50,7 @@ using namespace arangodb::aql;
 
 /// @brief creates a query
 QueryContext::QueryContext(TRI_vocbase_t& vocbase, QueryId id)
-    : _resourceMonitor(GlobalResourceMonitor::instance()),
+    : _resourceMonitor(GlobalResourceMonitor::instance(), MemorySubsystem::Aql),
       _queryId(id ? id : TRI_NewServerSpecificTick()),
       _collections(&vocbase),
       _vocbase(vocbase),
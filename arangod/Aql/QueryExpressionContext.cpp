@@ -63,6 +63,11 @@ arangodb::ValidatorBase* QueryExpressionContext::buildValidator(
   return _aqlFunctionsInternalCache.buildValidator(params);
 }
 
+basics::DateFormatProgram const* QueryExpressionContext::buildDateFormat(
+    std::string_view formatString) {
+  return _aqlFunctionsInternalCache.buildDateFormat(formatString);
+}
+
 TRI_vocbase_t& QueryExpressionContext::vocbase() const {
   return _trx.vocbase();
 }
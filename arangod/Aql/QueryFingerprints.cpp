@@ -0,0 +1,419 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "QueryFingerprints.h"
+
+#include "Basics/debugging.h"
+#include "Basics/fasthash.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Value.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+constexpr uint64_t fingerprintSeed = 0xdeadbeefdeadbeefULL;
+
+bool isIdentifierStart(char c) noexcept {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' ||
+         c == '$';
+}
+
+bool isDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+bool isIdentifierChar(char c) noexcept {
+  return isIdentifierStart(c) || isDigit(c);
+}
+
+bool isHexDigit(char c) noexcept {
+  return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+/// @brief whether the word is one of the keywords true, false or null,
+/// which are case-insensitive
+bool isKeywordLiteral(std::string_view word) noexcept {
+  auto equals = [word](std::string_view keyword) noexcept {
+    return word.size() == keyword.size() &&
+           std::equal(word.begin(), word.end(), keyword.begin(),
+                      [](char lhs, char rhs) noexcept {
+                        return (lhs | 0x20) == rhs;
+                      });
+  };
+  return equals("true") || equals("false") || equals("null");
+}
+
+bool isWhitespace(char c) noexcept {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' ||
+         c == '\v';
+}
+
+/// @brief whether a token starting with c must be separated from a preceding
+/// token ending with prev by a space
+bool needsSeparator(char prev, char c) noexcept {
+  return (isIdentifierChar(prev) || prev == '?' || prev == '`') &&
+         (isIdentifierChar(c) || c == '\'' || c == '"' || c == '`' ||
+          c == '@' || static_cast<unsigned char>(c) >= 0x80);
+}
+
+}  // namespace
+
+QueryFingerprints::QueryFingerprints(size_t maxEntries,
+                                     size_t maxQueryStringLength)
+    : _maxEntriesPerShard(std::max<size_t>(1, maxEntries / kNumShards)),
+      _maxQueryStringLength(maxQueryStringLength),
+      _size(0),
+      _evictions(0) {}
+
+std::string QueryFingerprints::normalize(std::string_view queryString) {
+  std::string out;
+  out.reserve(queryString.size());
+
+  char const* p = queryString.data();
+  char const* end = p + queryString.size();
+  bool pendingSpace = false;
+
+  while (p < end) {
+    char c = *p;
+
+    if (isWhitespace(c)) {
+      pendingSpace = true;
+      ++p;
+      continue;
+    }
+    if (c == '/' && p + 1 < end && p[1] == '/') {
+      // single-line comment
+      while (p < end && *p != '\n') {
+        ++p;
+      }
+      pendingSpace = true;
+      continue;
+    }
+    if (c == '/' && p + 1 < end && p[1] == '*') {
+      // multi-line comment
+      p += 2;
+      while (p < end && !(*p == '*' && p + 1 < end && p[1] == '/')) {
+        ++p;
+      }
+      p = std::min(p + 2, end);
+      pendingSpace = true;
+      continue;
+    }
+
+    if (pendingSpace && !out.empty() && needsSeparator(out.back(), c)) {
+      out.push_back(' ');
+    }
+    pendingSpace = false;
+
+    if (c == '\'' || c == '"') {
+      // string literal
+      ++p;
+      while (p < end && *p != c) {
+        if (*p == '\\' && p + 1 < end) {
+          ++p;
+        }
+        ++p;
+      }
+      p = std::min(p + 1, end);
+      out.push_back('?');
+    } else if (c == '`') {
+      // quoted identifier, keep as is
+      char const* start = p++;
+      while (p < end && *p != '`') {
+        if (*p == '\\' && p + 1 < end) {
+          ++p;
+        }
+        ++p;
+      }
+      p = std::min(p + 1, end);
+      out.append(start, p);
+    } else if (c == '\xc2' && p + 1 < end && p[1] == '\xb4') {
+      // identifier quoted with forward ticks (U+00B4), keep as is
+      char const* start = p;
+      p += 2;
+      while (p < end && !(*p == '\xc2' && p + 1 < end && p[1] == '\xb4')) {
+        ++p;
+      }
+      p = std::min(p + 2, end);
+      out.append(start, p);
+    } else if (c == '@') {
+      // bind parameter, keep as is
+      char const* start = p++;
+      if (p < end && *p == '@') {
+        ++p;
+      }
+      while (p < end && isIdentifierChar(*p)) {
+        ++p;
+      }
+      out.append(start, p);
+    } else if (isDigit(c) ||
+               (c == '.' && p + 1 < end && isDigit(p[1]) &&
+                (out.empty() || out.back() != '.'))) {
+      // number literal. note that "1..10" is a range, not a fraction
+      if (c == '0' && p + 1 < end && (p[1] == 'x' || p[1] == 'X')) {
+        p += 2;
+        while (p < end && isHexDigit(*p)) {
+          ++p;
+        }
+      } else if (c == '0' && p + 1 < end && (p[1] == 'b' || p[1] == 'B')) {
+        p += 2;
+        while (p < end && (*p == '0' || *p == '1')) {
+          ++p;
+        }
+      } else {
+        while (p < end && isDigit(*p)) {
+          ++p;
+        }
+        if (p + 1 < end && *p == '.' && isDigit(p[1])) {
+          ++p;
+          while (p < end && isDigit(*p)) {
+            ++p;
+          }
+        }
+        if (p < end && (*p == 'e' || *p == 'E')) {
+          char const* exp = p + 1;
+          if (exp < end && (*exp == '+' || *exp == '-')) {
+            ++exp;
+          }
+          if (exp < end && isDigit(*exp)) {
+            p = exp;
+            while (p < end && isDigit(*p)) {
+              ++p;
+            }
+          }
+        }
+      }
+      out.push_back('?');
+    } else if (isIdentifierStart(c)) {
+      // keyword, function name, variable or attribute name
+      char const* start = p;
+      while (p < end && isIdentifierChar(*p)) {
+        ++p;
+      }
+      std::string_view word(start, static_cast<size_t>(p - start));
+      if (isKeywordLiteral(word) && (out.empty() || out.back() != '.')) {
+        // boolean literal or null, but not an attribute name
+        out.push_back('?');
+      } else {
+        out.append(word);
+      }
+    } else {
+      out.push_back(c);
+      ++p;
+    }
+  }
+
+  return out;
+}
+
+uint64_t QueryFingerprints::fingerprint(std::string_view database,
+                                        std::string_view normalized) noexcept {
+  return fasthash64(
+      normalized.data(), normalized.size(),
+      fasthash64(database.data(), database.size(), fingerprintSeed));
+}
+
+void QueryFingerprints::track(std::string_view database,
+                              std::string_view queryString,
+                              Sample const& sample) {
+  std::string normalized = normalize(queryString);
+  uint64_t key = fingerprint(database, normalized);
+
+  Shard& shard = _shards[key % kNumShards];
+
+  std::lock_guard guard(shard.mutex);
+
+  uint64_t const now = ++shard.ticks;
+  if (now % (_maxEntriesPerShard * kAgingFactor) == 0) {
+    // let the frequencies decay, so that queries which were executed often
+    // a long time ago do not stay forever
+    for (auto& [_, entry] : shard.entries) {
+      entry.frequency /= 2;
+    }
+  }
+
+  auto [begin, end] = shard.entries.equal_range(key);
+  auto it = std::find_if(begin, end, [&](auto const& candidate) {
+    return candidate.second.query == normalized &&
+           candidate.second.database == database;
+  });
+  if (it == end) {
+    if (shard.entries.size() >= _maxEntriesPerShard) {
+      evict(shard);
+    }
+    Entry entry;
+    entry.database = database;
+    entry.query = std::move(normalized);
+    entry.created = now;
+    it = shard.entries.emplace(key, std::move(entry));
+    _size.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  Entry& entry = it->second;
+  ++entry.frequency;
+  entry.lastUsed = now;
+  entry.add(sample);
+}
+
+void QueryFingerprints::evict(Shard& shard) noexcept {
+  TRI_ASSERT(!shard.entries.empty());
+
+  // at most half of the entries can be protected, so that a burst of new
+  // queries does not push out the frequently executed ones
+  auto isProtected = [&](Entry const& entry) noexcept {
+    return shard.ticks - entry.created < _maxEntriesPerShard / 2;
+  };
+  // whether lhs should rather be evicted than rhs
+  auto isBetterVictim = [&](Entry const& lhs, Entry const& rhs) noexcept {
+    bool lhsProtected = isProtected(lhs);
+    if (lhsProtected != isProtected(rhs)) {
+      return !lhsProtected;
+    }
+    if (lhsProtected) {
+      // all candidates are new. throw out the oldest one
+      return lhs.created < rhs.created;
+    }
+    if (lhs.frequency != rhs.frequency) {
+      return lhs.frequency < rhs.frequency;
+    }
+    return lhs.lastUsed < rhs.lastUsed;
+  };
+
+  auto victim = shard.entries.begin();
+  for (auto it = std::next(victim); it != shard.entries.end(); ++it) {
+    if (isBetterVictim(it->second, victim->second)) {
+      victim = it;
+    }
+  }
+  shard.entries.erase(victim);
+  _size.fetch_sub(1, std::memory_order_relaxed);
+  _evictions.fetch_add(1, std::memory_order_relaxed);
+}
+
+void QueryFingerprints::toVelocyPack(velocypack::Builder& out,
+                                     std::string_view database,
+                                     bool allDatabases, size_t limit) const {
+  std::vector<std::pair<uint64_t, Entry>> entries;
+
+  for (auto const& shard : _shards) {
+    std::lock_guard guard(shard.mutex);
+    for (auto const& [key, entry] : shard.entries) {
+      if (allDatabases || entry.database == database) {
+        entries.emplace_back(key, entry);
+      }
+    }
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](auto const& lhs, auto const& rhs) {
+              return lhs.second.totalTime > rhs.second.totalTime;
+            });
+  if (entries.size() > limit) {
+    entries.resize(limit);
+  }
+
+  out.openArray();
+  for (auto const& [key, entry] : entries) {
+    entry.toVelocyPack(out, key, _maxQueryStringLength);
+  }
+  out.close();
+}
+
+void QueryFingerprints::clear(std::string_view database, bool allDatabases) {
+  for (auto& shard : _shards) {
+    std::lock_guard guard(shard.mutex);
+    size_t removed = std::erase_if(shard.entries, [&](auto const& it) {
+      return allDatabases || it.second.database == database;
+    });
+    _size.fetch_sub(removed, std::memory_order_relaxed);
+  }
+}
+
+void QueryFingerprints::Entry::add(Sample const& sample) noexcept {
+  if (calls == 0 || sample.runTime < minTime) {
+    minTime = sample.runTime;
+  }
+  maxTime = std::max(maxTime, sample.runTime);
+  totalTime += sample.runTime;
+
+  ++calls;
+  failed += sample.failed ? 1 : 0;
+  rows += sample.rows;
+  peakMemoryUsage = std::max(peakMemoryUsage, sample.peakMemoryUsage);
+  scannedFull += sample.scannedFull;
+  scannedIndex += sample.scannedIndex;
+  filtered += sample.filtered;
+  writesExecuted += sample.writesExecuted;
+
+  // bucket b contains execution times in [2^(b-1), 2^b) microseconds
+  auto micros = static_cast<uint64_t>(std::max(0.0, sample.runTime) * 1.0e6);
+  size_t bucket = std::min<size_t>(std::bit_width(micros), kNumTimeBuckets - 1);
+  ++timeBuckets[bucket];
+}
+
+double QueryFingerprints::Entry::percentile(double p) const noexcept {
+  auto rank = static_cast<uint64_t>(std::ceil(p * static_cast<double>(calls)));
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < kNumTimeBuckets; ++bucket) {
+    seen += timeBuckets[bucket];
+    if (seen >= rank) {
+      // upper bound of the bucket, which can never be more than the maximum
+      // or less than the minimum time actually seen
+      double upper = static_cast<double>(uint64_t(1) << bucket) / 1.0e6;
+      return std::clamp(upper, minTime, maxTime);
+    }
+  }
+  return maxTime;
+}
+
+void QueryFingerprints::Entry::toVelocyPack(
+    velocypack::Builder& out, uint64_t fingerprint,
+    size_t maxQueryStringLength) const {
+  out.openObject();
+  out.add("fingerprint", velocypack::Value(std::to_string(fingerprint)));
+  out.add("database", velocypack::Value(database));
+  out.add("query", velocypack::Value(std::string_view(query).substr(
+                       0, maxQueryStringLength)));
+  out.add("calls", velocypack::Value(calls));
+  out.add("failed", velocypack::Value(failed));
+  out.add("totalTime", velocypack::Value(totalTime));
+  out.add("meanTime", velocypack::Value(
+                          calls == 0 ? 0.0 : totalTime / static_cast<double>(calls)));
+  out.add("minTime", velocypack::Value(minTime));
+  out.add("maxTime", velocypack::Value(maxTime));
+  out.add("p99Time", velocypack::Value(percentile(0.99)));
+  out.add("rows", velocypack::Value(rows));
+  out.add("peakMemoryUsage", velocypack::Value(peakMemoryUsage));
+  out.add("scannedFull", velocypack::Value(scannedFull));
+  out.add("scannedIndex", velocypack::Value(scannedIndex));
+  out.add("filtered", velocypack::Value(filtered));
+  out.add("writesExecuted", velocypack::Value(writesExecuted));
+  out.close();
+}
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+namespace aql {
+
+/// @brief cumulative execution statistics for AQL queries, aggregated by
+/// query fingerprint. the fingerprint of a query is its query string with
+/// all literal values replaced by placeholders, so that queries which only
+/// differ in their literal values are counted together.
+/// the table is bounded and split into shards with a mutex each, so that
+/// concurrently finishing queries rarely contend on the same lock.
+class QueryFingerprints {
+ public:
+  /// @brief execution statistics of a single finished query
+  struct Sample {
+    double runTime = 0.0;
+    uint64_t rows = 0;
+    uint64_t peakMemoryUsage = 0;
+    uint64_t scannedFull = 0;
+    uint64_t scannedIndex = 0;
+    uint64_t filtered = 0;
+    uint64_t writesExecuted = 0;
+    bool failed = false;
+  };
+
+  /// @brief create the table, keeping at most maxEntries fingerprints
+  /// @param maxQueryStringLength max length of the normalized query strings
+  /// that are stored for display
+  QueryFingerprints(size_t maxEntries, size_t maxQueryStringLength);
+
+  QueryFingerprints(QueryFingerprints const&) = delete;
+  QueryFingerprints& operator=(QueryFingerprints const&) = delete;
+
+  /// @brief number of independently locked parts of the table
+  static constexpr size_t kNumShards = 16;
+
+  /// @brief normalize a query string: string, number and boolean literals
+  /// and null are replaced with "?", comments are removed and whitespace is
+  /// collapsed. bind parameters and quoted identifiers are kept as they are
+  static std::string normalize(std::string_view queryString);
+
+  /// @brief the fingerprint of a normalized query string in a database
+  static uint64_t fingerprint(std::string_view database,
+                              std::string_view normalized) noexcept;
+
+  /// @brief account the sample for the query string in the given database
+  void track(std::string_view database, std::string_view queryString,
+             Sample const& sample);
+
+  /// @brief build an array with the statistics for the given database (or
+  /// for all databases), ordered by descending total execution time. at most
+  /// limit entries are returned
+  void toVelocyPack(velocypack::Builder& out, std::string_view database,
+                    bool allDatabases, size_t limit) const;
+
+  /// @brief remove the statistics for the given database (or all databases)
+  void clear(std::string_view database, bool allDatabases);
+
+  /// @brief number of fingerprints currently tracked
+  size_t size() const noexcept {
+    return _size.load(std::memory_order_relaxed);
+  }
+
+  /// @brief number of fingerprints evicted so far to make room for new ones
+  uint64_t evictions() const noexcept {
+    return _evictions.load(std::memory_order_relaxed);
+  }
+
+ private:
+  /// @brief number of log2-scaled buckets (in microseconds) used for
+  /// estimating percentiles of the execution time
+  static constexpr size_t kNumTimeBuckets = 32;
+  /// @brief the eviction frequencies of a shard are halved whenever
+  /// kAgingFactor times its capacity queries have been tracked in it
+  static constexpr size_t kAgingFactor = 8;
+
+  struct Entry {
+    std::string database;
+    /// @brief the complete normalized query string
+    std::string query;
+    uint64_t calls = 0;
+    uint64_t failed = 0;
+    uint64_t rows = 0;
+    uint64_t peakMemoryUsage = 0;
+    uint64_t scannedFull = 0;
+    uint64_t scannedIndex = 0;
+    uint64_t filtered = 0;
+    uint64_t writesExecuted = 0;
+    double totalTime = 0.0;
+    double minTime = 0.0;
+    double maxTime = 0.0;
+    std::array<uint64_t, kNumTimeBuckets> timeBuckets{};
+    /// @brief number of calls used for eviction, which decays over time
+    uint64_t frequency = 0;
+    /// @brief shard tick of the creation and of the last call
+    uint64_t created = 0;
+    uint64_t lastUsed = 0;
+
+    void add(Sample const& sample) noexcept;
+    double percentile(double p) const noexcept;
+    void toVelocyPack(velocypack::Builder& out, uint64_t fingerprint,
+                      size_t maxQueryStringLength) const;
+  };
+
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    /// @brief entries, keyed by fingerprint. different queries can have
+    /// the same fingerprint, so the key alone does not identify an entry
+    std::unordered_multimap<uint64_t, Entry> entries;
+    /// @brief number of queries tracked in this shard so far
+    uint64_t ticks = 0;
+  };
+
+  /// @brief remove one entry from a full shard. entries that were created
+  /// within the last _maxEntriesPerShard / 2 ticks are kept if possible, so
+  /// a new query has a chance to be called again. of the others, the one
+  /// with the lowest frequency is evicted
+  void evict(Shard& shard) noexcept;
+
+  size_t const _maxEntriesPerShard;
+  size_t const _maxQueryStringLength;
+  std::array<Shard, kNumShards> _shards;
+  std::atomic<size_t> _size;
+  std::atomic<uint64_t> _evictions;
+};
+
+}  // namespace aql
+}  // namespace arangodb
@@ -154,7 +154,8 @@ void ShardLocking::addNode(ExecutionNode const* baseNode, size_t snippetId,
       if (useRestrictedShard) {
         addRestrictedShard(colNode->collection(), restrictedShards);
       } else if (colNode->isRestricted()) {
-        restrictedShards.emplace(colNode->restrictedShard());
+        restrictedShards.insert(colNode->restrictedShards().begin(),
+                                colNode->restrictedShards().end());
       }
 
       auto* col = colNode->collection();
@@ -198,7 +199,8 @@ void ShardLocking::addNode(ExecutionNode const* baseNode, size_t snippetId,
       if (useRestrictedShard) {
         addRestrictedShard(modNode->collection(), restrictedShards);
       } else if (modNode->isRestricted()) {
-        restrictedShards.emplace(modNode->restrictedShard());
+        restrictedShards.insert(modNode->restrictedShards().begin(),
+                                modNode->restrictedShards().end());
       }
       // Not supported yet
       TRI_ASSERT(!modNode->isUsedAsSatellite());
@@ -0,0 +1,509 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "UserFunctionExpression.h"
+
+#include "Aql/Ast.h"
+#include "Aql/AstNode.h"
+#include "Aql/Function.h"
+#include "Aql/Parser.h"
+#include "Aql/Query.h"
+#include "Aql/QueryContext.h"
+#include "Aql/QueryResult.h"
+#include "Aql/QueryString.h"
+#include "Aql/StandaloneCalculation.h"
+#include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/debugging.h"
+#include "Containers/FlatHashMap.h"
+#include "Logger/LogMacros.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/DatabaseGuard.h"
+#include "Utils/ExecContext.h"
+#include "VocBase/vocbase.h"
+
+#include <absl/strings/str_cat.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <mutex>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+using FunctionMap =
+    containers::FlatHashMap<std::string,
+                            std::shared_ptr<UserFunctionExpression const>>;
+
+/// @brief for how long loaded function definitions are used. definitions
+/// are reloaded after that, so that functions registered or removed on
+/// other coordinators become visible
+constexpr auto cacheTtl = std::chrono::seconds(5);
+/// @brief after which time without a reload the definitions of a database
+/// are dropped, so that those of dropped databases do not stay around
+constexpr auto unusedTtl = std::chrono::minutes(1);
+
+struct CachedFunctions {
+  std::shared_ptr<FunctionMap const> functions;
+  std::chrono::steady_clock::time_point expires;
+  bool loading = false;
+};
+
+std::mutex cacheLock;
+/// @brief function definitions per database id
+containers::FlatHashMap<TRI_voc_tick_t, CachedFunctions> cache;
+/// @brief increased whenever definitions are updated, so that a load that
+/// started before does not install outdated definitions
+uint64_t cacheGeneration = 0;
+
+bool isValidParameterName(std::string_view name) {
+  if (name.empty() || !std::isalpha(static_cast<unsigned char>(name[0]))) {
+    return false;
+  }
+  return std::all_of(name.begin(), name.end(), [](char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+  });
+}
+
+/// @brief validate a node of a function expression. returns an error
+/// message for invalid nodes
+std::string validateNode(AstNode const* node,
+                         std::vector<std::string> const& parameters) {
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_UNARY_PLUS:
+    case NODE_TYPE_OPERATOR_UNARY_MINUS:
+    case NODE_TYPE_OPERATOR_UNARY_NOT:
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR:
+    case NODE_TYPE_OPERATOR_BINARY_PLUS:
+    case NODE_TYPE_OPERATOR_BINARY_MINUS:
+    case NODE_TYPE_OPERATOR_BINARY_TIMES:
+    case NODE_TYPE_OPERATOR_BINARY_DIV:
+    case NODE_TYPE_OPERATOR_BINARY_MOD:
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+    case NODE_TYPE_OPERATOR_BINARY_IN:
+    case NODE_TYPE_OPERATOR_BINARY_NIN:
+    case NODE_TYPE_OPERATOR_BINARY_ARRAY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_ARRAY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_ARRAY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_ARRAY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_ARRAY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_ARRAY_GE:
+    case NODE_TYPE_OPERATOR_BINARY_ARRAY_IN:
+    case NODE_TYPE_OPERATOR_BINARY_ARRAY_NIN:
+    case NODE_TYPE_OPERATOR_NARY_AND:
+    case NODE_TYPE_OPERATOR_NARY_OR:
+    case NODE_TYPE_OPERATOR_TERNARY:
+    case NODE_TYPE_QUANTIFIER:
+    case NODE_TYPE_VALUE:
+    case NODE_TYPE_ARRAY:
+    case NODE_TYPE_OBJECT:
+    case NODE_TYPE_OBJECT_ELEMENT:
+    case NODE_TYPE_CALCULATED_OBJECT_ELEMENT:
+    case NODE_TYPE_ATTRIBUTE_ACCESS:
+    case NODE_TYPE_INDEXED_ACCESS:
+    case NODE_TYPE_RANGE:
+    case NODE_TYPE_PASSTHRU:
+      return {};
+    case NODE_TYPE_FCALL: {
+      auto func = static_cast<Function const*>(node->getData());
+      if (func->hasFlag(Function::Flags::Internal) ||
+          func->hasFlag(Function::Flags::CanReadDocuments) ||
+          !func->hasCxxImplementation()) {
+        return absl::StrCat("function '", func->name, "' is forbidden");
+      }
+      return {};
+    }
+    case NODE_TYPE_PARAMETER: {
+      auto it = std::find(parameters.begin(), parameters.end(),
+                          node->getStringView());
+      if (it == parameters.end()) {
+        return absl::StrCat("unknown parameter '@", node->getStringView(),
+                            "'");
+      }
+      return {};
+    }
+    default:
+      // variables, subqueries, data sources, user functions etc.
+      return absl::StrCat("node type '", node->getTypeString(),
+                          "' is forbidden");
+  }
+}
+
+/// @brief count the references to the parameters in a validated function
+/// expression, and note which of them are only evaluated conditionally
+void countReferences(
+    AstNode const* node, std::vector<std::string> const& parameters,
+    std::vector<UserFunctionExpression::ParameterUsage>& usage,
+    bool conditional) {
+  if (node->type == NODE_TYPE_PARAMETER) {
+    auto it = std::find(parameters.begin(), parameters.end(),
+                        node->getStringView());
+    TRI_ASSERT(it != parameters.end());
+    auto& u = usage[std::distance(parameters.begin(), it)];
+    ++u.references;
+    u.conditional |= conditional;
+    return;
+  }
+
+  // the first operand of a ternary or logical operator is always evaluated,
+  // the other operands only depending on its value
+  bool const branches = node->type == NODE_TYPE_OPERATOR_TERNARY ||
+                        node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
+                        node->type == NODE_TYPE_OPERATOR_BINARY_OR ||
+                        node->type == NODE_TYPE_OPERATOR_NARY_AND ||
+                        node->type == NODE_TYPE_OPERATOR_NARY_OR;
+  size_t const n = node->numMembers();
+  for (size_t i = 0; i < n; ++i) {
+    countReferences(node->getMemberUnchecked(i), parameters, usage,
+                    conditional || (branches && i > 0));
+  }
+}
+
+/// @brief whether or not a call argument can be evaluated any number of
+/// times, including not at all, without changing the query result
+bool isSimpleArgument(AstNode const* node) {
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    node = node->getMemberUnchecked(0);
+  }
+  return node->isConstant() || node->type == NODE_TYPE_REFERENCE ||
+         node->type == NODE_TYPE_PARAMETER;
+}
+
+/// @brief load the definitions of all expression functions of a database.
+/// returns a nullptr if they could not be loaded
+std::shared_ptr<FunctionMap const> loadFunctions(TRI_vocbase_t& vocbase) {
+  auto functions = std::make_shared<FunctionMap>();
+
+  auto binds = std::make_shared<velocypack::Builder>();
+  binds->openObject();
+  binds->add("@col", VPackValue(StaticStrings::AqlFunctionsCollection));
+  binds->close();
+
+  QueryResult queryResult;
+  try {
+    // the definitions are visible to all users of the database, regardless
+    // of their collection permissions, like JavaScript user functions are
+    ExecContextSuperuserScope scope;
+    auto query = Query::create(
+        transaction::StandaloneContext::Create(vocbase),
+        QueryString("FOR fn IN @@col FILTER fn.expression != null RETURN fn"),
+        std::move(binds));
+    queryResult = query->executeSync();
+  } catch (basics::Exception const& ex) {
+    queryResult.result.reset(ex.code(), ex.message());
+  } catch (std::exception const& ex) {
+    queryResult.result.reset(TRI_ERROR_INTERNAL, ex.what());
+  }
+
+  if (queryResult.result.fail()) {
+    LOG_TOPIC("8b2f1", DEBUG, Logger::AQL)
+        << "unable to load AQL user functions of database '"
+        << vocbase.name() << "': " << queryResult.result.errorMessage();
+    return nullptr;
+  }
+
+  for (VPackSlice it :
+       VPackArrayIterator(queryResult.data->slice().resolveExternal())) {
+    it = it.resolveExternal();
+    VPackSlice key = it.get(StaticStrings::KeyString);
+    VPackSlice name = it.get("name");
+    VPackSlice expression = it.get("expression");
+    VPackSlice params = it.get("params");
+    if (!key.isString() || !name.isString() || !expression.isString() ||
+        !params.isArray()) {
+      continue;
+    }
+
+    std::vector<std::string> parameters;
+    for (VPackSlice p : VPackArrayIterator(params)) {
+      parameters.emplace_back(p.isString() ? p.copyString() : "");
+    }
+    auto res = UserFunctionExpression::create(
+        vocbase, name.copyString(), std::move(parameters),
+        expression.stringView());
+    if (res.fail()) {
+      LOG_TOPIC("c6d40", WARN, Logger::AQL)
+          << "ignoring invalid AQL user function '" << name.stringView()
+          << "' in database '" << vocbase.name()
+          << "': " << res.errorMessage();
+      continue;
+    }
+    functions->emplace(key.copyString(), std::move(res.get()));
+  }
+  return functions;
+}
+
+/// @brief install loaded definitions, unless they were updated in the
+/// meantime. if loading failed, the previous definitions are kept, and
+/// loading is retried later
+void finishLoad(TRI_voc_tick_t databaseId, uint64_t generation,
+                std::shared_ptr<FunctionMap const> functions) {
+  auto now = std::chrono::steady_clock::now();
+
+  std::lock_guard guard(cacheLock);
+  auto it = cache.find(databaseId);
+  if (it == cache.end()) {
+    return;
+  }
+  it->second.loading = false;
+  if (functions == nullptr || generation == cacheGeneration) {
+    if (functions != nullptr) {
+      it->second.functions = std::move(functions);
+    }
+    it->second.expires = now + cacheTtl;
+  }
+
+  absl::erase_if(cache, [databaseId, now](auto const& entry) {
+    return entry.first != databaseId && !entry.second.loading &&
+           entry.second.expires + unusedTtl <= now;
+  });
+}
+
+/// @brief load the definitions of a database on a scheduler thread, so that
+/// looking up a function never runs a query in the calling thread
+void loadInBackground(TRI_vocbase_t& vocbase, uint64_t generation) {
+  TRI_voc_tick_t const databaseId = vocbase.id();
+  auto* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler == nullptr) {
+    finishLoad(databaseId, generation, nullptr);
+    return;
+  }
+
+  std::shared_ptr<DatabaseGuard> database;
+  try {
+    database = std::make_shared<DatabaseGuard>(vocbase);
+  } catch (...) {
+    finishLoad(databaseId, generation, nullptr);
+    return;
+  }
+
+  scheduler->queue(RequestLane::INTERNAL_LOW, [database = std::move(database),
+                                               databaseId, generation]() {
+    std::shared_ptr<FunctionMap const> functions;
+    try {
+      functions = loadFunctions(database->database());
+    } catch (...) {
+    }
+    finishLoad(databaseId, generation, std::move(functions));
+  });
+}
+
+}  // namespace
+
+UserFunctionExpression::UserFunctionExpression(
+    std::string name, std::vector<std::string> parameters,
+    velocypack::Builder body, std::vector<ParameterUsage> usage,
+    bool deterministic)
+    : _name(std::move(name)),
+      _parameters(std::move(parameters)),
+      _body(std::move(body)),
+      _usage(std::move(usage)),
+      _deterministic(deterministic) {
+  TRI_ASSERT(_parameters.size() == _usage.size());
+}
+
+ResultT<std::shared_ptr<UserFunctionExpression const>>
+UserFunctionExpression::create(TRI_vocbase_t& vocbase, std::string name,
+                               std::vector<std::string> parameters,
+                               std::string_view expression) {
+  for (auto it = parameters.begin(); it != parameters.end(); ++it) {
+    if (!isValidParameterName(*it)) {
+      return Result(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE,
+                    absl::StrCat("invalid parameter name '", *it,
+                                 "' for AQL user function '", name, "'"));
+    }
+    if (std::find(parameters.begin(), it, *it) != it) {
+      return Result(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE,
+                    absl::StrCat("duplicate parameter name '", *it,
+                                 "' for AQL user function '", name, "'"));
+    }
+  }
+
+  try {
+    auto queryContext = StandaloneCalculation::buildQueryContext(vocbase);
+    Ast* ast = queryContext->ast();
+    TRI_ASSERT(ast != nullptr);
+
+    // the parentheses make sure that the expression cannot be followed by
+    // further statements, and the line break terminates a trailing comment
+    QueryString queryString(absl::StrCat("RETURN (", expression, "\n)"));
+    Parser parser(*queryContext, *ast, queryString);
+    parser.parse();
+
+    AstNode const* root = ast->root();
+    TRI_ASSERT(root->type == NODE_TYPE_ROOT);
+    TRI_ASSERT(root->numMembers() == 1);
+    TRI_ASSERT(root->getMember(0)->type == NODE_TYPE_RETURN);
+    AstNode const* body = root->getMember(0)->getMember(0);
+
+    std::string errorMessage;
+    Ast::traverseReadOnly(
+        body,
+        [&](AstNode const* node) {
+          if (errorMessage.empty()) {
+            errorMessage = validateNode(node, parameters);
+          }
+          return errorMessage.empty();
+        },
+        [](AstNode const*) {});
+
+    if (!errorMessage.empty()) {
+      return Result(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE,
+                    absl::StrCat("invalid expression for AQL user function '",
+                                 name, "': ", errorMessage));
+    }
+
+    std::vector<ParameterUsage> usage(parameters.size());
+    countReferences(body, parameters, usage, /*conditional*/ false);
+
+    velocypack::Builder serialized;
+    body->toVelocyPack(serialized, /*verbose*/ true);
+
+    return {std::make_shared<UserFunctionExpression const>(
+        std::move(name), std::move(parameters), std::move(serialized),
+        std::move(usage), body->isDeterministic())};
+  } catch (basics::Exception const& ex) {
+    return Result(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE,
+                  absl::StrCat("invalid expression for AQL user function '",
+                               name, "': ", ex.message()));
+  } catch (std::exception const& ex) {
+    return Result(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE, ex.what());
+  }
+}
+
+std::shared_ptr<UserFunctionExpression const> UserFunctionExpression::lookup(
+    TRI_vocbase_t& vocbase, std::string_view name) {
+  auto now = std::chrono::steady_clock::now();
+  std::shared_ptr<FunctionMap const> functions;
+  uint64_t generation;
+  bool load = false;
+  {
+    std::lock_guard guard(cacheLock);
+    auto& entry = cache[vocbase.id()];
+    if (entry.expires <= now && !entry.loading) {
+      entry.loading = true;
+      load = true;
+    }
+    functions = entry.functions;
+    generation = cacheGeneration;
+  }
+
+  if (load) {
+    loadInBackground(vocbase, generation);
+  }
+
+  if (functions != nullptr) {
+    if (auto it = functions->find(name); it != functions->end()) {
+      return it->second;
+    }
+  }
+  return nullptr;
+}
+
+void UserFunctionExpression::update(
+    TRI_vocbase_t& vocbase, std::string const& name,
+    std::shared_ptr<UserFunctionExpression const> function) {
+  std::lock_guard guard(cacheLock);
+  ++cacheGeneration;
+  auto& entry = cache[vocbase.id()];
+  // the map is shared with running lookups, so it is copied on write
+  auto functions = entry.functions != nullptr
+                       ? std::make_shared<FunctionMap>(*entry.functions)
+                       : std::make_shared<FunctionMap>();
+  if (function != nullptr) {
+    (*functions)[name] = std::move(function);
+  } else {
+    functions->erase(name);
+  }
+  entry.functions = std::move(functions);
+}
+
+void UserFunctionExpression::removeGroup(TRI_vocbase_t& vocbase,
+                                         std::string_view prefix) {
+  std::lock_guard guard(cacheLock);
+  ++cacheGeneration;
+  auto it = cache.find(vocbase.id());
+  if (it == cache.end() || it->second.functions == nullptr) {
+    return;
+  }
+  auto functions = std::make_shared<FunctionMap>(*it->second.functions);
+  absl::erase_if(*functions, [prefix](auto const& function) {
+    return function.first.starts_with(prefix);
+  });
+  it->second.functions = std::move(functions);
+}
+
+AstNode* UserFunctionExpression::inlineCall(Ast& ast,
+                                            AstNode const* arguments) const {
+  TRI_ASSERT(arguments != nullptr);
+  TRI_ASSERT(arguments->type == NODE_TYPE_ARRAY);
+
+  size_t const n = arguments->numMembers();
+  if (n != _parameters.size()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, _name.c_str(),
+        static_cast<int>(_parameters.size()),
+        static_cast<int>(_parameters.size()));
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    // a call evaluates each of its arguments exactly once. unless it is a
+    // constant or a variable, an argument must thus be referenced exactly
+    // once in the body, and not only depending on a condition
+    if ((_usage[i].references != 1 || _usage[i].conditional) &&
+        !isSimpleArgument(arguments->getMemberUnchecked(i))) {
+      return nullptr;
+    }
+  }
+
+  // instantiate the body in the calling query's AST, and replace the
+  // parameters with the call arguments. the first reference to an argument
+  // takes over the argument node, all further references get a copy
+  std::vector<size_t> used(n, 0);
+  AstNode* body = ast.createNode(_body.slice());
+  return Ast::traverseAndModify(body, [&](AstNode* node) -> AstNode* {
+    if (node->type != NODE_TYPE_PARAMETER) {
+      return node;
+    }
+    auto it = std::find(_parameters.begin(), _parameters.end(),
+                        node->getStringView());
+    TRI_ASSERT(it != _parameters.end());
+    size_t i = std::distance(_parameters.begin(), it);
+    AstNode* argument =
+        const_cast<AstNode*>(arguments->getMemberUnchecked(i));
+    return used[i]++ == 0 ? argument : ast.clone(argument);
+  });
+}
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Basics/ResultT.h"
+
+#include <velocypack/Builder.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct TRI_vocbase_t;
+
+namespace arangodb::aql {
+class Ast;
+struct AstNode;
+
+/// @brief an AQL user-defined function whose body is an AQL expression
+/// instead of JavaScript code. the function parameters are referred to as
+/// bind parameters in the expression, e.g. `@a * @b` for a function with
+/// the parameters `a` and `b`.
+/// calls of such functions are inlined into the AST of the calling query,
+/// so that they are optimized together with the query and executed without
+/// V8. the expression is stored in its serialized AST form, so that it can
+/// be instantiated in the AST of any query.
+class UserFunctionExpression {
+ public:
+  /// @brief how a parameter is used in the body of the function
+  struct ParameterUsage {
+    /// @brief number of references to the parameter
+    size_t references = 0;
+    /// @brief whether or not a reference is only evaluated depending on a
+    /// condition, i.e. in a branch of a ternary or logical operator
+    bool conditional = false;
+  };
+
+  UserFunctionExpression(std::string name, std::vector<std::string> parameters,
+                         velocypack::Builder body,
+                         std::vector<ParameterUsage> usage,
+                         bool deterministic);
+
+  /// @brief parse and validate the expression of a user function. the
+  /// expression must only use the function parameters as bind parameters,
+  /// and must not access documents or use V8, variables, subqueries or
+  /// other user functions
+  static ResultT<std::shared_ptr<UserFunctionExpression const>> create(
+      TRI_vocbase_t& vocbase, std::string name,
+      std::vector<std::string> parameters, std::string_view expression);
+
+  /// @brief return the expression function with the given normalized (i.e.
+  /// upper-case) name from the database, or a nullptr if there is no such
+  /// function or if it is a JavaScript function. this never runs a query:
+  /// the definitions are loaded in the background if they are missing or
+  /// older than a few seconds, and until then calls are not inlined
+  static std::shared_ptr<UserFunctionExpression const> lookup(
+      TRI_vocbase_t& vocbase, std::string_view name);
+
+  /// @brief update the cached definition of the function with the given
+  /// normalized name, to be called after a user function was registered or
+  /// removed. a nullptr removes the definition, e.g. for JavaScript
+  /// functions
+  static void update(TRI_vocbase_t& vocbase, std::string const& name,
+                     std::shared_ptr<UserFunctionExpression const> function);
+
+  /// @brief remove the cached definitions of all functions whose normalized
+  /// names start with the given prefix, to be called after a group of user
+  /// functions was removed
+  static void removeGroup(TRI_vocbase_t& vocbase, std::string_view prefix);
+
+  std::string const& name() const noexcept { return _name; }
+
+  std::vector<std::string> const& parameters() const noexcept {
+    return _parameters;
+  }
+
+  /// @brief whether or not the expression always returns the same result
+  /// for the same arguments
+  bool isDeterministic() const noexcept { return _deterministic; }
+
+  /// @brief create the body of the function for a call with the given
+  /// arguments in the AST of the calling query. returns a nullptr if the
+  /// call cannot be inlined, which is the case if an argument would not be
+  /// evaluated exactly once. only constants, variables and their attributes
+  /// can be used any number of times
+  AstNode* inlineCall(Ast& ast, AstNode const* arguments) const;
+
+ private:
+  std::string const _name;
+  std::vector<std::string> const _parameters;
+  /// @brief the serialized AST of the expression
+  velocypack::Builder const _body;
+  /// @brief usage of each of the parameters in the body
+  std::vector<ParameterUsage> const _usage;
+  bool const _deterministic;
+};
+
+}  // namespace arangodb::aql
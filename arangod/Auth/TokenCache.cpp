@@ -27,6 +27,7 @@
 #include "Agency/AgencyComm.h"
 #include "Auth/Handler.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
@@ -34,10 +35,15 @@
 #include "Cluster/ServerState.h"
 #include "GeneralServer/AuthenticationFeature.h"
 #include "Logger/LogMacros.h"
+#include "Metrics/CounterBuilder.h"
+#include "Metrics/HistogramBuilder.h"
+#include "Metrics/MetricsFeature.h"
 #include "Ssl/SslInterface.h"
 
 #include <fuerte/jwt.h>
 
+#include <chrono>
+
 #include <velocypack/Builder.h>
 #include <velocypack/Collection.h>
 #include <velocypack/Iterator.h>
@@ -50,20 +56,55 @@ using namespace arangodb::rest;
 namespace {
 constexpr std::string_view hs256String("HS256");
 constexpr std::string_view jwtString("JWT");
+
+double elapsedMicros(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
 }  // namespace
 
-auth::TokenCache::TokenCache(auth::UserManager* um, double timeout)
-    : _userManager(um), _jwtCache(16384), _authTimeout(timeout) {}
+struct TokenVerificationTimeScale {
+  static metrics::LogScale<double> scale() { return {10.0, 0.0, 1000000.0, 8}; }
+};
+
+DECLARE_COUNTER(arangodb_auth_basic_cache_hits_total,
+                "Number of basic authentication tokens found in the cache");
+DECLARE_COUNTER(arangodb_auth_basic_cache_misses_total,
+                "Number of basic authentication tokens not found in the cache");
+DECLARE_COUNTER(arangodb_auth_jwt_cache_hits_total,
+                "Number of JWTs found in the cache");
+DECLARE_COUNTER(arangodb_auth_jwt_cache_misses_total,
+                "Number of JWTs not found in the cache");
+DECLARE_HISTOGRAM(
+    arangodb_auth_basic_verification_time, TokenVerificationTimeScale,
+    "Time to verify basic authentication tokens not found in the cache [us]");
+DECLARE_HISTOGRAM(arangodb_auth_jwt_verification_time,
+                  TokenVerificationTimeScale,
+                  "Time to verify JWTs not found in the cache [us]");
+
+auth::TokenCache::TokenCache(metrics::MetricsFeature& metricsFeature,
+                             auth::UserManager* um, double timeout)
+    : _userManager(um),
+      _authTimeout(timeout),
+      _basicCacheHits(
+          metricsFeature.add(arangodb_auth_basic_cache_hits_total{})),
+      _basicCacheMisses(
+          metricsFeature.add(arangodb_auth_basic_cache_misses_total{})),
+      _jwtCacheHits(metricsFeature.add(arangodb_auth_jwt_cache_hits_total{})),
+      _jwtCacheMisses(
+          metricsFeature.add(arangodb_auth_jwt_cache_misses_total{})),
+      _basicVerificationTime(
+          metricsFeature.add(arangodb_auth_basic_verification_time{})),
+      _jwtVerificationTime(
+          metricsFeature.add(arangodb_auth_jwt_verification_time{})) {}
 
 auth::TokenCache::~TokenCache() {
   // properly clear structs while using the appropriate locks
-  {
-    WRITE_LOCKER(readLocker, _basicLock);
-    _basicCache.clear();
-  }
-  {
-    WRITE_LOCKER(writeLocker, _jwtSecretLock);
-    _jwtCache.clear();
+  clearBasicCache();
+  for (auto& shard : _jwtCache) {
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    shard.cache.clear();
   }
 }
 
@@ -75,6 +116,8 @@ void auth::TokenCache::setJwtSecret(std::string const& jwtSecret) {
     LOG_TOPIC("71a76", DEBUG, Logger::AUTHENTICATION)
         << "Setting jwt secret of size " << jwtSecret.size();
     _jwtActiveSecret = jwtSecret;
+    _jwtActiveKey = std::make_shared<SslInterface::HmacKey const>(
+        _jwtActiveSecret, SslInterface::Algorithm::ALGORITHM_SHA256);
   }
   generateSuperToken();
 }
@@ -110,9 +153,15 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthentication(
   }
 }
 
-void auth::TokenCache::invalidateBasicCache() {
-  WRITE_LOCKER(guard, _basicLock);
-  _basicCache.clear();
+void auth::TokenCache::invalidateBasicCache() { clearBasicCache(); }
+
+double auth::TokenCache::getTime() const { return TRI_microtime(); }
+
+void auth::TokenCache::clearBasicCache() {
+  for (auto& shard : _basicCache) {
+    WRITE_LOCKER(guard, shard.lock);
+    shard.cache.clear();
+  }
 }
 
 // private
@@ -126,15 +175,15 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationBasic(
 
   uint64_t version = _userManager->globalVersion();
   if (_basicCacheVersion.load(std::memory_order_acquire) != version) {
-    WRITE_LOCKER(guard, _basicLock);
-    _basicCache.clear();
+    clearBasicCache();
     _basicCacheVersion.store(version, std::memory_order_release);
   }
 
+  BasicCacheShard& shard = _basicCache[shardIndex(secret)];
   {
-    READ_LOCKER(guard, _basicLock);
-    auto const& it = _basicCache.find(secret);
-    if (it != _basicCache.end() && !it->second.expired()) {
+    READ_LOCKER(guard, shard.lock);
+    auto const& it = shard.cache.find(secret);
+    if (it != shard.cache.end() && !it->second.expired(getTime())) {
       // copy entry under the read-lock
       auth::TokenCache::Entry res = it->second;
       // and now give up on the read-lock
@@ -142,12 +191,16 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationBasic(
 
       // LDAP rights might need to be refreshed
       if (!_userManager->refreshUser(res.username())) {
+        ++_basicCacheHits;
         return res;
       }
       // fallthrough intentional here
     }
   }
 
+  ++_basicCacheMisses;
+  auto start = std::chrono::steady_clock::now();
+
   // parse Basic auth header
   std::string const up = StringUtils::decodeBase64(secret);
   std::string::size_type n = up.find(':', 0);
@@ -164,16 +217,17 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationBasic(
   bool authorized = _userManager->checkPassword(username, password);
   double expiry = _authTimeout;
   if (expiry > 0) {
-    expiry += TRI_microtime();
+    expiry += getTime();
   }
 
   auth::TokenCache::Entry entry(std::move(username), authorized, expiry);
+  _basicVerificationTime.count(::elapsedMicros(start));
   {
-    WRITE_LOCKER(guard, _basicLock);
+    WRITE_LOCKER(guard, shard.lock);
     if (authorized) {
-      _basicCache.insert_or_assign(std::move(secret), entry);
+      shard.cache.insert_or_assign(std::move(secret), entry);
     } else {
-      _basicCache.erase(secret);
+      shard.cache.erase(secret);
     }
   }
 
@@ -182,29 +236,45 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationBasic(
 
 auth::TokenCache::Entry auth::TokenCache::checkAuthenticationJWT(
     std::string const& jwt) {
-  // note that we need the write lock here because it is an LRU
+  // note that we need the exclusive lock here because it is an LRU
   // cache. reading from it will move the read entry to the start of
   // the cache's linked list. so acquiring just a read-lock is
   // insufficient!!
+  JwtCacheShard& shard = _jwtCache[shardIndex(jwt)];
   {
-    std::lock_guard<std::mutex> guard(_jwtCacheMutex);
-    // intentionally copy the entry from the cache
-    auth::TokenCache::Entry const* entry = _jwtCache.get(jwt);
+    std::unique_lock<std::mutex> guard(shard.mutex);
+    auth::TokenCache::Entry const* entry = shard.cache.get(jwt);
     if (entry != nullptr) {
       // would have thrown if not found
-      if (entry->expired()) {
-        _jwtCache.remove(jwt);
+      if (entry->expired(getTime())) {
+        shard.cache.remove(jwt);
+        guard.unlock();
+        // the token has to be rejected, this is not a usable cache entry
+        ++_jwtCacheMisses;
         LOG_TOPIC("65e15", TRACE, Logger::AUTHENTICATION)
             << "JWT Token expired";
         return auth::TokenCache::Entry::Unauthenticated();
       }
+      // intentionally copy the entry from the cache, so that the user
+      // manager is not called under the lock
+      auth::TokenCache::Entry res = *entry;
+      guard.unlock();
+
+      ++_jwtCacheHits;
       if (_userManager != nullptr) {
         // LDAP rights might need to be refreshed
-        _userManager->refreshUser(entry->username());
+        _userManager->refreshUser(res.username());
       }
-      return *entry;
+      return res;
     }
   }
+
+  ++_jwtCacheMisses;
+  auto start = std::chrono::steady_clock::now();
+  auto sg = arangodb::scopeGuard([&]() noexcept {
+    _jwtVerificationTime.count(::elapsedMicros(start));
+  });
+
   std::vector<std::string> const parts = StringUtils::split(jwt, '.');
   if (parts.size() != 3) {
     LOG_TOPIC("94a73", TRACE, arangodb::Logger::AUTHENTICATION)
@@ -237,8 +307,8 @@ auth::TokenCache::Entry auth::TokenCache::checkAuthenticationJWT(
   }
 
   {
-    std::lock_guard<std::mutex> guard(_jwtCacheMutex);
-    _jwtCache.put(jwt, newEntry);
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    shard.cache.put(jwt, newEntry);
   }
   return newEntry;
 }
@@ -373,7 +443,7 @@ auth::TokenCache::Entry auth::TokenCache::validateJwtBody(
 
     // in seconds since epoch
     double expiresSecs = expSlice.getNumber<double>();
-    double now = TRI_microtime();
+    double now = getTime();
     if (now >= expiresSecs || expiresSecs == 0) {
       LOG_TOPIC("9a8b2", TRACE, Logger::AUTHENTICATION) << "expired JWT token";
       return authResult;  // unauthenticated
@@ -392,11 +462,12 @@ bool auth::TokenCache::validateJwtHMAC256Signature(
     std::string const& message, std::string const& signature) {
   std::string decodedSignature = StringUtils::decodeBase64U(signature);
 
-  READ_LOCKER(guard, _jwtSecretLock);
-  return verifyHMAC(_jwtActiveSecret.c_str(), _jwtActiveSecret.length(),
-                    message.c_str(), message.length(), decodedSignature.c_str(),
-                    decodedSignature.length(),
-                    SslInterface::Algorithm::ALGORITHM_SHA256);
+  std::shared_ptr<SslInterface::HmacKey const> key;
+  {
+    READ_LOCKER(guard, _jwtSecretLock);
+    key = _jwtActiveKey;
+  }
+  return key != nullptr && key->verify(message, decodedSignature);
 }
 #endif
 
@@ -31,12 +31,17 @@
 #include "Basics/debugging.h"
 #include "Basics/system-functions.h"
 #include "Cluster/ServerState.h"
+#include "Metrics/Fwd.h"
+#include "Metrics/LogScale.h"
 #include "Rest/CommonDefines.h"
+#include "Ssl/SslInterface.h"
 
 #include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
 
+#include <array>
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -45,13 +50,18 @@ namespace arangodb {
 namespace auth {
 class UserManager;
 
-/// @brief Caches the basic and JWT authentication tokens
+/// @brief Caches the basic and JWT authentication tokens.
+/// Both caches are split into shards by the hash of the token, each with
+/// its own lock, so that concurrent requests with different tokens do not
+/// contend on a single lock.
 class TokenCache {
  public:
   /// Construct authentication cache
+  /// @param metricsFeature feature to register the cache metrics with
   /// @param um UserManager singleton
   /// @param timeout default token expiration timeout
-  explicit TokenCache(auth::UserManager* um, double timeout);
+  explicit TokenCache(metrics::MetricsFeature& metricsFeature,
+                      auth::UserManager* um, double timeout);
   ~TokenCache();
 
  public:
@@ -70,8 +80,9 @@ class TokenCache {
     void authenticated(bool value) noexcept { _authenticated = value; }
     void setExpiry(double expiry) noexcept { _expiry = expiry; }
     double expiry() const noexcept { return _expiry; }
-    bool expired() const noexcept {
-      return _expiry != 0 && _expiry < TRI_microtime();
+    /// @param now current time in seconds since epoch
+    bool expired(double now) const noexcept {
+      return _expiry != 0 && _expiry < now;
     }
     std::vector<std::string> const& allowedPaths() const {
       return _allowedPaths;
@@ -113,6 +124,11 @@ class TokenCache {
 
   std::string jwtSecret() const;
 
+ protected:
+  /// current time in seconds since epoch, which is compared with the
+  /// expiry of tokens
+  TEST_VIRTUAL double getTime() const;
+
  private:
   /// Check basic HTTP Authentication header
   TokenCache::Entry checkAuthenticationBasic(std::string const& secret);
@@ -129,11 +145,35 @@ class TokenCache {
   /// generate new superuser jwtToken
   void generateSuperToken();
 
+  static constexpr size_t kNumShards = 16;
+
+  /// total number of entries in the JWT cache, over all shards
+  static constexpr size_t kJwtCacheSize = 16384;
+
+  struct alignas(64) BasicCacheShard {
+    mutable arangodb::basics::ReadWriteLock lock;
+    std::unordered_map<std::string, TokenCache::Entry> cache;
+  };
+
+  struct alignas(64) JwtCacheShard {
+    JwtCacheShard() : cache(kJwtCacheSize / kNumShards) {}
+
+    // the LRU cache is modified on every lookup, so it needs an
+    // exclusive lock even for reads
+    std::mutex mutex;
+    arangodb::basics::LruCache<std::string, TokenCache::Entry> cache;
+  };
+
+  static size_t shardIndex(std::string const& token) noexcept {
+    return std::hash<std::string>{}(token) % kNumShards;
+  }
+
+  void clearBasicCache();
+
  private:
   auth::UserManager* const _userManager;
 
-  mutable arangodb::basics::ReadWriteLock _basicLock;
-  std::unordered_map<std::string, TokenCache::Entry> _basicCache;
+  std::array<BasicCacheShard, kNumShards> _basicCache;
   std::atomic<uint64_t> _basicCacheVersion{0};
 
   mutable arangodb::basics::ReadWriteLock _jwtSecretLock;
@@ -142,13 +182,23 @@ class TokenCache {
   std::vector<std::string> _jwtPassiveSecrets;
 #endif
   std::string _jwtActiveSecret;
+  /// HMAC state precomputed from _jwtActiveSecret, protected by
+  /// _jwtSecretLock. the key itself can be used without the lock
+  std::shared_ptr<rest::SslInterface::HmacKey const> _jwtActiveKey;
   std::string _jwtSuperToken;  /// token for internal use
 
-  mutable std::mutex _jwtCacheMutex;
-  arangodb::basics::LruCache<std::string, TokenCache::Entry> _jwtCache;
+  std::array<JwtCacheShard, kNumShards> _jwtCache;
 
   /// Timeout in seconds
   double const _authTimeout;
+
+  metrics::Counter& _basicCacheHits;
+  metrics::Counter& _basicCacheMisses;
+  metrics::Counter& _jwtCacheHits;
+  metrics::Counter& _jwtCacheMisses;
+  /// time to validate a token that was not found in the cache [us]
+  metrics::Histogram<metrics::LogScale<double>>& _basicVerificationTime;
+  metrics::Histogram<metrics::LogScale<double>>& _jwtVerificationTime;
 };
 }  // namespace auth
 }  // namespace arangodb
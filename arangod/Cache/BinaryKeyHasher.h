@@ -28,7 +28,7 @@
 #include <string_view>
 #include <utility>
 
-#include "Basics/fasthash.h"
+#include "Basics/wyhash.h"
 
 namespace arangodb::cache {
 
@@ -36,7 +36,7 @@ struct BinaryKeyHasher {
   static constexpr std::string_view name() { return "BinaryKeyHasher"; }
 
   static std::uint32_t hashKey(void const* key, std::size_t keySize) noexcept {
-    return (std::max)(std::uint32_t{1}, fasthash32(key, keySize, 0xdeadbeefUL));
+    return (std::max)(std::uint32_t{1}, wyhash32(key, keySize, 0xdeadbeefUL));
   }
 
   static bool sameKey(void const* key1, std::size_t keySize1, void const* key2,
@@ -38,9 +38,11 @@ struct VPackKeyHasher {
 
   static std::uint32_t hashKey(void const* key,
                                std::size_t /*keySize*/) noexcept {
+    // cache hashes only live in memory, so we can use the fast hash here
+    std::uint64_t hash = arangodb::basics::VelocyPackHelper::fastNormalizedHash(
+        VPackSlice(static_cast<std::uint8_t const*>(key)), 0xdeadbeefUL);
     return (std::max)(std::uint32_t{1},
-                      VPackSlice(static_cast<std::uint8_t const*>(key))
-                          .normalizedHash32(0xdeadbeefUL));
+                      static_cast<std::uint32_t>(hash - (hash >> 32)));
   }
 
   static bool sameKey(void const* key1, std::size_t /*keySize1*/,
@@ -33,6 +33,7 @@
 #include "Logger/LogMacros.h"
 #include "Logger/Logger.h"
 #include "Logger/LoggerStream.h"
+#include "Metrics/MetricsFeature.h"
 #include "ProgramOptions/Parameters.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "Random/RandomGenerator.h"
@@ -283,8 +284,9 @@ void AuthenticationFeature::prepare() {
   }
 
   TRI_ASSERT(_authCache == nullptr);
-  _authCache = std::make_unique<auth::TokenCache>(_userManager.get(),
-                                                  _authenticationTimeout);
+  _authCache = std::make_unique<auth::TokenCache>(
+      server().getFeature<metrics::MetricsFeature>(), _userManager.get(),
+      _authenticationTimeout);
 
   if (_jwtSecretProgramOption.empty()) {
     LOG_TOPIC("43396", INFO, Logger::AUTHENTICATION)
@@ -60,6 +60,7 @@
 #include "RestHandler/RestAdminDatabaseHandler.h"
 #include "RestHandler/RestAdminExecuteHandler.h"
 #include "RestHandler/RestAdminLogHandler.h"
+#include "RestHandler/RestAdminProfileHandler.h"
 #include "RestHandler/RestAdminRoutingHandler.h"
 #include "RestHandler/RestAdminServerHandler.h"
 #include "RestHandler/RestAdminStatisticsHandler.h"
@@ -816,6 +817,10 @@ void GeneralServerFeature::defineRemainingHandlers(
       "/_admin/log",
       RestHandlerCreator<arangodb::RestAdminLogHandler>::createNoData);
 
+  f.addPrefixHandler(
+      "/_admin/profile",
+      RestHandlerCreator<arangodb::RestAdminProfileHandler>::createNoData);
+
   if (server().isEnabled<V8DealerFeature>()) {
     // the routing feature depends on V8. only enable it if JavaScript is
     // enabled
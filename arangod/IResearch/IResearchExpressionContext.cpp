@@ -73,6 +73,11 @@ arangodb::ValidatorBase* ViewExpressionContextBase::buildValidator(
   return _aqlFunctionsInternalCache->buildValidator(params);
 }
 
+basics::DateFormatProgram const* ViewExpressionContextBase::buildDateFormat(
+    std::string_view formatString) {
+  return _aqlFunctionsInternalCache->buildDateFormat(formatString);
+}
+
 TRI_vocbase_t& ViewExpressionContextBase::vocbase() const {
   return _trx->vocbase();
 }
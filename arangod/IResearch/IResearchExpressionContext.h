@@ -78,6 +78,9 @@ struct ViewExpressionContextBase : public arangodb::aql::ExpressionContext {
   arangodb::ValidatorBase* buildValidator(
       arangodb::velocypack::Slice) override final;
 
+  basics::DateFormatProgram const* buildDateFormat(
+      std::string_view formatString) override final;
+
   TRI_vocbase_t& vocbase() const override final;
   /// may be inaccessible on some platforms
   transaction::Methods& trx() const override final;
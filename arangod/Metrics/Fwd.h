@@ -32,6 +32,9 @@ class Counter;
 template<typename T>
 class Gauge;
 
+template<typename T>
+class ShardedGauge;
+
 template<typename T>
 class FixScale;
 
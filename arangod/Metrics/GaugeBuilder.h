@@ -24,6 +24,7 @@
 
 #include "Metrics/Builder.h"
 #include "Metrics/Gauge.h"
+#include "Metrics/ShardedGauge.h"
 
 namespace arangodb::metrics {
 
@@ -39,6 +40,18 @@ class GaugeBuilder : public GenericBuilder<Derived> {
   }
 };
 
+template<typename Derived, typename T>
+class ShardedGaugeBuilder : public GenericBuilder<Derived> {
+ public:
+  using MetricT = ShardedGauge<T>;
+
+  [[nodiscard]] std::string_view type() const noexcept final { return "gauge"; }
+  [[nodiscard]] std::shared_ptr<Metric> build() const final {
+    return std::make_shared<MetricT>(T{}, this->_name, this->_help,
+                                     this->_labels);
+  }
+};
+
 }  // namespace arangodb::metrics
 
 #define DECLARE_GAUGE(x, type, help)                    \
@@ -48,3 +61,11 @@ class GaugeBuilder : public GenericBuilder<Derived> {
       _help = help;                                     \
     }                                                   \
   }
+
+#define DECLARE_SHARDED_GAUGE(x, type, help)                   \
+  struct x : arangodb::metrics::ShardedGaugeBuilder<x, type> { \
+    x() {                                                      \
+      _name = #x;                                              \
+      _help = help;                                            \
+    }                                                          \
+  }
@@ -23,8 +23,10 @@
 #pragma once
 
 #include "Metrics/Metric.h"
+#include "Metrics/Shards.h"
 
 #include <atomic>
+#include <memory>
 #include <ostream>  // TODO(MBkkt) replace to iosfwd, compile error now
 #include <vector>
 
@@ -32,6 +34,9 @@ namespace arangodb::metrics {
 
 /**
  * @brief Histogram functionality
+ *
+ * Bucket counters and sum are sharded (see Shards), so counting does not
+ * contend with other threads. They are aggregated when the histogram is read.
  */
 template<typename Scale>
 class Histogram : public Metric {
@@ -41,18 +46,20 @@ class Histogram : public Metric {
   Histogram(Scale&& scale, std::string_view name, std::string_view help,
             std::string_view labels)
       : Metric(name, help, labels),
-        _c(HistType(scale.n())),
         _scale(std::move(scale)),
         _n(_scale.n() - 1),
-        _sum(0) {}
+        _linesPerShard((_scale.n() + kCountsPerLine - 1) / kCountsPerLine),
+        _lines(std::make_unique<Line[]>(Shards::count() * _linesPerShard)),
+        _sums(std::make_unique<Sum[]>(Shards::count())) {}
 
   Histogram(Scale const& scale, std::string_view name, std::string_view help,
             std::string_view labels)
       : Metric(name, help, labels),
-        _c(HistType(scale.n())),
         _scale(scale),
         _n(_scale.n() - 1),
-        _sum(0) {}
+        _linesPerShard((_scale.n() + kCountsPerLine - 1) / kCountsPerLine),
+        _lines(std::make_unique<Line[]>(Shards::count() * _linesPerShard)),
+        _sums(std::make_unique<Sum[]>(Shards::count())) {}
 
   void track_extremes(ValueType val) noexcept {
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
@@ -84,19 +91,26 @@ class Histogram : public Metric {
   void count(ValueType t) noexcept { count(t, 1); }
 
   void count(ValueType t, uint64_t n) noexcept {
+    size_t bucket;
     if (t < _scale.delims().front()) {
-      _c[0] += n;
+      bucket = 0;
     } else if (t >= _scale.delims().back()) {
-      _c[_n] += n;
+      bucket = _n;
     } else {
-      _c[pos(t)] += n;
+      bucket = pos(t);
     }
+    size_t const shard = Shards::current();
+    counter(shard, bucket).fetch_add(n, std::memory_order_relaxed);
+
+    auto& sum = _sums[shard].value;
     if constexpr (std::is_integral_v<ValueType>) {
-      _sum.fetch_add(static_cast<ValueType>(n) * t);
+      sum.fetch_add(static_cast<ValueType>(n) * t, std::memory_order_relaxed);
     } else {
-      ValueType tmp = _sum.load(std::memory_order_relaxed);
+      // the shard is normally only updated by this thread, so this
+      // succeeds at the first attempt
+      ValueType tmp = sum.load(std::memory_order_relaxed);
       do {
-      } while (!_sum.compare_exchange_weak(
+      } while (!sum.compare_exchange_weak(
           tmp, tmp + static_cast<ValueType>(n) * t, std::memory_order_relaxed,
           std::memory_order_relaxed));
     }
@@ -106,8 +120,6 @@ class Histogram : public Metric {
   ValueType low() const { return _scale.low(); }
   ValueType high() const { return _scale.high(); }
 
-  HistType::value_type& operator[](size_t n) { return _c[n]; }
-
   std::vector<uint64_t> load() const {
     std::vector<uint64_t> v(size());
     for (size_t i = 0; i < size(); ++i) {
@@ -116,9 +128,23 @@ class Histogram : public Metric {
     return v;
   }
 
-  uint64_t load(size_t i) const { return _c.load(i); }
+  uint64_t load(size_t i) const {
+    uint64_t value = 0;
+    for (size_t shard = 0, end = Shards::count(); shard != end; ++shard) {
+      value += counter(shard, i).load(std::memory_order_relaxed);
+    }
+    return value;
+  }
 
-  size_t size() const { return _c.size(); }
+  ValueType loadSum() const {
+    ValueType value = 0;
+    for (size_t shard = 0, end = Shards::count(); shard != end; ++shard) {
+      value += _sums[shard].value.load(std::memory_order_relaxed);
+    }
+    return value;
+  }
+
+  size_t size() const { return _scale.n(); }
 
   void toPrometheus(std::string& result, std::string_view globals) const final {
     std::string ls;
@@ -143,7 +169,7 @@ class Histogram : public Metric {
     (result.append(name()).append("_count") += '{').append(ls) += '}';
     result.append(std::to_string(sum)) += '\n';
     (result.append(name()).append("_sum") += '{').append(ls) += '}';
-    result.append(std::to_string(_sum.load(std::memory_order_relaxed))) += '\n';
+    result.append(std::to_string(loadSum())) += '\n';
   }
 
   std::ostream& print(std::ostream& o) const {
@@ -155,10 +181,29 @@ class Histogram : public Metric {
   }
 
  private:
-  HistType _c;
+  static constexpr size_t kCountsPerLine =
+      Shards::kCacheLineSize / sizeof(std::atomic<uint64_t>);
+
+  // a cache line worth of bucket counters. each shard starts a new line, so
+  // different shards never share a cache line
+  struct alignas(Shards::kCacheLineSize) Line {
+    std::atomic<uint64_t> counts[kCountsPerLine]{};
+  };
+
+  struct alignas(Shards::kCacheLineSize) Sum {
+    std::atomic<ValueType> value{0};
+  };
+
+  std::atomic<uint64_t>& counter(size_t shard, size_t bucket) const noexcept {
+    return _lines[shard * _linesPerShard + bucket / kCountsPerLine]
+        .counts[bucket % kCountsPerLine];
+  }
+
   Scale const _scale;
   size_t const _n;
-  std::atomic<ValueType> _sum;
+  size_t const _linesPerShard;
+  std::unique_ptr<Line[]> const _lines;
+  std::unique_ptr<Sum[]> const _sums;
 #ifdef ARANGODB_ENABLE_MAINTAINER_MODE
   std::atomic<ValueType> _lowr{std::numeric_limits<ValueType>::max()};
   std::atomic<ValueType> _highr{std::numeric_limits<ValueType>::min()};
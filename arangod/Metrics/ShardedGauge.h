@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Metrics/Metric.h"
+#include "Metrics/Shards.h"
+
+#include <velocypack/Value.h>
+#include <velocypack/Builder.h>
+
+#include <atomic>
+#include <memory>
+
+namespace arangodb::metrics {
+
+/**
+ * @brief Gauge that is only ever changed by adding and subtracting, e.g. to
+ * track the number of ongoing operations. The value is sharded (see Shards),
+ * so updates from different threads do not contend with each other. Loading
+ * the value adds up all shards, so it is more expensive than for Gauge and
+ * should not be done in hot paths.
+ */
+template<typename T>
+class ShardedGauge final : public Metric {
+ public:
+  ShardedGauge(T t, std::string_view name, std::string_view help,
+               std::string_view labels)
+      : Metric{name, help, labels},
+        _shards(std::make_unique<Shard[]>(Shards::count())) {
+    _shards[0].value.store(t, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] std::string_view type() const noexcept final { return "gauge"; }
+
+  void toPrometheus(std::string& result, std::string_view globals) const final {
+    Metric::addMark(result, name(), globals, labels());
+    result.append(std::to_string(load())) += '\n';
+  }
+
+  void toVPack(velocypack::Builder& builder, ArangodServer&) const final {
+    builder.add(velocypack::Value{name()});
+    builder.add(velocypack::Value{labels()});
+    builder.add(velocypack::Value{load()});
+  }
+
+  [[nodiscard]] T load() const noexcept {
+    // for unsigned types, single shards may wrap around if values are added
+    // and subtracted on different threads, but the total is still correct
+    T value{0};
+    for (std::size_t i = 0, end = Shards::count(); i != end; ++i) {
+      value += _shards[i].value.load(std::memory_order_relaxed);
+    }
+    return value;
+  }
+
+  void add(T t) noexcept {
+    auto& value = _shards[Shards::current()].value;
+    if constexpr (std::is_integral_v<T>) {
+      value.fetch_add(t, std::memory_order_relaxed);
+    } else {
+      T tmp(value.load(std::memory_order_relaxed));
+      while (!value.compare_exchange_weak(tmp, tmp + t,
+                                          std::memory_order_relaxed)) {
+      }
+    }
+  }
+
+  void sub(T t) noexcept {
+    auto& value = _shards[Shards::current()].value;
+    if constexpr (std::is_integral_v<T>) {
+      value.fetch_sub(t, std::memory_order_relaxed);
+    } else {
+      T tmp(value.load(std::memory_order_relaxed));
+      while (!value.compare_exchange_weak(tmp, tmp - t,
+                                          std::memory_order_relaxed)) {
+      }
+    }
+  }
+
+  ShardedGauge<T>& operator+=(T t) noexcept {
+    add(t);
+    return *this;
+  }
+
+  ShardedGauge<T>& operator-=(T t) noexcept {
+    sub(t);
+    return *this;
+  }
+
+  ShardedGauge<T>& operator++() noexcept {
+    add(1);
+    return *this;
+  }
+
+  ShardedGauge<T>& operator--() noexcept {
+    sub(1);
+    return *this;
+  }
+
+ private:
+  struct alignas(Shards::kCacheLineSize) Shard {
+    std::atomic<T> value{0};
+  };
+
+  std::unique_ptr<Shard[]> const _shards;
+};
+
+}  // namespace arangodb::metrics
@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <thread>
+
+namespace arangodb::metrics {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sharded metrics split their values into a number of cache line aligned
+/// shards. Every thread updates the shard it has been assigned to, so that
+/// threads which update the same metric concurrently do not bounce cache
+/// lines between cores. Readers add up the values of all shards, which is
+/// fine because metrics are updated far more often than they are read.
+////////////////////////////////////////////////////////////////////////////////
+struct Shards {
+  static constexpr std::size_t kCacheLineSize = 64;
+  static constexpr std::size_t kMaxCount = 16;
+
+  /// @brief number of shards, always a power of two
+  [[nodiscard]] static std::size_t count() noexcept {
+    static std::size_t const n = std::bit_ceil(std::clamp<std::size_t>(
+        std::thread::hardware_concurrency(), 1, kMaxCount));
+    return n;
+  }
+
+  /// @brief shard of the calling thread. threads are assigned to the shards
+  /// round-robin
+  [[nodiscard]] static std::size_t current() noexcept {
+    thread_local std::size_t const index = next();
+    return index;
+  }
+
+ private:
+  static std::size_t next() noexcept {
+    static std::atomic<std::size_t> threads{0};
+    return threads.fetch_add(1, std::memory_order_relaxed) & (count() - 1);
+  }
+};
+
+}  // namespace arangodb::metrics
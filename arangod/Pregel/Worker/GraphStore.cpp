@@ -110,7 +110,8 @@ GraphStore<V, E>::GraphStore(PregelFeature& feature, TRI_vocbase_t& vocbase,
                              GraphFormat<V, E>* graphFormat)
     : _feature(feature),
       _vocbaseGuard(vocbase),
-      _resourceMonitor(GlobalResourceMonitor::instance()),
+      _resourceMonitor(GlobalResourceMonitor::instance(),
+                       MemorySubsystem::Pregel),
       _executionNumber(executionNumber),
       _graphFormat(graphFormat),
       _config(nullptr),
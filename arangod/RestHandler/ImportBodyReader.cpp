@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ImportBodyReader.h"
+
+#include <velocypack/Parser.h>
+
+#include <cstring>
+#include <exception>
+
+using namespace arangodb;
+
+bool ImportBodyReader::start() {
+  if (_linewise) {
+    return true;
+  }
+  skipWhitespace();
+  if (_ptr == _end || *_ptr != '[') {
+    return false;
+  }
+  ++_ptr;
+  skipWhitespace();
+  if (_ptr < _end && *_ptr == ']') {
+    ++_ptr;
+    _done = true;
+  }
+  return true;
+}
+
+ImportBodyReader::Status ImportBodyReader::next(velocypack::Builder& builder) {
+  char const* valueEnd = nullptr;
+  if (_linewise) {
+    while (_ptr < _end && (*_ptr == ' ' || *_ptr == '\t' || *_ptr == '\r' ||
+                           *_ptr == '\b' || *_ptr == '\f')) {
+      ++_ptr;
+    }
+    if (_ptr == _end || *_ptr == '\0') {
+      return Status::kEnd;
+    }
+    if (*_ptr == '\n') {
+      ++_ptr;
+      return Status::kEmpty;
+    }
+    auto pos = static_cast<char const*>(memchr(_ptr, '\n', _end - _ptr));
+    valueEnd = (pos == nullptr) ? _end : pos;
+    _context = std::string_view(_ptr, valueEnd - _ptr);
+    _ptr = (pos == nullptr) ? _end : pos + 1;
+  } else {
+    if (_done) {
+      return Status::kEnd;
+    }
+    skipWhitespace();
+    valueEnd = findValueEnd(_ptr, _end);
+    if (valueEnd == nullptr || valueEnd == _ptr) {
+      return Status::kMalformed;
+    }
+    _context = std::string_view(_ptr, valueEnd - _ptr);
+    _ptr = valueEnd;
+    skipWhitespace();
+    if (_ptr < _end && *_ptr == ',') {
+      ++_ptr;
+    } else if (_ptr < _end && *_ptr == ']') {
+      ++_ptr;
+      _done = true;
+    } else {
+      return Status::kMalformed;
+    }
+  }
+
+  builder.clear();
+  try {
+    velocypack::Parser parser(builder);
+    parser.parse(_context.data(), _context.size());
+  } catch (std::exception const&) {
+    return Status::kInvalid;
+  }
+  return Status::kDocument;
+}
+
+char const* ImportBodyReader::findValueEnd(char const* p, char const* end) {
+  size_t depth = 0;
+  bool inString = false;
+  for (; p < end; ++p) {
+    char const c = *p;
+    if (inString) {
+      if (c == '\\') {
+        if (p + 1 == end) {
+          // the escape sequence is cut off
+          return nullptr;
+        }
+        ++p;
+      } else if (c == '"') {
+        inString = false;
+        if (depth == 0) {
+          return p + 1;
+        }
+      }
+      continue;
+    }
+    switch (c) {
+      case '"':
+        inString = true;
+        break;
+      case '{':
+      case '[':
+        ++depth;
+        break;
+      case '}':
+      case ']':
+        if (depth == 0) {
+          // end of the enclosing array
+          return p;
+        }
+        if (--depth == 0) {
+          return p + 1;
+        }
+        break;
+      case ',':
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+        if (depth == 0) {
+          return p;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  return (depth == 0 && !inString) ? end : nullptr;
+}
+
+void ImportBodyReader::skipWhitespace() {
+  while (_ptr < _end && (*_ptr == ' ' || *_ptr == '\t' || *_ptr == '\r' ||
+                         *_ptr == '\n' || *_ptr == '\b' || *_ptr == '\f')) {
+    ++_ptr;
+  }
+}
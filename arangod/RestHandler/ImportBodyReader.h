@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <velocypack/Builder.h>
+
+#include <string_view>
+
+namespace arangodb {
+
+/// @brief reads the documents of an import request body one at a time,
+/// either one JSON document per line or the members of a JSON array
+class ImportBodyReader {
+ public:
+  enum class Status { kDocument, kEmpty, kInvalid, kMalformed, kEnd };
+
+  ImportBodyReader(std::string_view body, bool linewise)
+      : _ptr(body.data()),
+        _end(body.data() + body.size()),
+        _linewise(linewise) {}
+
+  /// @brief whether the body can be read. a JSON array body must start
+  /// with an opening bracket
+  bool start();
+
+  /// @brief parses the next document into builder
+  Status next(velocypack::Builder& builder);
+
+  /// @brief the text of the document read last
+  std::string_view context() const noexcept { return _context; }
+
+  /// @brief returns the end of the JSON value starting at p, which is either
+  /// the position after its closing quote or bracket, or the position of the
+  /// delimiter following a scalar value. returns nullptr if the value is not
+  /// terminated before end. the value is not validated, this is left to the
+  /// parser
+  static char const* findValueEnd(char const* p, char const* end);
+
+ private:
+  void skipWhitespace();
+
+  char const* _ptr;
+  char const* const _end;
+  bool const _linewise;
+  bool _done = false;
+  std::string_view _context;
+};
+
+}  // namespace arangodb
@@ -0,0 +1,409 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RestAdminProfileHandler.h"
+
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/CpuProfiler.h"
+#include "Basics/files.h"
+#include "Basics/FileUtils.h"
+#include "Basics/GlobalResourceMonitor.h"
+#include "GeneralServer/ServerSecurityFeature.h"
+#include "Logger/LogMacros.h"
+#include "Logger/Logger.h"
+#include "Logger/LoggerStream.h"
+#include "Scheduler/SchedulerFeature.h"
+#include "Utils/ExecContext.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Value.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+#include <jemalloc/jemalloc.h>
+#endif
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+namespace {
+/// @brief maximum duration of a single CPU profile, in seconds
+constexpr uint64_t maxProfileSeconds = 300;
+
+/// @brief response header with the number of samples that did not fit into
+/// the profile buffers
+constexpr std::string_view droppedSamplesHeader =
+    "x-arango-profile-dropped-samples";
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+template<typename T>
+bool readMallctl(std::string const& name, T& value) {
+  size_t size = sizeof(T);
+  return mallctl(name.c_str(), &value, &size, nullptr, 0) == 0;
+}
+
+/// @brief whether jemalloc was built with profiling support and the server
+/// was started with MALLOC_CONF="prof:true". only then prof.active can be
+/// toggled at runtime
+bool heapProfilingAvailable() {
+  bool enabled = false;
+  return readMallctl("opt.prof", enabled) && enabled;
+}
+
+bool heapProfilingActive() {
+  bool active = false;
+  return readMallctl("prof.active", active) && active;
+}
+#endif
+
+void buildJemallocStats(velocypack::Builder& builder) {
+  builder.add(VPackValue("jemalloc"));
+  builder.openObject();
+#ifdef ARANGODB_HAVE_JEMALLOC
+  builder.add("available", VPackValue(true));
+
+  // statistics are cached by jemalloc and only refreshed when the epoch
+  // is advanced
+  uint64_t epoch = 1;
+  size_t size = sizeof(epoch);
+  mallctl("epoch", &epoch, &size, &epoch, size);
+
+  for (char const* name : {"allocated", "active", "metadata", "resident",
+                           "mapped", "retained"}) {
+    size_t value = 0;
+    if (readMallctl(std::string("stats.") + name, value)) {
+      builder.add(name, VPackValue(value));
+    }
+  }
+
+  builder.add(VPackValue("heapProfiling"));
+  builder.openObject();
+  bool const available = heapProfilingAvailable();
+  builder.add("available", VPackValue(available));
+  builder.add("active", VPackValue(available && heapProfilingActive()));
+  builder.close();
+
+  size_t pageSize = 0;
+  unsigned numArenas = 0;
+  readMallctl("arenas.page", pageSize);
+  readMallctl("arenas.narenas", numArenas);
+
+  builder.add(VPackValue("arenas"));
+  builder.openArray();
+  for (unsigned i = 0; i < numArenas; ++i) {
+    std::string const prefix = "stats.arenas." + std::to_string(i) + ".";
+    bool initialized = false;
+    if (!readMallctl("arena." + std::to_string(i) + ".initialized",
+                     initialized) ||
+        !initialized) {
+      continue;
+    }
+    unsigned threads = 0;
+    size_t pagesActive = 0;
+    size_t pagesDirty = 0;
+    size_t pagesMuzzy = 0;
+    size_t small = 0;
+    size_t large = 0;
+    size_t mapped = 0;
+    size_t retained = 0;
+    size_t resident = 0;
+    readMallctl(prefix + "nthreads", threads);
+    readMallctl(prefix + "pactive", pagesActive);
+    readMallctl(prefix + "pdirty", pagesDirty);
+    readMallctl(prefix + "pmuzzy", pagesMuzzy);
+    readMallctl(prefix + "small.allocated", small);
+    readMallctl(prefix + "large.allocated", large);
+    readMallctl(prefix + "mapped", mapped);
+    readMallctl(prefix + "retained", retained);
+    readMallctl(prefix + "resident", resident);
+
+    builder.openObject();
+    builder.add("arena", VPackValue(i));
+    builder.add("threads", VPackValue(threads));
+    builder.add("allocated", VPackValue(small + large));
+    builder.add("active", VPackValue(pagesActive * pageSize));
+    builder.add("dirty", VPackValue(pagesDirty * pageSize));
+    builder.add("muzzy", VPackValue(pagesMuzzy * pageSize));
+    builder.add("mapped", VPackValue(mapped));
+    builder.add("retained", VPackValue(retained));
+    builder.add("resident", VPackValue(resident));
+    builder.close();
+  }
+  builder.close();
+#else
+  builder.add("available", VPackValue(false));
+#endif
+  builder.close();
+}
+
+void buildSubsystemStats(velocypack::Builder& builder) {
+  GlobalResourceMonitor const& global = GlobalResourceMonitor::instance();
+
+  builder.add("tracked", VPackValue(global.current()));
+  builder.add("trackedLimit", VPackValue(global.memoryLimit()));
+  builder.add(VPackValue("subsystems"));
+  builder.openObject();
+  for (size_t i = 0; i < GlobalResourceMonitor::numSubsystems; ++i) {
+    auto subsystem = static_cast<MemorySubsystem>(i);
+    builder.add(GlobalResourceMonitor::subsystemName(subsystem),
+                VPackValue(global.subsystemUsage(subsystem)));
+  }
+  builder.close();
+}
+}  // namespace
+
+RestAdminProfileHandler::RestAdminProfileHandler(ArangodServer& server,
+                                                 GeneralRequest* request,
+                                                 GeneralResponse* response)
+    : RestBaseHandler(server, request, response) {}
+
+RestAdminProfileHandler::~RestAdminProfileHandler() = default;
+
+RestStatus RestAdminProfileHandler::execute() {
+  ServerSecurityFeature& security =
+      server().getFeature<ServerSecurityFeature>();
+
+  if (!security.canAccessHardenedApi()) {
+    // dont leak information about server internals here
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_FORBIDDEN);
+    return RestStatus::DONE;
+  }
+
+  if (ExecContext::isAuthEnabled() && !ExecContext::current().isSuperuser()) {
+    generateError(rest::ResponseCode::FORBIDDEN, TRI_ERROR_HTTP_FORBIDDEN,
+                  "you need super user rights for profiling");
+    return RestStatus::DONE;
+  }
+
+  auto const& suffixes = _request->suffixes();
+  auto const type = _request->requestType();
+
+  if (suffixes.size() == 1) {
+    if (suffixes[0] == "cpu" && type == RequestType::GET) {
+      return profileCpu();
+    }
+    if (suffixes[0] == "heap" && type == RequestType::GET) {
+      dumpHeapProfile();
+      return RestStatus::DONE;
+    }
+    if (suffixes[0] == "heap" && type == RequestType::PUT) {
+      setHeapProfiling();
+      return RestStatus::DONE;
+    }
+    if (suffixes[0] == "memory" && type == RequestType::GET) {
+      memoryStatistics();
+      return RestStatus::DONE;
+    }
+  }
+
+  generateError(ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND,
+                "expecting GET /_admin/profile/cpu, GET|PUT "
+                "/_admin/profile/heap or GET /_admin/profile/memory");
+  return RestStatus::DONE;
+}
+
+RestStatus RestAdminProfileHandler::continueExecute() {
+  finishCpuProfile();
+  return RestStatus::DONE;
+}
+
+RestStatus RestAdminProfileHandler::profileCpu() {
+  uint64_t const seconds = std::clamp<uint64_t>(
+      _request->parsedValue<uint64_t>("seconds", 10), 1, maxProfileSeconds);
+  auto const frequency = static_cast<uint32_t>(std::clamp<uint64_t>(
+      _request->parsedValue<uint64_t>("frequency",
+                                      CpuProfiler::defaultFrequency),
+      1, CpuProfiler::maxFrequency));
+
+  bool found = false;
+  std::string const& format = _request->value("format", found);
+  _pprof = found && format == "pprof";
+  if (found && !_pprof && format != "collapsed") {
+    generateError(ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "invalid value for 'format', expecting 'collapsed' or "
+                  "'pprof'");
+    return RestStatus::DONE;
+  }
+
+  // each thread is sampled per second of CPU time it consumes, so a
+  // thread cannot produce more samples than this
+  _profiler = std::make_unique<CpuProfiler>(frequency, seconds * frequency);
+
+  Result res = _profiler->start();
+  if (res.fail()) {
+    _profiler.reset();
+    generateError(res);
+    return RestStatus::DONE;
+  }
+
+  LOG_TOPIC("8b1d2", INFO, Logger::FIXME)
+      << "taking CPU profile of " << _profiler->numThreads()
+      << " threads for " << seconds << "s with " << frequency << " Hz";
+
+  _profileTimer = SchedulerFeature::SCHEDULER->queueDelayed(
+      "cpu-profile", RequestLane::CLIENT_SLOW, std::chrono::seconds(seconds),
+      [self = shared_from_this(), this](bool canceled) {
+        _profileCanceled = canceled;
+        wakeupHandler();
+      });
+  return RestStatus::WAITING;
+}
+
+void RestAdminProfileHandler::finishCpuProfile() {
+  TRI_ASSERT(_profiler != nullptr);
+  _profiler->stop();
+  _profileTimer.reset();
+
+  if (_profileCanceled || server().isStopping()) {
+    generateError(ResponseCode::SERVICE_UNAVAILABLE, TRI_ERROR_SHUTTING_DOWN);
+    return;
+  }
+
+  uint64_t const dropped = _profiler->numDropped();
+  if (dropped > 0) {
+    LOG_TOPIC("2fd4e", INFO, Logger::FIXME)
+        << "CPU profile buffers were full, dropped " << dropped << " of "
+        << (_profiler->numSamples() + dropped) << " samples";
+  }
+
+  resetResponse(ResponseCode::OK);
+  _response->setHeaderNC(std::string(droppedSamplesHeader),
+                         std::to_string(dropped));
+  if (_pprof) {
+    _response->setContentType(std::string("application/octet-stream"));
+    _response->addRawPayload(_profiler->toPprof());
+  } else {
+    _response->setContentType(ContentType::TEXT);
+    _response->addRawPayload(_profiler->toCollapsed());
+  }
+}
+
+void RestAdminProfileHandler::dumpHeapProfile() {
+#ifdef ARANGODB_HAVE_JEMALLOC
+  if (!heapProfilingAvailable()) {
+    generateError(ResponseCode::NOT_IMPLEMENTED, TRI_ERROR_NOT_IMPLEMENTED,
+                  "heap profiling is not available. start the server with "
+                  "MALLOC_CONF=\"prof:true,prof_active:false\"");
+    return;
+  }
+
+  long systemError;
+  std::string fileName;
+  std::string errorMessage;
+  auto res = TRI_GetTempName(nullptr, fileName, true, systemError,
+                             errorMessage);
+  if (res != TRI_ERROR_NO_ERROR) {
+    generateError(ResponseCode::SERVER_ERROR, res, errorMessage);
+    return;
+  }
+
+  char const* f = fileName.c_str();
+  std::string content;
+  try {
+    if (mallctl("prof.dump", nullptr, nullptr, &f, sizeof(char const*)) !=
+        0) {
+      TRI_UnlinkFile(f);
+      generateError(ResponseCode::SERVER_ERROR, TRI_ERROR_INTERNAL,
+                    "unable to dump heap profile");
+      return;
+    }
+    content = basics::FileUtils::slurp(fileName);
+    TRI_UnlinkFile(f);
+  } catch (...) {
+    TRI_UnlinkFile(f);
+    throw;
+  }
+
+  resetResponse(ResponseCode::OK);
+  _response->setContentType(ContentType::TEXT);
+  _response->addRawPayload(content);
+#else
+  generateError(ResponseCode::NOT_IMPLEMENTED, TRI_ERROR_NOT_IMPLEMENTED,
+                "heap profiling requires jemalloc");
+#endif
+}
+
+void RestAdminProfileHandler::setHeapProfiling() {
+  bool parseSuccess = false;
+  VPackSlice body = parseVPackBody(parseSuccess);
+  if (!parseSuccess) {
+    // error message generated in parseVPackBody
+    return;
+  }
+  if (!body.isObject() || !body.get("active").isBoolean()) {
+    generateError(ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting object with boolean attribute 'active'");
+    return;
+  }
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+  if (!heapProfilingAvailable()) {
+    generateError(ResponseCode::NOT_IMPLEMENTED, TRI_ERROR_NOT_IMPLEMENTED,
+                  "heap profiling is not available. start the server with "
+                  "MALLOC_CONF=\"prof:true,prof_active:false\"");
+    return;
+  }
+
+  bool active = body.get("active").getBoolean();
+  bool previous = false;
+  size_t size = sizeof(previous);
+  if (body.get("reset").isTrue() &&
+      mallctl("prof.reset", nullptr, nullptr, nullptr, 0) != 0) {
+    generateError(ResponseCode::SERVER_ERROR, TRI_ERROR_INTERNAL,
+                  "unable to reset heap profile");
+    return;
+  }
+  if (mallctl("prof.active", &previous, &size, &active, sizeof(active)) !=
+      0) {
+    generateError(ResponseCode::SERVER_ERROR, TRI_ERROR_INTERNAL,
+                  "unable to change heap profiling state");
+    return;
+  }
+
+  LOG_TOPIC("c6a3e", INFO, Logger::FIXME)
+      << "heap profiling " << (active ? "activated" : "deactivated");
+
+  VPackBuilder result;
+  result.openObject();
+  result.add("active", VPackValue(active));
+  result.add("previous", VPackValue(previous));
+  result.close();
+  generateOk(ResponseCode::OK, result.slice());
+#else
+  generateError(ResponseCode::NOT_IMPLEMENTED, TRI_ERROR_NOT_IMPLEMENTED,
+                "heap profiling requires jemalloc");
+#endif
+}
+
+void RestAdminProfileHandler::memoryStatistics() {
+  VPackBuilder result;
+  result.openObject();
+  buildSubsystemStats(result);
+  buildJemallocStats(result);
+  result.close();
+  generateOk(ResponseCode::OK, result.slice());
+}
@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RestHandler/RestBaseHandler.h"
+#include "Scheduler/Scheduler.h"
+
+#include <memory>
+
+namespace arangodb {
+class CpuProfiler;
+
+/// @brief handler for /_admin/profile: takes CPU profiles of the running
+/// server process, controls and dumps jemalloc heap profiles and reports
+/// memory usage per allocator arena and per subsystem
+class RestAdminProfileHandler : public RestBaseHandler {
+ public:
+  RestAdminProfileHandler(ArangodServer&, GeneralRequest*, GeneralResponse*);
+  ~RestAdminProfileHandler();
+
+  char const* name() const override final { return "RestAdminProfileHandler"; }
+  RequestLane lane() const override final { return RequestLane::CLIENT_SLOW; }
+  RestStatus execute() override;
+  RestStatus continueExecute() override;
+
+ private:
+  RestStatus profileCpu();
+  void finishCpuProfile();
+  void dumpHeapProfile();
+  void setHeapProfiling();
+  void memoryStatistics();
+
+  /// @brief the running CPU profiler. the handler does not block a thread
+  /// while the profile is taken, but is woken up by a delayed task
+  std::unique_ptr<CpuProfiler> _profiler;
+  Scheduler::WorkHandle _profileTimer;
+  bool _profileCanceled = false;
+  bool _pprof = false;
+};
+}  // namespace arangodb
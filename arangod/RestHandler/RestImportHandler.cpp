@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RestImportHandler.h"
+#include "RestHandler/ImportBodyReader.h"
 #include "Basics/NumberUtils.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
@@ -40,10 +41,22 @@
 #include <velocypack/Parser.h>
 #include <velocypack/Slice.h>
 
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+
+/// @brief default number of documents inserted per transaction by streaming
+/// imports
+constexpr uint64_t defaultStreamBatchSize = 1000;
+
+}  // namespace
+
 RestImportHandler::RestImportHandler(ArangodServer& server,
                                      GeneralRequest* request,
                                      GeneralResponse* response)
@@ -352,6 +365,16 @@ bool RestImportHandler::createFromJson(std::string const& type) {
     return false;
   }
 
+  if (_request->parsedValue("stream", false)) {
+    if (complete) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
+                    "'stream' cannot be combined with 'complete'");
+      return false;
+    }
+    return createFromJsonStream(collectionName, linewise, overwrite,
+                                opOptions);
+  }
+
   // find and load collection given by name or identifier
   auto ctx = transaction::StandaloneContext::Create(_vocbase);
   SingleCollectionTransaction trx(ctx, collectionName, AccessMode::Type::WRITE);
@@ -520,6 +543,150 @@ bool RestImportHandler::createFromJson(std::string const& type) {
   return true;
 }
 
+bool RestImportHandler::createFromJsonStream(
+    std::string const& collectionName, bool linewise, bool overwrite,
+    OperationOptions const& opOptions) {
+  uint64_t const batchSize = std::clamp<uint64_t>(
+      _request->parsedValue<uint64_t>("batchSize", ::defaultStreamBatchSize),
+      1, 1000000);
+
+  ImportBodyReader reader(_request->rawPayload(), linewise);
+  if (!reader.start()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting a JSON array in the request");
+    return false;
+  }
+
+  RestImportResult result;
+  VPackBuilder batches;
+  batches.openArray();
+
+  VPackBuilder babies;
+  VPackBuilder document;
+  VPackBuilder lineBuilder;
+  // position of the current document in the body, starting at 1
+  size_t i = 0;
+  bool more = true;
+  bool first = true;
+
+  while (more) {
+    auto ctx = transaction::StandaloneContext::Create(_vocbase);
+    SingleCollectionTransaction trx(ctx, collectionName,
+                                    AccessMode::Type::WRITE);
+
+    Result res = trx.begin();
+
+    if (res.fail()) {
+      if (first) {
+        generateTransactionError(collectionName,
+                                 OperationResult(res, opOptions), "");
+        return false;
+      }
+      registerError(result, positionize(i + 1) +
+                                "starting transaction failed: " +
+                                res.errorMessage());
+      break;
+    }
+
+    bool const isEdgeCollection = trx.isEdgeCollection(collectionName);
+
+    if (first && overwrite) {
+      OperationOptions truncateOpts(_context);
+      truncateOpts.waitForSync = false;
+      // truncate collection first
+      trx.truncate(collectionName, truncateOpts);
+      // Ignore the result ...
+    }
+    first = false;
+
+    RestImportResult batchResult;
+    size_t const offset = i + 1;
+    babies.clear();
+    babies.openArray();
+
+    // empty lines and invalid documents count towards the batch size, too
+    for (uint64_t n = 0; n < batchSize; ++n) {
+      auto status = reader.next(document);
+      if (status == ImportBodyReader::Status::kEnd) {
+        more = false;
+        break;
+      }
+
+      ++i;
+      if (status == ImportBodyReader::Status::kEmpty) {
+        ++batchResult._numEmpty;
+      } else if (status == ImportBodyReader::Status::kMalformed) {
+        registerError(batchResult,
+                      positionize(i) + "malformed JSON array in the request");
+        more = false;
+        break;
+      } else if (status == ImportBodyReader::Status::kInvalid) {
+        std::string_view context = reader.context();
+        registerError(
+            batchResult,
+            buildParseError(i, std::string(context.substr(0, 256)).c_str()));
+      } else {
+        handleSingleDocument(trx, lineBuilder, batchResult, babies,
+                             document.slice(), isEdgeCollection, i);
+      }
+    }
+
+    babies.close();
+    size_t const numDocuments = babies.slice().length();
+    size_t const numInvalid = batchResult._numErrors;
+
+    if (numDocuments > 0) {
+      res = performImport(trx, batchResult, collectionName, babies, false,
+                          opOptions);
+    }
+    res = trx.finish(res);
+
+    if (res.ok() && i + 1 == offset) {
+      // the body ended with the previous batch
+      break;
+    }
+
+    if (res.fail()) {
+      // nothing of this batch was stored
+      registerError(batchResult,
+                    positionize(offset) + "importing batch failed: " +
+                        res.errorMessage());
+      batchResult._numCreated = 0;
+      batchResult._numUpdated = 0;
+      batchResult._numIgnored = 0;
+      batchResult._numErrors =
+          numInvalid + std::max<size_t>(numDocuments, 1);
+    }
+
+    batches.openObject();
+    batches.add("offset", VPackValue(offset));
+    batches.add("documents", VPackValue(i + 1 - offset));
+    batches.add("created", VPackValue(batchResult._numCreated));
+    batches.add("errors", VPackValue(batchResult._numErrors));
+    batches.add("empty", VPackValue(batchResult._numEmpty));
+    batches.add("updated", VPackValue(batchResult._numUpdated));
+    batches.add("ignored", VPackValue(batchResult._numIgnored));
+    batches.add(StaticStrings::Error, VPackValue(res.fail()));
+    if (res.fail()) {
+      batches.add(StaticStrings::ErrorNum, VPackValue(res.errorNumber()));
+      batches.add(StaticStrings::ErrorMessage, VPackValue(res.errorMessage()));
+    }
+    batches.close();
+
+    result._numCreated += batchResult._numCreated;
+    result._numErrors += batchResult._numErrors;
+    result._numEmpty += batchResult._numEmpty;
+    result._numUpdated += batchResult._numUpdated;
+    result._numIgnored += batchResult._numIgnored;
+    std::move(batchResult._errors.begin(), batchResult._errors.end(),
+              std::back_inserter(result._errors));
+  }
+
+  batches.close();
+  generateDocumentsCreated(result, batches.slice());
+  return true;
+}
+
 bool RestImportHandler::createFromVPack(std::string const& type) {
   if (_request == nullptr) {
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid request");
@@ -951,7 +1118,7 @@ Result RestImportHandler::performImport(SingleCollectionTransaction& trx,
 ////////////////////////////////////////////////////////////////////////////////
 
 void RestImportHandler::generateDocumentsCreated(
-    RestImportResult const& result) {
+    RestImportResult const& result, VPackSlice batches) {
   VPackBuilder builder;
   builder.add(VPackValue(VPackValueType::Object));
   builder.add(StaticStrings::Error, VPackValue(false));
@@ -972,6 +1139,11 @@ void RestImportHandler::generateDocumentsCreated(
     builder.close();
   }
 
+  // per-batch results of streaming imports
+  if (batches.isArray()) {
+    builder.add("batches", batches);
+  }
+
   builder.close();
 
   generateResult(rest::ResponseCode::CREATED, builder.slice());
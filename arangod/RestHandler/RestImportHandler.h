@@ -106,6 +106,16 @@ class RestImportHandler : public RestVocbaseBaseHandler {
   bool createFromJson(std::string const&);
   bool createFromVPack(std::string const&);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief creates documents from JSON lines or a JSON array, parsing one
+  /// document at a time and inserting them in sub-batches, each in its own
+  /// transaction. only the documents of the current sub-batch are held in
+  /// memory as VelocyPack
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool createFromJsonStream(std::string const& collectionName, bool linewise,
+                            bool overwrite, OperationOptions const& opOptions);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief creates documents by JSON objects
   /// the input stream is one big JSON array containing all documents
@@ -133,7 +143,10 @@ class RestImportHandler : public RestVocbaseBaseHandler {
   /// @brief creates the result
   //////////////////////////////////////////////////////////////////////////////
 
-  void generateDocumentsCreated(RestImportResult const&);
+  void generateDocumentsCreated(
+      RestImportResult const&,
+      arangodb::velocypack::Slice batches =
+          arangodb::velocypack::Slice::noneSlice());
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief parses a string
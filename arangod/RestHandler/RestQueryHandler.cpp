@@ -146,6 +146,22 @@ void RestQueryHandler::readQuery(bool slow) {
   }
 }
 
+void RestQueryHandler::readQueryStatistics() {
+  VPackBuilder result;
+
+  bool const allDatabases = _request->parsedValue("all", false);
+  uint64_t const limit = _request->parsedValue<uint64_t>("limit", 100);
+
+  Result res = methods::Queries::listStatistics(_vocbase, result, allDatabases,
+                                                limit);
+
+  if (res.ok()) {
+    generateResult(rest::ResponseCode::OK, result.slice());
+  } else {
+    generateError(res);
+  }
+}
+
 /// @brief returns AQL query tracking
 void RestQueryHandler::readQuery() {
   auto const& suffixes = _request->suffixes();
@@ -164,10 +180,13 @@ void RestQueryHandler::readQuery() {
     readQuery(false);
   } else if (name == "properties") {
     readQueryProperties();
+  } else if (name == "statistics") {
+    readQueryStatistics();
   } else {
     generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND,
                   "unknown type '" + name +
-                      "', expecting 'slow', 'current', or 'properties'");
+                      "', expecting 'slow', 'current', 'statistics', or "
+                      "'properties'");
   }
 }
 
@@ -185,6 +204,18 @@ void RestQueryHandler::deleteQuerySlow() {
   }
 }
 
+void RestQueryHandler::deleteQueryStatistics() {
+  bool const allDatabases = _request->parsedValue("all", false);
+
+  Result res = methods::Queries::clearStatistics(_vocbase, allDatabases);
+
+  if (res.ok()) {
+    generateOk(rest::ResponseCode::OK, velocypack::Slice::noneSlice());
+  } else {
+    generateError(res);
+  }
+}
+
 void RestQueryHandler::killQuery(std::string const& id) {
   bool const allDatabases = _request->parsedValue("all", false);
   Result res =
@@ -211,6 +242,8 @@ void RestQueryHandler::deleteQuery() {
 
   if (id == "slow") {
     deleteQuerySlow();
+  } else if (id == "statistics") {
+    deleteQueryStatistics();
   } else {
     killQuery(id);
   }
@@ -371,7 +404,7 @@ ResultT<std::pair<std::string, bool>> RestQueryHandler::forwardingTarget() {
     auto const& suffixes = _request->suffixes();
     TRI_ASSERT(suffixes.size() >= 1);
     auto const& id = suffixes[0];
-    if (id != "slow") {
+    if (id != "slow" && id != "statistics") {
       uint64_t tick = basics::StringUtils::uint64(id);
       uint32_t sourceServer = TRI_ExtractServerIdFromTick(tick);
       if (sourceServer != ServerState::instance()->getShortId()) {
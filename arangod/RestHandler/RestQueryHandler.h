@@ -51,9 +51,15 @@ class RestQueryHandler : public RestVocbaseBaseHandler {
   /// @brief returns AQL query tracking
   void readQuery();
 
+  /// @brief returns the execution statistics per query fingerprint
+  void readQueryStatistics();
+
   /// @brief removes the slow log
   void deleteQuerySlow();
 
+  /// @brief removes the execution statistics per query fingerprint
+  void deleteQueryStatistics();
+
   /// @brief interrupts a query
   void deleteQuery();
 
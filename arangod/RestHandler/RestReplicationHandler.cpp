@@ -83,6 +83,7 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/Parser.h>
 #include <velocypack/Slice.h>
+#include <velocypack/Validator.h>
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -163,28 +164,10 @@ static Result checkPlanLeaderDirect(
   return Result{TRI_ERROR_FORBIDDEN};
 }
 
-static Result restoreDataParser(char const* ptr, char const* pos,
-                                std::string const& collectionName, int line,
-                                VPackBuilder& builder, VPackSlice& doc,
-                                TRI_replication_operation_e& type) {
-  builder.clear();
-
-  try {
-    TRI_ASSERT(pos >= ptr);
-    VPackParser parser(builder, builder.options);
-    parser.parse(ptr, static_cast<size_t>(pos - ptr));
-  } catch (std::exception const& ex) {
-    // Could not even build the string
-    return Result{TRI_ERROR_HTTP_CORRUPTED_JSON,
-                  "received invalid JSON data for collection '" +
-                      collectionName + "' on line " + std::to_string(line) +
-                      ": " + ex.what()};
-  } catch (...) {
-    return Result{TRI_ERROR_INTERNAL};
-  }
-
-  VPackSlice slice = builder.slice();
-
+static Result restoreDataClassifier(VPackSlice slice,
+                                    std::string const& collectionName,
+                                    int line, VPackSlice& doc,
+                                    TRI_replication_operation_e& type) {
   if (!slice.isObject()) {
     return Result{TRI_ERROR_HTTP_CORRUPTED_JSON,
                   "received invalid JSON data for collection '" +
@@ -256,6 +239,30 @@ static Result restoreDataParser(char const* ptr, char const* pos,
   return {};
 }
 
+static Result restoreDataParser(char const* ptr, char const* pos,
+                                std::string const& collectionName, int line,
+                                VPackBuilder& builder, VPackSlice& doc,
+                                TRI_replication_operation_e& type) {
+  builder.clear();
+
+  try {
+    TRI_ASSERT(pos >= ptr);
+    VPackParser parser(builder, builder.options);
+    parser.parse(ptr, static_cast<size_t>(pos - ptr));
+  } catch (std::exception const& ex) {
+    // Could not even build the string
+    return Result{TRI_ERROR_HTTP_CORRUPTED_JSON,
+                  "received invalid JSON data for collection '" +
+                      collectionName + "' on line " + std::to_string(line) +
+                      ": " + ex.what()};
+  } catch (...) {
+    return Result{TRI_ERROR_INTERNAL};
+  }
+
+  return restoreDataClassifier(builder.slice(), collectionName, line, doc,
+                               type);
+}
+
 RestReplicationHandler::RestReplicationHandler(ArangodServer& server,
                                                GeneralRequest* request,
                                                GeneralResponse* response)
@@ -1492,8 +1499,11 @@ Result RestReplicationHandler::parseBatch(
     bool generateNewRevisionIds) {
   // simon: originally VST was not allowed here, but in 3.7 the content-type
   // is properly set, so we can use it
+  // since 3.11, a batch can also consist of velocypack documents written
+  // one after the other, which saves parsing JSON
+  bool const isVPack = _request->contentType() == ContentType::VPACK;
   if (_request->transportType() != Endpoint::TransportType::HTTP &&
-      _request->contentType() != ContentType::DUMP) {
+      _request->contentType() != ContentType::DUMP && !isVPack) {
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid request type");
   }
 
@@ -1509,120 +1519,158 @@ Result RestReplicationHandler::parseBatch(
   bool const isUsersCollection =
       collectionName == StaticStrings::UsersCollection;
 
-  std::string_view bodyStr = _request->rawPayload();
-  char const* ptr = bodyStr.data();
-  char const* end = ptr + bodyStr.size();
-
-  VPackBuilder builder(
-      &basics::VelocyPackHelper::strictRequestValidationOptions);
-
   // First parse and collect all markers, we assemble everything in one
   // large builder holding an array
   documentsToRemove.clear();
   documentsToInsert.clear();
   documentsToInsert.openArray();
 
-  int line = 0;
-  while (ptr < end) {
-    char const* pos = strchr(ptr, '\n');
+  auto addMarker = [&](VPackSlice doc, TRI_replication_operation_e type) {
+    TRI_ASSERT(type != REPLICATION_INVALID);
 
-    if (pos == nullptr) {
-      pos = end;
-    } else {
-      *(const_cast<char*>(pos)) = '\0';
-      ++line;
+    // Put into array of all parsed markers:
+    if (type == REPLICATION_MARKER_DOCUMENT) {
+      documentsToInsert.openObject();
+
+      TRI_ASSERT(doc.isObject());
+      bool checkKey = true;
+      bool checkRev = generateNewRevisionIds;
+      for (auto it : VPackObjectIterator(doc, true)) {
+        // only check for "_key" attribute here if we still have to.
+        // once we have seen it, it will not show up again in the same
+        // document
+        bool const isKey =
+            checkKey && (it.key.stringView() == StaticStrings::KeyString);
+
+        if (isKey) {
+          // _key attribute
+
+          // prevent checking for _key twice in the same document
+          checkKey = false;
+
+          if (isUsersCollection) {
+            // ignore _key for _users
+            continue;
+          }
+          if (!documentsToRemove.empty()) {
+            // for any document key that we have tracked in documentsToRemove,
+            // we now got a new version to insert, so we need to remove the
+            // key from documentsToRemove. this is expensive, but we only have
+            // to pay for it if there are REPLICATION_MARKER_REMOVE markers
+            // present, which can only happen with MMFiles dumps from <= 3.6
+            documentsToRemove.erase(it.value.copyString());
+          }
+
+          documentsToInsert.add(it.key);
+          documentsToInsert.add(it.value);
+        } else if (checkRev &&
+                   (it.key.stringView() == StaticStrings::RevString)) {
+          // _rev attribute
+
+          // prevent checking for _rev twice in the same document
+          checkRev = false;
+
+          // We simply get rid of the `_rev` attribute here on the
+          // coordinator. We need to create a new value but it has to be
+          // unique in the shard, therefore the shard leader must create the
+          // value. If multiple coordinators would create a timestamp based
+          // _rev value concurrently, we could get a duplicate, which would
+          // lead to a clash on the actual shard leader and can lead to
+          // RocksDB conflicts or even data corruption between primary index
+          // and data in the documents column family.
+        } else {
+          // copy key/value verbatim
+          documentsToInsert.add(it.key);
+          documentsToInsert.add(it.value);
+        }
+      }
+
+      documentsToInsert.close();
+    } else if (type == REPLICATION_MARKER_REMOVE) {
+      // keep track of which documents to remove.
+      // in case we add a document to remove here that is already in
+      // documentsToInsert, this case will be detected later.
+      TRI_ASSERT(doc.isString());
+      documentsToRemove.emplace(doc.copyString());
     }
+  };
+
+  std::string_view bodyStr = _request->rawPayload();
+  char const* ptr = bodyStr.data();
+  char const* end = ptr + bodyStr.size();
+
+  if (isVPack) {
+    VPackValidator validator(
+        &basics::VelocyPackHelper::strictRequestValidationOptions);
+
+    int line = 0;
+    while (ptr < end) {
+      auto const* start = reinterpret_cast<uint8_t const*>(ptr);
+      size_t const length = static_cast<size_t>(end - ptr);
+      VPackSlice slice;
+      try {
+        // the input may contain more documents after this one
+        validator.validate(start, length, /*isSubPart*/ true);
+        slice = VPackSlice(start);
+      } catch (std::exception const& ex) {
+        return {TRI_ERROR_HTTP_CORRUPTED_JSON,
+                "received invalid velocypack data for collection '" +
+                    collectionName + "' in document " +
+                    std::to_string(line + 1) + ": " + ex.what()};
+      }
+      ++line;
 
-    TRI_ASSERT(ptr <= pos);
-    TRI_ASSERT(pos <= end);
-    if (pos - ptr > 1) {
-      // found something
       VPackSlice doc;
       TRI_replication_operation_e type = REPLICATION_INVALID;
-
       Result res =
-          restoreDataParser(ptr, pos, collectionName, line, builder, doc, type);
+          restoreDataClassifier(slice, collectionName, line, doc, type);
       if (res.fail()) {
-        if (res.is(TRI_ERROR_HTTP_CORRUPTED_JSON)) {
-          using namespace std::literals::string_literals;
-          auto data = std::string(ptr, pos);
-          res.withError([&](result::Error& err) {
-            err.appendErrorMessage(" in message '"s + data + "'");
-          });
-        }
         return res;
       }
+      addMarker(doc, type);
 
-      TRI_ASSERT(type != REPLICATION_INVALID);
+      ptr += slice.byteSize();
+    }
+  } else {
+    VPackBuilder builder(
+        &basics::VelocyPackHelper::strictRequestValidationOptions);
 
-      // Put into array of all parsed markers:
-      if (type == REPLICATION_MARKER_DOCUMENT) {
-        documentsToInsert.openObject();
-
-        TRI_ASSERT(doc.isObject());
-        bool checkKey = true;
-        bool checkRev = generateNewRevisionIds;
-        for (auto it : VPackObjectIterator(doc, true)) {
-          // only check for "_key" attribute here if we still have to.
-          // once we have seen it, it will not show up again in the same
-          // document
-          bool const isKey =
-              checkKey && (it.key.stringView() == StaticStrings::KeyString);
-
-          if (isKey) {
-            // _key attribute
-
-            // prevent checking for _key twice in the same document
-            checkKey = false;
-
-            if (isUsersCollection) {
-              // ignore _key for _users
-              continue;
-            }
-            if (!documentsToRemove.empty()) {
-              // for any document key that we have tracked in documentsToRemove,
-              // we now got a new version to insert, so we need to remove the
-              // key from documentsToRemove. this is expensive, but we only have
-              // to pay for it if there are REPLICATION_MARKER_REMOVE markers
-              // present, which can only happen with MMFiles dumps from <= 3.6
-              documentsToRemove.erase(it.value.copyString());
-            }
+    int line = 0;
+    while (ptr < end) {
+      char const* pos = strchr(ptr, '\n');
 
-            documentsToInsert.add(it.key);
-            documentsToInsert.add(it.value);
-          } else if (checkRev &&
-                     (it.key.stringView() == StaticStrings::RevString)) {
-            // _rev attribute
-
-            // prevent checking for _rev twice in the same document
-            checkRev = false;
-
-            // We simply get rid of the `_rev` attribute here on the
-            // coordinator. We need to create a new value but it has to be
-            // unique in the shard, therefore the shard leader must create the
-            // value. If multiple coordinators would create a timestamp based
-            // _rev value concurrently, we could get a duplicate, which would
-            // lead to a clash on the actual shard leader and can lead to
-            // RocksDB conflicts or even data corruption between primary index
-            // and data in the documents column family.
-          } else {
-            // copy key/value verbatim
-            documentsToInsert.add(it.key);
-            documentsToInsert.add(it.value);
+      if (pos == nullptr) {
+        pos = end;
+      } else {
+        *(const_cast<char*>(pos)) = '\0';
+        ++line;
+      }
+
+      TRI_ASSERT(ptr <= pos);
+      TRI_ASSERT(pos <= end);
+      if (pos - ptr > 1) {
+        // found something
+        VPackSlice doc;
+        TRI_replication_operation_e type = REPLICATION_INVALID;
+
+        Result res = restoreDataParser(ptr, pos, collectionName, line, builder,
+                                       doc, type);
+        if (res.fail()) {
+          if (res.is(TRI_ERROR_HTTP_CORRUPTED_JSON)) {
+            using namespace std::literals::string_literals;
+            auto data = std::string(ptr, pos);
+            res.withError([&](result::Error& err) {
+              err.appendErrorMessage(" in message '"s + data + "'");
+            });
           }
+          return res;
         }
 
-        documentsToInsert.close();
-      } else if (type == REPLICATION_MARKER_REMOVE) {
-        // keep track of which documents to remove.
-        // in case we add a document to remove here that is already in
-        // documentsToInsert, this case will be detected later.
-        TRI_ASSERT(doc.isString());
-        documentsToRemove.emplace(doc.copyString());
+        addMarker(doc, type);
       }
-    }
 
-    ptr = pos + 1;
+      ptr = pos + 1;
+    }
   }
 
   // close array
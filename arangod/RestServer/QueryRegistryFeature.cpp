@@ -28,6 +28,7 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Aql/Query.h"
 #include "Aql/QueryCache.h"
+#include "Aql/QueryFingerprints.h"
 #include "Aql/QueryRegistry.h"
 #include "Basics/GlobalResourceMonitor.h"
 #include "Basics/NumberOfCores.h"
@@ -150,8 +151,8 @@ DECLARE_HISTOGRAM(arangodb_aql_slow_query_time, SlowQueryTimeScale,
                   "Execution time histogram for slow AQL queries [s]");
 DECLARE_COUNTER(arangodb_aql_total_query_time_msec_total,
                 "Total execution time of all AQL queries [ms]");
-DECLARE_GAUGE(arangodb_aql_current_query, uint64_t,
-              "Current number of AQL queries executing");
+DECLARE_SHARDED_GAUGE(arangodb_aql_current_query, uint64_t,
+                      "Current number of AQL queries executing");
 DECLARE_GAUGE(
     arangodb_aql_global_memory_usage, uint64_t,
     "Total memory usage of all AQL queries executing [bytes], granularity: " +
@@ -162,6 +163,10 @@ DECLARE_COUNTER(arangodb_aql_global_query_memory_limit_reached_total,
                 "Number of global AQL query memory limit violations");
 DECLARE_COUNTER(arangodb_aql_local_query_memory_limit_reached_total,
                 "Number of local AQL query memory limit violations");
+DECLARE_GAUGE(arangodb_aql_query_fingerprints, uint64_t,
+              "Number of AQL query fingerprints with tracked statistics");
+DECLARE_COUNTER(arangodb_aql_query_fingerprints_evicted_total,
+                "Number of AQL query fingerprints evicted from statistics");
 
 QueryRegistryFeature::QueryRegistryFeature(Server& server)
     : ArangodFeature{server, *this},
@@ -170,6 +175,7 @@ QueryRegistryFeature::QueryRegistryFeature(Server& server)
       _trackQueryString(true),
       _trackBindVars(true),
       _trackDataSources(false),
+      _trackFingerprints(true),
       _failOnWarning(aql::QueryOptions::defaultFailOnWarning),
       _requireWith(false),
       _queryCacheIncludeSystem(false),
@@ -181,6 +187,7 @@ QueryRegistryFeature::QueryRegistryFeature(Server& server)
       _allowCollectionsInExpressions(false),
       _logFailedQueries(false),
       _maxQueryStringLength(4096),
+      _maxFingerprints(1024),
       _peakMemoryUsageThreshold(4294967296),  // 4GB
       _queryGlobalMemoryLimit(
           defaultMemoryLimit(PhysicalMemory::getValue(), 0.1, 0.90)),
@@ -217,7 +224,12 @@ QueryRegistryFeature::QueryRegistryFeature(Server& server)
               arangodb_aql_global_query_memory_limit_reached_total{})),
       _localQueryMemoryLimitReached(
           server.getFeature<metrics::MetricsFeature>().add(
-              arangodb_aql_local_query_memory_limit_reached_total{})) {
+              arangodb_aql_local_query_memory_limit_reached_total{})),
+      _queryFingerprintsCount(server.getFeature<metrics::MetricsFeature>().add(
+          arangodb_aql_query_fingerprints{})),
+      _queryFingerprintsEvicted(
+          server.getFeature<metrics::MetricsFeature>().add(
+              arangodb_aql_query_fingerprints_evicted_total{})) {
   static_assert(
       Server::isCreatedAfter<QueryRegistryFeature, metrics::MetricsFeature>());
 
@@ -231,6 +243,8 @@ QueryRegistryFeature::QueryRegistryFeature(Server& server)
   _queryCacheIncludeSystem = properties.includeSystem;
 }
 
+QueryRegistryFeature::~QueryRegistryFeature() = default;
+
 void QueryRegistryFeature::collectOptions(
     std::shared_ptr<ProgramOptions> options) {
   options->addSection("query", "AQL queries");
@@ -401,6 +415,43 @@ option to `false`.)");
                   new BooleanParameter(&_trackDataSources))
       .setIntroducedIn(30704);
 
+  options
+      ->addOption("--query.tracking-fingerprints",
+                  "Whether to keep cumulative statistics for AQL queries, "
+                  "aggregated by query fingerprint.",
+                  new BooleanParameter(&_trackFingerprints),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnCoordinator,
+                      arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31100)
+      .setLongDescription(R"(If set to `true`, the execution time, number of
+result rows, peak memory usage and number of scanned and filtered documents of
+every finished, failed or killed AQL query are accounted to the query's
+fingerprint. The fingerprint is the query string with all string, number and
+boolean literals and `null` replaced by placeholders, so that queries that only
+differ in their literal values are aggregated.
+
+The statistics can be retrieved via the `/_api/query/statistics` endpoint.
+This option only has an effect if `--query.tracking` is set to `true`.)");
+
+  options
+      ->addOption("--query.max-fingerprints",
+                  "The maximum number of AQL query fingerprints to keep "
+                  "statistics for.",
+                  new SizeTParameter(&_maxFingerprints, /*base*/ 1,
+                                     /*minValue*/ 16),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::Uncommon,
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnCoordinator,
+                      arangodb::options::Flags::OnSingle))
+      .setIntroducedIn(31100)
+      .setLongDescription(R"(Once this many fingerprints are tracked, the
+least frequently executed query fingerprints are evicted to make room for new
+ones. Executions in the past count less than recent ones, and fingerprints that
+were just added are only evicted if there is no other choice.)");
+
   options
       ->addOption("--query.fail-on-warning",
                   "Whether AQL queries should fail with errors even for "
@@ -767,6 +818,11 @@ void QueryRegistryFeature::prepare() {
   arangodb::aql::QueryCache::instance()->properties(properties);
   // create the query registry
   _queryRegistry = std::make_unique<aql::QueryRegistry>(_queryRegistryTTL);
+
+  if (_trackingEnabled && _trackFingerprints) {
+    _queryFingerprints = std::make_unique<aql::QueryFingerprints>(
+        _maxFingerprints, _maxQueryStringLength);
+  }
   QUERY_REGISTRY.store(_queryRegistry.get(), std::memory_order_release);
 }
 
@@ -796,6 +852,11 @@ void QueryRegistryFeature::updateMetrics() {
   auto stats = global.stats();
   _globalQueryMemoryLimitReached = stats.globalLimitReached;
   _localQueryMemoryLimitReached = stats.localLimitReached;
+
+  if (_queryFingerprints != nullptr) {
+    _queryFingerprintsCount = _queryFingerprints->size();
+    _queryFingerprintsEvicted = _queryFingerprints->evictions();
+  }
 }
 
 void QueryRegistryFeature::trackQueryStart() noexcept { ++_runningQueries; }
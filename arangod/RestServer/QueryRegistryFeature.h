@@ -28,6 +28,9 @@
 #include "Metrics/Fwd.h"
 
 namespace arangodb {
+namespace aql {
+class QueryFingerprints;
+}
 
 class QueryRegistryFeature final : public ArangodFeature {
  public:
@@ -38,6 +41,7 @@ class QueryRegistryFeature final : public ArangodFeature {
   }
 
   explicit QueryRegistryFeature(Server& server);
+  ~QueryRegistryFeature();
 
   void collectOptions(std::shared_ptr<options::ProgramOptions>) override final;
   void validateOptions(std::shared_ptr<options::ProgramOptions>) override final;
@@ -61,6 +65,7 @@ class QueryRegistryFeature final : public ArangodFeature {
   bool trackQueryString() const noexcept { return _trackQueryString; }
   bool trackBindVars() const noexcept { return _trackBindVars; }
   bool trackDataSources() const noexcept { return _trackDataSources; }
+  bool trackFingerprints() const noexcept { return _trackFingerprints; }
   double slowQueryThreshold() const noexcept { return _slowQueryThreshold; }
   double slowStreamingQueryThreshold() const noexcept {
     return _slowStreamingQueryThreshold;
@@ -89,6 +94,10 @@ class QueryRegistryFeature final : public ArangodFeature {
     return _queryRegistry.get();
   }
   uint64_t maxParallelism() const noexcept { return _maxParallelism; }
+  // statistics per query fingerprint. nullptr if not tracked
+  aql::QueryFingerprints* queryFingerprints() const noexcept {
+    return _queryFingerprints.get();
+  }
 
  private:
   bool _trackingEnabled;
@@ -96,6 +105,7 @@ class QueryRegistryFeature final : public ArangodFeature {
   bool _trackQueryString;
   bool _trackBindVars;
   bool _trackDataSources;
+  bool _trackFingerprints;
   bool _failOnWarning;
   bool _requireWith;
   bool _queryCacheIncludeSystem;
@@ -107,6 +117,7 @@ class QueryRegistryFeature final : public ArangodFeature {
   bool _allowCollectionsInExpressions;
   bool _logFailedQueries;
   size_t _maxQueryStringLength;
+  size_t _maxFingerprints;
   uint64_t _peakMemoryUsageThreshold;
   uint64_t _queryGlobalMemoryLimit;
   uint64_t _queryMemoryLimit;
@@ -127,16 +138,19 @@ class QueryRegistryFeature final : public ArangodFeature {
   static std::atomic<aql::QueryRegistry*> QUERY_REGISTRY;
 
   std::unique_ptr<aql::QueryRegistry> _queryRegistry;
+  std::unique_ptr<aql::QueryFingerprints> _queryFingerprints;
 
   metrics::Histogram<metrics::LogScale<double>>& _queryTimes;
   metrics::Histogram<metrics::LogScale<double>>& _slowQueryTimes;
   metrics::Counter& _totalQueryExecutionTime;
   metrics::Counter& _queriesCounter;
-  metrics::Gauge<uint64_t>& _runningQueries;
+  metrics::ShardedGauge<uint64_t>& _runningQueries;
   metrics::Gauge<uint64_t>& _globalQueryMemoryUsage;
   metrics::Gauge<uint64_t>& _globalQueryMemoryLimit;
   metrics::Counter& _globalQueryMemoryLimitReached;
   metrics::Counter& _localQueryMemoryLimitReached;
+  metrics::Gauge<uint64_t>& _queryFingerprintsCount;
+  metrics::Counter& _queryFingerprintsEvicted;
 };
 
 }  // namespace arangodb
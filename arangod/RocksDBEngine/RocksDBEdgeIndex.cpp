@@ -694,7 +694,8 @@ void RocksDBEdgeIndex::refillCache(transaction::Methods& trx,
   // intentionally empty
   keysBuilder.add(VPackSlice::emptyArraySlice());
 
-  ResourceMonitor monitor(GlobalResourceMonitor::instance());
+  ResourceMonitor monitor(GlobalResourceMonitor::instance(),
+                          MemorySubsystem::Indexes);
   RocksDBEdgeIndexLookupIterator it(monitor, &_collection, &trx, this,
                                     std::move(keysBuilder), _cache,
                                     ReadOwnWrites::no);
@@ -205,7 +205,7 @@ void RocksDBOptimizerRules::reduceExtractionToProjectionRule(
             plan->replaceNode(n, inode);
 
             if (en->isRestricted()) {
-              inode->restrictToShard(en->restrictedShard());
+              inode->restrictToShards(en->restrictedShards());
             }
             // copy over specialization data from smart-joins rule
             inode->setPrototype(en->prototypeCollection(),
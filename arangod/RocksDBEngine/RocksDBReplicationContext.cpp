@@ -47,6 +47,8 @@
 #include "RocksDBEngine/RocksDBMethods.h"
 #include "RocksDBEngine/RocksDBPrimaryIndex.h"
 #include "RocksDBEngine/RocksDBSettingsManager.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "Transaction/Context.h"
 #include "Transaction/Helpers.h"
@@ -85,8 +87,112 @@ rocksdb::SequenceNumber forceWrite(RocksDBEngine& engine) {
   return engine.db()->GetLatestSequenceNumber();
 }
 
+/// @brief determine the bounds of one of several disjoint ranges of the
+/// documents of a collection in the snapshot. the interval of document ids
+/// present in the snapshot is split into ranges of equal width. if the
+/// documents are not stored in document id order (legacy little-endian key
+/// format), or if there are no documents at all, the first range covers the
+/// whole collection and all other ranges are empty
+RocksDBKeyBounds documentRangeBounds(
+    rocksdb::DB* db, rocksdb::ReadOptions readOptions, uint64_t objectId,
+    RocksDBReplicationContext::DumpRange range) {
+  auto bounds = RocksDBKeyBounds::CollectionDocuments(objectId);
+  if (range.count <= 1) {
+    return bounds;
+  }
+
+  uint64_t first = 0;
+  uint64_t last = 0;
+  bool found = false;
+  if (rocksDBEndianness == RocksDBEndianness::Big) {
+    rocksdb::Slice upper = bounds.end();
+    readOptions.iterate_upper_bound = &upper;
+    std::unique_ptr<rocksdb::Iterator> it(
+        db->NewIterator(readOptions, bounds.columnFamily()));
+    it->Seek(bounds.start());
+    if (it->Valid()) {
+      first = RocksDBKey::documentId(it->key()).id();
+      it->SeekForPrev(bounds.end());
+      TRI_ASSERT(it->Valid());
+      if (it->Valid()) {
+        last = RocksDBKey::documentId(it->key()).id();
+        found = true;
+      }
+    }
+  }
+
+  if (!found) {
+    return range.index == 0 ? bounds
+                             : RocksDBKeyBounds::CollectionDocuments(
+                                   objectId, UINT64_MAX, 0);
+  }
+
+  auto [lower, upper] =
+      RocksDBReplicationContext::documentIdRange(first, last, range);
+  return RocksDBKeyBounds::CollectionDocuments(objectId, lower, upper);
+}
+
 }  // namespace
 
+std::pair<uint64_t, uint64_t> RocksDBReplicationContext::documentIdRange(
+    uint64_t first, uint64_t last, DumpRange range) noexcept {
+  TRI_ASSERT(first <= last);
+  TRI_ASSERT(range.index < range.count);
+  uint64_t width = (last - first) / range.count + 1;
+  uint64_t lower = range.index == 0 ? 0 : first + range.index * width;
+  uint64_t upper = range.index + 1 == range.count
+                       ? UINT64_MAX
+                       : first + (range.index + 1) * width - 1;
+  return {lower, upper};
+}
+
+bool RocksDBReplicationContext::PrefetchHandoff::start() {
+  std::lock_guard guard(_mutex);
+  if (_state == State::kCancelled) {
+    return false;
+  }
+  TRI_ASSERT(_state == State::kQueued);
+  _state = State::kRunning;
+  return true;
+}
+
+void RocksDBReplicationContext::PrefetchHandoff::finish() {
+  {
+    std::lock_guard guard(_mutex);
+    _state = State::kDone;
+  }
+  _cv.notify_all();
+}
+
+bool RocksDBReplicationContext::PrefetchHandoff::claim() {
+  std::unique_lock guard(_mutex);
+  if (_state == State::kQueued) {
+    _state = State::kCancelled;
+    return false;
+  }
+  _cv.wait(guard, [this]() { return _state == State::kDone; });
+  return true;
+}
+
+struct RocksDBReplicationContext::PrefetchedBatch : PrefetchHandoff {
+  PrefetchedBatch(bool vpack, uint64_t chunkSize, bool useEnvelope,
+                  bool singleArray)
+      : vpack(vpack),
+        chunkSize(chunkSize),
+        useEnvelope(useEnvelope),
+        singleArray(singleArray),
+        json(false) {}
+
+  bool const vpack;
+  uint64_t const chunkSize;
+  bool const useEnvelope;
+  bool const singleArray;
+
+  basics::StringBuffer json;
+  velocypack::Buffer<uint8_t> buffer;
+  Result result;
+};
+
 template<typename T>
 bool RocksDBReplicationContext::findCollection(
     std::string const& dbName, T const& collection,
@@ -214,18 +320,22 @@ void RocksDBReplicationContext::releaseIterators(TRI_vocbase_t& vocbase,
                                                  DataSourceId cid) {
   MUTEX_LOCKER(locker, _contextLock);
 
-  auto it = _iterators.find(cid);
+  auto it = _iterators.lower_bound({cid, DumpRange{0, 0}});
 
-  if (it != _iterators.end()) {
+  if (it == _iterators.end() || it->first.first != cid) {
+    LOG_TOPIC("5a0a1", ERR, Logger::REPLICATION)
+        << "trying to delete non-existent iterator";
+    return;
+  }
+
+  while (it != _iterators.end() && it->first.first == cid) {
     if (it->second->isUsed()) {
       LOG_TOPIC("74164", ERR, Logger::REPLICATION)
           << "trying to delete used iterator";
+      ++it;
     } else {
-      _iterators.erase(it);
+      it = _iterators.erase(it);
     }
-  } else {
-    LOG_TOPIC("5a0a1", ERR, Logger::REPLICATION)
-        << "trying to delete non-existent iterator";
   }
 }
 
@@ -247,7 +357,7 @@ RocksDBReplicationContext::bindCollectionIncremental(TRI_vocbase_t& vocbase,
 
   MUTEX_LOCKER(writeLocker, _contextLock);
 
-  auto it = _iterators.find(cid);
+  auto it = _iterators.find({cid, DumpRange{}});
   if (it != _iterators.end()) {  // nothing to do here
     return std::make_tuple(Result{}, it->second->logical->id(),
                            it->second->numberDocuments);
@@ -281,12 +391,12 @@ RocksDBReplicationContext::bindCollectionIncremental(TRI_vocbase_t& vocbase,
 
   auto iter =
       std::make_unique<CollectionIterator>(vocbase, logical, true, _snapshot);
-  auto result = _iterators.try_emplace(cid, std::move(iter));
+  auto result = _iterators.try_emplace({cid, DumpRange{}}, std::move(iter));
   TRI_ASSERT(result.second);
 
   CollectionIterator* cIter = result.first->second.get();
   if (nullptr == cIter->iter) {
-    _iterators.erase(cid);
+    _iterators.erase(result.first);
     return std::make_tuple(
         Result(TRI_ERROR_INTERNAL, "could not create db iterators"),
         DataSourceId::none(), 0);
@@ -494,7 +604,8 @@ std::string const& RocksDBReplicationContext::patchCount() const {
 // creating a new iterator if one does not exist for this collection
 RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpJson(
     TRI_vocbase_t& vocbase, std::string const& cname,
-    basics::StringBuffer& buff, uint64_t chunkSize, bool useEnvelope) {
+    basics::StringBuffer& buff, uint64_t chunkSize, bool useEnvelope,
+    DumpRange range, bool prefetch) {
   CollectionIterator* cIter{nullptr};
   auto guard = scopeGuard([&]() noexcept {
     try {
@@ -505,6 +616,7 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpJson(
     }
   });
 
+  std::shared_ptr<PrefetchedBatch> prefetched;
   {
     DataSourceId const cid = ::normalizeIdentifier(vocbase, cname);
     if (cid.empty()) {
@@ -512,8 +624,8 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpJson(
     }
 
     MUTEX_LOCKER(writeLocker, _contextLock);
-    cIter =
-        getCollectionIterator(vocbase, cid, /*sorted*/ false, /*create*/ true);
+    cIter = getCollectionIterator(vocbase, cid, /*sorted*/ false,
+                                  /*create*/ true, range, &prefetched);
     if (!cIter || cIter->sorted() || !cIter->iter) {
       return DumpResult(TRI_ERROR_BAD_PARAMETER);
     }
@@ -526,29 +638,30 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpJson(
   RocksDBBlockerGuard blocker(cIter->logical.get());
   auto blockerSeq = blocker.placeBlocker();
 
-  basics::VPackStringBufferAdapter adapter(buff.stringBuffer());
-  velocypack::Dumper dumper(&adapter, &cIter->vpackOptions);
-  TRI_ASSERT(cIter->iter && !cIter->sorted());
-  while (cIter->hasMore() && buff.length() < chunkSize) {
-    if (useEnvelope) {
-      buff.appendText("{\"type\":");
-      buff.appendInteger(REPLICATION_MARKER_DOCUMENT);  // set type
-      buff.appendText(",\"data\":");
+  if (prefetched != nullptr && prefetched->claim()) {
+    if (prefetched->result.fail()) {
+      return DumpResult(prefetched->result.errorNumber());
     }
-    // printing the data, note: we need the CustomTypeHandler here
-    dumper.dump(velocypack::Slice(
-        reinterpret_cast<uint8_t const*>(cIter->iter->value().data())));
-    if (useEnvelope) {
-      buff.appendChar('}');
+    if (prefetched->vpack || prefetched->useEnvelope != useEnvelope) {
+      // the prefetched documents are not in the requested format
+      return DumpResult(TRI_ERROR_BAD_PARAMETER);
     }
-    buff.appendChar('\n');
-    cIter->iter->Next();
-    ++cIter->numberDocumentsDumped;
+    buff.swap(&prefetched->json);
+  } else {
+    fillJson(*cIter, buff, chunkSize, useEnvelope);
   }
 
   bool hasMore = cIter->hasMore();
+  uint64_t tick = cIter->currentTick;
   if (hasMore) {
-    cIter->currentTick++;
+    tick = ++cIter->currentTick;
+    if (prefetch) {
+      schedulePrefetch(cIter, std::make_shared<PrefetchedBatch>(
+                                  /*vpack*/ false, chunkSize, useEnvelope,
+                                  /*singleArray*/ false));
+      // the iterator now belongs to the prefetch
+      cIter = nullptr;
+    }
   } else if (cIter->documentCountAdjustmentTicket > 0) {
     // reached the end
     int64_t adjustment = cIter->numberDocumentsDumped - cIter->numberDocuments;
@@ -557,7 +670,7 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpJson(
 
     cIter->numberDocumentsDumped = 0;
   }
-  return DumpResult(TRI_ERROR_NO_ERROR, hasMore, cIter->currentTick);
+  return DumpResult(TRI_ERROR_NO_ERROR, hasMore, tick);
 }
 
 // iterates over at most 'limit' documents in the collection specified,
@@ -565,7 +678,7 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpJson(
 RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpVPack(
     TRI_vocbase_t& vocbase, std::string const& cname,
     VPackBuffer<uint8_t>& buffer, uint64_t chunkSize, bool useEnvelope,
-    bool singleArray) {
+    bool singleArray, DumpRange range, bool prefetch) {
   TRI_ASSERT(!useEnvelope || !singleArray);
 
   CollectionIterator* cIter{nullptr};
@@ -578,6 +691,7 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpVPack(
     }
   });
 
+  std::shared_ptr<PrefetchedBatch> prefetched;
   {
     DataSourceId const cid = ::normalizeIdentifier(vocbase, cname);
     if (cid.empty()) {
@@ -586,8 +700,8 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpVPack(
 
     MUTEX_LOCKER(writeLocker, _contextLock);
     TRI_ASSERT(chunkSize > 0);
-    cIter =
-        getCollectionIterator(vocbase, cid, /*sorted*/ false, /*create*/ true);
+    cIter = getCollectionIterator(vocbase, cid, /*sorted*/ false,
+                                  /*create*/ true, range, &prefetched);
     if (!cIter || cIter->sorted() || !cIter->iter) {
       return DumpResult(TRI_ERROR_BAD_PARAMETER);
     }
@@ -600,42 +714,135 @@ RocksDBReplicationContext::DumpResult RocksDBReplicationContext::dumpVPack(
              RocksDBColumnFamilyManager::get(
                  RocksDBColumnFamilyManager::Family::Documents));
 
-  VPackBuilder builder(buffer, &cIter->vpackOptions);
+  if (prefetched != nullptr && prefetched->claim()) {
+    if (prefetched->result.fail()) {
+      return DumpResult(prefetched->result.errorNumber());
+    }
+    if (!prefetched->vpack || prefetched->useEnvelope != useEnvelope ||
+        prefetched->singleArray != singleArray) {
+      // the prefetched documents are not in the requested format
+      return DumpResult(TRI_ERROR_BAD_PARAMETER);
+    }
+    buffer = std::move(prefetched->buffer);
+  } else {
+    fillVPack(*cIter, buffer, chunkSize, useEnvelope, singleArray);
+  }
+
+  bool hasMore = cIter->hasMore();
+  uint64_t tick = cIter->currentTick;
+  if (hasMore) {
+    tick = ++cIter->currentTick;
+    if (prefetch) {
+      schedulePrefetch(cIter, std::make_shared<PrefetchedBatch>(
+                                  /*vpack*/ true, chunkSize, useEnvelope,
+                                  singleArray));
+      // the iterator now belongs to the prefetch
+      cIter = nullptr;
+    }
+  } else if (cIter->documentCountAdjustmentTicket > 0) {
+    // reached the end
+    int64_t adjustment = cIter->numberDocumentsDumped - cIter->numberDocuments;
+    handleCollectionCountAdjustment(cIter->documentCountAdjustmentTicket,
+                                    adjustment, blockerSeq, cIter);
+
+    cIter->numberDocumentsDumped = 0;
+  }
+  return DumpResult(TRI_ERROR_NO_ERROR, hasMore, tick);
+}
+
+void RocksDBReplicationContext::fillJson(CollectionIterator& cIter,
+                                         basics::StringBuffer& buff,
+                                         uint64_t chunkSize,
+                                         bool useEnvelope) {
+  basics::VPackStringBufferAdapter adapter(buff.stringBuffer());
+  velocypack::Dumper dumper(&adapter, &cIter.vpackOptions);
+  TRI_ASSERT(cIter.iter && !cIter.sorted());
+  while (cIter.hasMore() && buff.length() < chunkSize) {
+    if (useEnvelope) {
+      buff.appendText("{\"type\":");
+      buff.appendInteger(REPLICATION_MARKER_DOCUMENT);  // set type
+      buff.appendText(",\"data\":");
+    }
+    // printing the data, note: we need the CustomTypeHandler here
+    dumper.dump(velocypack::Slice(
+        reinterpret_cast<uint8_t const*>(cIter.iter->value().data())));
+    if (useEnvelope) {
+      buff.appendChar('}');
+    }
+    buff.appendChar('\n');
+    cIter.iter->Next();
+    ++cIter.numberDocumentsDumped;
+  }
+}
+
+void RocksDBReplicationContext::fillVPack(CollectionIterator& cIter,
+                                          VPackBuffer<uint8_t>& buffer,
+                                          uint64_t chunkSize, bool useEnvelope,
+                                          bool singleArray) {
+  VPackBuilder builder(buffer, &cIter.vpackOptions);
   if (singleArray) {
     // put everything into a single result array on demand
     builder.openArray(true);
   }
-  TRI_ASSERT(cIter->iter && !cIter->sorted());
-  while (cIter->hasMore() && buffer.length() < chunkSize) {
+  TRI_ASSERT(cIter.iter && !cIter.sorted());
+  while (cIter.hasMore() && buffer.length() < chunkSize) {
     if (useEnvelope) {
       builder.openObject();
       builder.add("type", VPackValue(REPLICATION_MARKER_DOCUMENT));
       builder.add(VPackValue("data"));
     }
     builder.add(velocypack::Slice(
-        reinterpret_cast<uint8_t const*>(cIter->iter->value().data())));
+        reinterpret_cast<uint8_t const*>(cIter.iter->value().data())));
     if (useEnvelope) {
       builder.close();
     }
-    cIter->iter->Next();
-    ++cIter->numberDocumentsDumped;
+    cIter.iter->Next();
+    ++cIter.numberDocumentsDumped;
   }
   if (singleArray) {
     builder.close();
   }
+}
 
-  bool hasMore = cIter->hasMore();
-  if (hasMore) {
-    cIter->currentTick++;
-  } else if (cIter->documentCountAdjustmentTicket > 0) {
-    // reached the end
-    int64_t adjustment = cIter->numberDocumentsDumped - cIter->numberDocuments;
-    handleCollectionCountAdjustment(cIter->documentCountAdjustmentTicket,
-                                    adjustment, blockerSeq, cIter);
+void RocksDBReplicationContext::schedulePrefetch(
+    CollectionIterator* cIter, std::shared_ptr<PrefetchedBatch> batch) {
+  TRI_ASSERT(cIter != nullptr && cIter->isUsed());
+  {
+    MUTEX_LOCKER(locker, _contextLock);
+    cIter->prefetched = batch;
+  }
 
-    cIter->numberDocumentsDumped = 0;
+  // the task keeps the context alive. the iterator cannot go away while it
+  // is in use
+  auto task = [self = shared_from_this(), cIter, batch]() {
+    if (!batch->start()) {
+      // the next request has already taken over
+      return;
+    }
+    try {
+      if (batch->vpack) {
+        fillVPack(*cIter, batch->buffer, batch->chunkSize, batch->useEnvelope,
+                  batch->singleArray);
+      } else {
+        fillJson(*cIter, batch->json, batch->chunkSize, batch->useEnvelope);
+      }
+    } catch (basics::Exception const& ex) {
+      batch->result.reset(ex.code(), ex.what());
+    } catch (std::exception const& ex) {
+      batch->result.reset(TRI_ERROR_INTERNAL, ex.what());
+    }
+    batch->finish();
+  };
+
+  auto* scheduler = SchedulerFeature::SCHEDULER;
+  if (scheduler == nullptr ||
+      !scheduler->tryBoundedQueue(RequestLane::INTERNAL_LOW, std::move(task))) {
+    // not a problem: the next request will find the batch still queued and
+    // produce it by itself
+    LOG_TOPIC("5c2e1", DEBUG, Logger::REPLICATION)
+        << "unable to queue prefetch of dump batch for collection '"
+        << cIter->logical->name() << "'";
   }
-  return DumpResult(TRI_ERROR_NO_ERROR, hasMore, cIter->currentTick);
 }
 
 /// Dump all key chunks for the bound collection
@@ -1124,9 +1331,11 @@ void RocksDBReplicationContext::lazyCreateSnapshot() {
 
 RocksDBReplicationContext::CollectionIterator::CollectionIterator(
     TRI_vocbase_t& vocbase, std::shared_ptr<LogicalCollection> const& coll,
-    bool sorted, std::shared_ptr<rocksdb::ManagedSnapshot> snapshot)
+    bool sorted, std::shared_ptr<rocksdb::ManagedSnapshot> snapshot,
+    DumpRange range)
     : vocbase(vocbase),
       logical{coll},
+      range{range},
       iter{nullptr},
       _snapshot(std::move(snapshot)),
       _bounds{RocksDBKeyBounds::Empty()},
@@ -1195,7 +1404,11 @@ void RocksDBReplicationContext::CollectionIterator::setSorted(bool sorted) {
       _bounds = RocksDBKeyBounds::PrimaryIndex(primaryIndex->objectId());
     } else {
       auto* rcoll = static_cast<RocksDBMetaCollection*>(logical->getPhysical());
-      _bounds = RocksDBKeyBounds::CollectionDocuments(rcoll->objectId());
+      _bounds = ::documentRangeBounds(vocbase.server()
+                                          .getFeature<EngineSelectorFeature>()
+                                          .engine<RocksDBEngine>()
+                                          .db(),
+                                      _readOptions, rcoll->objectId(), range);
     }
     _upperLimit = _bounds.end();
     rocksdb::ColumnFamilyHandle* cf = _bounds.columnFamily();
@@ -1240,21 +1453,30 @@ void RocksDBReplicationContext::CollectionIterator::resetToStart() {
 }
 
 RocksDBReplicationContext::CollectionIterator*
-RocksDBReplicationContext::getCollectionIterator(TRI_vocbase_t& vocbase,
-                                                 DataSourceId cid, bool sorted,
-                                                 bool allowCreate) {
+RocksDBReplicationContext::getCollectionIterator(
+    TRI_vocbase_t& vocbase, DataSourceId cid, bool sorted, bool allowCreate,
+    DumpRange range, std::shared_ptr<PrefetchedBatch>* prefetched) {
   _contextLock.assertLockedByCurrentThread();
   lazyCreateSnapshot();
 
+  TRI_ASSERT(range.index < range.count);
+  TRI_ASSERT(range.count == 1 || !sorted);
+
   CollectionIterator* cIter{nullptr};
   // check if iterator already exists
-  auto it = _iterators.find(cid);
+  auto it = _iterators.find({cid, range});
 
   if (_iterators.end() != it) {
     // exists, check if used
     if (!it->second->isUsed()) {
       // unused, select it
       cIter = it->second.get();
+    } else if (prefetched != nullptr && it->second->prefetched != nullptr) {
+      // used by the prefetch of its next batch. take it over from there,
+      // it stays in use
+      *prefetched = std::move(it->second->prefetched);
+      TRI_ASSERT(it->second->sorted() == sorted);
+      return it->second.get();
     }
   } else {
     if (!allowCreate) {
@@ -1265,16 +1487,16 @@ RocksDBReplicationContext::getCollectionIterator(TRI_vocbase_t& vocbase,
     std::shared_ptr<LogicalCollection> logical{vocbase.lookupCollection(cid)};
 
     if (nullptr != logical) {
-      auto result =
-          _iterators.try_emplace(cid, std::make_unique<CollectionIterator>(
-                                          vocbase, logical, sorted, _snapshot));
+      auto result = _iterators.try_emplace(
+          {cid, range}, std::make_unique<CollectionIterator>(
+                            vocbase, logical, sorted, _snapshot, range));
 
       if (result.second) {
         cIter = result.first->second.get();
 
         if (nullptr == cIter->iter) {
           cIter = nullptr;
-          _iterators.erase(cid);
+          _iterators.erase(result.first);
         }
       }
     }
@@ -1308,7 +1530,7 @@ void RocksDBReplicationContext::releaseDumpIterator(CollectionIterator* it) {
       it->vocbase.replicationClients().track(syncerId(),
                                              replicationClientServerId(),
                                              clientInfo(), _snapshotTick, _ttl);
-      _iterators.erase(it->logical->id());
+      _iterators.erase({it->logical->id(), it->range});
     } else {  // Context::release() will update the replication client
       it->release();
     }
@@ -47,9 +47,12 @@
 #include <velocypack/Slice.h>
 
 #include <atomic>
+#include <compare>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 
 namespace rocksdb {
 class Comparator;
@@ -64,8 +67,59 @@ namespace basics {
 class StringBuffer;
 }
 
-class RocksDBReplicationContext {
+class RocksDBReplicationContext
+    : public std::enable_shared_from_this<RocksDBReplicationContext> {
+ public:
+  /// @brief restricts a dump to one of several disjoint ranges of the
+  /// documents of a collection, so that multiple clients can dump the
+  /// ranges in parallel using the same context and snapshot.
+  /// a count of 1 means the whole collection
+  struct DumpRange {
+    uint64_t index = 0;
+    uint64_t count = 1;
+
+    auto operator<=>(DumpRange const&) const = default;
+  };
+
+  /// @brief the interval [lower, upper] of document ids belonging to the
+  /// given range, if the document ids present in a collection span from
+  /// first to last. the ranges have equal width. the first range starts at
+  /// 0 and the last range ends at UINT64_MAX, so that the ranges together
+  /// cover all possible document ids
+  static std::pair<uint64_t, uint64_t> documentIdRange(
+      uint64_t first, uint64_t last, DumpRange range) noexcept;
+
+  /// @brief hand-over of a batch between the scheduler thread prefetching
+  /// it and the request picking it up
+  class PrefetchHandoff {
+   public:
+    /// @brief called by the scheduler thread before it produces the batch.
+    /// returns false if the batch was cancelled in the meantime
+    bool start();
+
+    /// @brief called by the scheduler thread once the batch is complete
+    void finish();
+
+    /// @brief called by the request picking up the batch. waits for a
+    /// running prefetch to finish and returns true. if the prefetch has
+    /// not even started, it is cancelled and false is returned, so that
+    /// the caller produces the batch itself instead of waiting for a
+    /// scheduler thread to become available
+    bool claim();
+
+   private:
+    enum class State { kQueued, kRunning, kDone, kCancelled };
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    State _state = State::kQueued;
+  };
+
  private:
+  /// @brief a dump batch produced on a scheduler thread ahead of the request
+  /// asking for it
+  struct PrefetchedBatch;
+
   /// collection abstraction
   struct CollectionIterator {
     CollectionIterator(CollectionIterator const&) = delete;
@@ -73,11 +127,14 @@ class RocksDBReplicationContext {
 
     CollectionIterator(TRI_vocbase_t&,
                        std::shared_ptr<LogicalCollection> const&, bool sorted,
-                       std::shared_ptr<rocksdb::ManagedSnapshot> snapshot);
+                       std::shared_ptr<rocksdb::ManagedSnapshot> snapshot,
+                       DumpRange range = {});
     ~CollectionIterator();
 
     TRI_vocbase_t& vocbase;
     std::shared_ptr<LogicalCollection> logical;
+    /// range of the collection covered by the unsorted iterator
+    DumpRange const range;
 
     /// Iterator over primary index or documents
     std::unique_ptr<rocksdb::Iterator> iter;
@@ -102,6 +159,10 @@ class RocksDBReplicationContext {
     /// exclusively. this ticket is also later used to update the collection
     /// count on the leader if it is considered to be wrong.
     uint64_t documentCountAdjustmentTicket;
+    /// @brief batch currently being prefetched. as long as this is set, the
+    /// iterator stays in use and belongs to the prefetch, until the next
+    /// dump request takes it over
+    std::shared_ptr<PrefetchedBatch> prefetched;
 
     RocksDBKeyBounds const& bounds() const noexcept { return _bounds; }
     rocksdb::ReadOptions const& readOptions() const { return _readOptions; }
@@ -200,16 +261,20 @@ class RocksDBReplicationContext {
   };
 
   // iterates over at most 'limit' documents in the collection specified,
-  // creating a new iterator if one does not exist for this collection
+  // creating a new iterator if one does not exist for this collection.
+  // if prefetch is set, the next batch is produced by a scheduler thread
+  // right after this one, and handed out by the next call
   DumpResult dumpJson(TRI_vocbase_t& vocbase, std::string const& cname,
                       basics::StringBuffer&, uint64_t chunkSize,
-                      bool useEnvelope);
+                      bool useEnvelope, DumpRange range = {},
+                      bool prefetch = false);
 
   // iterates over at most 'limit' documents in the collection specified,
   // creating a new iterator if one does not exist for this collection
   DumpResult dumpVPack(TRI_vocbase_t& vocbase, std::string const& cname,
                        velocypack::Buffer<uint8_t>& buffer, uint64_t chunkSize,
-                       bool useEnvelope, bool singleArray);
+                       bool useEnvelope, bool singleArray, DumpRange range = {},
+                       bool prefetch = false);
 
   // ==================== Incremental Sync ===========================
 
@@ -257,12 +322,24 @@ class RocksDBReplicationContext {
 
   void lazyCreateSnapshot();
 
-  CollectionIterator* getCollectionIterator(TRI_vocbase_t& vocbase,
-                                            DataSourceId cid, bool sorted,
-                                            bool allowCreate);
+  CollectionIterator* getCollectionIterator(
+      TRI_vocbase_t& vocbase, DataSourceId cid, bool sorted, bool allowCreate,
+      DumpRange range = {},
+      std::shared_ptr<PrefetchedBatch>* prefetched = nullptr);
 
   void releaseDumpIterator(CollectionIterator*);
 
+  /// @brief hand over a dump iterator to a new prefetch of its next batch
+  void schedulePrefetch(CollectionIterator*, std::shared_ptr<PrefetchedBatch>);
+
+  /// @brief produce a batch of a dump, using the same format as dumpJson
+  /// and dumpVPack
+  static void fillJson(CollectionIterator&, basics::StringBuffer&,
+                       uint64_t chunkSize, bool useEnvelope);
+  static void fillVPack(CollectionIterator&, velocypack::Buffer<uint8_t>&,
+                        uint64_t chunkSize, bool useEnvelope,
+                        bool singleArray);
+
   void handleCollectionCountAdjustment(uint64_t documentCountAdjustmentTicket,
                                        int64_t adjustment,
                                        rocksdb::SequenceNumber blockerSeq,
@@ -284,7 +361,10 @@ class RocksDBReplicationContext {
 
   uint64_t _snapshotTick;  // tick in WAL from _snapshot
   std::shared_ptr<rocksdb::ManagedSnapshot> _snapshot;
-  std::map<DataSourceId, std::unique_ptr<CollectionIterator>> _iterators;
+  /// iterators, keyed by collection id and range of the collection
+  std::map<std::pair<DataSourceId, DumpRange>,
+           std::unique_ptr<CollectionIterator>>
+      _iterators;
 
   // db name => { collection id => transaction id }
   std::map<std::string, std::map<DataSourceId, uint64_t>> _blockers;
@@ -64,6 +64,12 @@ using namespace arangodb::basics;
 using namespace arangodb::rest;
 using namespace arangodb::rocksutils;
 
+namespace {
+/// @brief maximum number of ranges a collection can be split into for
+/// parallel dumping
+constexpr uint64_t maxDumpRanges = 64;
+}  // namespace
+
 RocksDBRestReplicationHandler::RocksDBRestReplicationHandler(
     ArangodServer& server, GeneralRequest* request, GeneralResponse* response)
     : RestReplicationHandler(server, request, response),
@@ -770,6 +776,41 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
   // to be fed into a multi-document operation.
   bool const singleArray = _request->parsedValue("array", false);
 
+  // "rangeIndex" and "rangeCount" URL parameters supported from >= 3.11
+  // onwards. they restrict the dump to one of "rangeCount" disjoint ranges of
+  // the collection, so that multiple clients can dump the ranges of a single
+  // collection or shard in parallel, using the same batch.
+  // clients must check that the response confirms the range via the
+  // "x-arango-replication-range" header, as older servers will ignore the
+  // parameters and return the entire collection.
+  RocksDBReplicationContext::DumpRange range;
+  range.index = _request->parsedValue("rangeIndex", uint64_t(0));
+  range.count = _request->parsedValue("rangeCount", uint64_t(1));
+  if (range.count == 0 || range.count > ::maxDumpRanges ||
+      range.index >= range.count) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "invalid rangeIndex or rangeCount parameter");
+    return;
+  }
+  auto setRangeHeader = [&]() {
+    if (range.count > 1) {
+      _response->setHeaderNC(StaticStrings::ReplicationHeaderRange,
+                             StringUtils::itoa(range.index) + "/" +
+                                 StringUtils::itoa(range.count));
+    }
+  };
+
+  // "prefetch" URL parameter supported from >= 3.11 onwards. when set to
+  // "true", the next batch will be produced in the background right after
+  // this one, while the client is still processing the current batch
+  bool const prefetch = _request->parsedValue("prefetch", false);
+
+  // "sanitize" URL parameter supported from >= 3.11 onwards. when set to
+  // "true", velocypack responses will not contain any server-internal types
+  // (e.g. the custom type used for "_id"), so that clients can store the
+  // documents as they are and send them back to the server later
+  bool const sanitize = _request->parsedValue("sanitize", false);
+
   uint64_t chunkSize = determineChunkSize();
   size_t reserve = std::max<size_t>(chunkSize, 8192);
 
@@ -781,7 +822,7 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
     auto trxCtx = transaction::StandaloneContext::Create(_vocbase);
 
     res = ctx->dumpVPack(_vocbase, cname, buffer, chunkSize, useEnvelope,
-                         singleArray);
+                         singleArray, range, prefetch);
     // generate the result
     if (res.fail()) {
       generateError(res.result());
@@ -791,7 +832,7 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
       resetResponse(rest::ResponseCode::OK);
       _response->setContentType(rest::ContentType::VPACK);
       _response->setPayload(std::move(buffer), *trxCtx->getVPackOptions(),
-                            /*resolveExternals*/ false);
+                            /*resolveExternals*/ sanitize);
     }
 
     // set headers
@@ -801,13 +842,14 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
     _response->setHeaderNC(
         StaticStrings::ReplicationHeaderLastIncluded,
         StringUtils::itoa(buffer.empty() ? 0 : res.includedTick));
+    setRangeHeader();
 
   } else {
     StringBuffer dump(reserve, false);
 
     // do the work!
-    res =
-        ctx->dumpJson(_vocbase, cname, dump, determineChunkSize(), useEnvelope);
+    res = ctx->dumpJson(_vocbase, cname, dump, chunkSize, useEnvelope, range,
+                        prefetch);
 
     if (res.fail()) {
       if (res.is(TRI_ERROR_BAD_PARAMETER)) {
@@ -837,6 +879,7 @@ void RocksDBRestReplicationHandler::handleCommandDump() {
     _response->setHeaderNC(
         StaticStrings::ReplicationHeaderLastIncluded,
         StringUtils::itoa((dump.length() == 0) ? 0 : res.includedTick));
+    setRangeHeader();
 
     if (_request->transportType() == Endpoint::TransportType::HTTP) {
       auto response = dynamic_cast<HttpResponse*>(_response.get());
@@ -2077,7 +2077,8 @@ void RocksDBVPackIndex::refillCache(transaction::Methods& trx,
     return;
   }
 
-  ResourceMonitor monitor(GlobalResourceMonitor::instance());
+  ResourceMonitor monitor(GlobalResourceMonitor::instance(),
+                          MemorySubsystem::Indexes);
   IndexIteratorOptions opts;
 
   RocksDBKeyBounds bounds = RocksDBKeyBounds::Empty();
@@ -2767,7 +2768,8 @@ void RocksDBVPackIndex::recalculateEstimates() {
 }
 
 void RocksDBVPackIndex::warmupInternal(transaction::Methods* trx) {
-  ResourceMonitor monitor(GlobalResourceMonitor::instance());
+  ResourceMonitor monitor(GlobalResourceMonitor::instance(),
+                          MemorySubsystem::Indexes);
   IndexIteratorOptions opts;
 
   RocksDBKeyBounds bounds = RocksDBKeyBounds::Empty();
@@ -33,6 +33,7 @@
 #include "Logger/LogMacros.h"
 #include "Sharding/ShardingFeature.h"
 #include "Sharding/ShardingStrategyDefault.h"
+#include "Sharding/ShardingStrategyRange.h"
 #include "Utils/CollectionNameResolver.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/vocbase.h"
@@ -147,6 +148,17 @@ ShardingInfo::ShardingInfo(arangodb::velocypack::Slice info,
     THROW_ARANGO_EXCEPTION(res);
   }
 
+  VPackSlice splitPoints = info.get(StaticStrings::ShardSplitPoints);
+  if (splitPoints.isArray()) {
+    if (splitPoints.length() > 0) {
+      _shardSplitPoints.add(splitPoints);
+    }
+  } else if (!splitPoints.isNone() && !splitPoints.isNull()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        "invalid non-array value for 'shardSplitPoints'");
+  }
+
   auto shardsSlice = info.get("shards");
   if (shardsSlice.isObject()) {
     for (auto const& shardSlice : VPackObjectIterator(shardsSlice)) {
@@ -173,6 +185,15 @@ ShardingInfo::ShardingInfo(arangodb::velocypack::Slice info,
         server.getFeature<ShardingFeature>().fromVelocyPack(info, this);
   }
   TRI_ASSERT(_shardingStrategy != nullptr);
+
+  if (!_shardSplitPoints.isEmpty() &&
+      ServerState::instance()->isCoordinator() &&
+      _shardingStrategy->name() != ShardingStrategyRange::NAME) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        "'shardSplitPoints' can only be used with sharding strategy '" +
+            ShardingStrategyRange::NAME + "'");
+  }
 }
 
 ShardingInfo::ShardingInfo(ShardingInfo const& other,
@@ -184,6 +205,7 @@ ShardingInfo::ShardingInfo(ShardingInfo const& other,
       _distributeShardsLike(other.distributeShardsLike()),
       _avoidServers(other.avoidServers()),
       _shardKeys(other.shardKeys()),
+      _shardSplitPoints(other._shardSplitPoints),
       _shardIds(std::make_shared<ShardMap>()),
       _shardingStrategy() {
   TRI_ASSERT(_collection != nullptr);
@@ -374,6 +396,10 @@ void ShardingInfo::toVelocyPack(VPackBuilder& result,
 
   result.close();  // shardKeys
 
+  if (!_shardSplitPoints.isEmpty()) {
+    result.add(StaticStrings::ShardSplitPoints, _shardSplitPoints.slice());
+  }
+
   if (!_avoidServers.empty()) {
     result.add(VPackValue("avoidServers"));
     result.openArray();
@@ -399,6 +425,13 @@ void ShardingInfo::distributeShardsLike(std::string const& cid,
         "a collection with a different number of shard key attributes");
   }
 
+  _distributeShardsLike = cid;
+
+  if (other->shardingStrategyName() == ShardingStrategyRange::NAME) {
+    // range sharding needs the same split points as the other collection
+    _shardSplitPoints = other->_shardSplitPoints;
+  }
+
   if (!usesSameShardingStrategy(other)) {
     auto& server = _collection->vocbase().server();
     auto& shr = server.getFeature<ShardingFeature>();
@@ -408,8 +441,6 @@ void ShardingInfo::distributeShardsLike(std::string const& cid,
     _shardingStrategy = shr.create(other->shardingStrategyName(), this);
   }
 
-  _distributeShardsLike = cid;
-
   if (_collection->isSmart() && _collection->type() == TRI_COL_TYPE_EDGE) {
     return;
   }
@@ -502,6 +533,13 @@ std::vector<std::string> const& ShardingInfo::shardKeys() const noexcept {
   return _shardKeys;
 }
 
+VPackSlice ShardingInfo::shardSplitPoints() const noexcept {
+  if (_shardSplitPoints.isEmpty()) {
+    return VPackSlice::emptyArraySlice();
+  }
+  return _shardSplitPoints.slice();
+}
+
 std::shared_ptr<ShardMap> ShardingInfo::shardIds() const { return _shardIds; }
 
 std::shared_ptr<std::vector<ShardID>> ShardingInfo::shardListAsShardID() const {
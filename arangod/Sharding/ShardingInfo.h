@@ -98,6 +98,10 @@ class ShardingInfo {
   bool usesDefaultShardKeys() const noexcept;
   std::vector<std::string> const& shardKeys() const noexcept;
 
+  /// @brief ascending values of the shard key at which a new shard starts,
+  /// for range sharding. returns an empty array if not set
+  arangodb::velocypack::Slice shardSplitPoints() const noexcept;
+
   std::shared_ptr<ShardMap> shardIds() const;
 
   // return a sorted vector of ShardIDs
@@ -157,6 +161,10 @@ class ShardingInfo {
   // @brief vector of shard keys in use. this is immutable after initial setup
   std::vector<std::string> _shardKeys;
 
+  // @brief split points for range sharding, empty if not set. this is
+  // immutable after initial setup
+  arangodb::velocypack::Builder _shardSplitPoints;
+
   // @brief current shard ids
   std::shared_ptr<ShardMap> _shardIds;
 
@@ -0,0 +1,377 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ShardingStrategyRange.h"
+
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Aql/Ast.h"
+#include "Aql/AstNode.h"
+#include "Basics/AttributeNameParser.h"
+#include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Cluster/ClusterFeature.h"
+#include "Cluster/ClusterInfo.h"
+#include "Sharding/ShardingInfo.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+
+#include <algorithm>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+std::string const ShardingStrategyRange::NAME("range");
+
+ShardingStrategyRange::ShardingStrategyRange(ShardingInfo* sharding)
+    : ShardingStrategy(),
+      _sharding(sharding),
+      _usesDefaultShardKeys(false),
+      _shardsSet(false) {
+  auto const& shardKeys = _sharding->shardKeys();
+  if (shardKeys.size() != 1 || shardKeys[0].empty() ||
+      shardKeys[0].front() == ':' || shardKeys[0].back() == ':') {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        std::string("sharding strategy ") + NAME +
+            " requires exactly one shard key attribute");
+  }
+
+  if (_sharding->collection()->isSmart()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        std::string("sharding strategy ") + NAME +
+            " cannot be used for smart collections");
+  }
+
+  _usesDefaultShardKeys = (shardKeys[0] == StaticStrings::KeyString);
+
+  // with distributeShardsLike, the number of shards and the split points
+  // are taken from the prototype collection later
+  if (_sharding->distributeShardsLike().empty()) {
+    Result res = validateSplitPoints(_sharding->shardSplitPoints(),
+                                     _sharding->numberOfShards());
+    if (res.fail()) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+  }
+}
+
+bool ShardingStrategyRange::isCompatible(ShardingStrategy const* other) const {
+  if (name() != other->name()) {
+    return false;
+  }
+  auto const* range = static_cast<ShardingStrategyRange const*>(other);
+  return basics::VelocyPackHelper::equal(
+      _sharding->shardSplitPoints(), range->_sharding->shardSplitPoints(),
+      true);
+}
+
+ErrorCode ShardingStrategyRange::getResponsibleShard(
+    velocypack::Slice slice, bool docComplete, ShardID& shardID,
+    bool& usesDefaultShardKeys, std::string_view key) {
+  auto const shards = determineShards();
+  TRI_ASSERT(!shards.empty());
+
+  usesDefaultShardKeys = _usesDefaultShardKeys;
+
+  auto res = TRI_ERROR_NO_ERROR;
+  std::string const& attribute = _sharding->shardKeys()[0];
+  velocypack::Builder temporaryBuilder;
+  velocypack::Slice value = velocypack::Slice::nullSlice();
+
+  slice = slice.resolveExternal();
+  if (slice.isObject()) {
+    value = slice.get(attribute).resolveExternal();
+    if (value.isNone()) {
+      // shard key attribute not present in document
+      if (attribute == StaticStrings::KeyString && !key.empty()) {
+        temporaryBuilder.add(velocypack::ValuePair(
+            key.data(), key.size(), velocypack::ValueType::String));
+        value = temporaryBuilder.slice();
+      } else {
+        if (!docComplete) {
+          res = TRI_ERROR_CLUSTER_NOT_ALL_SHARDING_ATTRIBUTES_GIVEN;
+        }
+        // Null is equal to None/not present
+        value = velocypack::Slice::nullSlice();
+      }
+    }
+  } else if (slice.isString() && _usesDefaultShardKeys) {
+    // optimization for `_key` and `_id` values with `_key` as shard key
+    TRI_ASSERT(key.empty());
+    std::string_view k = slice.stringView();
+    size_t pos = k.find('/');
+    if (pos != std::string_view::npos) {
+      k = k.substr(pos + 1);
+      temporaryBuilder.add(velocypack::ValuePair(
+          k.data(), k.size(), velocypack::ValueType::String));
+      value = temporaryBuilder.slice();
+    } else {
+      value = slice;
+    }
+  } else if (slice.isString() && !docComplete) {
+    // ok for use in update, replace and remove operation
+    res = TRI_ERROR_CLUSTER_NOT_ALL_SHARDING_ATTRIBUTES_GIVEN;
+  } else {
+    TRI_ASSERT(false);
+    res = TRI_ERROR_BAD_PARAMETER;
+  }
+
+  size_t index = shardIndex(_sharding->shardSplitPoints(), value);
+  TRI_ASSERT(index < shards.size());
+  shardID = shards[std::min(index, shards.size() - 1)];
+  return res;
+}
+
+size_t ShardingStrategyRange::shardIndex(velocypack::Slice splitPoints,
+                                         velocypack::Slice value) {
+  TRI_ASSERT(splitPoints.isArray());
+  // binary search for the first split point greater than the value
+  size_t low = 0;
+  size_t high = splitPoints.length();
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (basics::VelocyPackHelper::compare(splitPoints.at(mid), value, true) <=
+        0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+Result ShardingStrategyRange::validateSplitPoints(velocypack::Slice splitPoints,
+                                                  size_t numberOfShards) {
+  if (!splitPoints.isArray()) {
+    return {TRI_ERROR_BAD_PARAMETER, "'shardSplitPoints' must be an array"};
+  }
+  if (numberOfShards == 0 || splitPoints.length() != numberOfShards - 1) {
+    return {TRI_ERROR_BAD_PARAMETER,
+            "'shardSplitPoints' must contain one value less than the number "
+            "of shards"};
+  }
+  velocypack::Slice previous;
+  for (velocypack::Slice it : velocypack::ArrayIterator(splitPoints)) {
+    if (!previous.isNone() &&
+        basics::VelocyPackHelper::compare(previous, it, true) >= 0) {
+      return {TRI_ERROR_BAD_PARAMETER,
+              "'shardSplitPoints' must be in strictly ascending order"};
+    }
+    previous = it;
+  }
+  return {};
+}
+
+std::span<ShardID const> ShardingStrategyRange::determineShards() {
+  if (!_shardsSet.load(std::memory_order_acquire)) {
+    std::lock_guard lock{_shardsSetMutex};
+    if (_shardsSet.load(std::memory_order_relaxed)) {
+      return _shards;
+    }
+
+    // determine all available shards (which will stay const afterwards)
+    auto& ci = _sharding->collection()
+                   ->vocbase()
+                   .server()
+                   .getFeature<ClusterFeature>()
+                   .clusterInfo();
+    auto shards =
+        ci.getShardList(std::to_string(_sharding->collection()->id().id()));
+
+    if (shards->empty()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "invalid shard count");
+    }
+    if (shards->size() != _sharding->shardSplitPoints().length() + 1) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_INTERNAL,
+          "number of shards does not match the shard split points");
+    }
+
+    _shards = *shards;
+    _shardsSet.store(true, std::memory_order_release);
+  }
+  return _shards;
+}
+
+ShardRangeFinder::ShardRangeFinder(aql::Variable const* variable,
+                                   std::string shardKey,
+                                   velocypack::Slice splitPoints)
+    : _variable(variable),
+      _shardKey(std::move(shardKey)),
+      _splitPoints(splitPoints),
+      _numShards(splitPoints.length() + 1) {}
+
+std::vector<bool> ShardRangeFinder::find(aql::AstNode const* node) const {
+  if (node == nullptr) {
+    return all();
+  }
+
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_NARY_AND: {
+      auto result = all();
+      for (size_t i = 0; i < node->numMembers(); ++i) {
+        auto sub = find(node->getMemberUnchecked(i));
+        for (size_t j = 0; j < _numShards; ++j) {
+          result[j] = result[j] && sub[j];
+        }
+      }
+      return result;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_OR:
+    case NODE_TYPE_OPERATOR_NARY_OR: {
+      auto result = none();
+      for (size_t i = 0; i < node->numMembers(); ++i) {
+        auto sub = find(node->getMemberUnchecked(i));
+        for (size_t j = 0; j < _numShards; ++j) {
+          result[j] = result[j] || sub[j];
+        }
+      }
+      return result;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_IN: {
+      auto lhs = node->getMemberUnchecked(0);
+      auto rhs = node->getMemberUnchecked(1);
+      if (!isShardKeyAccess(lhs) || !rhs->isArray() || !rhs->isConstant()) {
+        return all();
+      }
+      velocypack::Builder builder;
+      rhs->toVelocyPackValue(builder);
+      auto result = none();
+      for (velocypack::Slice value :
+           velocypack::ArrayIterator(builder.slice())) {
+        result[shardIndex(value)] = true;
+      }
+      return result;
+    }
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE: {
+      auto type = node->type;
+      auto lhs = node->getMemberUnchecked(0);
+      auto rhs = node->getMemberUnchecked(1);
+      if (!isShardKeyAccess(lhs)) {
+        // try the reversed form, e.g. 5 < doc.value
+        std::swap(lhs, rhs);
+        type = Ast::ReverseOperator(type);
+      }
+      if (!isShardKeyAccess(lhs) || !rhs->isConstant()) {
+        return all();
+      }
+      velocypack::Builder builder;
+      rhs->toVelocyPackValue(builder);
+      size_t index = shardIndex(builder.slice());
+
+      auto result = none();
+      if (type == NODE_TYPE_OPERATOR_BINARY_EQ) {
+        result[index] = true;
+      } else if (type == NODE_TYPE_OPERATOR_BINARY_LT ||
+                 type == NODE_TYPE_OPERATOR_BINARY_LE) {
+        if (type == NODE_TYPE_OPERATOR_BINARY_LT && index > 0 &&
+            basics::VelocyPackHelper::compare(_splitPoints.at(index - 1),
+                                              builder.slice(), true) == 0) {
+          // the value is the lower bound of the shard, so all documents in
+          // the shard are greater than or equal to it
+          --index;
+        }
+        std::fill(result.begin(), result.begin() + index + 1, true);
+      } else {
+        std::fill(result.begin() + index, result.end(), true);
+      }
+      return result;
+    }
+    default: {
+      return all();
+    }
+  }
+}
+
+size_t ShardRangeFinder::shardIndex(velocypack::Slice value) const {
+  return std::min(ShardingStrategyRange::shardIndex(_splitPoints, value),
+                  _numShards - 1);
+}
+
+bool ShardRangeFinder::isShardKeyAccess(aql::AstNode const* node) const {
+  std::pair<aql::Variable const*, std::vector<basics::AttributeName>> result;
+  return node->isAttributeAccessForVariable(result, false) &&
+         result.first == _variable && result.second.size() == 1 &&
+         !result.second[0].shouldExpand &&
+         result.second[0].name == _shardKey;
+}
+
+void ShardRangeRestrictions::add(std::string const& group,
+                                 std::vector<bool> const& matches) {
+  Group& g = _groups[group];
+  if (g.excluded) {
+    return;
+  }
+  if (g.matches.empty()) {
+    g.matches = matches;
+  } else if (g.matches.size() != matches.size()) {
+    // co-located collections have the same number of shards. if they
+    // don't, the shards cannot be paired, so leave them alone
+    g.excluded = true;
+  } else {
+    // the accesses may need different shards, so the whole group is
+    // restricted to the union of them
+    for (size_t i = 0; i < matches.size(); ++i) {
+      g.matches[i] = g.matches[i] || matches[i];
+    }
+  }
+}
+
+void ShardRangeRestrictions::exclude(std::string const& group) {
+  _groups[group].excluded = true;
+}
+
+std::vector<size_t> ShardRangeRestrictions::shardIndexes(
+    std::string const& group) const {
+  std::vector<size_t> result;
+  auto it = _groups.find(group);
+  if (it == _groups.end() || it->second.excluded) {
+    return result;
+  }
+  auto const& matches = it->second.matches;
+  for (size_t i = 0; i < matches.size(); ++i) {
+    if (matches[i]) {
+      result.emplace_back(i);
+    }
+  }
+  if (result.size() == matches.size()) {
+    result.clear();
+  } else if (result.empty() && !matches.empty()) {
+    // no shard can produce a result. still the accesses need to run
+    // somewhere, so use the first shard
+    result.emplace_back(0);
+  }
+  return result;
+}
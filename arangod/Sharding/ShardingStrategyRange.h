@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Basics/Result.h"
+#include "Sharding/ShardingStrategy.h"
+
+#include <velocypack/Slice.h>
+
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace arangodb {
+class ShardingInfo;
+namespace aql {
+struct AstNode;
+struct Variable;
+}  // namespace aql
+
+/// @brief range-based sharding. the collection has a single shard key, and
+/// its values are partitioned into consecutive ranges by the split points
+/// stored in the collection's "shardSplitPoints" attribute. shard i holds
+/// all documents with split point i - 1 <= shard key value < split point i,
+/// using the sort order of AQL. documents without the shard key attribute
+/// are treated as having a null value and go to the first shard.
+/// queries with range or IN conditions on the shard key can thus be
+/// restricted to the shards holding the requested ranges.
+class ShardingStrategyRange final : public ShardingStrategy {
+ public:
+  explicit ShardingStrategyRange(ShardingInfo* sharding);
+
+  std::string const& name() const override { return NAME; }
+
+  static std::string const NAME;
+
+  bool usesDefaultShardKeys() const noexcept override {
+    return _usesDefaultShardKeys;
+  }
+
+  /// @brief collections are only compatible if they use the same split
+  /// points, so that shards with the same index hold the same ranges
+  bool isCompatible(ShardingStrategy const* other) const override;
+
+  ErrorCode getResponsibleShard(velocypack::Slice slice, bool docComplete,
+                                ShardID& shardID, bool& usesDefaultShardKeys,
+                                std::string_view key) override;
+
+  /// @brief returns the index of the shard responsible for a shard key
+  /// value, i.e. the number of split points that are less than or equal to
+  /// the value
+  static size_t shardIndex(velocypack::Slice splitPoints,
+                           velocypack::Slice value);
+
+  /// @brief validates that the split points are an array of strictly
+  /// ascending values, one less than the number of shards
+  static Result validateSplitPoints(velocypack::Slice splitPoints,
+                                    size_t numberOfShards);
+
+ private:
+  std::span<ShardID const> determineShards();
+
+  ShardingInfo* _sharding;
+  bool _usesDefaultShardKeys;
+
+  std::atomic_bool _shardsSet;
+  std::mutex _shardsSetMutex;
+  std::vector<ShardID> _shards;
+};
+
+/// @brief determines which shards of a range-sharded collection can hold
+/// documents satisfying a condition on the collection's shard key. ==, <,
+/// <=, >, >= and IN comparisons of the shard key attribute of the variable
+/// with constants are analyzed, combined with AND and OR
+class ShardRangeFinder {
+ public:
+  ShardRangeFinder(aql::Variable const* variable, std::string shardKey,
+                   velocypack::Slice splitPoints);
+
+  /// @brief returns a flag for each shard whether it can contain matching
+  /// documents. conditions that cannot be analyzed match all shards
+  std::vector<bool> find(aql::AstNode const* node) const;
+
+ private:
+  std::vector<bool> all() const { return std::vector<bool>(_numShards, true); }
+  std::vector<bool> none() const {
+    return std::vector<bool>(_numShards, false);
+  }
+
+  size_t shardIndex(velocypack::Slice value) const;
+
+  bool isShardKeyAccess(aql::AstNode const* node) const;
+
+  aql::Variable const* _variable;
+  std::string const _shardKey;
+  velocypack::Slice _splitPoints;
+  size_t const _numShards;
+};
+
+/// @brief collects the shards that the accesses to range-sharded collections
+/// in one query snippet can match, and combines them per group of
+/// co-located collections, i.e. a collection together with all collections
+/// distributed like it. all accesses of a group must be restricted to the
+/// same shard indexes: a snippet can only be restricted to one set of shards
+/// per collection, and the shards of co-located collections in a snippet
+/// are paired by their index
+class ShardRangeRestrictions {
+ public:
+  /// @brief adds an access to a collection of the group, which can only
+  /// match the shards flagged in matches
+  void add(std::string const& group, std::vector<bool> const& matches);
+
+  /// @brief marks the group as not restrictable, because one of its
+  /// collections is accessed in a way that may need all shards
+  void exclude(std::string const& group);
+
+  /// @brief returns the indexes of the shards the accesses of the group are
+  /// restricted to. returns an empty vector if the group must not be
+  /// restricted, or if all of its shards can match
+  std::vector<size_t> shardIndexes(std::string const& group) const;
+
+ private:
+  struct Group {
+    std::vector<bool> matches;
+    bool excluded = false;
+  };
+
+  std::unordered_map<std::string, Group> _groups;
+};
+
+}  // namespace arangodb
@@ -551,8 +551,6 @@ Result transaction::helpers::mergeObjectsForUpdate(
     b->add(StaticStrings::RevString, revisionId.toValuePair(ridBuffer));
   }
 
-  containers::FlatHashSet<std::string_view> keysWritten;
-
   // add other attributes after the system attributes
   {
     VPackObjectIterator it(oldValue, true);
@@ -570,9 +568,6 @@ Result transaction::helpers::mergeObjectsForUpdate(
       if (found == newValues.end()) {
         // use old value
         b->addUnchecked(key, current.value);
-        if (batchOptions.computedValues != nullptr) {
-          keysWritten.emplace(key);
-        }
       } else if (options.mergeObjects && current.value.isObject() &&
                  (*found).second.isObject()) {
         // merge both values
@@ -581,9 +576,6 @@ Result transaction::helpers::mergeObjectsForUpdate(
           b->add(VPackValue(key, VPackValueType::String));
           VPackCollection::merge(*b, current.value, value, true,
                                  !options.keepNull);
-          if (batchOptions.computedValues != nullptr) {
-            keysWritten.emplace(key);
-          }
         }
         // clear the value in the map so its not added again
         (*found).second = VPackSlice();
@@ -592,9 +584,6 @@ Result transaction::helpers::mergeObjectsForUpdate(
         auto& value = (*found).second;
         if (options.keepNull || (!value.isNone() && !value.isNull())) {
           b->addUnchecked(key, value);
-          if (batchOptions.computedValues != nullptr) {
-            keysWritten.emplace(key);
-          }
         }
         // clear the value in the map so its not added again
         (*found).second = VPackSlice();
@@ -618,10 +607,6 @@ Result transaction::helpers::mergeObjectsForUpdate(
     } else {
       b->addUnchecked(it.first, s);
     }
-
-    if (batchOptions.computedValues != nullptr) {
-      keysWritten.emplace(it.first);
-    }
   }
 
   b->close();
@@ -630,7 +615,7 @@ Result transaction::helpers::mergeObjectsForUpdate(
     // add all remaining computed attributes, if we need to
     batchOptions.ensureComputedValuesContext(trx, collection);
     batchOptions.computedValues->mergeComputedAttributes(
-        *batchOptions.computedValuesContext, trx, b->slice(), keysWritten,
+        *batchOptions.computedValuesContext, trx, b->slice(),
         ComputeValuesOn::kUpdate, builder);
   } else {
     // add document as is
@@ -718,8 +703,6 @@ Result transaction::helpers::newObjectForInsert(
     b->add(StaticStrings::RevString, revisionId.toValuePair(ridBuffer));
   }
 
-  containers::FlatHashSet<std::string_view> keysWritten;
-
   // add other attributes after the system attributes
   VPackObjectIterator it(value, true);
   while (it.valid()) {
@@ -730,11 +713,6 @@ Result transaction::helpers::newObjectForInsert(
          key != StaticStrings::RevString && key != StaticStrings::FromString &&
          key != StaticStrings::ToString)) {
       b->add(key, it.value());
-      if (batchOptions.computedValues != nullptr) {
-        // track which attributes we have produced so that they are not
-        // added again by the computed attributes later.
-        keysWritten.emplace(key);
-      }
     }
     it.next();
   }
@@ -745,7 +723,7 @@ Result transaction::helpers::newObjectForInsert(
     // add all remaining computed attributes, if we need to
     batchOptions.ensureComputedValuesContext(trx, collection);
     batchOptions.computedValues->mergeComputedAttributes(
-        *batchOptions.computedValuesContext, trx, b->slice(), keysWritten,
+        *batchOptions.computedValuesContext, trx, b->slice(),
         ComputeValuesOn::kInsert, builder);
   } else {
     // add document as is
@@ -820,8 +798,6 @@ Result transaction::helpers::newObjectForReplace(
     b->add(StaticStrings::RevString, revisionId.toValuePair(&ridBuffer[0]));
   }
 
-  containers::FlatHashSet<std::string_view> keysWritten;
-
   // add other attributes after the system attributes
   VPackObjectIterator it(newValue, true);
   while (it.valid()) {
@@ -833,11 +809,6 @@ Result transaction::helpers::newObjectForReplace(
          key != StaticStrings::RevString && key != StaticStrings::FromString &&
          key != StaticStrings::ToString)) {
       b->add(key, it.value());
-      if (batchOptions.computedValues != nullptr) {
-        // track which attributes we have produced so that they are not
-        // added again by the computed attributes later.
-        keysWritten.emplace(key);
-      }
     }
     it.next();
   }
@@ -848,7 +819,7 @@ Result transaction::helpers::newObjectForReplace(
     // add all remaining computed attributes, if we need to
     batchOptions.ensureComputedValuesContext(trx, collection);
     batchOptions.computedValues->mergeComputedAttributes(
-        *batchOptions.computedValuesContext, trx, b->slice(), keysWritten,
+        *batchOptions.computedValuesContext, trx, b->slice(),
         ComputeValuesOn::kReplace, builder);
   } else {
     // add document as is
@@ -1914,7 +1914,8 @@ OperationResult transaction::Methods::anyLocal(
     }
   }
 
-  ResourceMonitor monitor(GlobalResourceMonitor::instance());
+  ResourceMonitor monitor(GlobalResourceMonitor::instance(),
+                          MemorySubsystem::Operations);
 
   resultBuilder.openArray();
 
@@ -2550,7 +2551,8 @@ OperationResult transaction::Methods::allLocal(
     }
   }
 
-  ResourceMonitor monitor(GlobalResourceMonitor::instance());
+  ResourceMonitor monitor(GlobalResourceMonitor::instance(),
+                          MemorySubsystem::Operations);
 
   resultBuilder.openArray();
 
@@ -132,6 +132,7 @@ V8DealerFeature::V8DealerFeature(Server& server)
       _nrMaxContexts(0),
       _nrMinContexts(0),
       _nrInflightContexts(0),
+      _nrIdleTarget(1),
       _maxContextInvocations(0),
       _copyInstallation(false),
       _allowAdminExecute(false),
@@ -276,6 +277,27 @@ When there are unused V8 contexts that linger around and the number of V8
 contexts is greater than `--javascript.v8-contexts-minimum`, the server's
 garbage collector thread automatically deletes them.)");
 
+  options
+      ->addOption("--javascript.v8-contexts-idle-target",
+                  "The number of unused V8 contexts to keep available by "
+                  "creating contexts in the background.",
+                  new UInt64Parameter(&_nrIdleTarget),
+                  arangodb::options::makeFlags(
+                      arangodb::options::Flags::DefaultNoComponents,
+                      arangodb::options::Flags::OnCoordinator,
+                      arangodb::options::Flags::OnSingle,
+                      arangodb::options::Flags::Uncommon))
+      .setIntroducedIn(31100)
+      .setLongDescription(R"(Creating a V8 context is expensive. If a request
+needs a V8 context and there is no unused one, the request has to create a new
+context, which adds to its latency. To avoid this, the server's garbage
+collector thread creates V8 contexts in the background whenever fewer than
+the configured number of contexts are unused, as long as the number of contexts
+is below `--javascript.v8-contexts`. It also does not remove superfluous
+contexts if this would drop the number of unused contexts below this value.
+
+Set this option to `0` to only create V8 contexts on demand.)");
+
   options->addOption(
       "--javascript.v8-contexts-max-invocations",
       "The maximum number of invocations for each V8 context before it is "
@@ -568,7 +590,7 @@ void V8DealerFeature::start() {
 
   LOG_TOPIC("09e14", DEBUG, Logger::V8)
       << "number of V8 contexts: min: " << _nrMinContexts
-      << ", max: " << _nrMaxContexts;
+      << ", max: " << _nrMaxContexts << ", idle target: " << _nrIdleTarget;
 
   defineDouble("V8_CONTEXTS", static_cast<double>(_nrMaxContexts));
 
@@ -839,6 +861,8 @@ void V8DealerFeature::collectGarbage() {
 
   while (!_stopping) {
     try {
+      prewarmContexts();
+
       V8Context* context = nullptr;
       bool wasDirty = false;
 
@@ -936,6 +960,7 @@ void V8DealerFeature::collectGarbage() {
           if (_contexts.size() > _nrMinContexts && !context->isDefault() &&
               context->shouldBeRemoved(_maxContextAge,
                                        _maxContextInvocations) &&
+              _idleContexts.size() >= _nrIdleTarget &&
               _dynamicContextCreationBlockers == 0) {
             // remove the extra context as it is not needed anymore
             _contexts.erase(std::remove_if(_contexts.begin(), _contexts.end(),
@@ -971,6 +996,53 @@ void V8DealerFeature::collectGarbage() {
   _gcFinished = true;
 }
 
+/// @brief create contexts until the number of unused contexts reaches the
+/// idle target, so that requests find unused contexts instead of creating
+/// them. only called by the garbage collector thread
+void V8DealerFeature::prewarmContexts() {
+  CONDITION_LOCKER(guard, _contextCondition);
+
+  while (!_stopping &&
+         _idleContexts.size() + _dirtyContexts.size() + _nrInflightContexts <
+             _nrIdleTarget &&
+         _contexts.size() + _nrInflightContexts < _nrMaxContexts &&
+         _dynamicContextCreationBlockers == 0) {
+    ++_nrInflightContexts;
+    guard.unlock();
+
+    std::unique_ptr<V8Context> context;
+    try {
+      LOG_TOPIC("b5e2c", DEBUG, Logger::V8)
+          << "creating additional V8 context in the background";
+      context = addContext();
+    } catch (...) {
+      guard.lock();
+      --_nrInflightContexts;
+      throw;
+    }
+
+    guard.lock();
+    --_nrInflightContexts;
+
+    _contexts.push_back(context.get());
+    try {
+      _idleContexts.push_back(context.get());
+    } catch (...) {
+      _contexts.pop_back();
+      ++_contextsDestroyed;
+      throw;
+    }
+    LOG_TOPIC("5d0f8", DEBUG, Logger::V8)
+        << "created additional V8 context #" << context->id()
+        << " in the background, number of contexts is now "
+        << _contexts.size();
+    context.release();
+
+    // wake up requests waiting for a context
+    guard.broadcast();
+  }
+}
+
 void V8DealerFeature::unblockDynamicContextCreation() {
   CONDITION_LOCKER(guard, _contextCondition);
 
@@ -1256,6 +1328,12 @@ V8Context* V8DealerFeature::enterContext(
     // should not fail because we reserved enough space beforehand
     _busyContexts.emplace(context);
 
+    if (_idleContexts.size() + _dirtyContexts.size() < _nrIdleTarget) {
+      // wake up the garbage collector thread, which creates contexts in
+      // the background
+      guard.broadcast();
+    }
+
     context->setDescription(securityContext.typeName(), TRI_microtime());
   }
 
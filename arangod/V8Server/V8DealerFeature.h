@@ -90,6 +90,9 @@ class V8DealerFeature final : public ArangodFeature {
   uint64_t _nrMinContexts;
   // number of contexts currently in creation
   uint64_t _nrInflightContexts;
+  // number of unused contexts to keep available by creating contexts in
+  // the background, so that requests do not need to create them
+  uint64_t _nrIdleTarget;
   // maximum number of V8 context invocations
   uint64_t _maxContextInvocations;
 
@@ -160,6 +163,7 @@ class V8DealerFeature final : public ArangodFeature {
   uint64_t nextId() { return _nextId++; }
   void copyInstallationFiles();
   void startGarbageCollection();
+  void prewarmContexts();
   std::unique_ptr<V8Context> addContext();
   std::unique_ptr<V8Context> buildContext(TRI_vocbase_t* vocbase, size_t id);
   V8Context* pickFreeContextForGc();
@@ -209,7 +209,8 @@ static void JS_AllQuery(v8::FunctionCallbackInfo<v8::Value> const& args) {
 
   std::string const collectionName(collection->name());
 
-  ResourceMonitor monitor(GlobalResourceMonitor::instance());
+  ResourceMonitor monitor(GlobalResourceMonitor::instance(),
+                          MemorySubsystem::Operations);
 
   auto transactionContext =
       transaction::V8Context::Create(collection->vocbase(), true);
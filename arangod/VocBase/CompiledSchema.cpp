@@ -0,0 +1,619 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CompiledSchema.h"
+
+#include "Basics/VelocyPackHelper.h"
+#include "Basics/debugging.h"
+
+#include <velocypack/Iterator.h>
+
+#include <cmath>
+#include <compare>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+using namespace arangodb;
+
+namespace {
+
+bool isSystemAttribute(std::string_view name) noexcept {
+  // keep in sync with validation::skip_special()
+  if (name.size() < 3 || name.size() > 5 || name[0] != '_') {
+    return false;
+  }
+  return name == "_key" || name == "_id" || name == "_rev" ||
+         name == "_from" || name == "_to";
+}
+
+// same tolerance as used by the tao::json schema validation
+bool isMultipleOf(double v, double d) {
+  double r = std::fmod(v, d);
+  return std::fabs(r) < std::numeric_limits<double>::epsilon() ||
+         std::fabs(r - d) < std::numeric_limits<double>::epsilon();
+}
+
+size_t numCodePoints(std::string_view value) noexcept {
+  size_t n = 0;
+  for (char c : value) {
+    n += ((c & 0xC0) != 0x80);
+  }
+  return n;
+}
+
+}  // namespace
+
+std::unique_ptr<CompiledSchema> CompiledSchema::compile(
+    velocypack::Slice schema) {
+  std::unique_ptr<CompiledSchema> compiled(new CompiledSchema());
+  compiled->_schema.add(schema);
+  compiled->compileNode(compiled->_schema.slice());
+  if (compiled->_unsupported) {
+    return nullptr;
+  }
+  TRI_ASSERT(!compiled->_nodes.empty());
+  return compiled;
+}
+
+bool CompiledSchema::parseLimit(velocypack::Slice value, Limit& limit) {
+  switch (value.type()) {
+    case velocypack::ValueType::SmallInt:
+    case velocypack::ValueType::Int:
+      limit.kind = Limit::Kind::kSigned;
+      limit.i = value.getNumber<int64_t>();
+      return true;
+    case velocypack::ValueType::UInt:
+      limit.kind = Limit::Kind::kUnsigned;
+      limit.u = value.getUInt();
+      return true;
+    case velocypack::ValueType::Double:
+      limit.kind = Limit::Kind::kDouble;
+      limit.d = value.getDouble();
+      return true;
+    default:
+      return false;
+  }
+}
+
+CompiledSchema::Range CompiledSchema::compileList(velocypack::Slice list) {
+  if (!list.isArray()) {
+    _unsupported = true;
+    return {};
+  }
+  // compile the sub schemas first, as they append to _subNodes themselves
+  std::vector<uint32_t> nodes;
+  for (velocypack::Slice entry : velocypack::ArrayIterator(list)) {
+    nodes.push_back(compileNode(entry));
+  }
+  Range range;
+  range.begin = static_cast<uint32_t>(_subNodes.size());
+  _subNodes.insert(_subNodes.end(), nodes.begin(), nodes.end());
+  range.end = static_cast<uint32_t>(_subNodes.size());
+  return range;
+}
+
+uint32_t CompiledSchema::compileNode(velocypack::Slice schema) {
+  if (!schema.isObject() || _unsupported) {
+    _unsupported = true;
+    return kNoNode;
+  }
+
+  // nodes are appended while compiling sub schemas, so fill a local node
+  // and store it at its position at the end
+  auto const index = static_cast<uint32_t>(_nodes.size());
+  _nodes.emplace_back();
+  Node node;
+
+  bool exclusiveMaximum = false;
+  bool exclusiveMinimum = false;
+  velocypack::Slice properties;
+  velocypack::Slice required;
+
+  auto setType = [&](velocypack::Slice type) {
+    std::string_view name = type.isString() ? type.stringView() : "";
+    if (name == "null") {
+      node.types |= kNull;
+    } else if (name == "boolean") {
+      node.types |= kBoolean;
+    } else if (name == "integer") {
+      node.types |= kInteger;
+    } else if (name == "number") {
+      node.types |= kNumber;
+    } else if (name == "string") {
+      node.types |= kString;
+    } else if (name == "array") {
+      node.types |= kArray;
+    } else if (name == "object") {
+      node.types |= kObject;
+    } else {
+      _unsupported = true;
+    }
+  };
+
+  for (auto it : velocypack::ObjectIterator(schema, true)) {
+    std::string_view keyword = it.key.stringView();
+    velocypack::Slice value = it.value;
+
+    if (keyword == "type") {
+      node.hasType = true;
+      if (value.isArray()) {
+        for (velocypack::Slice type : velocypack::ArrayIterator(value)) {
+          setType(type);
+        }
+      } else {
+        setType(value);
+      }
+    } else if (keyword == "enum") {
+      if (!value.isArray()) {
+        _unsupported = true;
+        return kNoNode;
+      }
+      node.hasEnum = true;
+      node.enumValues.begin = static_cast<uint32_t>(_enumValues.size());
+      for (velocypack::Slice entry : velocypack::ArrayIterator(value)) {
+        // documents are compared with velocypack equality, which does not
+        // hide the system attributes inside of objects
+        if (entry.isObject() || entry.isArray()) {
+          _unsupported = true;
+        }
+        _enumValues.push_back(entry);
+      }
+      node.enumValues.end = static_cast<uint32_t>(_enumValues.size());
+    } else if (keyword == "allOf") {
+      node.allOf = compileList(value);
+    } else if (keyword == "anyOf") {
+      node.anyOf = compileList(value);
+    } else if (keyword == "oneOf") {
+      node.oneOf = compileList(value);
+    } else if (keyword == "not") {
+      node.notNode = compileNode(value);
+    } else if (keyword == "multipleOf") {
+      if (!parseLimit(value, node.multipleOf)) {
+        _unsupported = true;
+      } else if (node.multipleOf.kind == Limit::Kind::kSigned) {
+        // the schema guarantees a positive value
+        node.multipleOf.kind = Limit::Kind::kUnsigned;
+        node.multipleOf.u = static_cast<uint64_t>(node.multipleOf.i);
+      }
+    } else if (keyword == "maximum") {
+      _unsupported |= !parseLimit(value, node.maximum);
+    } else if (keyword == "minimum") {
+      _unsupported |= !parseLimit(value, node.minimum);
+    } else if (keyword == "exclusiveMaximum") {
+      exclusiveMaximum = value.isTrue();
+    } else if (keyword == "exclusiveMinimum") {
+      exclusiveMinimum = value.isTrue();
+    } else if (keyword == "maxLength") {
+      node.maxLength = value.getNumber<uint64_t>();
+    } else if (keyword == "minLength") {
+      node.minLength = value.getNumber<uint64_t>();
+    } else if (keyword == "pattern") {
+      node.pattern = static_cast<uint32_t>(_patterns.size());
+      _patterns.emplace_back(value.copyString());
+    } else if (keyword == "items") {
+      // the tuple form of "items" is not supported
+      node.items = compileNode(value);
+    } else if (keyword == "uniqueItems") {
+      _unsupported |= value.isTrue();
+    } else if (keyword == "maxItems") {
+      node.maxItems = value.getNumber<uint64_t>();
+    } else if (keyword == "minItems") {
+      node.minItems = value.getNumber<uint64_t>();
+    } else if (keyword == "maxProperties") {
+      node.maxProperties = value.getNumber<uint64_t>();
+      node.checksMembers = true;
+    } else if (keyword == "minProperties") {
+      node.minProperties = value.getNumber<uint64_t>();
+      node.checksMembers = true;
+    } else if (keyword == "required") {
+      required = value;
+    } else if (keyword == "properties") {
+      properties = value;
+    } else if (keyword == "additionalProperties") {
+      if (value.isBoolean()) {
+        node.additional =
+            value.getBool() ? kAdditionalAllowed : kAdditionalForbidden;
+      } else {
+        node.additional = compileNode(value);
+      }
+      node.checksMembers = true;
+    } else if (keyword == "format" || keyword == "patternProperties" ||
+               keyword == "dependencies" || keyword == "additionalItems" ||
+               keyword == "$ref") {
+      _unsupported = true;
+    }
+    // all other keywords are annotations or ignored by the generic
+    // validation as well
+
+    if (_unsupported) {
+      return kNoNode;
+    }
+  }
+
+  node.maximum.exclusive = exclusiveMaximum;
+  node.minimum.exclusive = exclusiveMinimum;
+
+  if (properties.isObject() || required.isArray()) {
+    containers::FlatHashMap<std::string, Property> lookup;
+    if (properties.isObject()) {
+      for (auto it : velocypack::ObjectIterator(properties, true)) {
+        uint32_t sub = compileNode(it.value);
+        if (_unsupported) {
+          return kNoNode;
+        }
+        lookup.emplace(it.key.copyString(),
+                       Property{static_cast<uint32_t>(lookup.size()), sub,
+                                false});
+      }
+    }
+    if (required.isArray()) {
+      for (velocypack::Slice name : velocypack::ArrayIterator(required)) {
+        auto [pos, inserted] = lookup.try_emplace(
+            name.copyString(),
+            Property{static_cast<uint32_t>(lookup.size()), kNoNode, true});
+        if (inserted || !pos->second.required) {
+          pos->second.required = true;
+          ++node.numRequired;
+        }
+      }
+    }
+    node.numProperties = static_cast<uint32_t>(lookup.size());
+    node.properties = static_cast<uint32_t>(_properties.size());
+    _properties.push_back(std::move(lookup));
+    node.checksMembers = true;
+  }
+
+  _nodes[index] = node;
+  return index;
+}
+
+CompiledSchema::Outcome CompiledSchema::validate(
+    velocypack::Slice document) const {
+  TRI_ASSERT(!_nodes.empty());
+  return validateNode(document, 0);
+}
+
+CompiledSchema::Outcome CompiledSchema::validateNode(velocypack::Slice value,
+                                                     uint32_t index) const {
+  TRI_ASSERT(index < _nodes.size());
+  Node const& node = _nodes[index];
+
+  value = value.resolveExternal();
+
+  uint8_t type;
+  switch (value.type()) {
+    case velocypack::ValueType::Null:
+      type = kNull;
+      break;
+    case velocypack::ValueType::Bool:
+      type = kBoolean;
+      break;
+    case velocypack::ValueType::SmallInt:
+    case velocypack::ValueType::Int:
+    case velocypack::ValueType::UInt:
+      type = kInteger | kNumber;
+      break;
+    case velocypack::ValueType::Double:
+      type = kNumber;
+      break;
+    case velocypack::ValueType::String:
+      type = kString;
+      break;
+    case velocypack::ValueType::Array:
+      type = kArray;
+      break;
+    case velocypack::ValueType::Object:
+      type = kObject;
+      break;
+    default:
+      // custom types, binary data etc. are left to the generic validation
+      return Outcome::kUnsupported;
+  }
+
+  if (node.hasType && (node.types & type) == 0) {
+    return Outcome::kInvalid;
+  }
+
+  if (node.hasEnum) {
+    bool found = false;
+    for (uint32_t i = node.enumValues.begin; i < node.enumValues.end; ++i) {
+      if (basics::VelocyPackHelper::equal(value, _enumValues[i], false)) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return Outcome::kInvalid;
+    }
+  }
+
+  Outcome res = Outcome::kValid;
+  if (type & kNumber) {
+    res = validateNumber(value, node);
+  } else if (type == kString) {
+    res = validateString(value, node);
+  } else if (type == kArray) {
+    res = validateArray(value, node);
+  } else if (type == kObject) {
+    res = validateObject(value, node);
+  }
+  if (res != Outcome::kValid) {
+    return res;
+  }
+
+  for (uint32_t i = node.allOf.begin; i < node.allOf.end; ++i) {
+    res = validateNode(value, _subNodes[i]);
+    if (res != Outcome::kValid) {
+      return res;
+    }
+  }
+
+  if (!node.anyOf.empty()) {
+    bool unsupported = false;
+    bool matched = false;
+    for (uint32_t i = node.anyOf.begin; i < node.anyOf.end && !matched; ++i) {
+      res = validateNode(value, _subNodes[i]);
+      matched = (res == Outcome::kValid);
+      unsupported |= (res == Outcome::kUnsupported);
+    }
+    if (!matched) {
+      return unsupported ? Outcome::kUnsupported : Outcome::kInvalid;
+    }
+  }
+
+  if (!node.oneOf.empty()) {
+    size_t matches = 0;
+    for (uint32_t i = node.oneOf.begin; i < node.oneOf.end; ++i) {
+      res = validateNode(value, _subNodes[i]);
+      if (res == Outcome::kUnsupported) {
+        return res;
+      }
+      matches += (res == Outcome::kValid);
+    }
+    if (matches != 1) {
+      return Outcome::kInvalid;
+    }
+  }
+
+  if (node.notNode != kNoNode) {
+    res = validateNode(value, node.notNode);
+    if (res == Outcome::kUnsupported) {
+      return res;
+    }
+    if (res == Outcome::kValid) {
+      return Outcome::kInvalid;
+    }
+  }
+
+  return Outcome::kValid;
+}
+
+namespace {
+
+template<typename T>
+std::partial_ordering compareTo(T v, int64_t limit) {
+  if constexpr (std::is_same_v<T, uint64_t>) {
+    if (limit < 0) {
+      return std::partial_ordering::greater;
+    }
+    return v <=> static_cast<uint64_t>(limit);
+  } else if constexpr (std::is_same_v<T, int64_t>) {
+    return v <=> limit;
+  } else {
+    return v <=> static_cast<double>(limit);
+  }
+}
+
+template<typename T>
+std::partial_ordering compareTo(T v, uint64_t limit) {
+  if constexpr (std::is_same_v<T, int64_t>) {
+    if (v < 0) {
+      return std::partial_ordering::less;
+    }
+    return static_cast<uint64_t>(v) <=> limit;
+  } else if constexpr (std::is_same_v<T, uint64_t>) {
+    return v <=> limit;
+  } else {
+    return v <=> static_cast<double>(limit);
+  }
+}
+
+template<typename T>
+std::partial_ordering compareTo(T v, double limit) {
+  return static_cast<double>(v) <=> limit;
+}
+
+}  // namespace
+
+CompiledSchema::Outcome CompiledSchema::validateNumber(
+    velocypack::Slice value, Node const& node) const {
+  auto check = [&node](auto v) -> bool {
+    auto compare = [v](Limit const& limit) {
+      switch (limit.kind) {
+        case Limit::Kind::kSigned:
+          return compareTo(v, limit.i);
+        case Limit::Kind::kUnsigned:
+          return compareTo(v, limit.u);
+        case Limit::Kind::kDouble:
+          return compareTo(v, limit.d);
+        case Limit::Kind::kNone:
+          break;
+      }
+      return std::partial_ordering::unordered;
+    };
+
+    if (node.maximum.kind != Limit::Kind::kNone) {
+      auto cmp = compare(node.maximum);
+      if (node.maximum.exclusive ? cmp >= 0 : cmp > 0) {
+        return false;
+      }
+    }
+    if (node.minimum.kind != Limit::Kind::kNone) {
+      auto cmp = compare(node.minimum);
+      if (node.minimum.exclusive ? cmp <= 0 : cmp < 0) {
+        return false;
+      }
+    }
+
+    using T = decltype(v);
+    if (node.multipleOf.kind == Limit::Kind::kUnsigned) {
+      if constexpr (std::is_same_v<T, double>) {
+        return isMultipleOf(v, static_cast<double>(node.multipleOf.u));
+      } else if constexpr (std::is_same_v<T, int64_t>) {
+        uint64_t abs = v < 0 ? uint64_t(0) - static_cast<uint64_t>(v)
+                             : static_cast<uint64_t>(v);
+        return abs % node.multipleOf.u == 0;
+      } else {
+        return v % node.multipleOf.u == 0;
+      }
+    } else if (node.multipleOf.kind == Limit::Kind::kDouble) {
+      return isMultipleOf(static_cast<double>(v), node.multipleOf.d);
+    }
+    return true;
+  };
+
+  bool ok;
+  switch (value.type()) {
+    case velocypack::ValueType::Double:
+      ok = check(value.getDouble());
+      break;
+    case velocypack::ValueType::UInt:
+      ok = check(value.getUInt());
+      break;
+    default:
+      ok = check(value.getNumber<int64_t>());
+      break;
+  }
+  return ok ? Outcome::kValid : Outcome::kInvalid;
+}
+
+CompiledSchema::Outcome CompiledSchema::validateString(
+    velocypack::Slice value, Node const& node) const {
+  std::string_view s = value.stringView();
+  if (node.minLength > 0 || node.maxLength != UINT64_MAX) {
+    size_t length = numCodePoints(s);
+    if (length < node.minLength || length > node.maxLength) {
+      return Outcome::kInvalid;
+    }
+  }
+  if (node.pattern != kNoNode &&
+      !std::regex_search(s.begin(), s.end(), _patterns[node.pattern])) {
+    return Outcome::kInvalid;
+  }
+  return Outcome::kValid;
+}
+
+CompiledSchema::Outcome CompiledSchema::validateArray(
+    velocypack::Slice value, Node const& node) const {
+  velocypack::ArrayIterator it(value);
+  if (it.size() < node.minItems || it.size() > node.maxItems) {
+    return Outcome::kInvalid;
+  }
+  if (node.items != kNoNode) {
+    for (; it.valid(); it.next()) {
+      Outcome res = validateNode(it.value(), node.items);
+      if (res != Outcome::kValid) {
+        return res;
+      }
+    }
+  }
+  return Outcome::kValid;
+}
+
+CompiledSchema::Outcome CompiledSchema::validateObject(
+    velocypack::Slice value, Node const& node) const {
+  if (!node.checksMembers) {
+    return Outcome::kValid;
+  }
+
+  containers::FlatHashMap<std::string, Property> const* lookup = nullptr;
+  if (node.properties != kNoNode) {
+    lookup = &_properties[node.properties];
+  }
+
+  // attributes of the node seen so far, by position. most schemas have
+  // few properties, so a single word will do in almost all cases
+  uint64_t seenWord = 0;
+  std::vector<bool> seenVector;
+  if (node.numProperties > 64) {
+    seenVector.resize(node.numProperties, false);
+  }
+  auto markSeen = [&](uint32_t position) -> bool {
+    if (seenVector.empty()) {
+      uint64_t bit = uint64_t(1) << position;
+      bool seen = (seenWord & bit) != 0;
+      seenWord |= bit;
+      return !seen;
+    }
+    bool seen = seenVector[position];
+    seenVector[position] = true;
+    return !seen;
+  };
+
+  uint64_t members = 0;
+  uint32_t required = 0;
+  for (velocypack::ObjectIterator it(value, true); it.valid(); it.next()) {
+    velocypack::Slice key = it.key(false);
+    if (!key.isString()) {
+      // translated system attribute
+      continue;
+    }
+    std::string_view name = key.stringView();
+    if (isSystemAttribute(name)) {
+      continue;
+    }
+    ++members;
+
+    uint32_t sub = node.additional;
+    if (lookup != nullptr) {
+      if (auto pos = lookup->find(name); pos != lookup->end()) {
+        Property const& property = pos->second;
+        if (!markSeen(property.position)) {
+          // duplicate attribute names fail the validation
+          return Outcome::kInvalid;
+        }
+        required += property.required;
+        if (property.node != kNoNode) {
+          sub = property.node;
+        }
+      }
+    }
+
+    if (sub == kAdditionalForbidden) {
+      return Outcome::kInvalid;
+    }
+    if (sub != kAdditionalAllowed) {
+      Outcome res = validateNode(it.value(), sub);
+      if (res != Outcome::kValid) {
+        return res;
+      }
+    }
+  }
+
+  if (members < node.minProperties || members > node.maxProperties ||
+      required != node.numRequired) {
+    return Outcome::kInvalid;
+  }
+  return Outcome::kValid;
+}
@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Containers/FlatHashMap.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <cstdint>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace arangodb {
+
+/// @brief a JSON schema (draft 4) compiled into a flat program of nodes that
+/// is evaluated directly on velocypack documents. this avoids producing
+/// events for every value of a document and setting up consumer objects
+/// for each schema node on every validation, which is what the generic
+/// tao::json schema validation does.
+/// only a subset of the schema keywords is supported. compile() returns a
+/// nullptr for schemas using other keywords, and validate() returns
+/// Outcome::kUnsupported for documents containing value types it cannot
+/// handle. in both cases the caller has to use the generic validation.
+/// the attributes _key, _id, _rev, _from and _to are invisible to the
+/// schema on all levels, the same as with the generic validation.
+class CompiledSchema {
+ public:
+  enum class Outcome : uint8_t {
+    kValid,
+    kInvalid,
+    kUnsupported,
+  };
+
+  /// @brief compile a schema. the schema must have been validated by the
+  /// tao::json schema before. returns a nullptr if the schema uses keywords
+  /// not supported by the compiled validation
+  static std::unique_ptr<CompiledSchema> compile(velocypack::Slice schema);
+
+  Outcome validate(velocypack::Slice document) const;
+
+ private:
+  // bit values for the "type" keyword
+  enum TypeBits : uint8_t {
+    kNull = 1,
+    kBoolean = 2,
+    kInteger = 4,
+    kNumber = 8,
+    kString = 16,
+    kArray = 32,
+    kObject = 64,
+  };
+
+  /// @brief a numeric limit as used by "minimum", "maximum" and
+  /// "multipleOf". the representation follows the one in the schema, so
+  /// that comparisons are exact for integers
+  struct Limit {
+    enum class Kind : uint8_t { kNone, kSigned, kUnsigned, kDouble };
+    Kind kind = Kind::kNone;
+    bool exclusive = false;
+    union {
+      int64_t i = 0;
+      uint64_t u;
+      double d;
+    };
+  };
+
+  /// @brief a range of entries in one of the lists below
+  struct Range {
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    bool empty() const noexcept { return begin == end; }
+  };
+
+  struct Property {
+    // position of the property among the properties of its node, used to
+    // detect duplicate and missing required attributes
+    uint32_t position;
+    // node to validate the attribute value with, or kNoNode if the
+    // attribute is only mentioned in "required"
+    uint32_t node;
+    bool required;
+  };
+
+  static constexpr uint32_t kNoNode = UINT32_MAX;
+  // values for Node::additional other than a node index
+  static constexpr uint32_t kAdditionalAllowed = UINT32_MAX;
+  static constexpr uint32_t kAdditionalForbidden = UINT32_MAX - 1;
+
+  struct Node {
+    bool hasType = false;
+    bool hasEnum = false;
+    uint8_t types = 0;
+    Limit minimum;
+    Limit maximum;
+    Limit multipleOf;
+    uint64_t minLength = 0;
+    uint64_t maxLength = UINT64_MAX;
+    uint64_t minItems = 0;
+    uint64_t maxItems = UINT64_MAX;
+    uint64_t minProperties = 0;
+    uint64_t maxProperties = UINT64_MAX;
+    // index into _patterns, or kNoNode
+    uint32_t pattern = kNoNode;
+    uint32_t items = kNoNode;
+    uint32_t notNode = kNoNode;
+    uint32_t additional = kAdditionalAllowed;
+    // index into _properties, or kNoNode if the node has neither
+    // "properties" nor "required"
+    uint32_t properties = kNoNode;
+    uint32_t numProperties = 0;
+    uint32_t numRequired = 0;
+    // ranges in _subNodes
+    Range allOf;
+    Range anyOf;
+    Range oneOf;
+    // range in _enumValues
+    Range enumValues;
+    // whether the node needs to look at the members of objects at all
+    bool checksMembers = false;
+  };
+
+  CompiledSchema() = default;
+
+  uint32_t compileNode(velocypack::Slice schema);
+  Range compileList(velocypack::Slice list);
+  static bool parseLimit(velocypack::Slice value, Limit& limit);
+
+  Outcome validateNode(velocypack::Slice value, uint32_t node) const;
+  Outcome validateNumber(velocypack::Slice value, Node const& node) const;
+  Outcome validateString(velocypack::Slice value, Node const& node) const;
+  Outcome validateArray(velocypack::Slice value, Node const& node) const;
+  Outcome validateObject(velocypack::Slice value, Node const& node) const;
+
+  std::vector<Node> _nodes;
+  std::vector<uint32_t> _subNodes;
+  std::vector<std::regex> _patterns;
+  std::vector<containers::FlatHashMap<std::string, Property>> _properties;
+  std::vector<velocypack::Slice> _enumValues;
+  // owns the memory of the enum values
+  velocypack::Builder _schema;
+  // set while compiling if the schema cannot be compiled
+  bool _unsupported = false;
+};
+
+}  // namespace arangodb
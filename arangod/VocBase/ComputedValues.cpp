@@ -36,6 +36,7 @@
 #include "Aql/Variable.h"
 #include "Basics/DownCast.h"
 #include "Basics/Exceptions.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StaticStrings.h"
 #include "Logger/LogMacros.h"
 #include "RestServer/DatabaseFeature.h"
@@ -137,6 +138,12 @@ ValidatorBase* ComputedValuesExpressionContext::buildValidator(
   return _aqlFunctionsInternalCache.buildValidator(params);
 }
 
+basics::DateFormatProgram const*
+ComputedValuesExpressionContext::buildDateFormat(
+    std::string_view formatString) {
+  return _aqlFunctionsInternalCache.buildDateFormat(formatString);
+}
+
 aql::AqlValue ComputedValuesExpressionContext::getVariableValue(
     aql::Variable const* variable, bool doCopy, bool& mustDestroy) const {
   auto it = _variables.find(variable);
@@ -333,76 +340,88 @@ bool ComputedValues::mustComputeValuesOnReplace() const noexcept {
   return !_attributesForReplace.empty();
 }
 
+void ComputedValues::Computations::add(std::string_view name,
+                                       std::size_t position, bool overwrite) {
+  attributes.emplace(name, position);
+  positions.push_back(position);
+  if (overwrite) {
+    overwriting.push_back(position);
+  }
+}
+
 void ComputedValues::mergeComputedAttributes(
     aql::ExpressionContext& ctx, transaction::Methods& trx,
-    velocypack::Slice input,
-    containers::FlatHashSet<std::string_view> const& keysWritten,
-    ComputeValuesOn mustComputeOn, velocypack::Builder& output) const {
+    velocypack::Slice input, ComputeValuesOn mustComputeOn,
+    velocypack::Builder& output) const {
   if (mustComputeOn == ComputeValuesOn::kInsert) {
-    mergeComputedAttributes(ctx, _attributesForInsert, trx, input, keysWritten,
-                            output);
+    mergeComputedAttributes(ctx, _attributesForInsert, trx, input, output);
   } else if (mustComputeOn == ComputeValuesOn::kUpdate) {
-    mergeComputedAttributes(ctx, _attributesForUpdate, trx, input, keysWritten,
-                            output);
+    mergeComputedAttributes(ctx, _attributesForUpdate, trx, input, output);
   } else if (mustComputeOn == ComputeValuesOn::kReplace) {
-    mergeComputedAttributes(ctx, _attributesForReplace, trx, input, keysWritten,
-                            output);
+    mergeComputedAttributes(ctx, _attributesForReplace, trx, input, output);
   } else {
     TRI_ASSERT(false);
   }
 }
 
 void ComputedValues::mergeComputedAttributes(
-    aql::ExpressionContext& ctx,
-    containers::FlatHashMap<std::string, std::size_t> const& attributes,
+    aql::ExpressionContext& ctx, Computations const& computations,
     transaction::Methods& trx, velocypack::Slice input,
-    containers::FlatHashSet<std::string_view> const& keysWritten,
     velocypack::Builder& output) const {
+  // only if the document contains attributes that we are going to overwrite
+  // we need to filter the document attributes while copying them
+  bool mustFilter = false;
+  for (auto position : computations.overwriting) {
+    if (input.hasKey(_values[position].name())) {
+      mustFilter = true;
+      break;
+    }
+  }
+
   output.openObject();
 
-  {
-    // copy over document attributes, one by one, in the same
-    // order (the order is important, because we expect _key, _id and _rev
-    // to be at the front)
-    VPackObjectIterator it(input, true);
-
-    while (it.valid()) {
-      // note: key slices can be strings or numbers. they are numbers
-      // for the internal attributes _id, _key, _rev, _from, _to
-      VPackSlice key = it.key(/*translate*/ false);
-      if (key.isNumber()) {
-        // _id, _key, _rev, _from, _to
-        output.addUnchecked(key, it.value());
-      } else {
-        auto itCompute = attributes.find(key.stringView());
-        if (itCompute == attributes.end() ||
-            !_values[itCompute->second].overwrite()) {
-          // only add these attributes from the original document
-          // that we are not going to overwrite
-          output.addUnchecked(key, it.value());
-        }
+  // copy over document attributes, one by one, in the same
+  // order (the order is important, because we expect _key, _id and _rev
+  // to be at the front)
+  for (VPackObjectIterator it(input, true); it.valid(); it.next()) {
+    // note: key slices can be strings or numbers. they are numbers
+    // for the internal attributes _id, _key, _rev, _from, _to
+    VPackSlice key = it.key(/*translate*/ false);
+    if (mustFilter && key.isString()) {
+      auto itCompute = computations.attributes.find(key.stringView());
+      if (itCompute != computations.attributes.end() &&
+          _values[itCompute->second].overwrite()) {
+        // will be replaced by the computed value
+        continue;
       }
-      it.next();
     }
+    output.addUnchecked(key, it.value());
   }
 
-  // now add all the computed attributes
+  // now add all the computed attributes. the expression context is set up
+  // once per batch of documents by the caller, so all we need to do per
+  // document is to bind the temporary variable (@doc)
   auto& cvec = basics::downCast<ComputedValuesExpressionContext>(ctx);
 
-  for (auto const& it : attributes) {
-    auto const& cv = _values[it.second];
-    if (cv.overwrite() || !keysWritten.contains(cv.name())) {
+  for (auto position : computations.positions) {
+    auto const& cv = _values[position];
+    // all attributes of the document are contained in input, so a
+    // non-overwriting computation only has to check for the name there
+    if (cv.overwrite() || !input.hasKey(cv.name())) {
       // update "failOnWarning" flag for each computation
       cvec.failOnWarning(cv.failOnWarning());
       // update "name" vlaue for each computation (for errors/warnings)
       cvec.setName(cv.name());
       // inject document into temporary variable (@doc)
       cvec.setVariable(cv.tempVariable(), input);
+      // the context outlives the document, so the variable must not be
+      // left behind, not even if the computation throws
+      auto guard = scopeGuard(
+          [&]() noexcept { cvec.clearVariable(cv.tempVariable()); });
       // if "computeAttribute" throws, then the operation is
       // intentionally aborted here. caller has to catch the
       // exception
       cv.computeAttribute(cvec, input, output);
-      cvec.clearVariable(cv.tempVariable());
     }
   }
 
@@ -471,17 +490,17 @@ Result ComputedValues::buildDefinitions(TRI_vocbase_t& vocbase,
           mustComputeOn = static_cast<ComputeValuesOn>(
               ::mustComputeOnValue(mustComputeOn) |
               ::mustComputeOnValue(ComputeValuesOn::kInsert));
-          _attributesForInsert.emplace(n, _values.size());
+          _attributesForInsert.add(n, _values.size(), overwrite.getBoolean());
         } else if (ov == "update") {
           mustComputeOn = static_cast<ComputeValuesOn>(
               ::mustComputeOnValue(mustComputeOn) |
               ::mustComputeOnValue(ComputeValuesOn::kUpdate));
-          _attributesForUpdate.emplace(n, _values.size());
+          _attributesForUpdate.add(n, _values.size(), overwrite.getBoolean());
         } else if (ov == "replace") {
           mustComputeOn = static_cast<ComputeValuesOn>(
               ::mustComputeOnValue(mustComputeOn) |
               ::mustComputeOnValue(ComputeValuesOn::kReplace));
-          _attributesForReplace.emplace(n, _values.size());
+          _attributesForReplace.add(n, _values.size(), overwrite.getBoolean());
         } else {
           return {TRI_ERROR_BAD_PARAMETER,
                   absl::StrCat("invalid 'computedValues' entry: invalid "
@@ -500,9 +519,9 @@ Result ComputedValues::buildDefinitions(TRI_vocbase_t& vocbase,
           ::mustComputeOnValue(ComputeValuesOn::kInsert) |
           ::mustComputeOnValue(ComputeValuesOn::kUpdate) |
           ::mustComputeOnValue(ComputeValuesOn::kReplace));
-      _attributesForInsert.emplace(n, _values.size());
-      _attributesForUpdate.emplace(n, _values.size());
-      _attributesForReplace.emplace(n, _values.size());
+      _attributesForInsert.add(n, _values.size(), overwrite.getBoolean());
+      _attributesForUpdate.add(n, _values.size(), overwrite.getBoolean());
+      _attributesForReplace.add(n, _values.size(), overwrite.getBoolean());
     } else {
       return {TRI_ERROR_BAD_PARAMETER,
               "invalid 'computedValues' entry: invalid 'computeOn' value"};
@@ -94,6 +94,9 @@ class ComputedValuesExpressionContext final : public aql::ExpressionContext {
 
   ValidatorBase* buildValidator(velocypack::Slice params) override;
 
+  basics::DateFormatProgram const* buildDateFormat(
+      std::string_view formatString) override;
+
   TRI_vocbase_t& vocbase() const override;
 
   transaction::Methods& trx() const override;
@@ -180,23 +183,42 @@ class ComputedValues {
   bool mustComputeValuesOnUpdate() const noexcept;
   bool mustComputeValuesOnReplace() const noexcept;
 
-  void mergeComputedAttributes(
-      aql::ExpressionContext& ctx, transaction::Methods& trx,
-      velocypack::Slice input,
-      containers::FlatHashSet<std::string_view> const& keysWritten,
-      ComputeValuesOn mustComputeOn, velocypack::Builder& output) const;
+  // builds a new document in output from the attributes of input plus the
+  // computed attributes. input must be the complete document as produced
+  // by the insert/update/replace operation, including system attributes.
+  // intended to be called for every document of a batch with the same
+  // expression context. documents are computed one at a time, because the
+  // callers generate _key and _rev and handle conflicts per document.
+  void mergeComputedAttributes(aql::ExpressionContext& ctx,
+                               transaction::Methods& trx,
+                               velocypack::Slice input,
+                               ComputeValuesOn mustComputeOn,
+                               velocypack::Builder& output) const;
 
   static ResultT<std::shared_ptr<ComputedValues>> buildInstance(
       TRI_vocbase_t& vocbase, std::vector<std::string> const& shardKeys,
       velocypack::Slice computedValues);
 
  private:
-  void mergeComputedAttributes(
-      aql::ExpressionContext& ctx,
-      containers::FlatHashMap<std::string, std::size_t> const& attributes,
-      transaction::Methods& trx, velocypack::Slice input,
-      containers::FlatHashSet<std::string_view> const& keysWritten,
-      velocypack::Builder& output) const;
+  // the computations to run for one type of operation
+  struct Computations {
+    void add(std::string_view name, std::size_t position, bool overwrite);
+    bool empty() const noexcept { return positions.empty(); }
+
+    // the size_t value indiciates the position of the computation inside
+    // the _values vector
+    containers::FlatHashMap<std::string, std::size_t> attributes;
+    // positions of all computations, in the order of their definition
+    std::vector<std::size_t> positions;
+    // positions of the computations that overwrite existing attributes
+    std::vector<std::size_t> overwriting;
+  };
+
+  void mergeComputedAttributes(aql::ExpressionContext& ctx,
+                               Computations const& computations,
+                               transaction::Methods& trx,
+                               velocypack::Slice input,
+                               velocypack::Builder& output) const;
 
   Result buildDefinitions(TRI_vocbase_t& vocbase,
                           std::span<std::string const> shardKeys,
@@ -205,11 +227,9 @@ class ComputedValues {
   // individual instructions for computed values
   std::vector<ComputedValue> _values;
 
-  // the size_t value indiciates the position of the computation inside
-  // the _values vector
-  containers::FlatHashMap<std::string, std::size_t> _attributesForInsert;
-  containers::FlatHashMap<std::string, std::size_t> _attributesForUpdate;
-  containers::FlatHashMap<std::string, std::size_t> _attributesForReplace;
+  Computations _attributesForInsert;
+  Computations _attributesForUpdate;
+  Computations _attributesForReplace;
 };
 
 }  // namespace arangodb
@@ -27,6 +27,7 @@
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
 #include "Aql/QueryString.h"
+#include "Aql/UserFunctionExpression.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
@@ -43,6 +44,7 @@
 #include "V8Server/V8Context.h"
 #include "V8Server/V8DealerFeature.h"
 
+#include <absl/strings/str_cat.h>
 #include <v8.h>
 #include <velocypack/Builder.h>
 #include <velocypack/Iterator.h>
@@ -68,7 +70,8 @@ bool isValidFunctionNameFilter(std::string const& testName) {
   return std::regex_match(testName, funcFilterRegEx);
 }
 
-void reloadAqlUserFunctions(ArangodServer& server) {
+void reloadAqlUserFunctions(TRI_vocbase_t& vocbase) {
+  auto& server = vocbase.server();
   if (server.hasFeature<V8DealerFeature>() &&
       server.isEnabled<V8DealerFeature>() &&
       server.getFeature<V8DealerFeature>().isEnabled()) {
@@ -77,6 +80,127 @@ void reloadAqlUserFunctions(ArangodServer& server) {
   }
 }
 
+/// @brief insert or replace the document of a user function. function is
+/// the definition of an expression function, or a nullptr for JavaScript
+/// functions
+Result storeUserFunction(
+    TRI_vocbase_t& vocbase, VPackSlice document,
+    std::shared_ptr<aql::UserFunctionExpression const> function,
+    bool& replacedExisting) {
+  Result res;
+  {
+    arangodb::OperationOptions opOptions;
+    opOptions.waitForSync = true;
+    opOptions.returnOld = true;
+    opOptions.overwriteMode = OperationOptions::OverwriteMode::Replace;
+
+    // find and load collection given by name or identifier
+    auto ctx = transaction::V8Context::CreateWhenRequired(vocbase, true);
+    SingleCollectionTransaction trx(ctx, StaticStrings::AqlFunctionsCollection,
+                                    AccessMode::Type::WRITE);
+
+    res = trx.begin();
+    if (res.fail()) {
+      return res;
+    }
+
+    arangodb::OperationResult result =
+        trx.insert(StaticStrings::AqlFunctionsCollection, document, opOptions);
+
+    if (result.ok()) {
+      VPackSlice oldSlice = result.slice().get(StaticStrings::Old);
+      replacedExisting = !(oldSlice.isNone() || oldSlice.isNull());
+    }
+    // Will commit if no error occured.
+    // or abort if an error occured.
+    // result stays valid!
+    res = trx.finish(result.result);
+  }
+
+  if (res.ok()) {
+    aql::UserFunctionExpression::update(
+        vocbase, document.get(StaticStrings::KeyString).copyString(),
+        std::move(function));
+    reloadAqlUserFunctions(vocbase);
+  }
+
+  return res;
+}
+
+/// @brief registers a user function with an AQL expression as its body.
+/// such functions do not need V8 when their calls are inlined
+Result registerExpressionFunction(TRI_vocbase_t& vocbase,
+                                  std::string const& name,
+                                  velocypack::Slice userFunction,
+                                  bool& replacedExisting) {
+  auto expression = userFunction.get("expression");
+  if (!expression.isString() || expression.getStringLength() == 0) {
+    return Result(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE,
+                  "expecting string with function expression");
+  }
+
+  std::vector<std::string> parameters;
+  auto params = userFunction.get("params");
+  if (!params.isNone()) {
+    if (!params.isArray()) {
+      return Result(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE,
+                    "expecting array with parameter names");
+    }
+    for (VPackSlice param : VPackArrayIterator(params)) {
+      if (!param.isString()) {
+        return Result(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE,
+                      "expecting array with parameter names");
+      }
+      parameters.emplace_back(param.copyString());
+    }
+  }
+
+  auto function = aql::UserFunctionExpression::create(
+      vocbase, name, parameters, expression.stringView());
+  if (function.fail()) {
+    return function.result();
+  }
+
+  // JavaScript code that evaluates the expression in a query. it is only
+  // used for calls that cannot be inlined into the calling query, and
+  // replaces any code sent by the client. parameter names are alphanumeric
+  // and need no escaping
+  VPackBuilder queryString;
+  queryString.add(VPackValue(
+      absl::StrCat("RETURN (", expression.stringView(), "\n)")));
+  std::string code = absl::StrCat(
+      "(function () { return require('@arangodb').db._query(",
+      queryString.slice().toJson(), ", {");
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    absl::StrAppend(&code, (i == 0 ? "" : ", "), "\"", parameters[i],
+                    "\": arguments[", i, "]");
+  }
+  code.append("}).toArray()[0]; }\n)");
+
+  std::string _key(name);
+  basics::StringUtils::toupperInPlace(_key);
+
+  VPackBuilder oneFunctionDocument;
+  oneFunctionDocument.openObject();
+  oneFunctionDocument.add(StaticStrings::KeyString, VPackValue(_key));
+  oneFunctionDocument.add("name", VPackValue(name));
+  oneFunctionDocument.add("code", VPackValue(code));
+  oneFunctionDocument.add("expression", expression);
+  oneFunctionDocument.add(VPackValue("params"));
+  {
+    VPackArrayBuilder guard(&oneFunctionDocument);
+    for (auto const& param : parameters) {
+      oneFunctionDocument.add(VPackValue(param));
+    }
+  }
+  oneFunctionDocument.add("isDeterministic",
+                          VPackValue(function.get()->isDeterministic()));
+  oneFunctionDocument.close();
+
+  return storeUserFunction(vocbase, oneFunctionDocument.slice(),
+                           std::move(function.get()), replacedExisting);
+}
+
 }  // namespace
 
 Result arangodb::unregisterUserFunction(TRI_vocbase_t& vocbase,
@@ -112,7 +236,8 @@ Result arangodb::unregisterUserFunction(TRI_vocbase_t& vocbase,
   }
 
   if (res.ok()) {
-    reloadAqlUserFunctions(vocbase.server());
+    aql::UserFunctionExpression::update(vocbase, UCFN, nullptr);
+    reloadAqlUserFunctions(vocbase);
   } else if (res.is(TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND)) {
     return res.reset(TRI_ERROR_QUERY_FUNCTION_NOT_FOUND,
                      std::string("no AQL user function with name '") +
@@ -178,7 +303,8 @@ Result arangodb::unregisterUserFunctionsGroup(
     deleteCount = static_cast<int>(countSlice.length());
   }
 
-  reloadAqlUserFunctions(vocbase.server());
+  aql::UserFunctionExpression::removeGroup(vocbase, uc);
+  reloadAqlUserFunctions(vocbase);
   return Result();
 }
 
@@ -189,14 +315,6 @@ Result arangodb::registerUserFunction(TRI_vocbase_t& vocbase,
 
   Result res;
 
-  auto& server = vocbase.server();
-  if (!server.hasFeature<V8DealerFeature>() ||
-      !server.isEnabled<V8DealerFeature>() ||
-      !server.getFeature<V8DealerFeature>().isEnabled()) {
-    return res.reset(TRI_ERROR_DISABLED,
-                     "JavaScript operations are not available");
-  }
-
   std::string name;
 
   try {
@@ -221,6 +339,19 @@ Result arangodb::registerUserFunction(TRI_vocbase_t& vocbase,
                       "' is not a valid name");
   }
 
+  if (!userFunction.get("expression").isNone()) {
+    return registerExpressionFunction(vocbase, name, userFunction,
+                                      replacedExisting);
+  }
+
+  auto& server = vocbase.server();
+  if (!server.hasFeature<V8DealerFeature>() ||
+      !server.isEnabled<V8DealerFeature>() ||
+      !server.getFeature<V8DealerFeature>().isEnabled()) {
+    return res.reset(TRI_ERROR_DISABLED,
+                     "JavaScript operations are not available");
+  }
+
   auto cvString = userFunction.get("code");
   if (!cvString.isString() || cvString.getStringLength() == 0) {
     return Result(TRI_ERROR_QUERY_FUNCTION_INVALID_CODE,
@@ -298,41 +429,8 @@ Result arangodb::registerUserFunction(TRI_vocbase_t& vocbase,
   oneFunctionDocument.add("isDeterministic", VPackValue(isDeterministic));
   oneFunctionDocument.close();
 
-  {
-    arangodb::OperationOptions opOptions;
-    opOptions.waitForSync = true;
-    opOptions.returnOld = true;
-    opOptions.overwriteMode = OperationOptions::OverwriteMode::Replace;
-
-    // find and load collection given by name or identifier
-    auto ctx = transaction::V8Context::CreateWhenRequired(vocbase, true);
-    SingleCollectionTransaction trx(ctx, StaticStrings::AqlFunctionsCollection,
-                                    AccessMode::Type::WRITE);
-
-    res = trx.begin();
-    if (res.fail()) {
-      return res;
-    }
-
-    arangodb::OperationResult result =
-        trx.insert(StaticStrings::AqlFunctionsCollection,
-                   oneFunctionDocument.slice(), opOptions);
-
-    if (result.ok()) {
-      VPackSlice oldSlice = result.slice().get(StaticStrings::Old);
-      replacedExisting = !(oldSlice.isNone() || oldSlice.isNull());
-    }
-    // Will commit if no error occured.
-    // or abort if an error occured.
-    // result stays valid!
-    res = trx.finish(result.result);
-  }
-
-  if (res.ok()) {
-    reloadAqlUserFunctions(vocbase.server());
-  }
-
-  return res;
+  return storeUserFunction(vocbase, oneFunctionDocument.slice(), nullptr,
+                           replacedExisting);
 }
 
 Result arangodb::toArrayUserFunctions(TRI_vocbase_t& vocbase,
@@ -416,6 +514,12 @@ Result arangodb::toArrayUserFunctions(TRI_vocbase_t& vocbase,
       oneFunction.add("name", name);
       oneFunction.add("code", VPackValue(tmp));
       oneFunction.add("isDeterministic", VPackValue(isDeterministic));
+      VPackSlice expression = resolved.get("expression");
+      VPackSlice params = resolved.get("params");
+      if (expression.isString() && params.isArray()) {
+        oneFunction.add("expression", expression);
+        oneFunction.add("params", params);
+      }
       oneFunction.close();
       result.add(oneFunction.slice());
     }
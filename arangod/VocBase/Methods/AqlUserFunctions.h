@@ -65,6 +65,11 @@ Result unregisterUserFunctionsGroup(TRI_vocbase_t& vocbase,
 //    code: the javascript code of the function body
 //    isDeterministic: whether the function will return the same result on same
 //    params
+//  alternatively, the function body can be given as an AQL expression, which
+//  does not need V8 when the function is called from AQL:
+//    expression: the AQL expression, referring to the parameters as bind
+//    parameters, e.g. "@a * @b"
+//    params: the names of the parameters, e.g. ["a", "b"]
 // @param replaceExisting set to true if the function replaced a previously
 // existing one
 // @return result object
@@ -920,7 +920,8 @@ Result Collections::properties(Context& ctxt, VPackBuilder& builder) {
         {StaticStrings::DistributeShardsLike, StaticStrings::IsSmart,
          StaticStrings::NumberOfShards, StaticStrings::ReplicationFactor,
          StaticStrings::MinReplicationFactor, StaticStrings::ShardKeys,
-         StaticStrings::ShardingStrategy, StaticStrings::IsDisjoint});
+         StaticStrings::ShardSplitPoints, StaticStrings::ShardingStrategy,
+         StaticStrings::IsDisjoint});
 
     // this transaction is held longer than the following if...
     auto trx = ctxt.trx(AccessMode::Type::READ, true, false);
@@ -1234,7 +1235,8 @@ arangodb::Result Collections::checksum(LogicalCollection& collection,
     return res.result;
   }
 
-  ResourceMonitor monitor(GlobalResourceMonitor::instance());
+  ResourceMonitor monitor(GlobalResourceMonitor::instance(),
+                          MemorySubsystem::Operations);
 
   auto ctx =
       transaction::V8Context::CreateWhenRequired(collection.vocbase(), true);
@@ -1305,7 +1307,8 @@ arangodb::Result Collections::checksum(LogicalCollection& collection,
       StaticStrings::GraphSmartGraphAttribute, StaticStrings::Schema,          \
       StaticStrings::SmartJoinAttribute, StaticStrings::ReplicationFactor,     \
       StaticStrings::MinReplicationFactor, /* deprecated */                    \
-      StaticStrings::WriteConcern, "servers", StaticStrings::ComputedValues
+      StaticStrings::WriteConcern, "servers", StaticStrings::ComputedValues,   \
+      StaticStrings::ShardSplitPoints
 
 arangodb::velocypack::Builder Collections::filterInput(
     arangodb::velocypack::Slice properties, bool allowDC2DCAttributes) {
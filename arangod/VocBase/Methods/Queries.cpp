@@ -26,6 +26,7 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Aql/Query.h"
 #include "Aql/QueryExecutionState.h"
+#include "Aql/QueryFingerprints.h"
 #include "Aql/QueryList.h"
 #include "Auth/TokenCache.h"
 #include "Basics/Common.h"
@@ -38,6 +39,7 @@
 #include "Network/Methods.h"
 #include "Network/Utils.h"
 #include "RestServer/DatabaseFeature.h"
+#include "RestServer/QueryRegistryFeature.h"
 #include "Utils/ExecContext.h"
 #include "VocBase/vocbase.h"
 
@@ -288,6 +290,43 @@ Result Queries::clearSlow(TRI_vocbase_t& vocbase, bool allDatabases,
   return res;
 }
 
+/// @brief return the execution statistics per query fingerprint
+Result Queries::listStatistics(TRI_vocbase_t& vocbase, velocypack::Builder& out,
+                               bool allDatabases, size_t limit) {
+  Result res = checkAuthorization(vocbase, allDatabases);
+
+  if (res.ok()) {
+    auto const* fingerprints = vocbase.server()
+                                   .getFeature<QueryRegistryFeature>()
+                                   .queryFingerprints();
+    if (fingerprints != nullptr) {
+      fingerprints->toVelocyPack(out, vocbase.name(), allDatabases, limit);
+    } else {
+      // statistics are turned off
+      out.openArray();
+      out.close();
+    }
+  }
+
+  return res;
+}
+
+/// @brief clears the execution statistics per query fingerprint
+Result Queries::clearStatistics(TRI_vocbase_t& vocbase, bool allDatabases) {
+  Result res = checkAuthorization(vocbase, allDatabases);
+
+  if (res.ok()) {
+    auto* fingerprints = vocbase.server()
+                             .getFeature<QueryRegistryFeature>()
+                             .queryFingerprints();
+    if (fingerprints != nullptr) {
+      fingerprints->clear(vocbase.name(), allDatabases);
+    }
+  }
+
+  return res;
+}
+
 /// @brief kills the given query
 Result Queries::kill(TRI_vocbase_t& vocbase, TRI_voc_tick_t id,
                      bool allDatabases) {
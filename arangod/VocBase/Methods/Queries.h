@@ -46,6 +46,14 @@ struct Queries {
   static Result clearSlow(TRI_vocbase_t& vocbase, bool allDatabases,
                           bool fanout);
 
+  /// @brief return the execution statistics per query fingerprint, ordered
+  /// by descending total execution time
+  static Result listStatistics(TRI_vocbase_t& vocbase, velocypack::Builder& out,
+                               bool allDatabases, size_t limit);
+
+  /// @brief clears the execution statistics per query fingerprint
+  static Result clearStatistics(TRI_vocbase_t& vocbase, bool allDatabases);
+
   /// @brief kills the given query
   static Result kill(TRI_vocbase_t& vocbase, TRI_voc_tick_t id,
                      bool allDatabases);
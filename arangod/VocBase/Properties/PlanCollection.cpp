@@ -91,7 +91,7 @@ auto PlanCollection::Invariants::isValidShardingStrategy(
   // Hash is first on purpose (default)
   if (strat == "" || strat == "hash" || strat == "enterprise-hash-smart-edge" ||
       strat == "community-compat" || strat == "enterprise-compat" ||
-      strat == "enterprise-smart-edge-compat") {
+      strat == "enterprise-smart-edge-compat" || strat == "range") {
     return inspection::Status::Success{};
   }
   return {
@@ -153,6 +153,13 @@ arangodb::velocypack::Builder PlanCollection::toCollectionsCreate() {
     attributesToErase.emplace_back(StaticStrings::ShardingStrategy);
   }
 
+  if (builder.slice().hasKey(StaticStrings::ShardSplitPoints) &&
+      builder.slice().get(StaticStrings::ShardSplitPoints).isEmptyArray()) {
+    // TODO: This is a hack to erase the ShardSplitPoints attribute if it was
+    // not set
+    attributesToErase.emplace_back(StaticStrings::ShardSplitPoints);
+  }
+
   if (builder.slice().hasKey(StaticStrings::GraphSmartGraphAttribute) &&
       builder.slice()
           .get(StaticStrings::GraphSmartGraphAttribute)
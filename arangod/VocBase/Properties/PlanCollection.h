@@ -101,6 +101,10 @@ struct PlanCollection {
 
   std::vector<std::string> shardKeys;
 
+  // split points of the shard key ranges, only used with the "range"
+  // sharding strategy
+  arangodb::velocypack::Builder shardSplitPoints;
+
   // TODO: This can be optimized into it's own struct.
   // Did a short_cut here to avoid concatenated changes
   arangodb::velocypack::Builder computedValues;
@@ -185,6 +189,8 @@ auto inspect(Inspector& f, PlanCollection& planCollection) {
               .invariant(PlanCollection::Invariants::isValidShardingStrategy),
           f.field("shardKeys", planCollection.shardKeys)
               .fallback(std::vector<std::string>{StaticStrings::KeyString}),
+          f.field("shardSplitPoints", planCollection.shardSplitPoints)
+              .fallback(VPackSlice::emptyArraySlice()),
           f.field("type", planCollection.type)
               .fallback(TRI_col_type_e::TRI_COL_TYPE_DOCUMENT)
               .invariant(PlanCollection::Invariants::isValidCollectionType),
@@ -26,6 +26,7 @@
 #include "Basics/StaticStrings.h"
 #include "Basics/debugging.h"
 #include "Logger/LogMacros.h"
+#include "VocBase/CompiledSchema.h"
 
 #include <tao/json/contrib/schema.hpp>
 #include <tao/json/jaxn/to_string.hpp>
@@ -232,10 +233,24 @@ ValidatorJsonSchema::ValidatorJsonSchema(VPackSlice params)
     LOG_TOPIC("baabe", ERR, Logger::VALIDATION) << msg;
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_VALIDATION_BAD_PARAMETER, msg);
   }
+  if (_special == validation::SpecialProperties::None) {
+    _compiled = CompiledSchema::compile(_builder.slice());
+  }
 }
 
 Result ValidatorJsonSchema::validateOne(VPackSlice slice,
                                         VPackOptions const* options) const {
+  if (_compiled != nullptr) {
+    switch (_compiled->validate(slice)) {
+      case CompiledSchema::Outcome::kValid:
+        return {};
+      case CompiledSchema::Outcome::kInvalid:
+        return {TRI_ERROR_VALIDATION_FAILED, _message};
+      case CompiledSchema::Outcome::kUnsupported:
+        // document contains values the compiled schema cannot handle
+        break;
+    }
+  }
   auto res = validation::validate(*_schema, _special, slice, options);
   if (res) {
     return {};
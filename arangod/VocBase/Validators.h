@@ -36,6 +36,7 @@ class basic_schema;
 }
 
 namespace arangodb {
+class CompiledSchema;
 
 enum class ValidationLevel {
   None = 0,
@@ -86,6 +87,9 @@ struct ValidatorJsonSchema : public ValidatorBase {
 
  private:
   std::shared_ptr<tao::json::basic_schema<tao::json::traits>> _schema;
+  // the schema compiled for validating velocypack directly. nullptr if the
+  // schema uses features not supported by the compiled validation
+  std::shared_ptr<CompiledSchema const> _compiled;
   VPackBuilder _builder;
 };
 
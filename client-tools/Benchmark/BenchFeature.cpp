@@ -28,6 +28,7 @@
 
 #include "BenchFeature.h"
 
+#include <array>
 #include <ctime>
 #include <fstream>
 #include <iomanip>
@@ -80,6 +81,7 @@ BenchFeature::BenchFeature(Server& server, int* result)
       _realOperations(0),
       _batchSize(0),
       _duration(0),
+      _warmup(0.0),
       _collection("ArangoBenchmark"),
       _testCase("version"),
       _complexity(1),
@@ -96,10 +98,19 @@ BenchFeature::BenchFeature(Server& server, int* result)
       _jsonReportFile(""),
       _replicationFactor(1),
       _numberOfShards(1),
+      _mixedOperations(
+          "read=50,update=20,insert=10,traversal=5,search=5,transaction=10"),
+      _mixedKeys(100000),
+      _mixedDistribution("zipfian"),
+      _mixedZipfianConstant(0.99),
+      _mixedHotspotKeys(0.2),
+      _mixedHotspotAccesses(0.8),
       _result(result),
       _histogramNumIntervals(1000),
       _histogramIntervalSize(0.0),
-      _percentiles({50.0, 80.0, 85.0, 90.0, 95.0, 99.0, 99.99}) {
+      _percentiles({50.0, 80.0, 85.0, 90.0, 95.0, 99.0, 99.99}),
+      _requestRate(0.0),
+      _requestSchedule("poisson") {
   setOptional(false);
   startsAfter<application_features::BasicFeaturePhaseClient>();
 
@@ -114,6 +125,7 @@ BenchFeature::BenchFeature(Server& server, int* result)
   DocumentCrudWriteReadTest::registerTestcase();
   DocumentImportTest::registerTestcase();
   EdgeCrudTest::registerTestcase();
+  MixedWorkloadTest::registerTestcase();
   PersistentIndexTest::registerTestcase();
   VersionTest::registerTestcase();
 }
@@ -153,6 +165,25 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
   options->addOption("--requests", "The total number of operations.",
                      new UInt64Parameter(&_operations));
 
+  options
+      ->addOption("--request-rate",
+                  "The target number of requests per second of all threads "
+                  "(0 = send requests back-to-back). With a target rate, "
+                  "requests are sent on schedule regardless of the response "
+                  "times (open loop), and latencies are measured from the "
+                  "time a request was due.",
+                  new DoubleParameter(&_requestRate))
+      .setIntroducedIn(31100);
+
+  options
+      ->addOption("--request-schedule",
+                  "The distribution of the gaps between requests when a "
+                  "`--request-rate` is set.",
+                  new DiscreteValuesParameter<StringParameter>(
+                      &_requestSchedule,
+                      std::unordered_set<std::string>{"constant", "poisson"}))
+      .setIntroducedIn(31100);
+
   options->addOption(
       "--batch-size",
       "The number of operations in one batch (0 = disable batching)",
@@ -197,6 +228,13 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
                      "fixed test count.",
                      new UInt64Parameter(&_duration));
 
+  options
+      ->addOption("--warmup",
+                  "Send requests for this many seconds before the test "
+                  "starts, without counting or timing them.",
+                  new DoubleParameter(&_warmup))
+      .setIntroducedIn(31100);
+
   std::unordered_set<std::string> cases;
   for (auto& [name, _] : BenchmarkOperation::allBenchmarks()) {
     cases.emplace(name);
@@ -252,6 +290,56 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
           new StringParameter(&_customQueryBindVars))
       .setIntroducedIn(31000);
 
+  options->addSection("mixed", "Configuration of the \"mixed\" test case");
+
+  options
+      ->addOption("--mixed.operations",
+                  "The ratios of the operation types, as comma-separated "
+                  "pairs of operation type and weight. Operation types are "
+                  "read, update, insert, traversal, search and transaction.",
+                  new StringParameter(&_mixedOperations))
+      .setIntroducedIn(31100);
+
+  options
+      ->addOption("--mixed.keys",
+                  "The number of documents created by the set-up, from "
+                  "which the accessed documents are picked.",
+                  new UInt64Parameter(&_mixedKeys))
+      .setIntroducedIn(31100);
+
+  options
+      ->addOption("--mixed.key-distribution",
+                  "How the accessed documents are picked: uniformly, "
+                  "following a (scrambled) Zipfian distribution, or from a "
+                  "hot set of documents which receives most accesses.",
+                  new DiscreteValuesParameter<StringParameter>(
+                      &_mixedDistribution,
+                      std::unordered_set<std::string>{"uniform", "zipfian",
+                                                      "hotspot"}))
+      .setIntroducedIn(31100);
+
+  options
+      ->addOption("--mixed.zipfian-constant",
+                  "The skew of the Zipfian key distribution, between 0 and 1 "
+                  "(exclusive). Larger values concentrate the accesses on "
+                  "fewer documents.",
+                  new DoubleParameter(&_mixedZipfianConstant))
+      .setIntroducedIn(31100);
+
+  options
+      ->addOption("--mixed.hotspot-keys",
+                  "The fraction of documents in the hot set of the hotspot "
+                  "key distribution.",
+                  new DoubleParameter(&_mixedHotspotKeys))
+      .setIntroducedIn(31100);
+
+  options
+      ->addOption("--mixed.hotspot-accesses",
+                  "The fraction of accesses which go to the hot set of the "
+                  "hotspot key distribution.",
+                  new DoubleParameter(&_mixedHotspotAccesses))
+      .setIntroducedIn(31100);
+
   options->addOption("--quiet", "suppress status messages",
                      new BooleanParameter(&_quiet));
 
@@ -281,6 +369,40 @@ void BenchFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
              "'--histogram.generate = true'.";
     }
   }
+  if (_warmup < 0.0) {
+    LOG_TOPIC("e82c5", FATAL, arangodb::Logger::BENCH)
+        << "invalid value for '--warmup': " << _warmup;
+    FATAL_ERROR_EXIT();
+  }
+  if (_testCase == MixedWorkloadTest::name()) {
+    std::array<double, MixedWorkloadTest::NumOperations> weights;
+    std::string error =
+        MixedWorkloadTest::parseOperations(_mixedOperations, weights);
+    if (!error.empty()) {
+      LOG_TOPIC("1f6d8", FATAL, arangodb::Logger::BENCH)
+          << "invalid value for '--mixed.operations': " << error;
+      FATAL_ERROR_EXIT();
+    }
+    if (!(_mixedZipfianConstant > 0.0 && _mixedZipfianConstant < 1.0) ||
+        !(_mixedHotspotKeys > 0.0 && _mixedHotspotKeys <= 1.0) ||
+        !(_mixedHotspotAccesses >= 0.0 && _mixedHotspotAccesses <= 1.0)) {
+      LOG_TOPIC("a5c37", FATAL, arangodb::Logger::BENCH)
+          << "invalid key distribution parameters: '--mixed.zipfian-constant' "
+             "must be between 0 and 1 (exclusive), and the hotspot fractions "
+             "between 0 and 1";
+      FATAL_ERROR_EXIT();
+    }
+  }
+  if (_requestRate < 0.0) {
+    LOG_TOPIC("4e1c7", FATAL, arangodb::Logger::BENCH)
+        << "invalid value for '--request-rate': " << _requestRate;
+    FATAL_ERROR_EXIT();
+  }
+  if (_requestRate > 0.0 && _batchSize > 0) {
+    LOG_TOPIC("9a7d2", INFO, arangodb::Logger::BENCH)
+        << "'--request-rate' is the number of batch requests per second, "
+        << "each containing " << _batchSize << " operations";
+  }
   if (!_customQueryBindVars.empty()) {
     try {
       _customQueryBindVarsBuilder = VPackParser::fromJson(_customQueryBindVars);
@@ -316,13 +438,18 @@ void BenchFeature::setupHistogram(std::stringstream& pp) {
 void BenchFeature::updateStatsValues(
     std::stringstream& pp, VPackBuilder& builder,
     const std::vector<std::unique_ptr<BenchmarkThread>>& threads,
-    BenchmarkStats& totalStats) {
+    BenchmarkStats& totalStats, LatencyHistogram& totalLatencies,
+    std::map<std::string, LatencyHistogram>& operationLatencies) {
   for (size_t i = 0; i < static_cast<size_t>(_threadCount); ++i) {
     if (_duration != 0) {
       _realOperations += threads[i]->_counter;
     }
 
     totalStats.add(threads[i]->stats());
+    totalLatencies.add(threads[i]->latencies());
+    for (auto const& [type, latencies] : threads[i]->operationLatencies()) {
+      operationLatencies[type].add(latencies);
+    }
     if (_generateHistogram) {
       double scope;
       auto res = threads[i]->getPercentiles(_percentiles, scope);
@@ -438,6 +565,8 @@ void BenchFeature::start() {
 
   // aggregated stats for all runs
   BenchmarkStats totalStats;
+  LatencyHistogram totalLatencies;
+  std::map<std::string, LatencyHistogram> operationLatencies;
 
   VPackBuilder builder;
   builder.openObject();
@@ -455,7 +584,7 @@ void BenchFeature::start() {
     double runUntil = 0.0;
 
     if (_duration != 0) {
-      runUntil = TRI_microtime() + _duration;
+      runUntil = TRI_microtime() + _warmup + _duration;
     }
 
     BenchmarkCounter<uint64_t> operationsCounter(0, _operations, runUntil);
@@ -465,11 +594,20 @@ void BenchFeature::start() {
     _started = 0;
 
     for (uint64_t i = 0; i < _threadCount; ++i) {
+      BenchmarkThread::RequestSchedule schedule;
+      if (_requestRate > 0.0) {
+        // each thread sends its share of the requests. the threads start
+        // one average gap apart, so that their requests interleave
+        schedule.rate = _requestRate / _threadCount;
+        schedule.poisson = (_requestSchedule == "poisson");
+        schedule.startDelay = i / _requestRate;
+      }
       auto thread = std::make_unique<BenchmarkThread>(
           server(), benchmark.get(), &startCondition,
           &BenchFeature::updateStartCounter, static_cast<int>(i), _batchSize,
           &operationsCounter, client, _keepAlive, _async,
-          _histogramIntervalSize, _histogramNumIntervals, _generateHistogram);
+          _histogramIntervalSize, _histogramNumIntervals, _generateHistogram,
+          schedule, _warmup);
       thread->setOffset(i * realStep);
       thread->start();
       threads.push_back(std::move(thread));
@@ -485,15 +623,20 @@ void BenchFeature::start() {
       std::this_thread::sleep_for(std::chrono::seconds(10));
     }
 
-    status("executing tests...");
-    double start = TRI_microtime();
-
     // broadcast the start signal to all threads
     {
       CONDITION_LOCKER(guard, startCondition);
       guard.broadcast();
     }
 
+    if (_warmup > 0.0) {
+      status("warming up...");
+      std::this_thread::sleep_for(std::chrono::duration<double>(_warmup));
+    }
+
+    status("executing tests...");
+    double start = TRI_microtime();
+
     uint64_t const stepValue = _operations / 20;
     uint64_t nextReportValue = stepValue;
 
@@ -536,7 +679,8 @@ void BenchFeature::start() {
         requestTime,
     });
 
-    updateStatsValues(pp, builder, threads, totalStats);
+    updateStatsValues(pp, builder, threads, totalStats, totalLatencies,
+                      operationLatencies);
 
     threads.clear();
   }
@@ -551,7 +695,8 @@ void BenchFeature::start() {
               return a._time < b._time;
             });
 
-  report(client, results, totalStats, pp.str(), builder);
+  report(client, results, totalStats, totalLatencies, operationLatencies,
+         pp.str(), builder);
 
   builder.close();
 
@@ -576,6 +721,9 @@ void BenchFeature::start() {
 void BenchFeature::report(ClientFeature& client,
                           std::vector<BenchRunResult> const& results,
                           BenchmarkStats const& stats,
+                          LatencyHistogram const& latencies,
+                          std::map<std::string, LatencyHistogram> const&
+                              operationLatencies,
                           std::string const& histogram, VPackBuilder& builder) {
   if (_generateHistogram) {
     std::cout << histogram << '\n';
@@ -608,6 +756,10 @@ void BenchFeature::report(ClientFeature& client,
   builder.add("complexity", VPackValue(_complexity));
   builder.add("database", VPackValue(client.databaseName()));
   builder.add("collection", VPackValue(_collection));
+  builder.add("requestRate", VPackValue(_requestRate));
+  if (_requestRate > 0.0) {
+    builder.add("requestSchedule", VPackValue(_requestSchedule));
+  }
 
   TRI_ASSERT(
       std::is_sorted(std::begin(results), std::end(results),
@@ -669,11 +821,74 @@ void BenchFeature::report(ClientFeature& client,
   builder.add("avg", VPackValue(stats.avg()));
   builder.add("max", VPackValue(stats.max));
 
+  reportLatencies(latencies, builder);
+  if (!operationLatencies.empty()) {
+    reportOperationLatencies(operationLatencies, builder);
+  }
+
   if (!_junitReportFile.empty()) {
     writeJunitReport(output);
   }
 }
 
+void BenchFeature::reportLatencies(LatencyHistogram const& latencies,
+                                   VPackBuilder& builder) {
+  builder.add(VPackValue("latencies"));
+  latencies.toVelocyPack(builder, _percentiles);
+
+  if (_requestRate <= 0.0) {
+    // in closed-loop mode, the latencies equal the request times reported
+    // above. the percentiles are only part of the JSON report
+    return;
+  }
+
+  std::cout << "Latency percentiles, measured from the time requests were "
+               "due (target rate: "
+            << std::fixed << std::setprecision(2) << _requestRate
+            << " requests/s, schedule: " << _requestSchedule
+            << "):" << std::endl;
+  for (double percentile : _percentiles) {
+    double time = latencies.percentile(percentile);
+    std::cout << std::right << std::fixed << std::setw(9)
+              << std::setprecision(2) << percentile << "%: " << std::setw(12)
+              << std::setprecision(4) << (time * 1000) << "ms" << std::endl;
+  }
+  std::cout << std::setw(10) << "max" << ": " << std::setw(12)
+            << std::setprecision(4) << (latencies.max() * 1000) << "ms"
+            << std::endl
+            << '\n';
+}
+
+void BenchFeature::reportOperationLatencies(
+    std::map<std::string, LatencyHistogram> const& latencies,
+    VPackBuilder& builder) {
+  builder.add("operations", VPackValue(VPackValueType::Object));
+  for (auto const& [type, histogram] : latencies) {
+    builder.add(VPackValue(type));
+    histogram.toVelocyPack(builder, _percentiles);
+  }
+  builder.close();
+
+  std::cout << "Latencies per operation type"
+            << (_requestRate > 0.0 ? " (from the time requests were due)" : "")
+            << ":" << std::endl
+            << std::left << std::setw(14) << "type" << std::right
+            << std::setw(10) << "count" << std::setw(14) << "avg"
+            << std::setw(14) << "p50" << std::setw(14) << "p99"
+            << std::setw(14) << "max" << std::endl;
+  for (auto const& [type, histogram] : latencies) {
+    std::cout << std::left << std::setw(14) << type << std::right
+              << std::setw(10) << histogram.count() << std::fixed
+              << std::setprecision(4);
+    for (double time : {histogram.avg(), histogram.percentile(50.0),
+                        histogram.percentile(99.0), histogram.max()}) {
+      std::cout << std::setw(12) << (time * 1000) << "ms";
+    }
+    std::cout << std::endl;
+  }
+  std::cout << '\n';
+}
+
 bool BenchFeature::writeJunitReport(BenchRunResult const& result) {
   std::ofstream outfile(_junitReportFile, std::ofstream::binary);
   if (!outfile.is_open()) {
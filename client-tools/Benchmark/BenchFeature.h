@@ -24,11 +24,13 @@
 #pragma once
 
 #include <atomic>
+#include <map>
 
 #include "ApplicationFeatures/ApplicationFeature.h"
 #include "Benchmark/arangobench.h"
 #include "Benchmark/BenchmarkThread.h"
 #include "Benchmark/BenchmarkStats.h"
+#include "Benchmark/LatencyHistogram.h"
 
 namespace arangodb {
 namespace arangobench {
@@ -87,11 +89,26 @@ class BenchFeature final : public ArangoBenchFeature {
     return _customQueryBindVarsBuilder;
   }
 
+  std::string const& mixedOperations() const { return _mixedOperations; }
+  uint64_t mixedKeys() const { return _mixedKeys; }
+  std::string const& mixedDistribution() const { return _mixedDistribution; }
+  double mixedZipfianConstant() const { return _mixedZipfianConstant; }
+  double mixedHotspotKeys() const { return _mixedHotspotKeys; }
+  double mixedHotspotAccesses() const { return _mixedHotspotAccesses; }
+
  private:
   void status(std::string const& value);
   void report(ClientFeature& client, std::vector<BenchRunResult> const& results,
               arangobench::BenchmarkStats const& stats,
+              arangobench::LatencyHistogram const& latencies,
+              std::map<std::string, arangobench::LatencyHistogram> const&
+                  operationLatencies,
               std::string const& histogram, VPackBuilder& builder);
+  void reportLatencies(arangobench::LatencyHistogram const& latencies,
+                       VPackBuilder& builder);
+  void reportOperationLatencies(
+      std::map<std::string, arangobench::LatencyHistogram> const& latencies,
+      VPackBuilder& builder);
   void printResult(BenchRunResult const& result, VPackBuilder& builder);
   bool writeJunitReport(BenchRunResult const& result);
   void setupHistogram(std::stringstream& pp);
@@ -100,13 +117,17 @@ class BenchFeature final : public ArangoBenchFeature {
       std::vector<
           std::unique_ptr<arangodb::arangobench::BenchmarkThread>> const&
           threads,
-      arangodb::arangobench::BenchmarkStats& totalStats);
+      arangodb::arangobench::BenchmarkStats& totalStats,
+      arangodb::arangobench::LatencyHistogram& totalLatencies,
+      std::map<std::string, arangodb::arangobench::LatencyHistogram>&
+          operationLatencies);
 
   uint64_t _threadCount;
   uint64_t _operations;
   uint64_t _realOperations;
   uint64_t _batchSize;
   uint64_t _duration;
+  double _warmup;
   std::string _collection;
   std::string _testCase;
   uint64_t _complexity;
@@ -131,12 +152,24 @@ class BenchFeature final : public ArangoBenchFeature {
   std::string _customQueryBindVars;
   std::shared_ptr<VPackBuilder> _customQueryBindVarsBuilder;
 
+  std::string _mixedOperations;
+  uint64_t _mixedKeys;
+  std::string _mixedDistribution;
+  double _mixedZipfianConstant;
+  double _mixedHotspotKeys;
+  double _mixedHotspotAccesses;
+
   int* _result;
 
   uint64_t _histogramNumIntervals;
   double _histogramIntervalSize;
   std::vector<double> _percentiles;
 
+  /// @brief target number of requests per second of all threads in
+  /// open-loop mode. 0 means closed loop
+  double _requestRate;
+  std::string _requestSchedule;
+
   static void updateStartCounter();
   static int getStartCounter();
 
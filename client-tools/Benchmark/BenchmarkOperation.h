@@ -27,6 +27,7 @@
 
 #include <map>
 #include <memory>
+#include <string_view>
 
 #include <velocypack/Builder.h>
 #include <velocypack/Options.h>
@@ -45,11 +46,16 @@ struct BenchmarkOperation {
     arangodb::rest::RequestType type;
     arangodb::velocypack::Options options;
     arangodb::velocypack::Builder payload;
+    /// @brief name of the kind of operation, for test cases which mix
+    /// different operations. latencies are additionally reported per
+    /// operation type if set. must refer to a string with static lifetime
+    std::string_view operationType;
 
     void clear() {
       url.clear();
       payload.clear();
       type = arangodb::rest::RequestType::ILLEGAL;
+      operationType = {};
     }
   };
 
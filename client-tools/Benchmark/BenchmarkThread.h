@@ -23,9 +23,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <memory>
+#include <random>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <shared_mutex>
 
@@ -42,6 +48,7 @@
 #include "Benchmark/BenchmarkCounter.h"
 #include "Benchmark/BenchmarkOperation.h"
 #include "Benchmark/BenchmarkStats.h"
+#include "Benchmark/LatencyHistogram.h"
 #include "Logger/LogMacros.h"
 #include "Logger/Logger.h"
 #include "Logger/LoggerStream.h"
@@ -60,7 +67,21 @@ namespace arangodb {
 namespace arangobench {
 
 class BenchmarkThread : public arangodb::Thread {
+  using Clock = std::chrono::steady_clock;
+
  public:
+  /// @brief schedule of the requests in open-loop mode
+  struct RequestSchedule {
+    /// @brief requests per second sent by this thread. 0 means that requests
+    /// are sent back-to-back (closed loop)
+    double rate = 0.0;
+    /// @brief exponentially distributed gaps between requests instead of
+    /// constant ones
+    bool poisson = false;
+    /// @brief delay of the first request, to interleave the threads
+    double startDelay = 0.0;
+  };
+
   BenchmarkThread(application_features::ApplicationServer& server,
                   BenchmarkOperation* operation,
                   basics::ConditionVariable* condition, void (*callback)(),
@@ -68,7 +89,8 @@ class BenchmarkThread : public arangodb::Thread {
                   BenchmarkCounter<uint64_t>* operationsCounter,
                   ClientFeature& client, bool keepAlive, bool async,
                   double histogramIntervalSize, uint64_t histogramNumIntervals,
-                  bool generateHistogram)
+                  bool generateHistogram, RequestSchedule schedule,
+                  double warmup)
       : Thread(server, "BenchmarkThread"),
         _operation(operation),
         _startCondition(condition),
@@ -87,6 +109,11 @@ class BenchmarkThread : public arangodb::Thread {
         _generateHistogram(generateHistogram),
         _httpClient(nullptr),
         _offset(0),
+        _schedule(schedule),
+        _random(threadNumber + std::random_device{}()),
+        _warmup(warmup),
+        _warmupUntil(0.0),
+        _warmingUp(false),
         _counter(0),
         _histogramNumIntervals(histogramNumIntervals),
         _histogramIntervalSize(histogramIntervalSize),
@@ -95,9 +122,32 @@ class BenchmarkThread : public arangodb::Thread {
 
   ~BenchmarkThread() { shutdown(); }
 
-  void trackTime(double time) {
+  void trackTime(double time, std::string_view operationType) {
+    if (_warmingUp) {
+      return;
+    }
+
+    double latency = time;
+    if (_schedule.rate > 0.0) {
+      // measure from the time the request was due, so that the time spent
+      // waiting for previous, slow responses is included (no coordinated
+      // omission)
+      latency = std::chrono::duration<double>(Clock::now() - _due).count();
+    }
+
     std::lock_guard lock{_mutex};
     _stats.track(time);
+    _latencies.track(latency);
+    if (!operationType.empty()) {
+      auto it = std::find_if(
+          _operationLatencies.begin(), _operationLatencies.end(),
+          [&](auto const& entry) { return entry.first == operationType; });
+      if (it == _operationLatencies.end()) {
+        it = _operationLatencies.emplace(_operationLatencies.end(),
+                                         operationType, LatencyHistogram());
+      }
+      it->second.track(latency);
+    }
     if (_generateHistogram) {
       if (_histogramScope == 0.0) {
         _histogramScope = time * 20;
@@ -155,6 +205,19 @@ class BenchmarkThread : public arangodb::Thread {
     return _stats;
   }
 
+  // return a copy of the thread's latency histogram
+  LatencyHistogram latencies() const {
+    std::shared_lock lock{_mutex};
+    return _latencies;
+  }
+
+  // return a copy of the thread's latency histograms per operation type
+  std::vector<std::pair<std::string, LatencyHistogram>> operationLatencies()
+      const {
+    std::shared_lock lock{_mutex};
+    return _operationLatencies;
+  }
+
  protected:
   void run() override {
     try {
@@ -208,13 +271,30 @@ class BenchmarkThread : public arangodb::Thread {
       guard.wait();
     }
 
+    if (_schedule.rate > 0.0) {
+      _due = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                std::chrono::duration<double>(
+                                    _schedule.startDelay));
+    }
+    if (_warmup > 0.0) {
+      _warmupUntil = TRI_microtime() + _warmup;
+    }
+
     while (!isStopping()) {
-      uint64_t numOps = _operationsCounter->next(_batchSize);
+      // requests during the warm-up are neither counted nor timed
+      _warmingUp = (_warmupUntil != 0.0 && TRI_microtime() < _warmupUntil);
+
+      uint64_t numOps = _warmingUp ? std::max<uint64_t>(_batchSize, 1)
+                                   : _operationsCounter->next(_batchSize);
 
       if (numOps == 0) {
         break;
       }
 
+      if (_schedule.rate > 0.0 && !waitUntilDue()) {
+        break;
+      }
+
       try {
         if (_batchSize < 1) {
           executeSingleRequest();
@@ -235,11 +315,48 @@ class BenchmarkThread : public arangodb::Thread {
         FATAL_ERROR_EXIT();
       }
 
-      _operationsCounter->done(_batchSize > 0 ? _batchSize : 1);
+      if (!_warmingUp) {
+        _operationsCounter->done(_batchSize > 0 ? _batchSize : 1);
+      }
+
+      if (_schedule.rate > 0.0) {
+        _due += nextInterval();
+      }
     }
   }
 
  private:
+  /// @brief sleep until the next request is due. if the thread is behind
+  /// schedule, the request is sent immediately. returns false if the thread
+  /// is stopped while waiting
+  bool waitUntilDue() {
+    while (true) {
+      auto now = Clock::now();
+      if (now >= _due) {
+        return true;
+      }
+      if (isStopping()) {
+        return false;
+      }
+      // wake up regularly, so that a stopped thread does not wait for the
+      // rest of a long gap between requests
+      std::this_thread::sleep_for(std::min<Clock::duration>(
+          _due - now, std::chrono::milliseconds(100)));
+    }
+  }
+
+  /// @brief the gap between the current and the next request
+  Clock::duration nextInterval() {
+    double seconds;
+    if (_schedule.poisson) {
+      seconds = std::exponential_distribution<double>(_schedule.rate)(_random);
+    } else {
+      seconds = 1.0 / _schedule.rate;
+    }
+    return std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(seconds));
+  }
+
   /// @brief request location rewriter (injects database name)
   static std::string rewriteLocation(void* data, std::string const& location) {
     auto t = static_cast<arangobench::BenchmarkThread*>(data);
@@ -316,7 +433,8 @@ class BenchmarkThread : public arangodb::Thread {
         _payloadBuffer.size(), _headers));
 
     double delta = TRI_microtime() - start;
-    trackTime(delta);
+    // a batch mixes operations, so it is not attributed to an operation type
+    trackTime(delta, {});
     processResponse(result.get(), /*batch*/ true, numOperations);
 
     _httpClient->recycleResult(std::move(result));
@@ -358,7 +476,7 @@ class BenchmarkThread : public arangodb::Thread {
     std::unique_ptr<httpclient::SimpleHttpResult> result(_httpClient->request(
         _requestData.type, _requestData.url, p, length, _headers));
     double delta = TRI_microtime() - start;
-    trackTime(delta);
+    trackTime(delta, _requestData.operationType);
     processResponse(result.get(), /*batch*/ false, 1);
 
     _httpClient->recycleResult(std::move(result));
@@ -475,6 +593,31 @@ class BenchmarkThread : public arangodb::Thread {
   /// @brief statistics for the thread
   BenchmarkStats _stats;
 
+  /// @brief latencies of the requests, measured from the time they were due
+  /// in open-loop mode
+  LatencyHistogram _latencies;
+
+  /// @brief request schedule in open-loop mode
+  RequestSchedule const _schedule;
+
+  /// @brief time at which the current request is due in open-loop mode
+  Clock::time_point _due;
+
+  /// @brief random generator for the poisson schedule
+  std::mt19937_64 _random;
+
+  /// @brief latencies per operation type, for test cases which set it
+  std::vector<std::pair<std::string, LatencyHistogram>> _operationLatencies;
+
+  /// @brief duration of the warm-up phase, in seconds
+  double const _warmup;
+
+  /// @brief end of the warm-up phase
+  double _warmupUntil;
+
+  /// @brief whether the current request is part of the warm-up
+  bool _warmingUp;
+
  public:
   /// @brief thread counter value
   uint64_t _counter;
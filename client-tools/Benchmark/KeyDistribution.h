@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string_view>
+
+#include "Basics/debugging.h"
+
+namespace arangodb::arangobench {
+
+/// @brief distribution of accessed keys, which are numbered from 0 to n - 1
+class KeyDistribution {
+ public:
+  enum class Type { Uniform, Zipfian, Hotspot };
+
+  KeyDistribution(Type type, uint64_t n, double zipfianConstant,
+                  double hotspotKeys, double hotspotAccesses)
+      : _type(type),
+        _n(std::max<uint64_t>(n, 1)),
+        _theta(zipfianConstant),
+        _zetan(0.0),
+        _alpha(0.0),
+        _eta(0.0),
+        _hotKeys(std::clamp<uint64_t>(
+            static_cast<uint64_t>(std::llround(hotspotKeys * _n)), 1, _n)),
+        _hotAccesses(hotspotAccesses) {
+    if (_type == Type::Zipfian) {
+      // constants of the generator described by Gray et al., "Quickly
+      // generating billion-record synthetic databases", as used by YCSB
+      for (uint64_t i = 1; i <= _n; ++i) {
+        _zetan += 1.0 / std::pow(static_cast<double>(i), _theta);
+      }
+      double zeta2 = 1.0 + std::pow(0.5, _theta);
+      _alpha = 1.0 / (1.0 - _theta);
+      _eta = (1.0 - std::pow(2.0 / _n, 1.0 - _theta)) / (1.0 - zeta2 / _zetan);
+    }
+  }
+
+  static Type typeFromString(std::string_view value) {
+    if (value == "zipfian") {
+      return Type::Zipfian;
+    } else if (value == "hotspot") {
+      return Type::Hotspot;
+    }
+    TRI_ASSERT(value == "uniform");
+    return Type::Uniform;
+  }
+
+  /// @brief map two independent, uniformly distributed values from [0, 1)
+  /// to a key
+  uint64_t key(double u, double v) const noexcept {
+    switch (_type) {
+      case Type::Zipfian: {
+        uint64_t rank;
+        double uz = u * _zetan;
+        if (uz < 1.0) {
+          rank = 0;
+        } else if (uz < 1.0 + std::pow(0.5, _theta)) {
+          rank = 1;
+        } else {
+          rank = static_cast<uint64_t>(_n *
+                                       std::pow(_eta * u - _eta + 1, _alpha));
+        }
+        // scatter the popular keys over the key range, so that they do not
+        // end up next to each other in the same shard or block
+        return hash(std::min(rank, _n - 1)) % _n;
+      }
+      case Type::Hotspot: {
+        if (u < _hotAccesses || _hotKeys == _n) {
+          return scale(v, _hotKeys);
+        }
+        return _hotKeys + scale(v, _n - _hotKeys);
+      }
+      case Type::Uniform:
+        break;
+    }
+    return scale(u, _n);
+  }
+
+  /// @brief a well-mixing 64-bit hash (the splitmix64 finalizer)
+  static uint64_t hash(uint64_t x) noexcept {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  /// @brief a uniformly distributed value from [0, 1), derived from x
+  static double uniform(uint64_t x) noexcept {
+    return static_cast<double>(hash(x) >> 11) * 0x1.0p-53;
+  }
+
+ private:
+  static uint64_t scale(double u, uint64_t n) noexcept {
+    return std::min(static_cast<uint64_t>(u * n), n - 1);
+  }
+
+  Type const _type;
+  uint64_t const _n;
+  double const _theta;
+  double _zetan;
+  double _alpha;
+  double _eta;
+  uint64_t const _hotKeys;
+  double const _hotAccesses;
+};
+
+}  // namespace arangodb::arangobench
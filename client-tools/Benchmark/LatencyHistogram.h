@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <velocypack/Builder.h>
+#include <velocypack/Value.h>
+
+namespace arangodb::arangobench {
+
+/// @brief latency histogram with log-linear buckets, in the style of
+/// HdrHistogram. values are recorded in microseconds. values below
+/// 2^(subBucketBits + 1) get a bucket each, larger values share buckets
+/// whose width is at most 1/2^subBucketBits of the values they contain.
+/// thus percentiles have a relative error of below 1%, regardless of the
+/// range of the recorded values, and histograms can be merged exactly.
+class LatencyHistogram {
+ public:
+  static constexpr unsigned subBucketBits = 7;
+  /// @brief larger values (about 19 hours) are recorded as this value
+  static constexpr uint64_t maxValue = (uint64_t(1) << 36) - 1;
+
+  LatencyHistogram()
+      : _counts(indexOf(maxValue) + 1, 0),
+        _count(0),
+        _min(std::numeric_limits<uint64_t>::max()),
+        _max(0),
+        _total(0) {}
+
+  /// @brief record a latency, given in seconds
+  void track(double seconds) noexcept {
+    uint64_t value = 0;
+    if (seconds > 0.0) {
+      value = static_cast<uint64_t>(
+          std::min(seconds * 1.0e6, static_cast<double>(maxValue)));
+    }
+    ++_counts[indexOf(value)];
+    ++_count;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+    _total += value;
+  }
+
+  void add(LatencyHistogram const& other) noexcept {
+    for (size_t i = 0; i < _counts.size(); ++i) {
+      _counts[i] += other._counts[i];
+    }
+    _count += other._count;
+    _min = std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+    _total += other._total;
+  }
+
+  uint64_t count() const noexcept { return _count; }
+
+  double min() const noexcept { return _count == 0 ? 0.0 : _min / 1.0e6; }
+  double max() const noexcept { return _max / 1.0e6; }
+  double avg() const noexcept {
+    return _count == 0 ? 0.0 : static_cast<double>(_total) / _count / 1.0e6;
+  }
+
+  /// @brief the latency (in seconds) which the given percentage of recorded
+  /// values does not exceed. this is the upper bound of the bucket holding
+  /// the value of that rank
+  double percentile(double percent) const noexcept {
+    if (_count == 0) {
+      return 0.0;
+    }
+    uint64_t rank = static_cast<uint64_t>(
+        std::ceil(percent / 100.0 * static_cast<double>(_count)));
+    rank = std::clamp<uint64_t>(rank, 1, _count);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < _counts.size(); ++i) {
+      seen += _counts[i];
+      if (seen >= rank) {
+        return std::min(highestValueOf(i), _max) / 1.0e6;
+      }
+    }
+    return max();
+  }
+
+  /// @brief write the summary, the requested percentiles and all non-empty
+  /// buckets as pairs of [upper bound in microseconds, count], so that the
+  /// distributions of different runs can be compared
+  void toVelocyPack(velocypack::Builder& builder,
+                    std::vector<double> const& percentiles) const {
+    builder.openObject();
+    builder.add("count", VPackValue(_count));
+    builder.add("min", VPackValue(min()));
+    builder.add("avg", VPackValue(avg()));
+    builder.add("max", VPackValue(max()));
+    builder.add("percentiles", VPackValue(VPackValueType::Object));
+    for (double p : percentiles) {
+      builder.add(std::to_string(p), VPackValue(percentile(p)));
+    }
+    builder.close();
+    builder.add("buckets", VPackValue(VPackValueType::Array));
+    for (size_t i = 0; i < _counts.size(); ++i) {
+      if (_counts[i] != 0) {
+        builder.openArray();
+        builder.add(VPackValue(highestValueOf(i)));
+        builder.add(VPackValue(_counts[i]));
+        builder.close();
+      }
+    }
+    builder.close();
+    builder.close();
+  }
+
+ private:
+  static size_t indexOf(uint64_t value) noexcept {
+    unsigned const width = static_cast<unsigned>(std::bit_width(value));
+    unsigned shift = 0;
+    if (width > subBucketBits + 1) {
+      shift = width - subBucketBits - 1;
+    }
+    return (size_t(shift) << subBucketBits) + (value >> shift);
+  }
+
+  static uint64_t highestValueOf(size_t index) noexcept {
+    if (index < (size_t(2) << subBucketBits)) {
+      return index;
+    }
+    unsigned const shift = static_cast<unsigned>(index >> subBucketBits) - 1;
+    uint64_t const top = index - (size_t(shift) << subBucketBits);
+    return ((top + 1) << shift) - 1;
+  }
+
+  std::vector<uint64_t> _counts;
+  uint64_t _count;
+  uint64_t _min;
+  uint64_t _max;
+  uint64_t _total;
+};
+
+}  // namespace arangodb::arangobench
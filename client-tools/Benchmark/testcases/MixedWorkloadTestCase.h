@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Benchmark.h"
+#include "helpers.h"
+
+#include "Basics/StringUtils.h"
+#include "Basics/debugging.h"
+#include "Benchmark/KeyDistribution.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Value.h>
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+
+namespace arangodb::arangobench {
+
+struct MixedWorkloadTest : public Benchmark<MixedWorkloadTest> {
+  static std::string name() { return "mixed"; }
+
+  enum Operation : size_t {
+    Read = 0,
+    Update,
+    Insert,
+    Traversal,
+    Search,
+    Transaction,
+    NumOperations
+  };
+
+  static constexpr std::array<std::string_view, NumOperations> operationNames{
+      "read", "update", "insert", "traversal", "search", "transaction"};
+
+  /// @brief number of distinct words in the text attribute of documents
+  static constexpr uint64_t vocabularySize = 1000;
+
+  /// @brief parse operation ratios such as "read=80,update=20" into weights.
+  /// returns an error message if the value is invalid
+  static std::string parseOperations(
+      std::string const& value, std::array<double, NumOperations>& weights) {
+    weights.fill(0.0);
+    double sum = 0.0;
+    for (auto const& part : basics::StringUtils::split(value, ',')) {
+      auto pair = basics::StringUtils::split(part, '=');
+      auto it = operationNames.end();
+      if (pair.size() == 2) {
+        it = std::find(operationNames.begin(), operationNames.end(),
+                       basics::StringUtils::trim(pair[0]));
+      }
+      if (it == operationNames.end()) {
+        return "invalid operation '" + part + "', expecting one of " +
+               "read, update, insert, traversal, search, transaction, " +
+               "followed by '=' and a weight";
+      }
+      double weight = basics::StringUtils::doubleDecimal(pair[1]);
+      if (!(weight >= 0.0)) {
+        return "invalid weight for operation '" + part + "'";
+      }
+      weights[it - operationNames.begin()] = weight;
+      sum += weight;
+    }
+    if (sum <= 0.0) {
+      return "the sum of the operation weights must be positive";
+    }
+    return {};
+  }
+
+  MixedWorkloadTest(BenchFeature& arangobench)
+      : Benchmark<MixedWorkloadTest>(arangobench),
+        _numKeys(std::max<uint64_t>(arangobench.mixedKeys(), 1)),
+        _keys(KeyDistribution::typeFromString(arangobench.mixedDistribution()),
+              _numKeys, arangobench.mixedZipfianConstant(),
+              arangobench.mixedHotspotKeys(),
+              arangobench.mixedHotspotAccesses()),
+        _edgeCollection(arangobench.collection() + "_edges"),
+        _view(arangobench.collection() + "_view") {
+    std::array<double, NumOperations> weights;
+    [[maybe_unused]] std::string error =
+        parseOperations(arangobench.mixedOperations(), weights);
+    // already validated by BenchFeature
+    TRI_ASSERT(error.empty());
+    double sum = 0.0;
+    for (size_t i = 0; i < NumOperations; ++i) {
+      sum += weights[i];
+      _thresholds[i] = sum;
+    }
+    for (auto& threshold : _thresholds) {
+      threshold /= sum;
+    }
+  }
+
+  bool setUp(arangodb::httpclient::SimpleHttpClient* client) override {
+    if (!_arangobench.createCollection()) {
+      // use the existing data
+      return true;
+    }
+
+    std::string const& collection = _arangobench.collection();
+    if (!DeleteView(client, _view) ||
+        !DeleteCollection(client, _edgeCollection) ||
+        !DeleteCollection(client, collection) ||
+        !CreateCollection(client, collection, 2, _arangobench) ||
+        !CreateCollection(client, _edgeCollection, 3, _arangobench)) {
+      return false;
+    }
+
+    // documents with a few words of text, each with two outgoing edges to
+    // documents picked by the key distribution, so that traversals visit
+    // popular documents more often, too
+    constexpr size_t batchSize = 4 * 1024 * 1024;
+    std::string documents;
+    std::string edges;
+    for (uint64_t i = 0; i < _numKeys; ++i) {
+      documents.append("{\"_key\":\"").append(key(i));
+      documents.append("\",\"value\":").append(std::to_string(i));
+      documents.append(",\"text\":\"").append(text(i)).append("\"}\n");
+
+      for (uint64_t j = 0; j < 2; ++j) {
+        edges.append("{\"_from\":\"").append(collection).append("/");
+        edges.append(key(i)).append("\",\"_to\":\"").append(collection);
+        edges.append("/").append(key(randomKey(i * 2 + j, 0)));
+        edges.append("\"}\n");
+      }
+
+      if (documents.size() >= batchSize || i + 1 == _numKeys) {
+        if (!ImportDocuments(client, collection, documents) ||
+            !ImportDocuments(client, _edgeCollection, edges)) {
+          return false;
+        }
+        documents.clear();
+        edges.clear();
+      }
+    }
+
+    return CreateView(client, "{\"name\":\"" + _view +
+                                  "\",\"type\":\"arangosearch\","
+                                  "\"links\":{\"" +
+                                  collection +
+                                  "\":{\"fields\":{\"text\":{"
+                                  "\"analyzers\":[\"text_en\"]}}}}}");
+  }
+
+  void tearDown() override {}
+
+  void buildRequest(
+      size_t threadNumber, size_t threadCounter, size_t globalCounter,
+      BenchmarkOperation::RequestData& requestData) const override {
+    // all random choices are derived from the global counter, so that
+    // requests can be built concurrently without shared state
+    double u = KeyDistribution::uniform(KeyDistribution::hash(globalCounter));
+    size_t op = 0;
+    while (op + 1 < NumOperations && u >= _thresholds[op]) {
+      ++op;
+    }
+    requestData.operationType = operationNames[op];
+
+    std::string const& collection = _arangobench.collection();
+    using namespace arangodb::velocypack;
+
+    switch (op) {
+      case Read:
+        requestData.url = "/_api/document/" + collection + "/" +
+                          key(randomKey(globalCounter, 1));
+        requestData.type = rest::RequestType::GET;
+        break;
+
+      case Update:
+        requestData.url = "/_api/document/" + collection + "/" +
+                          key(randomKey(globalCounter, 1)) + "?silent=true";
+        requestData.type = rest::RequestType::PATCH;
+        requestData.payload.openObject();
+        requestData.payload.add("value", Value(globalCounter));
+        requestData.payload.close();
+        break;
+
+      case Insert:
+        // the server generates the keys, so that inserted documents never
+        // clash with each other or with the initial documents
+        requestData.url =
+            "/_api/document?collection=" + collection + "&silent=true";
+        requestData.type = rest::RequestType::POST;
+        requestData.payload.openObject();
+        requestData.payload.add("value", Value(globalCounter));
+        requestData.payload.add("text", Value(text(globalCounter)));
+        requestData.payload.close();
+        break;
+
+      case Traversal:
+        buildQuery(requestData,
+                   "FOR v IN 1..2 OUTBOUND @start @@edges RETURN v._key");
+        requestData.payload.add("bindVars", Value(ValueType::Object));
+        requestData.payload.add(
+            "start",
+            Value(collection + "/" + key(randomKey(globalCounter, 1))));
+        requestData.payload.add("@edges", Value(_edgeCollection));
+        requestData.payload.close();
+        requestData.payload.close();
+        break;
+
+      case Search:
+        buildQuery(requestData,
+                   "FOR d IN @@view SEARCH ANALYZER(d.text IN TOKENS(@word, "
+                   "'text_en'), 'text_en') LIMIT 10 RETURN d._key");
+        requestData.payload.add("bindVars", Value(ValueType::Object));
+        requestData.payload.add("@view", Value(_view));
+        requestData.payload.add(
+            "word", Value(word(randomKey(globalCounter, 1) % vocabularySize)));
+        requestData.payload.close();
+        requestData.payload.close();
+        break;
+
+      case Transaction: {
+        // a single AQL query updating several documents atomically
+        buildQuery(requestData,
+                   "FOR k IN @keys UPDATE k WITH { value: @value } IN "
+                   "@@collection");
+        requestData.payload.add("bindVars", Value(ValueType::Object));
+        requestData.payload.add("keys", Value(ValueType::Array));
+        uint64_t n = std::max<uint64_t>(_arangobench.complexity(), 2);
+        for (uint64_t i = 0; i < n; ++i) {
+          requestData.payload.add(
+              Value(key(randomKey(globalCounter, 1 + i))));
+        }
+        requestData.payload.close();
+        requestData.payload.add("value", Value(globalCounter));
+        requestData.payload.add("@collection", Value(collection));
+        requestData.payload.close();
+        requestData.payload.close();
+        break;
+      }
+    }
+  }
+
+  char const* getDescription() const noexcept override {
+    return "will perform a mix of document reads, updates and inserts, graph "
+           "traversals, ArangoSearch queries and multi-document transactions "
+           "(AQL updates), in the ratios given by --mixed.operations. The "
+           "set-up creates --mixed.keys documents with two outgoing edges "
+           "each in an edge collection named like --collection with suffix "
+           "'_edges', and an arangosearch view with suffix '_view'. The "
+           "accessed documents are picked with the distribution given by "
+           "--mixed.key-distribution. The --complexity parameter controls the "
+           "number of documents updated per transaction (at least 2). "
+           "Latencies are reported per operation type.";
+  }
+
+  bool isDeprecated() const noexcept override { return false; }
+
+ private:
+  static std::string key(uint64_t i) { return "k" + std::to_string(i); }
+
+  static std::string word(uint64_t i) { return "w" + std::to_string(i); }
+
+  /// @brief text of a few words, derived from i
+  static std::string text(uint64_t i) {
+    std::string result;
+    for (uint64_t j = 0; j < 8; ++j) {
+      if (j > 0) {
+        result.push_back(' ');
+      }
+      result.append(
+          word(KeyDistribution::hash(i * 8 + j + 1) % vocabularySize));
+    }
+    return result;
+  }
+
+  /// @brief the stream-th random key of the request with the given counter
+  uint64_t randomKey(uint64_t counter, uint64_t stream) const noexcept {
+    uint64_t base = KeyDistribution::hash(counter) + 2 * stream;
+    return _keys.key(KeyDistribution::uniform(base),
+                     KeyDistribution::uniform(base + 1));
+  }
+
+  static void buildQuery(BenchmarkOperation::RequestData& requestData,
+                         char const* query) {
+    requestData.url = "/_api/cursor";
+    requestData.type = rest::RequestType::POST;
+    requestData.payload.openObject();
+    requestData.payload.add("query", velocypack::Value(query));
+  }
+
+  uint64_t const _numKeys;
+  KeyDistribution const _keys;
+  std::string const _edgeCollection;
+  std::string const _view;
+  /// @brief cumulative, normalized operation weights
+  std::array<double, NumOperations> _thresholds;
+};
+
+}  // namespace arangodb::arangobench
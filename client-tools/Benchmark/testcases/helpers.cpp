@@ -150,4 +150,85 @@ bool CreateDocument(arangodb::httpclient::SimpleHttpClient* client,
   return !failed;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief delete a view
+////////////////////////////////////////////////////////////////////////////////
+
+bool DeleteView(arangodb::httpclient::SimpleHttpClient* client,
+                std::string const& name) {
+  std::unordered_map<std::string, std::string> headerFields;
+  std::unique_ptr<arangodb::httpclient::SimpleHttpResult> result(
+      client->request(rest::RequestType::DELETE_REQ, "/_api/view/" + name, "",
+                      0, headerFields));
+
+  bool failed = true;
+  if (result != nullptr) {
+    int statusCode = result->getHttpReturnCode();
+    if (statusCode == 200 || statusCode == 202 || statusCode == 404) {
+      failed = false;
+    }
+  }
+
+  return !failed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a view from its JSON definition
+////////////////////////////////////////////////////////////////////////////////
+
+bool CreateView(arangodb::httpclient::SimpleHttpClient* client,
+                std::string const& payload) {
+  std::unordered_map<std::string, std::string> headerFields;
+
+  std::unique_ptr<arangodb::httpclient::SimpleHttpResult> result(
+      client->request(rest::RequestType::POST, "/_api/view", payload.c_str(),
+                      payload.size(), headerFields));
+
+  bool failed = true;
+
+  if (result != nullptr) {
+    int statusCode = result->getHttpReturnCode();
+    if (statusCode == 200 || statusCode == 201) {
+      failed = false;
+    } else {
+      LOG_TOPIC("7d3e1", WARN, Logger::BENCH)
+          << "error when creating view: " << result->getHttpReturnMessage()
+          << " for payload '" << payload << "': " << result->getBody();
+    }
+  }
+
+  return !failed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief import documents, given as one JSON object per line
+////////////////////////////////////////////////////////////////////////////////
+
+bool ImportDocuments(arangodb::httpclient::SimpleHttpClient* client,
+                     std::string const& collection,
+                     std::string const& payload) {
+  std::unordered_map<std::string, std::string> headerFields;
+
+  std::unique_ptr<arangodb::httpclient::SimpleHttpResult> result(
+      client->request(rest::RequestType::POST,
+                      "/_api/import?type=documents&complete=true&collection=" +
+                          collection,
+                      payload.c_str(), payload.size(), headerFields));
+
+  bool failed = true;
+
+  if (result != nullptr) {
+    if (result->getHttpReturnCode() == 201) {
+      failed = false;
+    } else {
+      LOG_TOPIC("b4a96", WARN, Logger::BENCH)
+          << "error when importing documents into collection '" << collection
+          << "': " << result->getHttpReturnMessage() << ": "
+          << result->getBody();
+    }
+  }
+
+  return !failed;
+}
+
 }  // namespace arangodb::arangobench
@@ -43,4 +43,11 @@ bool CreateDocument(arangodb::httpclient::SimpleHttpClient*, std::string const&,
 
 bool CreateIndex(arangodb::httpclient::SimpleHttpClient*, std::string const&,
                  std::string const&, std::string const&);
+
+bool DeleteView(arangodb::httpclient::SimpleHttpClient*, std::string const&);
+
+bool CreateView(arangodb::httpclient::SimpleHttpClient*, std::string const&);
+
+bool ImportDocuments(arangodb::httpclient::SimpleHttpClient*,
+                     std::string const&, std::string const&);
 }  // namespace arangodb::arangobench
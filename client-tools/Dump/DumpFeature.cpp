@@ -25,9 +25,14 @@
 #include "DumpFeature.h"
 
 #include <chrono>
+#include <cstring>
+#include <unordered_set>
 
 #include <velocypack/Collection.h>
 #include <velocypack/Iterator.h>
+#include <velocypack/Validator.h>
+
+#include <lz4frame.h>
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/Exceptions.h"
@@ -279,13 +284,82 @@ arangodb::Result dumpJsonObjects(arangodb::DumpFeature::DumpJob& job,
   return {};
 }
 
+/// @brief validate and mask a batch of velocypack documents and append it
+/// to the dump file as a single LZ4 frame. as frames are independent of each
+/// other, multiple jobs can append to the same file without coordination
+arangodb::Result dumpVPackObjects(arangodb::DumpFeature::DumpJob& job,
+                                  arangodb::ManagedDirectory::File& file,
+                                  arangodb::basics::StringBuffer const& body) {
+  auto const* data = reinterpret_cast<uint8_t const*>(body.data());
+  size_t length = body.length();
+
+  // servers that do not understand the "sanitize" URL parameter send the
+  // server-internal representation of "_id", which cannot be restored
+  VPackOptions options = VPackOptions::Defaults;
+  options.disallowCustom = true;
+  options.disallowExternals = true;
+  VPackValidator validator(&options);
+  try {
+    for (uint8_t const* p = data; p < data + length;
+         p += VPackSlice(p).byteSize()) {
+      validator.validate(p, data + length - p, /*isSubPart*/ true);
+    }
+  } catch (std::exception const& ex) {
+    return {TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+            arangodb::basics::StringUtils::concatT(
+                "got invalid velocypack data from server while dumping "
+                "collection '",
+                job.collectionName, "': ", ex.what(),
+                ". please use --data-format json")};
+  }
+
+  VPackBuffer<uint8_t> masked;
+  if (job.maskings != nullptr) {
+    job.maskings->mask(job.collectionName, data, length, masked);
+    data = masked.data();
+    length = masked.size();
+  }
+
+  LZ4F_preferences_t preferences;
+  memset(&preferences, 0, sizeof(preferences));
+  preferences.frameInfo.blockSizeID = LZ4F_max4MB;
+  preferences.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+  preferences.frameInfo.contentSize = length;
+
+  std::string compressed;
+  compressed.resize(LZ4F_compressFrameBound(length, &preferences));
+  size_t compressedLength = LZ4F_compressFrame(
+      compressed.data(), compressed.size(), data, length, &preferences);
+  if (LZ4F_isError(compressedLength)) {
+    return {TRI_ERROR_INTERNAL,
+            arangodb::basics::StringUtils::concatT(
+                "cannot compress data of collection '", job.collectionName,
+                "': ", LZ4F_getErrorName(compressedLength))};
+  }
+
+  file.write(compressed.data(), compressedLength);
+
+  if (file.status().fail()) {
+    return {TRI_ERROR_CANNOT_WRITE_FILE,
+            arangodb::basics::StringUtils::concatT(
+                "cannot write file '", file.path(),
+                "': ", file.status().errorMessage())};
+  }
+
+  job.stats.totalWritten += static_cast<uint64_t>(compressedLength);
+
+  return {};
+}
+
 /// @brief dump the actual data from an individual collection
 arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
                                 arangodb::DumpFeature::DumpJob& job,
                                 arangodb::ManagedDirectory::File& file,
                                 std::string const& name,
                                 std::string const& server, uint64_t batchId,
-                                uint64_t minTick, uint64_t maxTick) {
+                                uint64_t minTick, uint64_t maxTick,
+                                uint32_t rangeIndex = 0,
+                                uint32_t rangeCount = 1) {
   using arangodb::basics::StringUtils::boolean;
   using arangodb::basics::StringUtils::itoa;
   using arangodb::basics::StringUtils::uint64;
@@ -298,6 +372,22 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
       "/_api/replication/dump?collection=" + urlEncode(name) +
       "&batchId=" + itoa(batchId) + "&ticks=false" +
       "&useEnvelope=" + (job.options.useEnvelope ? "true" : "false");
+  if (job.options.prefetchBatches) {
+    // let the server produce the next batch while we are writing this one
+    baseUrl += "&prefetch=true";
+  }
+  bool const useVPack = job.options.dataFormat == "vpack";
+  if (useVPack) {
+    // we store the documents as they are, so they must not contain any
+    // server-internal types
+    baseUrl += "&sanitize=true";
+  }
+  std::string expectedRange;
+  if (rangeCount > 1) {
+    expectedRange = itoa(rangeIndex) + "/" + itoa(rangeCount);
+    baseUrl += "&rangeIndex=" + itoa(rangeIndex) +
+               "&rangeCount=" + itoa(rangeCount);
+  }
   if (job.options.clusterMode) {
     // we are in cluster mode, must specify dbserver
     baseUrl += "&DBserver=" + server;
@@ -308,7 +398,8 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
 
   std::unordered_map<std::string, std::string> headers;
   headers.emplace(arangodb::StaticStrings::Accept,
-                  arangodb::StaticStrings::MimeTypeDump);
+                  useVPack ? arangodb::StaticStrings::MimeTypeVPack
+                           : arangodb::StaticStrings::MimeTypeDump);
 
   while (true) {
     std::string url =
@@ -364,17 +455,47 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
                   name + "'"};
     }
 
+    if (!expectedRange.empty()) {
+      // servers that cannot dump ranges of a collection ignore the range
+      // parameters and return all documents
+      header = response->getHeaderField(
+          arangodb::StaticStrings::ReplicationHeaderRange, headerExtracted);
+      if (!headerExtracted || header != expectedRange) {
+        return {TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+                std::string("server does not support dumping ranges of "
+                            "collection '") +
+                    name + "', please use --workers-per-shard 1"};
+      }
+    }
+
+    arangodb::basics::StringBuffer const& body = response->getBody();
+
     header = response->getHeaderField(
         arangodb::StaticStrings::ContentTypeHeader, headerExtracted);
-    if (!headerExtracted ||
-        header.compare(0, 25, "application/x-arango-dump") != 0) {
+    if (useVPack) {
+      // empty responses may come without a velocypack content-type
+      if (body.length() > 0 &&
+          (!headerExtracted ||
+           header.compare(0, arangodb::StaticStrings::MimeTypeVPack.size(),
+                          arangodb::StaticStrings::MimeTypeVPack) != 0)) {
+        return {TRI_ERROR_REPLICATION_INVALID_RESPONSE,
+                "got invalid response from server: content-type is invalid"};
+      }
+    } else if (!headerExtracted ||
+               header.compare(0, 25, "application/x-arango-dump") != 0) {
       return {TRI_ERROR_REPLICATION_INVALID_RESPONSE,
               "got invalid response from server: content-type is invalid"};
     }
 
     // now actually write retrieved data to dump file
-    arangodb::basics::StringBuffer const& body = response->getBody();
-    arangodb::Result result = dumpJsonObjects(job, file, body);
+    arangodb::Result result;
+    if (useVPack) {
+      if (body.length() > 0) {
+        result = dumpVPackObjects(job, file, body);
+      }
+    } else {
+      result = dumpJsonObjects(job, file, body);
+    }
 
     if (result.fail()) {
       return result;
@@ -399,6 +520,23 @@ arangodb::Result dumpCollection(arangodb::httpclient::SimpleHttpClient& client,
   return {TRI_ERROR_INTERNAL};
 }
 
+/// @brief split the dump of a collection or shard into one job per range,
+/// which are processed in parallel
+void queueRangeJobs(arangodb::DumpFeature::DumpJob& job,
+                    std::string const& name, std::string const& server,
+                    uint64_t batchId, bool ownsBatch,
+                    std::shared_ptr<arangodb::ManagedDirectory::File> file) {
+  uint32_t const count = job.options.workersPerShard;
+  auto batch = std::make_shared<arangodb::DumpFeature::SharedBatch>(
+      server, batchId, ownsBatch, count);
+  for (uint32_t i = 0; i < count; ++i) {
+    auto rangeJob = std::make_unique<arangodb::DumpFeature::DumpRangeJob>(
+        job.directory, job.feature, job.options, job.maskings, job.stats,
+        job.collectionInfo, name, batch, file, i);
+    job.feature.taskQueue().queueJob(std::move(rangeJob));
+  }
+}
+
 /// @brief process a single job from the queue
 void processJob(arangodb::httpclient::SimpleHttpClient& client,
                 arangodb::DumpFeature::DumpJob& job) {
@@ -531,10 +669,13 @@ Result DumpFeature::DumpCollectionJob::run(
   }
 
   if (res.ok()) {
-    // always create the file so that arangorestore does not complain
-    auto file =
-        directory.writableFile(collectionName + "_" + hexString + ".data.json",
-                               true /*overwrite*/, 0, true /*gzipOk*/);
+    // always create the file so that arangorestore does not complain.
+    // binary dumps are compressed with LZ4 instead of gzip
+    bool const useVPack = options.dataFormat == "vpack";
+    auto file = directory.writableFile(
+        collectionName + "_" + hexString +
+            (useVPack ? ".data.vpack.lz4" : ".data.json"),
+        true /*overwrite*/, 0, !useVPack /*gzipOk*/);
     if (!::fileOk(file.get())) {
       return ::fileError(file.get(), true);
     }
@@ -586,9 +727,17 @@ Result DumpFeature::DumpCollectionJob::run(
         // keep the batch alive
         ::extendBatch(client, "", batchId);
 
-        // do the hard work in another function...
-        res = ::dumpCollection(client, *this, *file, collectionName, "",
-                               batchId, options.tickStart, options.tickEnd);
+        if (options.workersPerShard > 1) {
+          // the batch belongs to the whole dump and is ended by it
+          ::queueRangeJobs(*this, collectionName, "", batchId,
+                           /*ownsBatch*/ false,
+                           std::shared_ptr<ManagedDirectory::File>(
+                               file.release()));
+        } else {
+          // do the hard work in another function...
+          res = ::dumpCollection(client, *this, *file, collectionName, "",
+                                 batchId, options.tickStart, options.tickEnd);
+        }
       }
     }
   }
@@ -619,6 +768,12 @@ Result DumpFeature::DumpShardJob::run(
   // make sure we have a batch on this dbserver
   auto [res, batchId] = ::startBatch(client, server);
   if (res.ok()) {
+    if (options.workersPerShard > 1) {
+      // the batch is ended by the last of the range jobs
+      ::queueRangeJobs(*this, shardName, server, batchId, /*ownsBatch*/ true,
+                       file);
+      return res;
+    }
     // do the hard work elsewhere
     res = ::dumpCollection(client, *this, *file, shardName, server, batchId, 0,
                            UINT64_MAX);
@@ -628,6 +783,47 @@ Result DumpFeature::DumpShardJob::run(
   return res;
 }
 
+DumpFeature::DumpRangeJob::DumpRangeJob(
+    ManagedDirectory& directory, DumpFeature& feature, Options const& options,
+    maskings::Maskings* maskings, Stats& stats, VPackSlice collectionInfo,
+    std::string const& name, std::shared_ptr<SharedBatch> batch,
+    std::shared_ptr<ManagedDirectory::File> file, uint32_t rangeIndex)
+    : DumpJob(directory, feature, options, maskings, stats, collectionInfo),
+      name(name),
+      batch(std::move(batch)),
+      file(std::move(file)),
+      rangeIndex(rangeIndex) {}
+
+DumpFeature::DumpRangeJob::~DumpRangeJob() = default;
+
+Result DumpFeature::DumpRangeJob::run(
+    arangodb::httpclient::SimpleHttpClient& client) {
+  if (options.progress) {
+    LOG_TOPIC("5d1b4", DEBUG, arangodb::Logger::DUMP)
+        << "# Dumping range " << (rangeIndex + 1) << " of "
+        << options.workersPerShard << " of '" << name << "'...";
+  }
+
+  Result res;
+  if (options.clusterMode) {
+    res = ::dumpCollection(client, *this, *file, name, batch->server,
+                           batch->id, 0, UINT64_MAX, rangeIndex,
+                           options.workersPerShard);
+  } else {
+    res = ::dumpCollection(client, *this, *file, name, "", batch->id,
+                           options.tickStart, options.tickEnd, rangeIndex,
+                           options.workersPerShard);
+  }
+
+  if (batch->pending.fetch_sub(1) == 1 && batch->owned) {
+    // last range of the shard
+    uint64_t batchId = batch->id;
+    ::endBatch(client, batch->server, batchId);
+  }
+
+  return res;
+}
+
 DumpFeature::DumpFeature(Server& server, int& exitCode)
     : ArangoDumpFeature{server, *this},
       _clientManager{server.getFeature<HttpEndpointProvider, ClientFeature>(),
@@ -648,6 +844,7 @@ DumpFeature::DumpFeature(Server& server, int& exitCode)
 void DumpFeature::collectOptions(
     std::shared_ptr<options::ProgramOptions> options) {
   using arangodb::options::BooleanParameter;
+  using arangodb::options::DiscreteValuesParameter;
   using arangodb::options::StringParameter;
   using arangodb::options::UInt32Parameter;
   using arangodb::options::UInt64Parameter;
@@ -683,6 +880,21 @@ void DumpFeature::collectOptions(
               arangodb::options::Flags::Dynamic))
       .setIntroducedIn(30400);
 
+  options
+      ->addOption("--workers-per-shard",
+                  "The number of disjoint ranges each collection/shard is "
+                  "split into. The ranges are dumped in parallel, using up "
+                  "to --threads threads overall.",
+                  new UInt32Parameter(&_options.workersPerShard))
+      .setIntroducedIn(31100);
+
+  options
+      ->addOption("--prefetch-batches",
+                  "Let the server produce the next batch of a collection or "
+                  "shard while the previous batch is being written.",
+                  new BooleanParameter(&_options.prefetchBatches))
+      .setIntroducedIn(31100);
+
   options->addOption("--dump-data", "Whether to dump collection data.",
                      new BooleanParameter(&_options.dumpData));
 
@@ -740,6 +952,18 @@ void DumpFeature::collectOptions(
                   "gzip format (not compatible with encryption).",
                   new BooleanParameter(&_options.useGzip))
       .setIntroducedIn(30406);
+
+  options
+      ->addOption("--data-format",
+                  "The format of files containing collection contents. "
+                  "\"json\" writes JSON lines, optionally compressed with "
+                  "gzip. \"vpack\" writes the velocypack documents as "
+                  "received from the server, in LZ4 frames, which needs "
+                  "far less CPU time for dumping and restoring.",
+                  new DiscreteValuesParameter<StringParameter>(
+                      &_options.dataFormat,
+                      std::unordered_set<std::string>{"json", "vpack"}))
+      .setIntroducedIn(31100);
 }
 
 void DumpFeature::validateOptions(
@@ -792,6 +1016,13 @@ void DumpFeature::validateOptions(
         << "capping --threads value to " << clamped;
     _options.threadCount = clamped;
   }
+
+  clamped = std::clamp(_options.workersPerShard, uint32_t(1), uint32_t(64));
+  if (_options.workersPerShard != clamped) {
+    LOG_TOPIC("e6f1a", WARN, Logger::DUMP)
+        << "capping --workers-per-shard value to " << clamped;
+    _options.workersPerShard = clamped;
+  }
 }
 
 // dump data from cluster via a coordinator
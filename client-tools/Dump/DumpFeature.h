@@ -34,6 +34,7 @@
 #include "Utils/ClientTaskQueue.h"
 #include "Utils/ManagedDirectory.h"
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -66,9 +67,11 @@ class DumpFeature final : public ArangoDumpFeature {
     std::vector<std::string> shards{};
     std::string outputPath{};
     std::string maskingsFile{};
+    std::string dataFormat{"json"};
     uint64_t initialChunkSize{1024 * 1024 * 8};
     uint64_t maxChunkSize{1024 * 1024 * 64};
     uint32_t threadCount{2};
+    uint32_t workersPerShard{1};
     uint64_t tickStart{0};
     uint64_t tickEnd{0};
     bool allDatabases{false};
@@ -81,6 +84,7 @@ class DumpFeature final : public ArangoDumpFeature {
     bool progress{true};
     bool useGzip{true};
     bool useEnvelope{false};
+    bool prefetchBatches{true};
   };
 
   /// @brief Stores stats about the overall dump progress
@@ -144,6 +148,43 @@ class DumpFeature final : public ArangoDumpFeature {
     std::shared_ptr<ManagedDirectory::File> file;
   };
 
+  /// @brief a batch shared by the jobs dumping the ranges of a single
+  /// collection or shard
+  struct SharedBatch {
+    SharedBatch(std::string server, uint64_t id, bool owned,
+                uint32_t pending)
+        : server(std::move(server)), id(id), owned(owned), pending(pending) {}
+
+    /// @brief DB server the batch was started on, empty for single servers
+    std::string const server;
+    uint64_t const id;
+    /// @brief whether the batch must be ended by the last range job
+    bool const owned;
+    /// @brief number of range jobs not yet finished
+    std::atomic<uint32_t> pending;
+  };
+
+  /// @brief stores all necessary data to dump one of several disjoint
+  /// ranges of a collection or shard, in parallel to the other ranges.
+  /// used in both single server and cluster mode
+  struct DumpRangeJob : public DumpJob {
+    DumpRangeJob(ManagedDirectory&, DumpFeature&, Options const& options,
+                 maskings::Maskings* maskings, Stats& stats,
+                 VPackSlice collectionInfo, std::string const& name,
+                 std::shared_ptr<SharedBatch> batch,
+                 std::shared_ptr<ManagedDirectory::File> file,
+                 uint32_t rangeIndex);
+
+    ~DumpRangeJob();
+
+    Result run(arangodb::httpclient::SimpleHttpClient& client) override;
+
+    std::string const name;
+    std::shared_ptr<SharedBatch> const batch;
+    std::shared_ptr<ManagedDirectory::File> const file;
+    uint32_t const rangeIndex;
+  };
+
   ClientTaskQueue<DumpJob>& taskQueue();
 
  private:
@@ -25,6 +25,7 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/ScopeGuard.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
@@ -39,12 +40,15 @@
 #include "SimpleHttpClient/HttpResponseChecker.h"
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpResult.h"
+#include "Utils/ClientManager.h"
+#include "Utils/ClientTaskQueue.h"
 
 #include <boost/property_tree/detail/xml_parser_utils.hpp>
 #include <velocypack/Builder.h>
 #include <velocypack/Dumper.h>
 #include <velocypack/Slice.h>
 #include <velocypack/Sink.h>
+#include <algorithm>
 #include <iostream>
 #include <regex>
 #include <sys/types.h>
@@ -77,7 +81,8 @@ ExportFeature::ExportFeature(Server& server, int* result)
       _overwrite(false),
       _progress(true),
       _useGzip(false),
-      _firstLine(true),
+      _splitFiles(false),
+      _threads(1),
       _documentsPerBatch(1000),
       _skippedDeepNested(0),
       _httpRequestsDone(0),
@@ -172,6 +177,25 @@ void ExportFeature::collectOptions(
                   new BooleanParameter(&_useGzip))
       .setIntroducedIn(30408)
       .setIntroducedIn(30501);
+
+  options
+      ->addOption("--threads",
+                  "The number of threads exporting collections in parallel. "
+                  "With more than one thread, collections (or their shards "
+                  "in a cluster) are split into key ranges which are "
+                  "exported through concurrent streaming cursors.",
+                  new UInt32Parameter(&_threads))
+      .setIntroducedIn(31100);
+
+  options
+      ->addOption("--split-files",
+                  "Write each key range of a collection exported by multiple "
+                  "threads to its own file (`<collection>.<n>.<type>`) "
+                  "instead of merging the ranges into one file. A "
+                  "collection exported as a single range is written to "
+                  "`<collection>.<type>`.",
+                  new BooleanParameter(&_splitFiles))
+      .setIntroducedIn(31100);
 }
 
 void ExportFeature::validateOptions(
@@ -261,6 +285,10 @@ void ExportFeature::validateOptions(
     _csvFields = StringUtils::split(_csvFieldOptions, ',');
   }
 
+  if (_threads == 0) {
+    _threads = 1;
+  }
+
   // we will use _maxRuntime only if the option was set by the user
   _useMaxRuntime =
       options->processingResult().touched("--custom-query-max-runtime");
@@ -347,14 +375,15 @@ void ExportFeature::start() {
       _typeExport == "csv") {
     if (_collections.size()) {
       progressDetails = std::to_string(_collections.size()) + " collection(s)";
-      collectionExport(httpClient.get());
-
-      for (auto const& collection : _collections) {
-        std::string filePath = _outputDirectory + TRI_DIR_SEPARATOR_STR +
-                               collection + "." + _typeExport;
-        if (_useGzip) {
-          filePath.append(".gz");
-        }  // if
+      if (_threads > 1) {
+        parallelCollectionExport(httpClient.get());
+      } else {
+        collectionExport(httpClient.get());
+      }
+
+      for (auto const& fileName : _exportedFiles) {
+        std::string filePath =
+            _outputDirectory + TRI_DIR_SEPARATOR_STR + fileName;
         int64_t fileSize = TRI_SizeFile(filePath.c_str());
 
         if (0 < fileSize) {
@@ -390,7 +419,7 @@ void ExportFeature::start() {
   using arangodb::basics::StringUtils::formatSize;
 
   std::cout << "Processed " << progressDetails << ", wrote "
-            << formatSize(exportedSize) << ", " << _httpRequestsDone
+            << formatSize(exportedSize) << ", " << _httpRequestsDone.load()
             << " HTTP request(s)" << std::endl;
 
   *_result = ret;
@@ -436,26 +465,381 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, errorMsg);
     }
 
+    _exportedFiles.emplace_back(_useGzip ? fileName + ".gz" : fileName);
+
     writeFirstLine(*fd, fileName, collection);
 
-    writeBatch(*fd, VPackArrayIterator(body.get("result")), fileName);
+    bool firstLine = true;
+    writeBatch(*fd, VPackArrayIterator(body.get("result")), firstLine);
 
     while (body.hasKey("id")) {
       std::string const url = "/_api/cursor/" + body.get("id").copyString();
       parsedBody = httpCall(httpClient, url, rest::RequestType::POST);
       body = parsedBody->slice();
 
-      writeBatch(*fd, VPackArrayIterator(body.get("result")), fileName);
+      writeBatch(*fd, VPackArrayIterator(body.get("result")), firstLine);
+    }
+
+    writeLastLine(*fd);
+  }
+}
+
+void ExportFeature::parallelCollectionExport(SimpleHttpClient* httpClient) {
+  ClientManager clientManager(
+      server().getFeature<HttpEndpointProvider, ClientFeature>(),
+      Logger::COMMUNICATION);
+  ClientTaskQueue<ExportJob> jobQueue(
+      server(), [this](SimpleHttpClient& client, ExportJob& job) {
+        try {
+          exportRange(client, job);
+        } catch (basics::Exception const& ex) {
+          reportError(Result(ex.code(), ex.what()));
+        } catch (std::exception const& ex) {
+          reportError(Result(TRI_ERROR_INTERNAL, ex.what()));
+        } catch (...) {
+          reportError(Result(TRI_ERROR_INTERNAL));
+        }
+      });
+
+  if (!jobQueue.spawnWorkers(clientManager, _threads)) {
+    LOG_TOPIC("3c9e2", FATAL, Logger::COMMUNICATION)
+        << "cannot create server connections, giving up!";
+    FATAL_ERROR_EXIT();
+  }
+
+  // part files of each collection, in key order
+  std::vector<std::pair<std::string, std::vector<std::string>>> merges;
+
+  for (auto const& collection : _collections) {
+    if (_progress) {
+      std::cout << "# Exporting collection '" << collection << "'..."
+                << std::endl;
+    }
+
+    auto shards = collectionShards(httpClient, collection);
+
+    // distribute the threads over the shards, but do not split up shards
+    // into ranges smaller than a batch
+    uint64_t const rangesPerShard = std::max<uint64_t>(
+        1, (_threads + shards.size() - 1) / std::max<size_t>(1, shards.size()));
+
+    std::vector<std::unique_ptr<ExportJob>> jobs;
+    uint64_t const batchSize = std::max<uint64_t>(1, _documentsPerBatch);
+    for (auto const& [shard, count] : shards) {
+      uint64_t parts = std::clamp<uint64_t>(
+          (count + batchSize - 1) / batchSize, 1, rangesPerShard);
+      std::vector<std::string> keys;
+      if (parts > 1) {
+        keys = splitKeys(httpClient, collection, shard, count, parts);
+      }
+
+      for (size_t i = 0; i <= keys.size(); ++i) {
+        auto job = std::make_unique<ExportJob>();
+        job->collection = collection;
+        job->shard = shard;
+        if (i > 0) {
+          job->lowerKey = keys[i - 1];
+        }
+        if (i < keys.size()) {
+          job->upperKey = keys[i];
+        }
+        jobs.emplace_back(std::move(job));
+      }
+    }
+
+    if (jobs.size() == 1) {
+      // a single range is written directly to the collection's export file.
+      // there is nothing to merge
+      auto& job = jobs.front();
+      job->fileName = collection + "." + _typeExport;
+      job->standalone = true;
+      _exportedFiles.emplace_back(_useGzip ? job->fileName + ".gz"
+                                           : job->fileName);
+      jobQueue.queueJob(std::move(job));
+      continue;
+    }
+
+    std::vector<std::string> parts;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+      auto& job = jobs[i];
+      if (_splitFiles) {
+        job->fileName =
+            collection + "." + std::to_string(i) + "." + _typeExport;
+        job->standalone = true;
+        _exportedFiles.emplace_back(_useGzip ? job->fileName + ".gz"
+                                             : job->fileName);
+      } else {
+        job->fileName = collection + "." + _typeExport + ".part" +
+                        std::to_string(i);
+        parts.emplace_back(job->fileName);
+      }
+      jobQueue.queueJob(std::move(job));
     }
 
-    if (_typeExport == "json") {
-      std::string closingBracket = "\n]";
-      writeToFile(*fd, closingBracket);
-    } else if (_typeExport == "xml") {
-      std::string xmlFooter = "</collection>";
-      writeToFile(*fd, xmlFooter);
+    if (!_splitFiles) {
+      merges.emplace_back(collection, std::move(parts));
+    }
+  }
+
+  jobQueue.waitForIdle();
+
+  {
+    MUTEX_LOCKER(locker, _workerErrorLock);
+    if (_workerError.fail()) {
+      LOG_TOPIC("d71f4", FATAL, Logger::FIXME)
+          << "error while exporting: " << _workerError.errorMessage();
+      FATAL_ERROR_EXIT();
+    }
+  }
+
+  for (auto const& [collection, parts] : merges) {
+    mergeParts(collection, parts);
+  }
+}
+
+std::vector<std::pair<std::string, uint64_t>> ExportFeature::collectionShards(
+    SimpleHttpClient* httpClient, std::string const& collection) {
+  std::string const url = "/_api/collection/" +
+                          StringUtils::urlEncode(collection) +
+                          "/count?details=true";
+  std::shared_ptr<VPackBuilder> parsedBody =
+      httpCall(httpClient, url, rest::RequestType::GET);
+  VPackSlice count = parsedBody->slice().get("count");
+
+  std::vector<std::pair<std::string, uint64_t>> shards;
+  if (count.isObject()) {
+    // cluster: per-shard counts
+    for (auto it : VPackObjectIterator(count)) {
+      shards.emplace_back(it.key.copyString(),
+                          it.value.isNumber() ? it.value.getNumber<uint64_t>()
+                                              : 0);
+    }
+  } else {
+    shards.emplace_back(std::string(),
+                        count.isNumber() ? count.getNumber<uint64_t>() : 0);
+  }
+  return shards;
+}
+
+std::vector<std::string> ExportFeature::splitKeys(
+    SimpleHttpClient* httpClient, std::string const& collection,
+    std::string const& shard, uint64_t count, uint64_t parts) {
+  TRI_ASSERT(parts > 1);
+
+  uint64_t const step = std::max<uint64_t>(count / parts, 1);
+
+  // read all keys once in sorted order, and pick every step-th key as a
+  // split point. the query only reads the primary index, which is sorted by
+  // _key, so the SORT is optimized away and the cursor can be streamed
+  VPackBuilder post;
+  post.openObject();
+  post.add("query",
+           VPackValue("FOR doc IN @@collection SORT doc._key RETURN doc._key"));
+  post.add("bindVars", VPackValue(VPackValueType::Object));
+  post.add("@collection", VPackValue(collection));
+  post.close();
+  post.add("ttl", VPackValue(::ttlValue));
+  post.add("batchSize", VPackValue(std::max<uint64_t>(_documentsPerBatch,
+                                                      10000)));
+  post.add("options", VPackValue(VPackValueType::Object));
+  post.add("stream", VPackSlice::trueSlice());
+  if (!shard.empty()) {
+    post.add("shardIds", VPackValue(VPackValueType::Array));
+    post.add(VPackValue(shard));
+    post.close();
+  }
+  post.close();
+  post.close();
+
+  std::shared_ptr<VPackBuilder> parsedBody = httpCall(
+      httpClient, "_api/cursor", rest::RequestType::POST, post.toJson());
+  VPackSlice body = parsedBody->slice();
+
+  std::vector<std::string> keys;
+  uint64_t position = 0;
+  while (true) {
+    bool complete =
+        collectSplitKeys(body.get("result"), step, parts, position, keys);
+    if (!body.hasKey("id")) {
+      break;
+    }
+    std::string const url = "/_api/cursor/" + body.get("id").copyString();
+    if (complete) {
+      // all split points found, the rest of the keys is not needed
+      httpCall(httpClient, url, rest::RequestType::DELETE_REQ);
+      break;
+    }
+    parsedBody = httpCall(httpClient, url, rest::RequestType::POST);
+    body = parsedBody->slice();
+  }
+  return keys;
+}
+
+bool ExportFeature::collectSplitKeys(VPackSlice batch, uint64_t step,
+                                     uint64_t parts, uint64_t& position,
+                                     std::vector<std::string>& keys) {
+  TRI_ASSERT(step > 0);
+  for (VPackSlice key : VPackArrayIterator(batch)) {
+    if (keys.size() + 1 >= parts) {
+      break;
+    }
+    if (++position % step == 0 && key.isString()) {
+      keys.emplace_back(key.copyString());
     }
   }
+  return keys.size() + 1 >= parts;
+}
+
+void ExportFeature::buildRangeRequest(VPackBuilder& post, ExportJob const& job,
+                                      uint64_t batchSize) {
+  std::string query = "FOR doc IN @@collection ";
+  if (!job.lowerKey.empty() && !job.upperKey.empty()) {
+    query.append("FILTER doc._key >= @lower && doc._key < @upper ");
+  } else if (!job.lowerKey.empty()) {
+    query.append("FILTER doc._key >= @lower ");
+  } else if (!job.upperKey.empty()) {
+    query.append("FILTER doc._key < @upper ");
+  }
+  query.append("RETURN doc");
+
+  post.openObject();
+  post.add("query", VPackValue(query));
+  post.add("bindVars", VPackValue(VPackValueType::Object));
+  post.add("@collection", VPackValue(job.collection));
+  if (!job.lowerKey.empty()) {
+    post.add("lower", VPackValue(job.lowerKey));
+  }
+  if (!job.upperKey.empty()) {
+    post.add("upper", VPackValue(job.upperKey));
+  }
+  post.close();
+  post.add("ttl", VPackValue(::ttlValue));
+  post.add("batchSize", VPackValue(batchSize));
+  post.add("options", VPackValue(VPackValueType::Object));
+  post.add("stream", VPackSlice::trueSlice());
+  if (!job.shard.empty()) {
+    post.add("shardIds", VPackValue(VPackValueType::Array));
+    post.add(VPackValue(job.shard));
+    post.close();
+  }
+  post.close();
+  post.close();
+}
+
+void ExportFeature::exportRange(SimpleHttpClient& httpClient, ExportJob& job) {
+  std::unique_ptr<ManagedDirectory::File> fd;
+  {
+    MUTEX_LOCKER(locker, _directoryLock);
+    // part files are read again for merging, so do not compress them
+    fd = _directory->writableFile(job.fileName, _overwrite, 0,
+                                  job.standalone);
+  }
+
+  if (nullptr == fd.get() || !fd->status().ok()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_CANNOT_WRITE_FILE,
+        "cannot write to file '" + job.fileName + "'");
+  }
+
+  VPackBuilder post;
+  buildRangeRequest(post, job, _documentsPerBatch);
+
+  std::shared_ptr<VPackBuilder> parsedBody = httpCall(
+      &httpClient, "_api/cursor", rest::RequestType::POST, post.toJson());
+  VPackSlice body = parsedBody->slice();
+
+  // in part files, every JSON array member is preceded by a separator. the
+  // very first one is removed when merging the parts
+  bool firstLine = job.standalone;
+  if (job.standalone) {
+    writeFirstLine(*fd, job.fileName, job.collection);
+  }
+
+  writeBatch(*fd, VPackArrayIterator(body.get("result")), firstLine);
+
+  while (body.hasKey("id")) {
+    std::string const url = "/_api/cursor/" + body.get("id").copyString();
+    parsedBody = httpCall(&httpClient, url, rest::RequestType::POST);
+    body = parsedBody->slice();
+
+    writeBatch(*fd, VPackArrayIterator(body.get("result")), firstLine);
+  }
+
+  if (job.standalone) {
+    writeLastLine(*fd);
+  }
+}
+
+void ExportFeature::mergeParts(std::string const& collection,
+                               std::vector<std::string> const& parts) {
+  std::string fileName = collection + "." + _typeExport;
+
+  std::unique_ptr<ManagedDirectory::File> fd =
+      _directory->writableFile(fileName, _overwrite, 0, true);
+
+  if (nullptr == fd.get() || !fd->status().ok()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE,
+                                   "cannot write to file '" + fileName + "'");
+  }
+
+  _exportedFiles.emplace_back(_useGzip ? fileName + ".gz" : fileName);
+
+  writeFirstLine(*fd, fileName, collection);
+
+  appendParts(*_directory, *fd, parts, _typeExport == "json");
+
+  writeLastLine(*fd);
+}
+
+void ExportFeature::appendParts(ManagedDirectory& directory,
+                                ManagedDirectory::File& out,
+                                std::vector<std::string> const& parts,
+                                bool stripSeparator) {
+  bool first = true;
+  std::string buffer;
+  buffer.resize(1024 * 1024);
+  for (auto const& part : parts) {
+    std::unique_ptr<ManagedDirectory::File> in =
+        directory.readableFile(part);
+    if (nullptr == in.get() || !in->status().ok()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_READ_FILE,
+                                     "cannot read from file '" + part + "'");
+    }
+
+    while (true) {
+      TRI_read_return_t numRead = in->read(buffer.data(), buffer.size());
+      if (numRead < 0 || in->status().fail()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_READ_FILE,
+                                       "cannot read from file '" + part + "'");
+      }
+      if (numRead == 0) {
+        break;
+      }
+      char const* data = buffer.data();
+      size_t length = static_cast<size_t>(numRead);
+      if (first) {
+        if (stripSeparator && data[0] == ',') {
+          ++data;
+          --length;
+        }
+        first = false;
+      }
+      out.write(data, length);
+      if (out.status().fail()) {
+        THROW_ARANGO_EXCEPTION(out.status());
+      }
+    }
+
+    in.reset();
+    TRI_UnlinkFile(directory.pathToFile(part).c_str());
+  }
+}
+
+void ExportFeature::reportError(Result const& error) {
+  MUTEX_LOCKER(locker, _workerErrorLock);
+  if (_workerError.ok()) {
+    _workerError = error;
+  }
 }
 
 void ExportFeature::queryExport(SimpleHttpClient* httpClient) {
@@ -499,29 +883,23 @@ void ExportFeature::queryExport(SimpleHttpClient* httpClient) {
 
   writeFirstLine(*fd, fileName, "");
 
-  writeBatch(*fd, VPackArrayIterator(body.get("result")), fileName);
+  bool firstLine = true;
+  writeBatch(*fd, VPackArrayIterator(body.get("result")), firstLine);
 
   while (body.hasKey("id")) {
     std::string const url = "/_api/cursor/" + body.get("id").copyString();
     parsedBody = httpCall(httpClient, url, rest::RequestType::POST);
     body = parsedBody->slice();
 
-    writeBatch(*fd, VPackArrayIterator(body.get("result")), fileName);
+    writeBatch(*fd, VPackArrayIterator(body.get("result")), firstLine);
   }
 
-  if (_typeExport == "json") {
-    std::string closingBracket = "\n]";
-    writeToFile(*fd, closingBracket);
-  } else if (_typeExport == "xml") {
-    std::string xmlFooter = "</collection>";
-    writeToFile(*fd, xmlFooter);
-  }
+  writeLastLine(*fd);
 }
 
 void ExportFeature::writeFirstLine(ManagedDirectory::File& fd,
                                    std::string const& fileName,
                                    std::string const& collection) {
-  _firstLine = true;
   if (_typeExport == "json") {
     std::string openingBracket = "[";
     writeToFile(fd, openingBracket);
@@ -550,41 +928,47 @@ void ExportFeature::writeFirstLine(ManagedDirectory::File& fd,
   }
 }
 
+void ExportFeature::writeLastLine(ManagedDirectory::File& fd) {
+  if (_typeExport == "json") {
+    std::string closingBracket = "\n]";
+    writeToFile(fd, closingBracket);
+  } else if (_typeExport == "xml") {
+    std::string xmlFooter = "</collection>";
+    writeToFile(fd, xmlFooter);
+  }
+}
+
 void ExportFeature::writeBatch(ManagedDirectory::File& fd,
-                               VPackArrayIterator it,
-                               std::string const& fileName) {
+                               VPackArrayIterator it, bool& firstLine) {
+  // the whole batch is formatted into one buffer, so that it is written to
+  // the file with a single call
   std::string line;
-  line.reserve(1024);
+  line.reserve(1024 * it.size());
 
   if (_typeExport == "jsonl") {
     VPackStringSink sink(&line);
     VPackDumper dumper(&sink);
 
     for (auto const& doc : it) {
-      line.clear();
       dumper.dump(doc);
       line.push_back('\n');
-      writeToFile(fd, line);
     }
   } else if (_typeExport == "json") {
     VPackStringSink sink(&line);
     VPackDumper dumper(&sink);
 
     for (auto const& doc : it) {
-      line.clear();
-      if (!_firstLine) {
+      if (!firstLine) {
         line.append(",\n  ", 4);
       } else {
         line.append("\n  ", 3);
-        _firstLine = false;
+        firstLine = false;
       }
       dumper.dump(doc);
-      writeToFile(fd, line);
     }
   } else if (_typeExport == "csv") {
     std::string value;
     for (auto const& doc : it) {
-      line.clear();
       bool isFirstValue = true;
 
       for (auto const& key : _csvFields) {
@@ -623,23 +1007,20 @@ void ExportFeature::writeBatch(ManagedDirectory::File& fd,
         }
       }
       line.push_back('\n');
-      writeToFile(fd, line);
     }
   } else if (_typeExport == "xml") {
     for (auto const& doc : it) {
-      line.clear();
       line.append("<doc key=\"");
       line.append(encode_char_entities(doc.get("_key").copyString()));
       line.append("\">\n");
-      writeToFile(fd, line);
       for (auto const& att : VPackObjectIterator(doc)) {
-        xgmmlWriteOneAtt(fd, att.value, att.key.copyString(), 2);
+        xgmmlWriteOneAtt(line, att.value, att.key.copyString(), 2);
       }
-      line.clear();
       line.append("</doc>\n");
-      writeToFile(fd, line);
     }
   }
+
+  writeToFile(fd, line);
 }
 
 void ExportFeature::writeToFile(ManagedDirectory::File& fd,
@@ -787,8 +1168,8 @@ directed="1">
   std::string closingGraphTag = "</graph>\n";
   writeToFile(*fd, closingGraphTag);
 
-  if (_skippedDeepNested) {
-    std::cout << "skipped " << _skippedDeepNested
+  if (_skippedDeepNested > 0) {
+    std::cout << "skipped " << _skippedDeepNested.load()
               << " deep nested objects / arrays" << std::endl;
   }
 }
@@ -797,6 +1178,7 @@ void ExportFeature::writeGraphBatch(ManagedDirectory::File& fd,
                                     VPackArrayIterator it,
                                     std::string const& fileName) {
   std::string xmlTag;
+  std::string output;
 
   for (auto const& doc : it) {
     if (doc.hasKey("_from")) {
@@ -809,21 +1191,21 @@ void ExportFeature::writeGraphBatch(ManagedDirectory::File& fd,
           "\" source=\"" + encode_char_entities(doc.get("_from").copyString()) +
           "\" target=\"" + encode_char_entities(doc.get("_to").copyString()) +
           "\"";
-      writeToFile(fd, xmlTag);
+      output.append(xmlTag);
       if (!_xgmmlLabelOnly) {
         xmlTag = ">\n";
-        writeToFile(fd, xmlTag);
+        output.append(xmlTag);
 
         for (auto it : VPackObjectIterator(doc)) {
-          xgmmlWriteOneAtt(fd, it.value, it.key.copyString());
+          xgmmlWriteOneAtt(output, it.value, it.key.copyString());
         }
 
         xmlTag = "</edge>\n";
-        writeToFile(fd, xmlTag);
+        output.append(xmlTag);
 
       } else {
         xmlTag = " />\n";
-        writeToFile(fd, xmlTag);
+        output.append(xmlTag);
       }
 
     } else {
@@ -834,27 +1216,29 @@ void ExportFeature::writeGraphBatch(ManagedDirectory::File& fd,
                                    ? doc.get(_xgmmlLabelAttribute).copyString()
                                    : "Default-Label") +
           "\" id=\"" + encode_char_entities(doc.get("_id").copyString()) + "\"";
-      writeToFile(fd, xmlTag);
+      output.append(xmlTag);
       if (!_xgmmlLabelOnly) {
         xmlTag = ">\n";
-        writeToFile(fd, xmlTag);
+        output.append(xmlTag);
 
         for (auto it : VPackObjectIterator(doc)) {
-          xgmmlWriteOneAtt(fd, it.value, it.key.copyString());
+          xgmmlWriteOneAtt(output, it.value, it.key.copyString());
         }
 
         xmlTag = "</node>\n";
-        writeToFile(fd, xmlTag);
+        output.append(xmlTag);
 
       } else {
         xmlTag = " />\n";
-        writeToFile(fd, xmlTag);
+        output.append(xmlTag);
       }
     }
   }
+
+  writeToFile(fd, output);
 }
 
-void ExportFeature::xgmmlWriteOneAtt(ManagedDirectory::File& fd,
+void ExportFeature::xgmmlWriteOneAtt(std::string& output,
                                      VPackSlice const& slice,
                                      std::string const& name, int deep) {
   std::string value, type, xmlTag;
@@ -882,10 +1266,9 @@ void ExportFeature::xgmmlWriteOneAtt(ManagedDirectory::File& fd,
 
   } else if (slice.isArray() || slice.isObject()) {
     if (0 < deep) {
-      if (_skippedDeepNested == 0) {
+      if (_skippedDeepNested.fetch_add(1) == 0) {
         std::cout << "Warning: skip deep nested objects / arrays" << std::endl;
       }
-      _skippedDeepNested++;
       return;
     }
 
@@ -893,38 +1276,38 @@ void ExportFeature::xgmmlWriteOneAtt(ManagedDirectory::File& fd,
     xmlTag = "  <att name=\"" + encode_char_entities(name) +
              "\" type=\"string\" value=\"" +
              encode_char_entities(slice.toString()) + "\"/>\n";
-    writeToFile(fd, xmlTag);
+    output.append(xmlTag);
     return;
   }
 
   if (!type.empty()) {
     xmlTag = "  <att name=\"" + encode_char_entities(name) + "\" type=\"" +
              type + "\" value=\"" + encode_char_entities(value) + "\"/>\n";
-    writeToFile(fd, xmlTag);
+    output.append(xmlTag);
 
   } else if (slice.isArray()) {
     xmlTag =
         "  <att name=\"" + encode_char_entities(name) + "\" type=\"list\">\n";
-    writeToFile(fd, xmlTag);
+    output.append(xmlTag);
 
     for (VPackSlice val : VPackArrayIterator(slice)) {
-      xgmmlWriteOneAtt(fd, val, name, deep + 1);
+      xgmmlWriteOneAtt(output, val, name, deep + 1);
     }
 
     xmlTag = "  </att>\n";
-    writeToFile(fd, xmlTag);
+    output.append(xmlTag);
 
   } else if (slice.isObject()) {
     xmlTag =
         "  <att name=\"" + encode_char_entities(name) + "\" type=\"list\">\n";
-    writeToFile(fd, xmlTag);
+    output.append(xmlTag);
 
     for (auto it : VPackObjectIterator(slice)) {
-      xgmmlWriteOneAtt(fd, it.value, it.key.copyString(), deep + 1);
+      xgmmlWriteOneAtt(output, it.value, it.key.copyString(), deep + 1);
     }
 
     xmlTag = "  </att>\n";
-    writeToFile(fd, xmlTag);
+    output.append(xmlTag);
   }
 }
 
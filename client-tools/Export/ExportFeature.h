@@ -26,7 +26,14 @@
 #include <velocypack/Builder.h>
 #include <velocypack/Iterator.h>
 
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Basics/Mutex.h"
+#include "Basics/Result.h"
 #include "Basics/files.h"
 #include "Export/arangoexport.h"
 #include "Rest/CommonDefines.h"
@@ -59,17 +66,72 @@ class ExportFeature final : public ArangoExportFeature,
     return _customQueryBindVarsBuilder;
   }
 
+  /// @brief a _key range of a collection (or of one of its shards), which is
+  /// exported through its own streaming cursor by one of the worker threads
+  struct ExportJob {
+    std::string collection;
+    /// @brief shard to restrict the cursor to. empty on single servers
+    std::string shard;
+    /// @brief inclusive lower and exclusive upper bound of the range. an
+    /// empty string means that the range is unbounded on that side
+    std::string lowerKey;
+    std::string upperKey;
+    /// @brief file the documents of the range are written to
+    std::string fileName;
+    /// @brief whether the file is a complete export file with header and
+    /// footer, or a part file that is merged into the collection's file
+    bool standalone = false;
+  };
+
+  /// @brief adds every step-th key of a batch of keys in sorted order to
+  /// keys, until parts - 1 split keys are collected. position is the number
+  /// of keys seen in all batches so far. returns true once all split keys
+  /// have been collected
+  static bool collectSplitKeys(VPackSlice batch, uint64_t step, uint64_t parts,
+                               uint64_t& position,
+                               std::vector<std::string>& keys);
+  /// @brief builds the body of the cursor request exporting the range of a
+  /// job
+  static void buildRangeRequest(VPackBuilder& post, ExportJob const& job,
+                                uint64_t batchSize);
+  /// @brief appends the part files in order to out, and removes them. with
+  /// stripSeparator, the separator in front of the very first document is
+  /// dropped
+  static void appendParts(ManagedDirectory& directory,
+                          ManagedDirectory::File& out,
+                          std::vector<std::string> const& parts,
+                          bool stripSeparator);
+
  private:
   void collectionExport(httpclient::SimpleHttpClient* httpClient);
+  void parallelCollectionExport(httpclient::SimpleHttpClient* httpClient);
+  /// @brief returns the shards of a collection with their number of
+  /// documents. on a single server, a single entry with an empty shard name
+  /// is returned
+  std::vector<std::pair<std::string, uint64_t>> collectionShards(
+      httpclient::SimpleHttpClient* httpClient, std::string const& collection);
+  /// @brief returns up to parts - 1 keys that split the collection (or the
+  /// shard) into key ranges with about the same number of documents
+  std::vector<std::string> splitKeys(httpclient::SimpleHttpClient* httpClient,
+                                     std::string const& collection,
+                                     std::string const& shard, uint64_t count,
+                                     uint64_t parts);
+  void exportRange(httpclient::SimpleHttpClient& httpClient, ExportJob& job);
+  /// @brief concatenates the part files of a collection in order into the
+  /// collection's export file and removes them
+  void mergeParts(std::string const& collection,
+                  std::vector<std::string> const& parts);
+  void reportError(Result const& error);
   void queryExport(httpclient::SimpleHttpClient* httpClient);
   void writeFirstLine(ManagedDirectory::File& fd, std::string const& fileName,
                       std::string const& collection);
+  void writeLastLine(ManagedDirectory::File& fd);
   void writeBatch(ManagedDirectory::File& fd, VPackArrayIterator it,
-                  std::string const& fileName);
+                  bool& firstLine);
   void graphExport(httpclient::SimpleHttpClient* httpClient);
   void writeGraphBatch(ManagedDirectory::File& fd, VPackArrayIterator it,
                        std::string const& fileName);
-  void xgmmlWriteOneAtt(ManagedDirectory::File& fd, VPackSlice const& slice,
+  void xgmmlWriteOneAtt(std::string& output, VPackSlice const& slice,
                         std::string const& name, int deep = 0);
 
   void writeToFile(ManagedDirectory::File& fd, std::string const& string);
@@ -95,15 +157,22 @@ class ExportFeature final : public ArangoExportFeature,
   bool _overwrite;
   bool _progress;
   bool _useGzip;
-  bool _firstLine;
+  bool _splitFiles;
+  uint32_t _threads;
   uint64_t _documentsPerBatch;
-  uint64_t _skippedDeepNested;
-  uint64_t _httpRequestsDone;
+  std::atomic<uint64_t> _skippedDeepNested;
+  std::atomic<uint64_t> _httpRequestsDone;
   std::string _currentCollection;
   std::string _currentGraph;
   std::string _customQueryBindVars;
   std::shared_ptr<VPackBuilder> _customQueryBindVarsBuilder;
   std::unique_ptr<ManagedDirectory> _directory;
+  /// @brief names of the written export files, relative to the directory
+  std::vector<std::string> _exportedFiles;
+  /// @brief serializes opening files in the directory from worker threads
+  Mutex _directoryLock;
+  Mutex _workerErrorLock;
+  Result _workerError;
 
   int* _result;
 };
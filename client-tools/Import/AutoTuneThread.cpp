@@ -21,6 +21,7 @@
 /// @author Matthew Von-Maszewski
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <iostream>
 #include <thread>
 
@@ -57,14 +58,42 @@ using namespace arangodb::import;
 // release
 //  a new thread early in such cases to again encourage rate growth.
 //
+// With a target latency, a closed-loop controller is used instead. The sender
+//  threads report the server latency of each batch and whether the server
+//  signaled overload: HTTP 429 or 503 responses, or requests that were
+//  queued on the server for more than half of the target latency. Once per
+//  second, the controller adjusts the number of senders that may send
+//  concurrently and the batch size (additive increase, multiplicative
+//  decrease):
+//  - overload: halve the concurrency, or the batch size if only one sender
+//    is left. overload means that the server as a whole is saturated.
+//  - average latency above target: shrink the batch size by a quarter, as the
+//    latency of a single batch grows with its size.
+//  - average latency below 80% of the target: add one sender, or grow the
+//    batch size by a quarter of the initial batch size if all senders are
+//    in use already.
+//
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+/// @brief lower bound for the batch size chosen by the latency controller
+constexpr uint64_t minLatencyBatchSize = 64 * 1024;
+}  // namespace
+
 AutoTuneThread::AutoTuneThread(application_features::ApplicationServer& server,
-                               ImportHelper& importHelper)
+                               ImportHelper& importHelper,
+                               double targetLatency)
     : Thread(server, "AutoTuneThread"),
       _importHelper(importHelper),
       _nextSend(std::chrono::steady_clock::now()),
-      _pace(std::chrono::milliseconds(1000 / importHelper.getThreadCount())) {}
+      _pace(std::chrono::milliseconds(1000 / importHelper.getThreadCount())),
+      _targetLatency(targetLatency),
+      _initialBatchSize(importHelper.getMaxUploadSize()),
+      // start with a single sender and let the controller ramp up
+      _concurrency(targetLatency > 0.0 ? 1 : importHelper.getThreadCount()),
+      _periodResponses(0),
+      _periodLatencyMicros(0),
+      _periodOverloaded(0) {}
 
 AutoTuneThread::~AutoTuneThread() { shutdown(); }
 
@@ -77,7 +106,9 @@ void AutoTuneThread::beginShutdown() {
 }
 
 void AutoTuneThread::run() {
-  constexpr uint64_t period = 2;  // seconds
+  // the latency controller reacts faster, as it relies on per-batch
+  // measurements and not on the throughput of a period
+  uint64_t const period = targetsLatency() ? 1 : 2;  // seconds
 
   while (!isStopping()) {
     {
@@ -85,39 +116,105 @@ void AutoTuneThread::run() {
       guard.wait(std::chrono::seconds(period));
     }
     if (!isStopping()) {
-      // getMaxUploadSize() is per thread
-      uint64_t currentMax = _importHelper.getMaxUploadSize();
-      currentMax *= _importHelper.getThreadCount();
-      uint64_t periodActual = _importHelper.rotatePeriodByteCount();
-      uint64_t newMax;
-
-      // is currentMax way too big
-      if (periodActual < currentMax && period < periodActual) {
-        newMax = periodActual / period;
-      } else if (periodActual <= period) {
-        newMax = currentMax / period;
+      if (targetsLatency()) {
+        adjustForLatency();
       } else {
-        newMax = (currentMax + periodActual / period) / 2;
+        adjustForThroughput(period);
       }
+    }
+  }
+}
 
-      // grow number slowly (25%)
-      newMax += newMax / 4;
+void AutoTuneThread::adjustForThroughput(uint64_t period) {
+  // getMaxUploadSize() is per thread
+  uint64_t currentMax = _importHelper.getMaxUploadSize();
+  currentMax *= _importHelper.getThreadCount();
+  uint64_t periodActual = _importHelper.rotatePeriodByteCount();
+  uint64_t newMax;
+
+  // is currentMax way too big
+  if (periodActual < currentMax && period < periodActual) {
+    newMax = periodActual / period;
+  } else if (periodActual <= period) {
+    newMax = currentMax / period;
+  } else {
+    newMax = (currentMax + periodActual / period) / 2;
+  }
 
-      // make "per thread"
-      newMax /= _importHelper.getThreadCount();
+  // grow number slowly (25%)
+  newMax += newMax / 4;
 
-      // notes in Import mention an internal limit of 768MBytes
-      if ((arangodb::import::ImportHelper::MaxBatchSize) < newMax) {
-        newMax = arangodb::import::ImportHelper::MaxBatchSize;
-      }
+  // make "per thread"
+  newMax /= _importHelper.getThreadCount();
+
+  // notes in Import mention an internal limit of 768MBytes
+  if ((arangodb::import::ImportHelper::MaxBatchSize) < newMax) {
+    newMax = arangodb::import::ImportHelper::MaxBatchSize;
+  }
+
+  LOG_TOPIC("e815e", DEBUG, arangodb::Logger::FIXME)
+      << "current: " << currentMax << ", period: " << periodActual
+      << ", new: " << newMax;
 
-      LOG_TOPIC("e815e", DEBUG, arangodb::Logger::FIXME)
-          << "current: " << currentMax << ", period: " << periodActual
-          << ", new: " << newMax;
+  _importHelper.setMaxUploadSize(newMax);
+}
+
+void AutoTuneThread::adjustForLatency() {
+  uint64_t responses = _periodResponses.exchange(0);
+  uint64_t latencyMicros = _periodLatencyMicros.exchange(0);
+  uint64_t overloaded = _periodOverloaded.exchange(0);
+
+  if (responses == 0 && overloaded == 0) {
+    // nothing was sent, e.g. because reading the input is the bottleneck
+    return;
+  }
 
-      _importHelper.setMaxUploadSize(newMax);
+  uint32_t const maxConcurrency = _importHelper.getThreadCount();
+  uint64_t const minBatchSize =
+      std::min<uint64_t>(_initialBatchSize, minLatencyBatchSize);
+  uint32_t concurrency = _concurrency.load(std::memory_order_relaxed);
+  uint64_t batchSize = _importHelper.getMaxUploadSize();
+  double const latency =
+      responses == 0 ? 0.0 : latencyMicros / 1000000.0 / responses;
+
+  if (overloaded > 0) {
+    if (concurrency > 1) {
+      concurrency = std::max<uint32_t>(1, concurrency / 2);
+    } else {
+      batchSize = std::max(minBatchSize, batchSize / 2);
+    }
+  } else if (latency > _targetLatency) {
+    batchSize = std::max(minBatchSize, batchSize - batchSize / 4);
+  } else if (latency < _targetLatency * 0.8) {
+    if (concurrency < maxConcurrency) {
+      ++concurrency;
+    } else {
+      batchSize = std::min<uint64_t>(
+          ImportHelper::MaxBatchSize,
+          batchSize + std::max<uint64_t>(1, _initialBatchSize / 4));
     }
   }
+
+  LOG_TOPIC("2e9d7", DEBUG, arangodb::Logger::FIXME)
+      << "batches: " << responses << ", average latency: " << latency
+      << " s, overloaded: " << overloaded
+      << ", concurrency: " << concurrency << ", batch size: " << batchSize;
+
+  _concurrency.store(concurrency, std::memory_order_relaxed);
+  _importHelper.setMaxUploadSize(batchSize);
+}
+
+void AutoTuneThread::recordResponse(
+    std::chrono::steady_clock::duration latency, bool overloaded) noexcept {
+  if (overloaded) {
+    _periodOverloaded.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    _periodResponses.fetch_add(1, std::memory_order_relaxed);
+    _periodLatencyMicros.fetch_add(
+        std::chrono::duration_cast<std::chrono::microseconds>(latency)
+            .count(),
+        std::memory_order_relaxed);
+  }
 }
 
 void AutoTuneThread::paceSends() {
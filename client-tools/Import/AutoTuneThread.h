@@ -23,6 +23,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
 #include "Basics/ConditionVariable.h"
 #include "Basics/Thread.h"
 #include "Logger/Logger.h"
@@ -42,8 +46,11 @@ class AutoTuneThread final : public arangodb::Thread {
   AutoTuneThread& operator=(AutoTuneThread const&) = delete;
 
  public:
+  /// @brief a targetLatency of 0 selects the throughput-based pacing.
+  /// otherwise the number of concurrent senders and the batch size are
+  /// adjusted to keep the server latency of batches below the target
   explicit AutoTuneThread(application_features::ApplicationServer& server,
-                          ImportHelper& importHelper);
+                          ImportHelper& importHelper, double targetLatency);
 
   ~AutoTuneThread();
 
@@ -51,13 +58,49 @@ class AutoTuneThread final : public arangodb::Thread {
 
   void paceSends();
 
+  /// @brief whether the latency-targeting controller is used
+  bool targetsLatency() const noexcept { return _targetLatency > 0.0; }
+
+  /// @brief target server latency per batch (in seconds)
+  double targetLatency() const noexcept { return _targetLatency; }
+
+  /// @brief number of sender threads that may send batches concurrently
+  uint32_t concurrency() const noexcept {
+    return _concurrency.load(std::memory_order_relaxed);
+  }
+
+  /// @brief record the server latency of a batch and whether the server
+  /// signaled overload (HTTP 429/503 or queued requests). called by the
+  /// sender threads
+  void recordResponse(std::chrono::steady_clock::duration latency,
+                      bool overloaded) noexcept;
+
  protected:
   void run() override;
 
+ private:
+  /// @brief throughput-based heuristic, adjusting the batch size only
+  void adjustForThroughput(uint64_t period);
+
+  /// @brief AIMD controller for concurrency and batch size
+  void adjustForLatency();
+
+ protected:
   ImportHelper& _importHelper;
   basics::ConditionVariable _condition;
   std::chrono::steady_clock::time_point _nextSend;
   std::chrono::microseconds _pace;
+
+  double const _targetLatency;
+  /// @brief the batch size the import started with, used as the additive
+  /// increment of the batch size
+  uint64_t const _initialBatchSize;
+  std::atomic<uint32_t> _concurrency;
+
+  /// @brief responses recorded in the current period
+  std::atomic<uint64_t> _periodResponses;
+  std::atomic<uint64_t> _periodLatencyMicros;
+  std::atomic<uint64_t> _periodOverloaded;
 };
 }  // namespace import
 }  // namespace arangodb
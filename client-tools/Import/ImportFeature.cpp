@@ -58,8 +58,10 @@ ImportFeature::ImportFeature(Server& server, int* result)
       _useBackslash(false),
       _convert(true),
       _autoChunkSize(false),
+      _targetLatency(0.0),
       _chunkSize(1024 * 1024 * 8),
       _threadCount(2),
+      _parseThreads(1),
       _collectionName(""),
       _fromCollectionPrefix(""),
       _toCollectionPrefix(""),
@@ -96,6 +98,17 @@ void ImportFeature::collectOptions(
                   new BooleanParameter(&_autoChunkSize))
       .setIntroducedIn(30711);
 
+  options
+      ->addOption("--auto-rate-limit-target-latency",
+                  "The server latency per batch (in seconds) to aim for. "
+                  "If set, implies `--auto-rate-limit` and adapts the number "
+                  "of concurrently sending threads and the batch size to "
+                  "keep the latency below this value. The import backs off "
+                  "if the server signals overload (HTTP 429/503 or queued "
+                  "requests) and retries rejected batches. 0 = disabled.",
+                  new DoubleParameter(&_targetLatency))
+      .setIntroducedIn(31100);
+
   options->addOption("--backslash-escape",
                      "Use backslash as the escape character for quotes. Used "
                      "for CSV and TSV imports.",
@@ -110,6 +123,14 @@ void ImportFeature::collectOptions(
       new UInt32Parameter(&_threadCount),
       arangodb::options::makeDefaultFlags(arangodb::options::Flags::Dynamic));
 
+  options
+      ->addOption("--parse-threads",
+                  "Number of threads for parsing CSV and TSV input. "
+                  "Values greater than 1 split the input into chunks of "
+                  "complete rows, which are converted in parallel.",
+                  new UInt32Parameter(&_parseThreads))
+      .setIntroducedIn(31100);
+
   options->addOption("--collection",
                      "The name of the collection to import into.",
                      new StringParameter(&_collectionName));
@@ -280,6 +301,14 @@ void ImportFeature::validateOptions(
     _chunkSize = arangodb::import::ImportHelper::MaxBatchSize;
   }
 
+  if (_targetLatency < 0.0) {
+    LOG_TOPIC("5e0c8", WARN, arangodb::Logger::FIXME)
+        << "ignoring negative --auto-rate-limit-target-latency value";
+    _targetLatency = 0.0;
+  } else if (_targetLatency > 0.0) {
+    _autoChunkSize = true;
+  }
+
   if (_threadCount < 1) {
     // it's not sensible to use just one thread
     LOG_TOPIC("9e3f9", WARN, arangodb::Logger::FIXME)
@@ -293,6 +322,14 @@ void ImportFeature::validateOptions(
         << "capping --threads value to " << NumberOfCores::getValue() * 2;
     _threadCount = static_cast<uint32_t>(NumberOfCores::getValue()) * 2;
   }
+  if (_parseThreads < 1 || _parseThreads > NumberOfCores::getValue()) {
+    uint32_t value = std::clamp(
+        _parseThreads, uint32_t(1),
+        static_cast<uint32_t>(NumberOfCores::getValue()));
+    LOG_TOPIC("3b8f1", WARN, arangodb::Logger::FIXME)
+        << "capping --parse-threads value to " << value;
+    _parseThreads = value;
+  }
 
   for (auto const& it : _translations) {
     auto parts = StringUtils::split(it, '=');
@@ -440,8 +477,13 @@ void ImportFeature::start() {
     if (_typeImport == "csv" || _typeImport == "tsv") {
       std::cout << "separator:              " << _separator << std::endl;
       std::cout << "headers file:           " << _headersFile << std::endl;
+      std::cout << "parse threads:          " << _parseThreads << std::endl;
     }
     std::cout << "threads:                " << _threadCount << std::endl;
+    if (_targetLatency > 0.0) {
+      std::cout << "target latency:         " << _targetLatency << " s"
+                << std::endl;
+    }
     std::cout << "on duplicate:           " << _onDuplicateAction << std::endl;
 
     std::cout << "connect timeout:        " << client.connectionTimeout()
@@ -506,7 +548,7 @@ void ImportFeature::start() {
   SimpleHttpClientParams params = _httpClient->params();
   arangodb::import::ImportHelper ih(encryption, client, client.endpoint(),
                                     params, _chunkSize, _threadCount,
-                                    _autoChunkSize);
+                                    _autoChunkSize, _targetLatency);
 
   // create colletion
   if (_createCollection) {
@@ -587,6 +629,8 @@ void ImportFeature::start() {
     ih.setProgress(true);
   }
 
+  ih.setParseThreads(_parseThreads);
+
   // progress
   if (_latencyStats) {
     ih.startHistogram();
@@ -57,8 +57,10 @@ class ImportFeature final : public ArangoImportFeature,
   bool _useBackslash;
   bool _convert;
   bool _autoChunkSize;
+  double _targetLatency;
   uint64_t _chunkSize;
   uint32_t _threadCount;
+  uint32_t _parseThreads;
   std::string _collectionName;
   std::string _fromCollectionPrefix;
   std::string _toCollectionPrefix;
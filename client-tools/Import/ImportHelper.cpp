@@ -31,6 +31,7 @@
 #include "Basics/files.h"
 #include "Basics/system-functions.h"
 #include "Basics/tri-strings.h"
+#include "Import/ParserThread.h"
 #include "Import/SenderThread.h"
 #include "Logger/Logger.h"
 #include "Rest/GeneralResponse.h"
@@ -44,6 +45,9 @@
 #include <velocypack/Collection.h>
 #include <velocypack/Iterator.h>
 
+#include <algorithm>
+#include <limits>
+
 #ifdef TRI_HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -171,16 +175,20 @@ ImportHelper::ImportHelper(EncryptionFeature* encryption,
                            std::string const& endpoint,
                            httpclient::SimpleHttpClientParams const& params,
                            uint64_t maxUploadSize, uint32_t threadCount,
-                           bool autoUploadSize)
-    : _encryption{encryption},
+                           bool autoUploadSize, double targetLatency)
+    : _server(client.server()),
+      _encryption{encryption},
       _httpClient(client.createHttpClient(endpoint, params)),
       _maxUploadSize(maxUploadSize),
       _periodByteCount(0),
       _autoUploadSize(autoUploadSize),
       _threadCount(threadCount),
+      _parseThreads(1),
       _tempBuffer(false),
       _separator(","),
       _quote("\""),
+      _separatorChar(','),
+      _importType(CSV),
       _createCollectionType("document"),
       _useBackslash(false),
       _convert(true),
@@ -199,26 +207,36 @@ ImportHelper::ImportHelper(EncryptionFeature* encryption,
       _onDuplicateAction("error"),
       _collectionName(),
       _overwriteCollectionPrefix(false),
-      _lineBuffer(false),
       _outputBuffer(false),
       _firstLine(""),
       _columnNames(),
       _hasError(false),
-      _headersSeen(false),
-      _emittedField(false) {
+      _headersSeen(false) {
+  // should self tuning code activate?
+  if (_autoUploadSize) {
+    _autoTuneThread = std::make_unique<AutoTuneThread>(client.server(), *this,
+                                                       targetLatency);
+  }
+
+  // with a target latency, the senders report the latency of each batch
+  AutoTuneThread* latencyTuner =
+      (_autoTuneThread != nullptr && _autoTuneThread->targetsLatency())
+          ? _autoTuneThread.get()
+          : nullptr;
+
   for (uint32_t i = 0; i < threadCount; i++) {
     auto http = client.createHttpClient(endpoint, params);
-    _senderThreads.emplace_back(
-        new SenderThread(client.server(), std::move(http), &_stats, [this]() {
+    _senderThreads.emplace_back(new SenderThread(
+        client.server(), std::move(http), &_stats,
+        [this]() {
           CONDITION_LOCKER(guard, _threadsCondition);
           guard.signal();
-        }));
+        },
+        latencyTuner));
     _senderThreads.back()->start();
   }
 
-  // should self tuning code activate?
-  if (_autoUploadSize) {
-    _autoTuneThread = std::make_unique<AutoTuneThread>(client.server(), *this);
+  if (_autoTuneThread != nullptr) {
     _autoTuneThread->start();
   }
 
@@ -243,9 +261,7 @@ ImportHelper::~ImportHelper() {
 }
 
 // read headers from separate file
-bool ImportHelper::readHeadersFile(std::string const& headersFile,
-                                   DelimitedImportType typeImport,
-                                   char separator) {
+bool ImportHelper::readHeadersFile(std::string const& headersFile) {
   TRI_ASSERT(!headersFile.empty());
   TRI_ASSERT(!_headersSeen);
 
@@ -268,20 +284,9 @@ bool ImportHelper::readHeadersFile(std::string const& headersFile,
   size_t rowsToSkip = _rowsToSkip;
   _rowsToSkip = 0;
 
+  CsvState state(_outputBuffer, _convert, /*dataOnly*/ false);
   TRI_csv_parser_t parser;
-  TRI_InitCsvParser(&parser, ProcessCsvBegin, ProcessCsvAdd, ProcessCsvEnd,
-                    nullptr);
-  TRI_SetSeparatorCsvParser(&parser, separator);
-  TRI_UseBackslashCsvParser(&parser, _useBackslash);
-
-  // in csv, we'll use the quote char if set
-  // in tsv, we do not use the quote char
-  if (typeImport == ImportHelper::CSV && _quote.size() > 0) {
-    TRI_SetQuoteCsvParser(&parser, _quote[0], true);
-  } else {
-    TRI_SetQuoteCsvParser(&parser, '\0', false);
-  }
-  parser._dataAdd = this;
+  initCsvParser(parser, state);
 
   auto guard =
       scopeGuard([&parser]() noexcept { TRI_DestroyCsvParser(&parser); });
@@ -320,9 +325,7 @@ bool ImportHelper::readHeadersFile(std::string const& headersFile,
   }
 
   // reset our state properly
-  _lineBuffer.clear();
   _headersSeen = true;
-  _emittedField = false;
   _rowOffset = 0;
   _rowsRead = 0;
   _numberLines = 0;
@@ -352,11 +355,9 @@ bool ImportHelper::importDelimited(std::string const& collectionName,
   _collectionName = collectionName;
   _firstLine = "";
   _outputBuffer.clear();
-  _lineBuffer.clear();
   _errorMessages.clear();
   _hasError = false;
   _headersSeen = false;
-  _emittedField = false;
   _rowOffset = 0;
   _rowsRead = 0;
   _numberLines = 0;
@@ -383,9 +384,10 @@ bool ImportHelper::importDelimited(std::string const& collectionName,
     separator = s[0];
     TRI_Free(s);
   }
+  _separatorChar = separator;
+  _importType = typeImport;
 
-  if (!headersFile.empty() &&
-      !readHeadersFile(headersFile, typeImport, separator)) {
+  if (!headersFile.empty() && !readHeadersFile(headersFile)) {
     return false;
   }
 
@@ -411,41 +413,37 @@ bool ImportHelper::importDelimited(std::string const& collectionName,
   // progress display control variables
   double nextProgress = ProgressStep;
 
+  CsvState state(_outputBuffer, _convert, /*dataOnly*/ false);
   TRI_csv_parser_t parser;
-  TRI_InitCsvParser(&parser, ProcessCsvBegin, ProcessCsvAdd, ProcessCsvEnd,
-                    nullptr);
-  TRI_SetSeparatorCsvParser(&parser, separator);
-  TRI_UseBackslashCsvParser(&parser, _useBackslash);
+  initCsvParser(parser, state);
 
-  // in csv, we'll use the quote char if set
-  // in tsv, we do not use the quote char
-  if (typeImport == ImportHelper::CSV && _quote.size() > 0) {
-    TRI_SetQuoteCsvParser(&parser, _quote[0], true);
+  if (_parseThreads > 1) {
+    if (!parseDelimitedParallel(*fd, parser, totalLength, nextProgress)) {
+      TRI_DestroyCsvParser(&parser);
+      return false;
+    }
   } else {
-    TRI_SetQuoteCsvParser(&parser, '\0', false);
-  }
-  parser._dataAdd = this;
-
-  constexpr int BUFFER_SIZE = 262144;
-  char buffer[BUFFER_SIZE];
+    constexpr int BUFFER_SIZE = 262144;
+    char buffer[BUFFER_SIZE];
 
-  while (!_hasError) {
-    auto n = fd->read(buffer, sizeof(buffer));
+    while (!_hasError) {
+      auto n = fd->read(buffer, sizeof(buffer));
 
-    if (n < 0) {
-      TRI_DestroyCsvParser(&parser);
-      _errorMessages.push_back(TRI_LAST_ERROR_STR);
-      return false;
-    } else if (n == 0) {
-      // we have read the entire file
-      // now have the CSV parser parse an additional new line so it
-      // will definitely process the last line of the input data if
-      // it did not end with a newline
-      TRI_ParseCsvString(&parser, "\n", 1);
-      break;
+      if (n < 0) {
+        TRI_DestroyCsvParser(&parser);
+        _errorMessages.push_back(TRI_LAST_ERROR_STR);
+        return false;
+      } else if (n == 0) {
+        // we have read the entire file
+        // now have the CSV parser parse an additional new line so it
+        // will definitely process the last line of the input data if
+        // it did not end with a newline
+        TRI_ParseCsvString(&parser, "\n", 1);
+        break;
+      }
+      reportProgress(totalLength, fd->offset(), nextProgress);
+      TRI_ParseCsvString(&parser, buffer, n);
     }
-    reportProgress(totalLength, fd->offset(), nextProgress);
-    TRI_ParseCsvString(&parser, buffer, n);
   }
 
   // trailing buffer items than can be accumulated because buffer length is
@@ -453,6 +451,7 @@ bool ImportHelper::importDelimited(std::string const& collectionName,
   handleCsvBuffer(0);
 
   TRI_DestroyCsvParser(&parser);
+  _numberLines += state.numberLines;
 
   waitForSenders();
   reportProgress(totalLength, fd->offset(), nextProgress);
@@ -461,6 +460,165 @@ bool ImportHelper::importDelimited(std::string const& collectionName,
   return !_hasError;
 }
 
+bool ImportHelper::parseDelimitedParallel(ManagedDirectory::File& fd,
+                                          TRI_csv_parser_t& parser,
+                                          int64_t totalLength,
+                                          double& nextProgress) {
+  std::vector<std::unique_ptr<ParserThread>> parsers;
+  for (uint32_t i = 0; i < _parseThreads; ++i) {
+    parsers.emplace_back(
+        std::make_unique<ParserThread>(_server, *this, [this]() {
+          CONDITION_LOCKER(guard, _threadsCondition);
+          guard.signal();
+        }));
+    parsers.back()->start();
+  }
+
+  // the rows to skip and the header determine how the data rows are
+  // converted, so they are handled by the serial parser
+  size_t serialRecords = _rowsToSkip + (_headersSeen ? 0 : 1);
+
+  // the input is split into chunks of complete records, which are handed
+  // to the parser threads in turn. their results are collected in the same
+  // order, so that batches are sent in input order
+  constexpr size_t readSize = 1048576;
+  size_t const chunkSize = std::clamp<uint64_t>(
+      4 * getMaxUploadSize(), readSize, 64 * readSize);
+  size_t next = 0;
+  basics::StringBuffer input(false);
+  bool atEnd = false;
+
+  while (!_hasError && !atEnd) {
+    if (input.reserve(readSize) == TRI_ERROR_OUT_OF_MEMORY) {
+      _errorMessages.emplace_back(TRI_errno_string(TRI_ERROR_OUT_OF_MEMORY));
+      return false;
+    }
+    auto n = fd.read(input.end(), readSize);
+    if (n < 0) {
+      _errorMessages.push_back(TRI_LAST_ERROR_STR);
+      return false;
+    } else if (n == 0) {
+      atEnd = true;
+    } else {
+      input.increaseLength(n);
+      reportProgress(totalLength, fd.offset(), nextProgress);
+    }
+
+    if (serialRecords > 0) {
+      size_t records = serialRecords;
+      size_t length = input.length();
+      if (!atEnd) {
+        length = TRI_ScanCsvRecords(&parser, input.begin(), input.length(),
+                                    &records);
+      }
+      TRI_ParseCsvString(&parser, input.begin(), length);
+      input.erase_front(length);
+      if (atEnd) {
+        // process the last line of the input data even if it did not end
+        // with a newline
+        TRI_ParseCsvString(&parser, "\n", 1);
+        break;
+      }
+      serialRecords -= records;
+      if (serialRecords > 0) {
+        continue;
+      }
+    }
+
+    if (input.length() < chunkSize && !atEnd) {
+      continue;
+    }
+
+    size_t length = input.length();
+    if (!atEnd) {
+      size_t records = std::numeric_limits<size_t>::max();
+      length =
+          TRI_ScanCsvRecords(&parser, input.begin(), input.length(), &records);
+      if (length == 0) {
+        // a single record larger than the chunk size. read more
+        continue;
+      }
+    }
+
+    ParserThread& thread = *parsers[next];
+    next = (next + 1) % parsers.size();
+    // the thread's previous chunk is the oldest chunk still in flight
+    if (!collectParsedData(thread)) {
+      break;
+    }
+    thread.parseData(input.begin(), length, atEnd);
+    input.erase_front(length);
+  }
+
+  for (size_t i = 0; i < parsers.size(); ++i) {
+    collectParsedData(*parsers[(next + i) % parsers.size()]);
+  }
+
+  return true;
+}
+
+bool ImportHelper::collectParsedData(ParserThread& thread) {
+  while (!thread.isIdle()) {
+    CONDITION_LOCKER(guard, _threadsCondition);
+    guard.wait(10000);
+  }
+
+  if (thread.hasError()) {
+    if (!_hasError) {
+      _hasError = true;
+      _errorMessages.push_back(thread.errorMessage());
+    }
+    return false;
+  }
+
+  size_t numberLines = 0;
+  std::vector<CsvBatch> batches = thread.takeBatches(numberLines);
+  _numberLines += numberLines;
+
+  for (auto& batch : batches) {
+    _rowsRead += batch.rows;
+    if (batch.data->length() > 0) {
+      sendCsvBuffer(*batch.data);
+    } else {
+      _rowOffset = _rowsRead;
+    }
+  }
+  return !_hasError;
+}
+
+void ImportHelper::parseCsvChunk(char const* data, size_t length, bool atEnd,
+                                 std::vector<CsvBatch>& batches,
+                                 size_t& numberLines) {
+  basics::StringBuffer outputBuffer(false);
+  CsvState state(outputBuffer, _convert, /*dataOnly*/ true);
+  TRI_csv_parser_t parser;
+  initCsvParser(parser, state);
+
+  auto guard =
+      scopeGuard([&parser]() noexcept { TRI_DestroyCsvParser(&parser); });
+
+  TRI_ParseCsvString(&parser, data, length);
+  if (atEnd) {
+    // process the last line of the input data even if it did not end with
+    // a newline
+    TRI_ParseCsvString(&parser, "\n", 1);
+  }
+  if (state.outputBuffer.length() > 0 || state.rowsRead > state.batchedRows) {
+    finishCsvBatch(state);
+  }
+
+  batches = std::move(state.batches);
+  numberLines = state.numberLines;
+}
+
+void ImportHelper::finishCsvBatch(CsvState& state) {
+  auto data = std::make_unique<basics::StringBuffer>(false);
+  data->swap(&state.outputBuffer);
+  state.batches.push_back(
+      CsvBatch{std::move(data), state.rowsRead - state.batchedRows});
+  state.batchedRows = state.rowsRead;
+}
+
 bool ImportHelper::importJson(std::string const& collectionName,
                               std::string const& pathName,
                               bool assumeLinewise) {
@@ -974,30 +1132,51 @@ std::string ImportHelper::getCollectionUrlPart() const {
   return std::string("collection=" + StringUtils::urlEncode(_collectionName));
 }
 
+void ImportHelper::initCsvParser(TRI_csv_parser_t& parser, CsvState& state) {
+  TRI_InitCsvParser(&parser, ProcessCsvBegin, ProcessCsvAdd, ProcessCsvEnd,
+                    &state);
+  TRI_SetSeparatorCsvParser(&parser, _separatorChar);
+  TRI_UseBackslashCsvParser(&parser, _useBackslash);
+
+  // in csv, we'll use the quote char if set
+  // in tsv, we do not use the quote char
+  if (_importType == ImportHelper::CSV && _quote.size() > 0) {
+    TRI_SetQuoteCsvParser(&parser, _quote[0], true);
+  } else {
+    TRI_SetQuoteCsvParser(&parser, '\0', false);
+  }
+  parser._dataAdd = this;
+}
+
+bool ImportHelper::isHeaderRow(CsvState const& state, size_t row) const {
+  return !state.dataOnly && row == _rowsToSkip && !_headersSeen;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief start a new csv line
 ////////////////////////////////////////////////////////////////////////////////
 
 void ImportHelper::ProcessCsvBegin(TRI_csv_parser_t* parser, size_t row) {
-  static_cast<ImportHelper*>(parser->_dataAdd)->beginLine(row);
+  static_cast<ImportHelper*>(parser->_dataAdd)
+      ->beginLine(*static_cast<CsvState*>(parser->_data), row);
 }
 
-void ImportHelper::beginLine(size_t row) {
-  _fieldsLookUpTable.clear();
-  if (_lineBuffer.length() > 0) {
+void ImportHelper::beginLine(CsvState& state, size_t row) {
+  state.fieldsLookUpTable.clear();
+  if (state.lineBuffer.length() > 0) {
     // error
     MUTEX_LOCKER(guard, _stats._mutex);
     ++_stats._numberErrors;
-    _lineBuffer.clear();
+    state.lineBuffer.clear();
   }
 
-  ++_numberLines;
-  _emittedField = false;
+  ++state.numberLines;
+  state.emittedField = false;
 
-  if (row > 0 + _rowsToSkip) {
-    _lineBuffer.appendChar('\n');
+  if (state.dataOnly || row > 0 + _rowsToSkip) {
+    state.lineBuffer.appendChar('\n');
   }
-  _lineBuffer.appendChar('[');
+  state.lineBuffer.appendChar('[');
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1008,18 +1187,20 @@ void ImportHelper::ProcessCsvAdd(TRI_csv_parser_t* parser, char const* field,
                                  size_t fieldLength, size_t row, size_t column,
                                  bool escaped) {
   auto importHelper = static_cast<ImportHelper*>(parser->_dataAdd);
-  importHelper->addField(field, fieldLength, row, column, escaped);
+  importHelper->addField(*static_cast<CsvState*>(parser->_data), field,
+                         fieldLength, row, column, escaped);
 }
 
-void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
-                            size_t column, bool escaped) {
-  if (_rowsRead < _rowsToSkip) {
+void ImportHelper::addField(CsvState& state, char const* field,
+                            size_t fieldLength, size_t row, size_t column,
+                            bool escaped) {
+  if (!state.dataOnly && _rowsRead < _rowsToSkip) {
     // still some rows left to skip over
     return;
   }
 
   // we are reading the first line if we get here
-  if (row == _rowsToSkip && !_headersSeen) {
+  if (isHeaderRow(state, row)) {
     std::string name = std::string(field, fieldLength);
     if (fieldLength > 0) {  // translate field
       auto it = _translations.find(name);
@@ -1041,21 +1222,22 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
 
   auto guard = scopeGuard([&]() noexcept {
     if (!_mergeAttributesInstructions.empty()) {
-      _fieldsLookUpTable.try_emplace(_columnNames[column],
-                                     std::move(lookUpTableValue));
+      state.fieldsLookUpTable.try_emplace(_columnNames[column],
+                                          std::move(lookUpTableValue));
     }
   });
 
   // we will write out this attribute!
+  basics::StringBuffer& lineBuffer = state.lineBuffer;
 
-  if (column > 0 && _emittedField) {
-    _lineBuffer.appendChar(',');
+  if (column > 0 && state.emittedField) {
+    lineBuffer.appendChar(',');
   }
 
-  _emittedField = true;
+  state.emittedField = true;
 
-  if (_keyColumn == -1 && row == _rowsToSkip && !_headersSeen &&
-      fieldLength == 4 && memcmp(field, "_key", 4) == 0) {
+  if (_keyColumn == -1 && isHeaderRow(state, row) && fieldLength == 4 &&
+      memcmp(field, "_key", 4) == 0) {
     _keyColumn = column;
   }
 
@@ -1069,11 +1251,10 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
     lookUpTableValue = field;
   }
 
-  if ((row == _rowsToSkip && !_headersSeen) ||
-      (escaped && itTypes == _datatypes.end()) ||
+  if (isHeaderRow(state, row) || (escaped && itTypes == _datatypes.end()) ||
       _keyColumn == static_cast<decltype(_keyColumn)>(column)) {
     // headline or escaped value
-    _lineBuffer.appendJsonEncoded(field, fieldLength);
+    lineBuffer.appendJsonEncoded(field, fieldLength);
     return;
   }
 
@@ -1082,12 +1263,12 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
     std::string const& datatype = (*itTypes).second;
     if (datatype == "number") {
       if (::isInteger(field, fieldLength) || ::isDecimal(field, fieldLength)) {
-        _lineBuffer.appendText(field, fieldLength);
+        lineBuffer.appendText(field, fieldLength);
       } else {
         if (!_mergeAttributesInstructions.empty()) {
           lookUpTableValue = "0";
         }
-        _lineBuffer.appendText("0", 1);
+        lineBuffer.appendText("0", 1);
       }
     } else if (datatype == "boolean") {
       if ((fieldLength == 5 && memcmp(field, "false", 5) == 0) ||
@@ -1096,29 +1277,29 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
         if (!_mergeAttributesInstructions.empty()) {
           lookUpTableValue = "false";
         }
-        _lineBuffer.appendText("false", 5);
+        lineBuffer.appendText("false", 5);
       } else {
         if (!_mergeAttributesInstructions.empty()) {
           lookUpTableValue = "true";
         }
-        _lineBuffer.appendText("true", 4);
+        lineBuffer.appendText("true", 4);
       }
     } else if (datatype == "null") {
       if (!_mergeAttributesInstructions.empty()) {
         lookUpTableValue = "null";
       }
-      _lineBuffer.appendText("null", 4);
+      lineBuffer.appendText("null", 4);
     } else {
       // string
       TRI_ASSERT(datatype == "string");
-      _lineBuffer.appendJsonEncoded(field, fieldLength);
+      lineBuffer.appendJsonEncoded(field, fieldLength);
     }
     return;
   }
 
   if (*field == '\0' || fieldLength == 0) {
     // do nothing
-    _lineBuffer.appendText("null", 4);
+    lineBuffer.appendText("null", 4);
     if (!_mergeAttributesInstructions.empty()) {
       lookUpTableValue = "null";
     }
@@ -1126,12 +1307,12 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
   }
 
   // automatic detection of datatype based on value (--convert)
-  if (_convert) {
+  if (state.convert) {
     // check for literals null, false and true
     if ((fieldLength == 4 &&
          (memcmp(field, "true", 4) == 0 || memcmp(field, "null", 4) == 0)) ||
         (fieldLength == 5 && memcmp(field, "false", 5) == 0)) {
-      _lineBuffer.appendText(field, fieldLength);
+      lineBuffer.appendText(field, fieldLength);
     } else if (::isInteger(field, fieldLength)) {
       // integer value
       // conversion might fail with out-of-range error
@@ -1146,16 +1327,16 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
         }
 
         int64_t num = StringUtils::int64(field, fieldLength);
-        size_t bufPos = _lineBuffer.length();
-        _lineBuffer.appendInteger(num);
+        size_t bufPos = lineBuffer.length();
+        lineBuffer.appendInteger(num);
         if (!_mergeAttributesInstructions.empty()) {
           lookUpTableValue =
-              std::string(_lineBuffer.stringBuffer()->_buffer + bufPos,
-                          _lineBuffer.length() - bufPos);
+              std::string(lineBuffer.stringBuffer()->_buffer + bufPos,
+                          lineBuffer.length() - bufPos);
         }
       } catch (...) {
         // conversion failed
-        _lineBuffer.appendJsonEncoded(field, fieldLength);
+        lineBuffer.appendJsonEncoded(field, fieldLength);
       }
     } else if (::isDecimal(field, fieldLength)) {
       // double value
@@ -1167,12 +1348,12 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
         if (pos == fieldLength) {
           bool failed = (num != num || num == HUGE_VAL || num == -HUGE_VAL);
           if (!failed) {
-            size_t bufPos = _lineBuffer.length();
-            _lineBuffer.appendDecimal(num);
+            size_t bufPos = lineBuffer.length();
+            lineBuffer.appendDecimal(num);
             if (!_mergeAttributesInstructions.empty()) {
               lookUpTableValue =
-                  std::string(_lineBuffer.stringBuffer()->_buffer + bufPos,
-                              _lineBuffer.length() - bufPos);
+                  std::string(lineBuffer.stringBuffer()->_buffer + bufPos,
+                              lineBuffer.length() - bufPos);
             }
             return;
           }
@@ -1184,21 +1365,21 @@ void ImportHelper::addField(char const* field, size_t fieldLength, size_t row,
         // fall-through to appending the number as a string
       }
 
-      _lineBuffer.appendChar('"');
-      _lineBuffer.appendText(field, fieldLength);
-      _lineBuffer.appendChar('"');
+      lineBuffer.appendChar('"');
+      lineBuffer.appendText(field, fieldLength);
+      lineBuffer.appendChar('"');
     } else {
-      _lineBuffer.appendJsonEncoded(field, fieldLength);
+      lineBuffer.appendJsonEncoded(field, fieldLength);
     }
   } else {
     if (::isInteger(field, fieldLength) || ::isDecimal(field, fieldLength)) {
       // numeric value. don't convert
-      _lineBuffer.appendChar('"');
-      _lineBuffer.appendText(field, fieldLength);
-      _lineBuffer.appendChar('"');
+      lineBuffer.appendChar('"');
+      lineBuffer.appendText(field, fieldLength);
+      lineBuffer.appendChar('"');
     } else {
       // non-numeric value
-      _lineBuffer.appendJsonEncoded(field, fieldLength);
+      lineBuffer.appendJsonEncoded(field, fieldLength);
     }
   }
 }
@@ -1211,32 +1392,42 @@ void ImportHelper::ProcessCsvEnd(TRI_csv_parser_t* parser, char const* field,
                                  size_t fieldLength, size_t row, size_t column,
                                  bool escaped) {
   auto importHelper = static_cast<ImportHelper*>(parser->_dataAdd);
+  auto& state = *static_cast<CsvState*>(parser->_data);
+
+  if (state.dataOnly) {
+    // rows of a parser thread are counted by the thread
+    ++state.rowsRead;
+    importHelper->addLastField(state, field, fieldLength, row, column,
+                               escaped);
+    return;
+  }
 
   if (importHelper->getRowsRead() < importHelper->getRowsToSkip()) {
     importHelper->incRowsRead();
     return;
   }
 
-  importHelper->addLastField(field, fieldLength, row, column, escaped);
+  importHelper->addLastField(state, field, fieldLength, row, column, escaped);
   importHelper->incRowsRead();
 }
 
-void ImportHelper::addLastField(char const* field, size_t fieldLength,
-                                size_t row, size_t column, bool escaped) {
+void ImportHelper::addLastField(CsvState& state, char const* field,
+                                size_t fieldLength, size_t row, size_t column,
+                                bool escaped) {
   if (column == 0 && *field == '\0') {
     // ignore empty line
-    _lineBuffer.reset();
+    state.lineBuffer.reset();
     return;
   }
 
-  addField(field, fieldLength, row, column++, escaped);
+  addField(state, field, fieldLength, row, column++, escaped);
 
   // add --merge-attributes arguments
   if (!_mergeAttributesInstructions.empty()) {
     for (auto const& it : _mergeAttributesInstructions) {
       auto const& key = it.first;
       auto const& value = it.second;
-      if (row == _rowsToSkip && !_headersSeen) {
+      if (isHeaderRow(state, row)) {
         std::for_each(
             value.begin(), value.end(),
             [this, &key](Step const& attrProperties) {
@@ -1251,62 +1442,74 @@ void ImportHelper::addLastField(char const* field, size_t fieldLength,
                 }
               }
             });
-        addField(key.c_str(), key.size(), row, column, escaped);
+        addField(state, key.c_str(), key.size(), row, column, escaped);
       } else {
         std::string attrsToMerge;
         std::for_each(
             value.begin(), value.end(),
-            [this, &attrsToMerge](Step const& attrProperties) {
+            [&state, &attrsToMerge](Step const& attrProperties) {
               if (!attrProperties.isLiteral) {
-                if (auto it = _fieldsLookUpTable.find(attrProperties.value);
-                    it != _fieldsLookUpTable.end()) {
+                if (auto it =
+                        state.fieldsLookUpTable.find(attrProperties.value);
+                    it != state.fieldsLookUpTable.end()) {
                   attrsToMerge += it->second;
                 }
               } else {
                 attrsToMerge += attrProperties.value;
               }
             });
-        bool tmp = _convert;
-        _convert =
+        bool tmp = state.convert;
+        state.convert =
             false;  // force only --merge-attribute arguments to be treated as
                     // string then switch back to normal conversion
-        addField(attrsToMerge.c_str(), attrsToMerge.size(), row, column,
+        addField(state, attrsToMerge.c_str(), attrsToMerge.size(), row, column,
                  escaped);
-        _convert = tmp;
+        state.convert = tmp;
       }
       column++;
     }
   }
 
-  _lineBuffer.appendChar(']');
+  state.lineBuffer.appendChar(']');
 
-  if (row == _rowsToSkip && !_headersSeen) {
+  if (isHeaderRow(state, row)) {
     // save the first line
-    _firstLine = std::string(_lineBuffer.c_str(), _lineBuffer.length());
-    _lineBuffer.reset();
+    _firstLine =
+        std::string(state.lineBuffer.c_str(), state.lineBuffer.length());
+    state.lineBuffer.reset();
     return;
-  } else if (row > _rowsToSkip && _firstLine.empty()) {
+  } else if ((state.dataOnly || row > _rowsToSkip) && _firstLine.empty()) {
     // error
     MUTEX_LOCKER(guard, _stats._mutex);
     ++_stats._numberErrors;
-    _lineBuffer.reset();
+    state.lineBuffer.reset();
     return;
   }
 
   // read a complete line
 
-  if (_lineBuffer.length() > 0) {
-    if (!_outputBuffer.length()) {
-      _outputBuffer.appendText(_firstLine);
-      _outputBuffer.appendChar('\n');
+  basics::StringBuffer& outputBuffer = state.outputBuffer;
+  if (state.lineBuffer.length() > 0) {
+    if (!outputBuffer.length()) {
+      outputBuffer.appendText(_firstLine);
+      outputBuffer.appendChar('\n');
     }
-    _outputBuffer.appendText(_lineBuffer);
-    _lineBuffer.reset();
+    outputBuffer.appendText(state.lineBuffer);
+    state.lineBuffer.reset();
   } else {
     MUTEX_LOCKER(guard, _stats._mutex);
     ++_stats._numberErrors;
   }
 
+  if (state.dataOnly) {
+    // parser threads hand over complete batches, which are sent in input
+    // order by the main thread
+    if (outputBuffer.length() > getMaxUploadSize()) {
+      finishCsvBatch(state);
+    }
+    return;
+  }
+
   // we will send the data if the buffer is already bigger than the batch size,
   // otherwise, it will accumulate to be sent later when buffer length is bigger
   // than the batch size
@@ -1428,6 +1631,14 @@ void ImportHelper::handleCsvBuffer(uint64_t bufferSizeThreshold) {
     return;
   }
 
+  sendCsvBuffer(_outputBuffer);
+}
+
+void ImportHelper::sendCsvBuffer(basics::StringBuffer& buffer) {
+  if (_hasError) {
+    return;
+  }
+
   std::string url("/_api/import?" + getCollectionUrlPart() + "&line=" +
                   StringUtils::itoa(_rowOffset) + "&details=true&onDuplicate=" +
                   StringUtils::urlEncode(_onDuplicateAction) +
@@ -1452,12 +1663,12 @@ void ImportHelper::handleCsvBuffer(uint64_t bufferSizeThreshold) {
 
   SenderThread* t = findIdleSender();
   if (t != nullptr) {
-    uint64_t tmp_length = _outputBuffer.length();
-    t->sendData(url, &_outputBuffer, _rowOffset + 1, _rowsRead);
+    uint64_t tmp_length = buffer.length();
+    t->sendData(url, &buffer, _rowOffset + 1, _rowsRead);
     addPeriodByteCount(tmp_length + url.length());
   }
 
-  _outputBuffer.reset();
+  buffer.reset();
   _rowOffset = _rowsRead;
 }
 
@@ -1506,20 +1717,42 @@ void ImportHelper::sendJsonBuffer(char const* str, size_t len, bool isObject) {
 /// Should return an idle sender, collect all errors
 /// and return nullptr, if there was an error
 SenderThread* ImportHelper::findIdleSender() {
+  uint32_t concurrency = _threadCount;
   if (_autoUploadSize) {
-    _autoTuneThread->paceSends();
+    if (_autoTuneThread->targetsLatency()) {
+      // the latency controller limits the number of concurrent senders
+      // instead of pacing them
+      concurrency = _autoTuneThread->concurrency();
+    } else {
+      _autoTuneThread->paceSends();
+    }
   }
 
   while (!_senderThreads.empty()) {
+    SenderThread* idle = nullptr;
+    uint32_t busy = 0;
     for (auto const& t : _senderThreads) {
       if (t->hasError()) {
         _hasError = true;
         _errorMessages.push_back(t->errorMessage());
         return nullptr;
       } else if (t->isIdle()) {
-        return t.get();
+        if (idle == nullptr) {
+          idle = t.get();
+          if (concurrency >= _threadCount) {
+            return idle;
+          }
+        }
+      } else {
+        ++busy;
       }
     }
+    if (idle != nullptr && busy < concurrency) {
+      return idle;
+    }
+    if (_autoUploadSize && _autoTuneThread->targetsLatency()) {
+      concurrency = _autoTuneThread->concurrency();
+    }
 
     CONDITION_LOCKER(guard, _threadsCondition);
     guard.wait(10000);
@@ -35,6 +35,7 @@
 #include "Basics/Mutex.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/csv.h"
+#include "Utils/ManagedDirectory.h"
 
 #ifdef _WIN32
 #include "Basics/win-utils.h"
@@ -56,6 +57,7 @@ struct SimpleHttpClientParams;
 
 namespace arangodb {
 namespace import {
+class ParserThread;
 class SenderThread;
 
 struct ImportStatistics {
@@ -78,6 +80,12 @@ class ImportHelper {
 
   enum DelimitedImportType { CSV = 0, TSV };
 
+  /// @brief a batch of converted CSV/TSV rows, ready to be sent
+  struct CsvBatch {
+    std::unique_ptr<basics::StringBuffer> data;
+    size_t rows;
+  };
+
  private:
   ImportHelper(ImportHelper const&) = delete;
   ImportHelper& operator=(ImportHelper const&) = delete;
@@ -87,7 +95,7 @@ class ImportHelper {
                std::string const& endpoint,
                httpclient::SimpleHttpClientParams const& params,
                uint64_t maxUploadSize, uint32_t threadCount,
-               bool autoUploadSize = false);
+               bool autoUploadSize = false, double targetLatency = 0.0);
 
   ~ImportHelper();
 
@@ -253,6 +261,20 @@ class ImportHelper {
 
   void setProgress(bool value) { _progress = value; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the number of threads parsing CSV/TSV input
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setParseThreads(uint32_t value) { _parseThreads = value; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief converts a chunk of complete CSV/TSV data rows into batches.
+  /// called by the parser threads, after the header has been processed
+  //////////////////////////////////////////////////////////////////////////////
+
+  void parseCsvChunk(char const* data, size_t length, bool atEnd,
+                     std::vector<CsvBatch>& batches, size_t& numberLines);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get the number of lines read (meaningful for CSV only)
   //////////////////////////////////////////////////////////////////////////////
@@ -323,9 +345,34 @@ class ImportHelper {
   static unsigned const MaxBatchSize;
 
  private:
+  /// @brief state for converting the rows of CSV/TSV input. the serial
+  /// import uses a single one, each parser thread its own
+  struct CsvState {
+    CsvState(basics::StringBuffer& outputBuffer, bool convert, bool dataOnly)
+        : outputBuffer(outputBuffer),
+          lineBuffer(false),
+          convert(convert),
+          dataOnly(dataOnly) {}
+
+    basics::StringBuffer& outputBuffer;
+    basics::StringBuffer lineBuffer;
+    std::unordered_map<std::string, std::string> fieldsLookUpTable;
+    /// @brief batches completed by a parser thread
+    std::vector<CsvBatch> batches;
+    size_t numberLines = 0;
+    /// @brief rows read by a parser thread, and the number of these rows
+    /// contained in completed batches
+    size_t rowsRead = 0;
+    size_t batchedRows = 0;
+    bool emittedField = false;
+    bool convert;
+    /// @brief whether the input consists of data rows only, as the rows to
+    /// skip and the header were processed before
+    bool const dataOnly;
+  };
+
   // read headers from separate file
-  bool readHeadersFile(std::string const& headersFile,
-                       DelimitedImportType typeImport, char separator);
+  bool readHeadersFile(std::string const& headersFile);
 
   static void ProcessCsvBegin(TRI_csv_parser_t*, size_t);
   static void ProcessCsvAdd(TRI_csv_parser_t*, char const*, size_t, size_t,
@@ -336,21 +383,32 @@ class ImportHelper {
   void reportProgress(int64_t, int64_t, double&);
 
   std::string getCollectionUrlPart() const;
-  void beginLine(size_t row);
-  void addField(char const*, size_t, size_t row, size_t column, bool escaped);
-  void addLastField(char const*, size_t, size_t row, size_t column,
-                    bool escaped);
+  void initCsvParser(TRI_csv_parser_t& parser, CsvState& state);
+  bool isHeaderRow(CsvState const& state, size_t row) const;
+  void beginLine(CsvState& state, size_t row);
+  void addField(CsvState& state, char const*, size_t, size_t row,
+                size_t column, bool escaped);
+  void addLastField(CsvState& state, char const*, size_t, size_t row,
+                    size_t column, bool escaped);
+  void finishCsvBatch(CsvState& state);
+
+  bool parseDelimitedParallel(ManagedDirectory::File& fd,
+                              TRI_csv_parser_t& parser, int64_t totalLength,
+                              double& nextProgress);
+  bool collectParsedData(ParserThread& thread);
 
   bool collectionExists();
   bool checkCreateCollection();
   bool truncateCollection();
 
   void handleCsvBuffer(uint64_t bufferSizeThreshold);
+  void sendCsvBuffer(basics::StringBuffer& buffer);
   void sendJsonBuffer(char const* str, size_t len, bool isObject);
   SenderThread* findIdleSender();
   void waitForSenders();
 
  private:
+  application_features::ApplicationServer& _server;
   EncryptionFeature* _encryption;
   std::unique_ptr<httpclient::SimpleHttpClient> _httpClient;
   std::atomic<uint64_t> _maxUploadSize;
@@ -359,11 +417,14 @@ class ImportHelper {
   std::unique_ptr<AutoTuneThread> _autoTuneThread;
   std::vector<std::unique_ptr<SenderThread>> _senderThreads;
   uint32_t const _threadCount;
+  uint32_t _parseThreads;
   basics::ConditionVariable _threadsCondition;
   basics::StringBuffer _tempBuffer;
 
   std::string _separator;
   std::string _quote;
+  char _separatorChar;
+  DelimitedImportType _importType;
   std::string _createCollectionType;
   bool _useBackslash;
   bool _convert;
@@ -388,7 +449,6 @@ class ImportHelper {
   std::string _fromCollectionPrefix;
   std::string _toCollectionPrefix;
   bool _overwriteCollectionPrefix;
-  arangodb::basics::StringBuffer _lineBuffer;
   arangodb::basics::StringBuffer _outputBuffer;
   std::string _firstLine;
   std::vector<std::string> _columnNames;
@@ -398,12 +458,10 @@ class ImportHelper {
 
   std::vector<std::pair<std::string, std::vector<Step>>>
       _mergeAttributesInstructions;
-  std::unordered_map<std::string, std::string> _fieldsLookUpTable;
   std::unordered_set<std::string> _removeAttributes;
 
   bool _hasError;
   bool _headersSeen;
-  bool _emittedField;
   std::vector<std::string> _errorMessages;
 
   static double const ProgressStep;
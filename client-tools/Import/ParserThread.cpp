@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ParserThread.h"
+
+#include "Basics/ConditionLocker.h"
+
+using namespace arangodb;
+using namespace arangodb::import;
+
+ParserThread::ParserThread(application_features::ApplicationServer& server,
+                           ImportHelper& importHelper,
+                           std::function<void()> const& wakeup)
+    : Thread(server, "Import Parser"),
+      _importHelper(importHelper),
+      _wakeup(wakeup),
+      _data(false),
+      _numberLines(0),
+      _atEnd(false),
+      _idle(true),
+      _hasError(false) {}
+
+ParserThread::~ParserThread() { shutdown(); }
+
+void ParserThread::beginShutdown() {
+  Thread::beginShutdown();
+
+  // wake up the thread that may be waiting in run()
+  CONDITION_LOCKER(guard, _condition);
+  guard.broadcast();
+}
+
+void ParserThread::parseData(char const* data, size_t length, bool atEnd) {
+  TRI_ASSERT(_idle && !_hasError);
+  _data.reset();
+  _data.appendText(data, length);
+
+  // wake up the thread that may be waiting in run()
+  CONDITION_LOCKER(guard, _condition);
+  _atEnd = atEnd;
+  _idle = false;
+  guard.broadcast();
+}
+
+std::vector<ImportHelper::CsvBatch> ParserThread::takeBatches(
+    size_t& numberLines) {
+  CONDITION_LOCKER(guard, _condition);
+  TRI_ASSERT(_idle);
+  numberLines = _numberLines;
+  _numberLines = 0;
+  return std::move(_batches);
+}
+
+bool ParserThread::isIdle() {
+  CONDITION_LOCKER(guard, _condition);
+  return _idle;
+}
+
+bool ParserThread::hasError() {
+  CONDITION_LOCKER(guard, _condition);
+  return _hasError;
+}
+
+void ParserThread::run() {
+  while (!isStopping()) {
+    bool atEnd;
+    {
+      CONDITION_LOCKER(guard, _condition);
+      if (_idle) {
+        guard.wait();
+        continue;
+      }
+      atEnd = _atEnd;
+    }
+
+    std::vector<ImportHelper::CsvBatch> batches;
+    size_t numberLines = 0;
+    std::string errorMessage;
+    try {
+      _importHelper.parseCsvChunk(_data.c_str(), _data.length(), atEnd,
+                                  batches, numberLines);
+    } catch (std::exception const& ex) {
+      errorMessage = ex.what();
+    } catch (...) {
+      errorMessage = "unknown exception while parsing import data";
+    }
+    _data.reset();
+
+    {
+      CONDITION_LOCKER(guard, _condition);
+      _batches = std::move(batches);
+      _numberLines = numberLines;
+      if (!errorMessage.empty()) {
+        _hasError = true;
+        _errorMessage = std::move(errorMessage);
+      }
+      _idle = true;
+    }
+
+    _wakeup();
+  }
+}
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Basics/ConditionVariable.h"
+#include "Basics/StringBuffer.h"
+#include "Basics/Thread.h"
+#include "Import/ImportHelper.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace arangodb {
+namespace application_features {
+class ApplicationServer;
+}
+
+namespace import {
+
+/// @brief thread converting chunks of CSV/TSV input into import batches.
+/// the chunks handed to the thread must consist of complete records
+class ParserThread final : public arangodb::Thread {
+ private:
+  ParserThread(ParserThread const&) = delete;
+  ParserThread& operator=(ParserThread const&) = delete;
+
+ public:
+  explicit ParserThread(application_features::ApplicationServer& server,
+                        ImportHelper& importHelper,
+                        std::function<void()> const& wakeup);
+
+  ~ParserThread();
+
+  /// @brief hand over a chunk of data rows to the idle thread. atEnd must be
+  /// set for the last chunk of the input
+  void parseData(char const* data, size_t length, bool atEnd);
+
+  /// @brief return the batches produced from the last chunk, and the number
+  /// of lines it contained. must only be called when the thread is idle
+  std::vector<ImportHelper::CsvBatch> takeBatches(size_t& numberLines);
+
+  /// Currently not parsing data
+  bool isIdle();
+  bool hasError();
+
+  std::string const& errorMessage() const { return _errorMessage; }
+
+  void beginShutdown() override;
+
+ protected:
+  void run() override;
+
+ private:
+  ImportHelper& _importHelper;
+  basics::ConditionVariable _condition;
+  std::function<void()> _wakeup;
+  basics::StringBuffer _data;
+  std::vector<ImportHelper::CsvBatch> _batches;
+  size_t _numberLines;
+  bool _atEnd;
+  bool _idle;
+  bool _hasError;
+  std::string _errorMessage;
+};
+}  // namespace import
+}  // namespace arangodb
@@ -23,9 +23,15 @@
 
 #include "SenderThread.h"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "AutoTuneThread.h"
 #include "Basics/Common.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
@@ -39,10 +45,42 @@
 using namespace arangodb;
 using namespace arangodb::import;
 
+namespace {
+/// @brief maximum number of times a batch is resent after the server
+/// rejected it because of overload
+constexpr uint32_t maxOverloadRetries = 10;
+
+/// @brief whether the server rejected the request because it is overloaded.
+/// such requests were not executed and can be sent again
+bool isRejected(httpclient::SimpleHttpResult const* result) {
+  return result != nullptr && (result->getHttpReturnCode() == 429 ||
+                               result->getHttpReturnCode() == 503);
+}
+
+/// @brief whether the server signaled overload. besides rejected requests,
+/// this is the case if requests were queued on the server for a significant
+/// part of the target latency before being executed
+bool isOverloaded(httpclient::SimpleHttpResult const* result,
+                  double targetLatency) {
+  if (isRejected(result)) {
+    return true;
+  }
+  if (result == nullptr) {
+    return false;
+  }
+  bool found = false;
+  std::string queueTime =
+      result->getHeaderField(StaticStrings::XArangoQueueTimeSeconds, found);
+  return found && basics::StringUtils::doubleDecimal(queueTime) >
+                      targetLatency / 2.0;
+}
+}  // namespace
+
 SenderThread::SenderThread(application_features::ApplicationServer& server,
                            std::unique_ptr<httpclient::SimpleHttpClient> client,
                            ImportStatistics* stats,
-                           std::function<void()> const& wakeup)
+                           std::function<void()> const& wakeup,
+                           AutoTuneThread* autoTune)
     : Thread(server, "Import Sender"),
       _client(std::move(client)),
       _wakeup(wakeup),
@@ -52,7 +90,8 @@ SenderThread::SenderThread(application_features::ApplicationServer& server,
       _ready(false),
       _lowLineNumber(0),
       _highLineNumber(0),
-      _stats(stats) {}
+      _stats(stats),
+      _autoTune(autoTune) {}
 
 SenderThread::~SenderThread() { shutdown(); }
 
@@ -129,8 +168,7 @@ void SenderThread::run() {
         {
           QuickHistogramTimer timer(_stats->_histogram,
                                     (_highLineNumber - _lowLineNumber) + 1);
-          std::unique_ptr<httpclient::SimpleHttpResult> result(_client->request(
-              rest::RequestType::POST, _url, _data.c_str(), _data.length()));
+          std::unique_ptr<httpclient::SimpleHttpResult> result = sendRequest();
 
           handleResult(result.get());
         }
@@ -154,6 +192,32 @@ void SenderThread::run() {
   TRI_ASSERT(_idle);
 }
 
+std::unique_ptr<httpclient::SimpleHttpResult> SenderThread::sendRequest() {
+  std::unique_ptr<httpclient::SimpleHttpResult> result;
+  for (uint32_t attempt = 0;; ++attempt) {
+    auto start = std::chrono::steady_clock::now();
+    result.reset(_client->request(rest::RequestType::POST, _url, _data.c_str(),
+                                  _data.length()));
+    if (_autoTune == nullptr) {
+      break;
+    }
+
+    _autoTune->recordResponse(
+        std::chrono::steady_clock::now() - start,
+        ::isOverloaded(result.get(), _autoTune->targetLatency()));
+
+    if (!::isRejected(result.get()) || attempt >= ::maxOverloadRetries ||
+        isStopping()) {
+      break;
+    }
+
+    // exponential backoff, from 100ms up to 6.4s
+    std::this_thread::sleep_for(std::chrono::milliseconds(100) *
+                                (1 << std::min<uint32_t>(attempt, 6)));
+  }
+  return result;
+}
+
 void SenderThread::handleResult(httpclient::SimpleHttpResult* result) {
   bool haveBody = false;
 
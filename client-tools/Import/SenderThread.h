@@ -41,6 +41,7 @@ class SimpleHttpResult;
 }  // namespace httpclient
 
 namespace import {
+class AutoTuneThread;
 struct ImportStatistics;
 
 class SenderThread final : public arangodb::Thread {
@@ -52,7 +53,8 @@ class SenderThread final : public arangodb::Thread {
   explicit SenderThread(application_features::ApplicationServer& server,
                         std::unique_ptr<httpclient::SimpleHttpClient>,
                         ImportStatistics* stats,
-                        std::function<void()> const& wakeup);
+                        std::function<void()> const& wakeup,
+                        AutoTuneThread* autoTune = nullptr);
 
   ~SenderThread();
 
@@ -90,7 +92,12 @@ class SenderThread final : public arangodb::Thread {
   size_t _highLineNumber;
 
   ImportStatistics* _stats;
+  /// @brief receives the latency of each batch, if the import adapts its
+  /// rate to the server latency. batches rejected because of overload are
+  /// then retried
+  AutoTuneThread* _autoTune;
   std::string _errorMessage;
+  std::unique_ptr<httpclient::SimpleHttpResult> sendRequest();
   void handleResult(httpclient::SimpleHttpResult* result);
 };
 }  // namespace import
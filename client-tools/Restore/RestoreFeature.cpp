@@ -28,8 +28,11 @@
 #include <velocypack/Collection.h>
 #include <velocypack/Iterator.h>
 
+#include <lz4frame.h>
+
 #include <algorithm>
 #include <chrono>
+#include <limits>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -41,6 +44,7 @@
 #include "Basics/MutexLocker.h"
 #include "Basics/NumberOfCores.h"
 #include "Basics/Result.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/StringUtils.h"
@@ -749,6 +753,9 @@ arangodb::Result processInputDirectory(
     std::unique_ptr<arangodb::RestoreFeature::RestoreMainJob> usersData;
     std::unique_ptr<arangodb::RestoreFeature::RestoreMainJob> analyzersData;
     std::vector<std::unique_ptr<arangodb::RestoreFeature::RestoreMainJob>> jobs;
+    // jobs creating the indexes after all data has been restored
+    std::vector<std::unique_ptr<arangodb::RestoreFeature::RestoreMainJob>>
+        indexJobs;
     jobs.reserve(collections.size());
 
     bool didModifyFoxxCollection = false;
@@ -808,6 +815,18 @@ arangodb::Result processInputDirectory(
         analyzersData = std::move(job);
       } else {
         stats.totalCollections++;
+        if (options.deferIndexes) {
+          // filling the collections is faster without secondary indexes
+          // to maintain, and the indexes can be built from the existing
+          // documents in one go afterwards
+          job->deferIndexes = true;
+          auto indexJob =
+              std::make_unique<arangodb::RestoreFeature::RestoreMainJob>(
+                  directory, feature, progressTracker, options, stats,
+                  collection, useEnvelope);
+          indexJob->indexesOnly = true;
+          indexJobs.push_back(std::move(indexJob));
+        }
         jobs.push_back(std::move(job));
       }
     }
@@ -843,10 +862,15 @@ arangodb::Result processInputDirectory(
       return Result{};
     };
 
-    // Step 5: create arangosearch views
-    auto r = createViews("arangosearch");
-    if (!r.ok()) {
-      return r;
+    // Step 5: create arangosearch views. with deferred index creation,
+    // the views are created after the data was restored as well, as their
+    // links would otherwise index every document while it is restored
+    Result r;
+    if (!options.deferIndexes) {
+      r = createViews("arangosearch");
+      if (!r.ok()) {
+        return r;
+      }
     }
 
     // Step 6: fire up data transfer
@@ -896,6 +920,28 @@ arangodb::Result processInputDirectory(
     jobQueue.waitForIdle();
     jobs.clear();
 
+    if (options.deferIndexes) {
+      Result firstError = feature.getFirstError();
+      if (firstError.fail()) {
+        return firstError;
+      }
+
+      // Step 6a: create the deferred indexes and arangosearch views
+      LOG_TOPIC("d3f7a", INFO, Logger::RESTORE) << "# Creating indexes...";
+      for (auto& job : indexJobs) {
+        if (!jobQueue.queueJob(std::move(job))) {
+          return Result(TRI_ERROR_OUT_OF_MEMORY, "unable to queue restore job");
+        }
+      }
+      jobQueue.waitForIdle();
+      indexJobs.clear();
+
+      r = createViews("arangosearch");
+      if (!r.ok()) {
+        return r;
+      }
+    }
+
     // Step 7: create search-alias views
     r = createViews("search-alias");
     if (!r.ok()) {
@@ -1143,14 +1189,16 @@ Result RestoreFeature::RestoreJob::sendRestoreData(
 
   std::unordered_map<std::string, std::string> headers;
   headers.emplace(arangodb::StaticStrings::ContentTypeHeader,
-                  arangodb::StaticStrings::MimeTypeDump);
+                  sharedState->vpack ? arangodb::StaticStrings::MimeTypeVPack
+                                     : arangodb::StaticStrings::MimeTypeDump);
 
   std::unique_ptr<SimpleHttpResult> response(client.request(
       arangodb::rest::RequestType::PUT, url, buffer, bufferSize, headers));
   arangodb::Result res = arangodb::HttpResponseChecker::check(
       client.getErrorMessage(), response.get(), "restoring data",
       std::string_view(buffer, bufferSize),
-      arangodb::HttpResponseChecker::PayloadType::JSONL);
+      sharedState->vpack ? arangodb::HttpResponseChecker::PayloadType::VPACK
+                         : arangodb::HttpResponseChecker::PayloadType::JSONL);
 
   if (res.fail()) {
     // error
@@ -1198,12 +1246,31 @@ Result RestoreFeature::RestoreJob::sendRestoreData(
   return res;
 }
 
+/// @brief the offset in the data file from which a restore can be resumed:
+/// the lowest offset that has not been acknowledged yet, or that has not
+/// been reached yet by one of the parallel streams
+size_t RestoreFeature::resumeOffset(
+    std::map<size_t, size_t> const& readOffsets,
+    std::map<size_t, size_t> const& streamOffsets) {
+  size_t readOffset = std::numeric_limits<size_t>::max();
+  if (!readOffsets.empty()) {
+    readOffset = readOffsets.begin()->first;
+  }
+  for (auto const& it : streamOffsets) {
+    readOffset = std::min(readOffset, it.second);
+  }
+  return readOffset;
+}
+
 void RestoreFeature::RestoreJob::updateProgress() {
   MUTEX_LOCKER(locker, sharedState->mutex);
 
-  if (!sharedState->readOffsets.empty()) {
-    auto it = sharedState->readOffsets.begin();
-    size_t readOffset = (*it).first;
+  if (!sharedState->readOffsets.empty() ||
+      !sharedState->streamOffsets.empty()) {
+    // resume from the lowest offset that has not been acknowledged yet, or
+    // that has not been reached yet by one of the parallel streams
+    size_t readOffset =
+        resumeOffset(sharedState->readOffsets, sharedState->streamOffsets);
 
     // progressTracker has its own lock
     locker.unlock();
@@ -1235,14 +1302,32 @@ RestoreFeature::RestoreMainJob::RestoreMainJob(
       parameters{parameters},
       useEnvelope{useEnvelope} {}
 
+RestoreFeature::RestoreMainJob::RestoreMainJob(RestoreMainJob const& main,
+                                               size_t begin, size_t end)
+    : RestoreJob(main.feature, main.progressTracker, main.options, main.stats,
+                 main.collectionName, main.sharedState),
+      directory{main.directory},
+      parameters{main.parameters},
+      useEnvelope{main.useEnvelope},
+      isStream{true},
+      rangeBegin{begin},
+      rangeEnd{end} {}
+
 Result RestoreFeature::RestoreMainJob::run(
     arangodb::httpclient::SimpleHttpClient& client) {
-  // restore indexes first
-  arangodb::Result res = restoreIndexes(client);
+  if (indexesOnly) {
+    return restoreIndexes(client);
+  }
+
+  arangodb::Result res;
+  if (!isStream && !deferIndexes) {
+    // restore indexes first
+    res = restoreIndexes(client);
+  }
   if (res.ok() && options.importData) {
     res = restoreData(client);
 
-    if (res.ok()) {
+    if (res.ok() && finishStream()) {
       ++stats.restoredCollections;
 
       if (options.progress) {
@@ -1259,6 +1344,21 @@ Result RestoreFeature::RestoreMainJob::run(
   return res;
 }
 
+bool RestoreFeature::RestoreMainJob::finishStream() {
+  {
+    MUTEX_LOCKER(locker, sharedState->mutex);
+    TRI_ASSERT(sharedState->pendingStreams > 0);
+    if (--sharedState->pendingStreams > 0) {
+      // other streams are still reading the data file
+      return false;
+    }
+    sharedState->readCompleteInputfile = true;
+  }
+
+  updateProgress();
+  return true;
+}
+
 /// @brief dispatch restore data
 Result RestoreFeature::RestoreMainJob::dispatchRestoreData(
     arangodb::httpclient::SimpleHttpClient& client, size_t readOffset,
@@ -1270,7 +1370,9 @@ Result RestoreFeature::RestoreMainJob::dispatchRestoreData(
   // data into it (which is the normal case)
   arangodb::basics::StringBuffer cleaned;
 
-  if (options.cleanupDuplicateAttributes) {
+  // velocypack documents from a binary dump are known to be free of
+  // duplicate attributes, as they were produced by the server
+  if (options.cleanupDuplicateAttributes && !sharedState->vpack) {
     auto res = cleaned.reserve(length);
 
     if (res != TRI_ERROR_NO_ERROR) {
@@ -1394,46 +1496,51 @@ Result RestoreFeature::RestoreMainJob::restoreData(
              currentStatus.state == arangodb::RestoreFeature::RESTORING);
 
   // import data. check if we have a datafile
-  //  ... there are 4 possible names
-  bool isCompressed = false;
-  auto datafile = directory.readableFile(
+  //  ... there are 5 possible names
+  std::string const prefix =
       collectionName + "_" +
-      arangodb::rest::SslInterface::sslMD5(collectionName) + ".data.json");
-  if (!datafile || datafile->status().fail()) {
-    datafile = directory.readableFile(
-        collectionName + "_" +
-        arangodb::rest::SslInterface::sslMD5(collectionName) + ".data.json.gz");
-    isCompressed = true;
-  }
-  if (!datafile || datafile->status().fail()) {
-    datafile = directory.readableFile(collectionName + ".data.json.gz");
-    isCompressed = true;
-  }
-  if (!datafile || datafile->status().fail()) {
-    datafile = directory.readableFile(collectionName + ".data.json");
-    isCompressed = false;
-  }
-  if (!datafile || datafile->status().fail()) {
+      arangodb::rest::SslInterface::sslMD5(collectionName);
+  std::string filename;
+  std::unique_ptr<ManagedDirectory::File> datafile;
+  for (std::string name :
+       {prefix + ".data.vpack.lz4", prefix + ".data.json",
+        prefix + ".data.json.gz", collectionName + ".data.json.gz",
+        collectionName + ".data.json"}) {
+    datafile = directory.readableFile(name);
+    if (datafile && datafile->status().ok()) {
+      filename = std::move(name);
+      break;
+    }
+  }
+  if (filename.empty()) {
     return {TRI_ERROR_CANNOT_READ_FILE,
             "could not open data file for collection '" + collectionName + "'"};
   }
+  bool const isVPack = filename.ends_with(".data.vpack.lz4");
+  bool const isGzip = filename.ends_with(".gz");
 
   int64_t const fileSize = TRI_SizeFile(datafile->path().c_str());
 
-  if (options.progress) {
+  if (options.progress && !isStream) {
     LOG_TOPIC("95913", INFO, Logger::RESTORE)
         << "# Loading data into " << collectionType << " collection '"
         << collectionName << "', data size: " << formatSize(fileSize)
-        << (isCompressed ? " (compressed)" : "");
+        << ((isGzip || isVPack) ? " (compressed)" : "");
   }
 
-  int64_t numReadForThisCollection = 0;
-  int64_t numReadSinceLastReport = 0;
+  if (isVPack) {
+    TRI_ASSERT(!isStream);
+    size_t readOffset = 0;
+    if (currentStatus.state == arangodb::RestoreFeature::RESTORING) {
+      LOG_TOPIC("2b7c4", INFO, Logger::RESTORE)
+          << "# continuing restoring " << collectionType << " collection '"
+          << collectionName << "' from offset " << currentStatus.bytes_acked;
+      readOffset = currentStatus.bytes_acked;
+    }
+    return restoreVPackData(client, *datafile, readOffset);
+  }
 
-  bool const isGzip =
-      datafile->path().size() > 3 &&
-      (0 ==
-       datafile->path().substr(datafile->path().size() - 3).compare(".gz"));
+  int64_t numReadSinceLastReport = 0;
 
   std::string ofFilesize;
   if (!isGzip) {
@@ -1441,7 +1548,14 @@ Result RestoreFeature::RestoreMainJob::restoreData(
   }
 
   size_t datafileReadOffset = 0;
-  if (currentStatus.state == arangodb::RestoreFeature::RESTORING) {
+  if (isStream) {
+    // we read a range of the file in parallel to the collection's main job
+    datafileReadOffset = rangeBegin;
+    datafile->skip(datafileReadOffset);
+    if (datafile->status().fail()) {
+      return datafile->status();
+    }
+  } else if (currentStatus.state == arangodb::RestoreFeature::RESTORING) {
     LOG_TOPIC("94913", INFO, Logger::RESTORE)
         << "# continuing restoring " << collectionType << " collection '"
         << collectionName << "' from offset " << currentStatus.bytes_acked;
@@ -1452,6 +1566,26 @@ Result RestoreFeature::RestoreMainJob::restoreData(
     }
   }
 
+  // offset up to which we read the data file
+  size_t readEnd = std::numeric_limits<size_t>::max();
+  if (isStream) {
+    readEnd = rangeEnd;
+  } else if (options.streamsPerCollection > 1 && !isGzip && !useEnvelope &&
+             fileSize > 0) {
+    // the enveloped format must be restored in order, and compressed files
+    // cannot be positioned cheaply. everything else can be read by multiple
+    // streams in parallel
+    readEnd = queueStreams(filename, datafileReadOffset,
+                           static_cast<size_t>(fileSize));
+  }
+  size_t const streamKey = isStream ? rangeBegin : datafileReadOffset;
+  bool isSplit = false;
+  {
+    MUTEX_LOCKER(locker, sharedState->mutex);
+    isSplit = sharedState->streamOffsets.contains(streamKey);
+  }
+  size_t readPosition = datafileReadOffset;
+
   // 1MB buffer by default
   size_t bufferSize = 1048576;
   if (bufferSize > options.chunkSize) {
@@ -1471,16 +1605,22 @@ Result RestoreFeature::RestoreMainJob::restoreData(
       return {TRI_ERROR_OUT_OF_MEMORY, "out of memory"};
     }
 
-    auto numRead = datafile->read(buffer->end(), bufferSize);
-    if (datafile->status().fail()) {  // error while reading
-      return datafile->status();
+    // reaching the end of our range counts as end of file
+    size_t const toRead = std::min(bufferSize, readEnd - readPosition);
+    TRI_read_return_t numRead = 0;
+    if (toRead > 0) {
+      numRead = datafile->read(buffer->end(), toRead);
+      if (datafile->status().fail()) {  // error while reading
+        return datafile->status();
+      }
     }
 
     if (numRead > 0) {
       // we read something
       buffer->increaseLength(numRead);
+      readPosition += static_cast<size_t>(numRead);
       stats.totalRead += static_cast<uint64_t>(numRead);
-      numReadForThisCollection += numRead;
+      sharedState->numRead += numRead;
       numReadSinceLastReport += numRead;
 
       if (buffer->length() < options.chunkSize) {
@@ -1543,6 +1683,11 @@ Result RestoreFeature::RestoreMainJob::restoreData(
 
       datafileReadOffset += length;
 
+      if (isSplit) {
+        MUTEX_LOCKER(locker, sharedState->mutex);
+        sharedState->streamOffsets[streamKey] = datafileReadOffset;
+      }
+
       // bytes successfully sent
       buffer->erase_front(length);
 
@@ -1550,6 +1695,7 @@ Result RestoreFeature::RestoreMainJob::restoreData(
           numReadSinceLastReport > 1024 * 1024 * 8) {
         // report every 8MB of transferred data
         //   currently do not have unzipped size for .gz files
+        int64_t const numReadForThisCollection = sharedState->numRead.load();
         std::string percentage;
         if (!isGzip) {
           percentage =
@@ -1574,16 +1720,270 @@ Result RestoreFeature::RestoreMainJob::restoreData(
 
   feature.returnBuffer(std::move(buffer));
 
-  // end of main job
-  if (result.ok()) {
-    {
-      MUTEX_LOCKER(locker, sharedState->mutex);
-      sharedState->readCompleteInputfile = true;
+  if (result.ok() && isSplit) {
+    // this stream is done. it does not hold back the resume offset anymore
+    MUTEX_LOCKER(locker, sharedState->mutex);
+    sharedState->streamOffsets.erase(streamKey);
+  }
+
+  return result;
+}
+
+/// @brief split the range [begin, end) of a data file holding one document
+/// per line into up to streams ranges of about equal size. each range after
+/// the first starts right after the first line break behind its nominal
+/// start offset. returns the start offsets of the ranges
+std::vector<size_t> RestoreFeature::findStreamBoundaries(
+    ManagedDirectory& directory, std::string const& filename, size_t begin,
+    size_t end, uint32_t streams) {
+  TRI_ASSERT(begin <= end);
+  TRI_ASSERT(streams > 0);
+
+  size_t const rangeSize = (end - begin) / streams;
+  std::vector<size_t> boundaries;
+  boundaries.reserve(streams);
+  boundaries.push_back(begin);
+
+  char buffer[4096];
+  for (uint32_t i = 1; i < streams; ++i) {
+    size_t offset = begin + i * rangeSize;
+    if (offset <= boundaries.back()) {
+      // the previous range consists of one very long line
+      continue;
+    }
+    auto file = directory.readableFile(filename);
+    if (!file || file->status().fail()) {
+      break;
+    }
+    file->skip(offset - 1);
+    bool found = false;
+    while (!found && file->status().ok() && offset < end) {
+      TRI_read_return_t numRead = file->read(&buffer[0], sizeof(buffer));
+      if (numRead <= 0) {
+        break;
+      }
+      char const* p = static_cast<char const*>(
+          memchr(&buffer[0], '\n', static_cast<size_t>(numRead)));
+      if (p != nullptr) {
+        offset += p - &buffer[0];
+        found = true;
+      } else {
+        offset += static_cast<size_t>(numRead);
+      }
     }
+    if (!found || offset >= end) {
+      // no more line breaks up to the end of the data
+      break;
+    }
+    boundaries.push_back(offset);
+  }
 
-    updateProgress();
+  return boundaries;
+}
+
+size_t RestoreFeature::RestoreMainJob::queueStreams(
+    std::string const& filename, size_t begin, size_t end) {
+  TRI_ASSERT(!isStream);
+  TRI_ASSERT(begin <= end);
+
+  if ((end - begin) / options.streamsPerCollection < options.chunkSize) {
+    // not worth splitting the file up
+    return end;
+  }
+
+  std::vector<size_t> boundaries = findStreamBoundaries(
+      directory, filename, begin, end, options.streamsPerCollection);
+  if (boundaries.size() == 1) {
+    return end;
+  }
+
+  {
+    MUTEX_LOCKER(locker, sharedState->mutex);
+    for (size_t boundary : boundaries) {
+      sharedState->streamOffsets.emplace(boundary, boundary);
+    }
+    sharedState->pendingStreams += static_cast<uint32_t>(boundaries.size() - 1);
+  }
+
+  LOG_TOPIC("4c0e8", DEBUG, Logger::RESTORE)
+      << "# Reading data file of collection '" << collectionName << "' using "
+      << boundaries.size() << " streams";
+
+  for (size_t i = 1; i < boundaries.size(); ++i) {
+    size_t rangeEnd = (i + 1 < boundaries.size()) ? boundaries[i + 1] : end;
+    if (!feature.taskQueue().queueJob(std::make_unique<RestoreMainJob>(
+            *this, boundaries[i], rangeEnd))) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_OUT_OF_MEMORY,
+                                     "unable to queue restore job");
+    }
+  }
+
+  return boundaries[1];
+}
+
+/// @brief returns the length of the complete velocypack documents at the
+/// start of data, but not more than chunkSize bytes unless the first
+/// document alone is larger
+size_t RestoreFeature::completeDocuments(uint8_t const* data, size_t length,
+                                         size_t chunkSize) {
+  size_t total = 0;
+  while (total < length) {
+    size_t left = length - total;
+    // a value whose byte size cannot be determined from what is left is
+    // incomplete. velocypack must not read past the end of the data to
+    // find out
+    size_t size = basics::VelocyPackHelper::byteSizeWithin(data + total, left);
+    if (size == 0 || size > left || (total > 0 && total + size > chunkSize)) {
+      break;
+    }
+    total += size;
+  }
+  return total;
+}
+
+/// @brief Restore the data of a binary dump. the file holds a sequence of
+/// LZ4 frames, which decompress into velocypack documents written one after
+/// the other. documents are sent to the server unmodified, in batches of up
+/// to --batch-size bytes. offsets tracked for resuming a restore refer to
+/// the decompressed data
+Result RestoreFeature::RestoreMainJob::restoreVPackData(
+    arangodb::httpclient::SimpleHttpClient& client,
+    ManagedDirectory::File& datafile, size_t readOffset) {
+  using arangodb::basics::StringUtils::concatT;
+
+  {
+    MUTEX_LOCKER(locker, sharedState->mutex);
+    sharedState->vpack = true;
+  }
+
+  LZ4F_dctx* context = nullptr;
+  size_t rc = LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+  if (LZ4F_isError(rc)) {
+    return {TRI_ERROR_OUT_OF_MEMORY, LZ4F_getErrorName(rc)};
+  }
+  auto contextGuard = arangodb::scopeGuard(
+      [context]() noexcept { LZ4F_freeDecompressionContext(context); });
+
+  // size of compressed data read at once, and of decompressed data produced
+  // at once
+  size_t const bufferSize =
+      std::max<size_t>(std::min<size_t>(1048576, options.chunkSize), 65536);
+
+  std::string input;
+  input.resize(bufferSize);
+
+  arangodb::Result result;
+  auto buffer = feature.leaseBuffer();
+  // offset of the start of buffer in the decompressed data
+  size_t streamOffset = 0;
+  // decompressed data to skip, because it was already restored
+  size_t skip = readOffset;
+
+  auto send = [&](bool atEnd) -> arangodb::Result {
+    while (buffer->length() > 0 &&
+           (atEnd || buffer->length() >= options.chunkSize)) {
+      size_t length = completeDocuments(
+          reinterpret_cast<uint8_t const*>(buffer->begin()), buffer->length(),
+          options.chunkSize);
+      if (length == 0) {
+        if (atEnd) {
+          return {TRI_ERROR_CANNOT_READ_FILE,
+                  concatT("unexpected end of data file '", datafile.path(),
+                          "'")};
+        }
+        break;
+      }
+
+      // enveloped data must be restored in order, see restoreData()
+      bool const forceDirect =
+          (atEnd && length == buffer->length()) || useEnvelope;
+      arangodb::Result res = dispatchRestoreData(
+          client, streamOffset, buffer->begin(), length, forceDirect);
+
+      // check if our status was changed by background jobs
+      if (res.ok()) {
+        MUTEX_LOCKER(locker, sharedState->mutex);
+        res = sharedState->result;
+      }
+      if (res.fail() && !options.force) {
+        return res;
+      }
+
+      streamOffset += length;
+      buffer->erase_front(length);
+    }
+    return {};
+  };
+
+  bool atEnd = false;
+  bool inFrame = false;
+  while (!atEnd) {
+    auto numRead = datafile.read(input.data(), input.size());
+    if (datafile.status().fail()) {  // error while reading
+      result = datafile.status();
+      break;
+    }
+    atEnd = (numRead == 0);
+    stats.totalRead += static_cast<uint64_t>(numRead);
+
+    char const* src = input.data();
+    size_t srcLeft = static_cast<size_t>(numRead);
+    while (true) {
+      if (buffer->reserve(bufferSize) != TRI_ERROR_NO_ERROR) {
+        result.reset(TRI_ERROR_OUT_OF_MEMORY, "out of memory");
+        break;
+      }
+      size_t dstSize = bufferSize;
+      size_t srcSize = srcLeft;
+      rc = LZ4F_decompress(context, buffer->end(), &dstSize, src, &srcSize,
+                           nullptr);
+      if (LZ4F_isError(rc)) {
+        result.reset(TRI_ERROR_CANNOT_READ_FILE,
+                     concatT("cannot decompress data file '", datafile.path(),
+                             "': ", LZ4F_getErrorName(rc)));
+        break;
+      }
+      if (srcSize > 0 || dstSize > 0) {
+        // LZ4 returns 0 when a frame is complete
+        inFrame = (rc != 0);
+      }
+      if (srcLeft == 0 && dstSize == 0) {
+        // all input consumed, and no more output buffered by LZ4
+        break;
+      }
+      buffer->increaseLength(dstSize);
+      src += srcSize;
+      srcLeft -= srcSize;
+
+      if (skip > 0) {
+        size_t n = std::min<size_t>(skip, buffer->length());
+        buffer->erase_front(n);
+        streamOffset += n;
+        skip -= n;
+      }
+
+      result = send(/*atEnd*/ false);
+      if (result.fail()) {
+        break;
+      }
+    }
+    if (result.fail()) {
+      break;
+    }
+  }
+
+  if (result.ok() && inFrame) {
+    // the last frame is incomplete
+    result.reset(TRI_ERROR_CANNOT_READ_FILE,
+                 concatT("unexpected end of data file '", datafile.path(),
+                         "'"));
+  }
+  if (result.ok()) {
+    result = send(/*atEnd*/ true);
   }
 
+  feature.returnBuffer(std::move(buffer));
+
   return result;
 }
 
@@ -1709,6 +2109,16 @@ void RestoreFeature::collectOptions(
                       arangodb::options::Flags::Dynamic))
       .setIntroducedIn(30400);
 
+  options
+      ->addOption("--streams-per-collection",
+                  "The number of parallel streams to read the data file of a "
+                  "single collection with. Only applies to uncompressed "
+                  "JSON data files without envelopes.",
+                  new UInt32Parameter(&_options.streamsPerCollection),
+                  arangodb::options::makeDefaultFlags(
+                      arangodb::options::Flags::Dynamic))
+      .setIntroducedIn(31100);
+
   options
       ->addOption("--initial-connect-retries",
                   "The number of connect retries for the initial connection.",
@@ -1757,6 +2167,13 @@ void RestoreFeature::collectOptions(
   options->addOption("--progress", "Show the progress.",
                      new BooleanParameter(&_options.progress));
 
+  options
+      ->addOption("--defer-indexes",
+                  "Create the indexes and arangosearch views only after the "
+                  "data of all collections has been restored.",
+                  new BooleanParameter(&_options.deferIndexes))
+      .setIntroducedIn(31100);
+
   options->addOption("--overwrite", "Overwrite collections if they exist.",
                      new BooleanParameter(&_options.overwrite));
 
@@ -1882,6 +2299,14 @@ void RestoreFeature::validateOptions(
     _options.threadCount = clamped;
   }
 
+  clamped = std::clamp(_options.streamsPerCollection, uint32_t(1),
+                       uint32_t(64));
+  if (_options.streamsPerCollection != clamped) {
+    LOG_TOPIC("e0b5d", WARN, Logger::RESTORE)
+        << "capping --streams-per-collection value to " << clamped;
+    _options.streamsPerCollection = clamped;
+  }
+
   // validate shards and replication factor
   if (_options.defaultNumberOfShards == 0) {
     LOG_TOPIC("248ee", FATAL, arangodb::Logger::RESTORE)
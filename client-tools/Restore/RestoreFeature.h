@@ -96,6 +96,7 @@ class RestoreFeature final : public ArangoRestoreFeature {
     std::vector<std::string> numberOfShards;
     std::vector<std::string> replicationFactor;
     uint32_t threadCount{2};
+    uint32_t streamsPerCollection{1};
     uint32_t initialConnectRetries{3};
     bool clusterMode{false};
     bool createDatabase{false};
@@ -115,6 +116,7 @@ class RestoreFeature final : public ArangoRestoreFeature {
 #endif
     bool cleanupDuplicateAttributes{false};
     bool progress{true};
+    bool deferIndexes{false};
   };
 
   enum CollectionState {
@@ -163,9 +165,27 @@ class RestoreFeature final : public ArangoRestoreFeature {
     /// each chunk to test the resumption of a restore after a crash)
     std::map<size_t, size_t> readOffsets;
 
+    /// @brief when the input data file is read by multiple parallel streams:
+    /// (start offset of the stream's range, offset up to which the stream has
+    /// dispatched data) of each stream that has not finished reading. the
+    /// restore must also not be resumed after any of these offsets
+    std::map<size_t, size_t> streamOffsets;
+
+    /// @brief number of streams that have not finished reading their part of
+    /// the input data file
+    uint32_t pendingStreams = 1;
+
+    /// @brief number of bytes of the input data file read by all streams,
+    /// used for progress reporting
+    std::atomic<int64_t> numRead{0};
+
     /// @brief whether ot not we have read the complete input data file for the
     /// collection
     bool readCompleteInputfile;
+
+    /// @brief whether the data is sent as velocypack documents instead of
+    /// JSON lines. set before any data is sent
+    bool vpack = false;
   };
 
   /// @brief Stores all necessary data to restore a single collection or shard
@@ -199,6 +219,10 @@ class RestoreFeature final : public ArangoRestoreFeature {
                    Options const& options, Stats& stats, VPackSlice parameters,
                    bool useEnvelope);
 
+    /// @brief create a job that reads the range [begin, end) of the data
+    /// file of the collection restored by main, in parallel to main
+    RestoreMainJob(RestoreMainJob const& main, size_t begin, size_t end);
+
     Result run(arangodb::httpclient::SimpleHttpClient& client) override;
 
     Result dispatchRestoreData(arangodb::httpclient::SimpleHttpClient& client,
@@ -207,6 +231,22 @@ class RestoreFeature final : public ArangoRestoreFeature {
 
     Result restoreData(arangodb::httpclient::SimpleHttpClient& client);
 
+    /// @brief split the data file from offset begin up to offset end into
+    /// ranges starting at line boundaries, and queue one job per range
+    /// except for the first. returns the end of the first range, which is
+    /// to be read by this job
+    size_t queueStreams(std::string const& filename, size_t begin, size_t end);
+
+    /// @brief mark the reading of this job's range of the data file as
+    /// finished. returns true for the last of the jobs reading the file
+    bool finishStream();
+
+    /// @brief Restore the data of a binary dump, which consists of LZ4 frames
+    /// holding velocypack documents
+    Result restoreVPackData(arangodb::httpclient::SimpleHttpClient& client,
+                            ManagedDirectory::File& datafile,
+                            size_t readOffset);
+
     /// @brief Restore a collection's indexes given its description
     Result restoreIndexes(arangodb::httpclient::SimpleHttpClient& client);
 
@@ -217,6 +257,16 @@ class RestoreFeature final : public ArangoRestoreFeature {
     ManagedDirectory& directory;
     VPackSlice parameters;
     bool useEnvelope;
+    /// @brief create the indexes only after the data was restored, by
+    /// another job
+    bool deferIndexes = false;
+    /// @brief only create the indexes, as the data was restored before
+    bool indexesOnly = false;
+    /// @brief whether this job reads a range of the data file in parallel
+    /// to the collection's main job
+    bool isStream = false;
+    size_t rangeBegin = 0;
+    size_t rangeEnd = 0;
   };
 
   struct RestoreSendJob : public RestoreJob {
@@ -238,6 +288,26 @@ class RestoreFeature final : public ArangoRestoreFeature {
   static void sortCollectionsForCreation(
       std::vector<VPackBuilder>& collections);
 
+  /// @brief offset from which the restore of a data file can be resumed,
+  /// given the offsets of the unacknowledged chunks and of the parallel
+  /// streams still reading the file
+  static size_t resumeOffset(std::map<size_t, size_t> const& readOffsets,
+                             std::map<size_t, size_t> const& streamOffsets);
+
+  /// @brief start offsets of up to streams ranges of about equal size of
+  /// the range [begin, end) of a data file. all ranges start at a line
+  /// boundary
+  static std::vector<size_t> findStreamBoundaries(ManagedDirectory& directory,
+                                                  std::string const& filename,
+                                                  size_t begin, size_t end,
+                                                  uint32_t streams);
+
+  /// @brief length of the complete velocypack documents at the start of a
+  /// chunk of a binary dump, limited to chunkSize unless the first document
+  /// alone is larger
+  static size_t completeDocuments(uint8_t const* data, size_t length,
+                                  size_t chunkSize);
+
  private:
   struct DatabaseInfo {
     std::string directory;
@@ -692,8 +692,17 @@ std::int64_t ManagedDirectory::File::offset() const {
 void ManagedDirectory::File::skip(size_t count) {
   MUTEX_LOCKER(lock, _mutex);
 
-  // TODO is there a better implementation than just read count bytes?
-  // how does this work with gzip?
+  bool canSeek = !isGzip();
+#ifdef USE_ENTERPRISE
+  canSeek &= !(_context && _directory.isEncrypted());
+#endif
+  if (canSeek && ::isReadable(_fd, _flags, _path, _status) &&
+      TRI_LSEEK(_fd, static_cast<int64_t>(count), SEEK_CUR) >= 0) {
+    // plain files can be positioned directly
+    return;
+  }
+
+  // compressed and encrypted files must be read up to the position
   size_t const bufferSize = 4 * 1024;
   char buffer[bufferSize];
 
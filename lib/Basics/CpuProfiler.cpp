@@ -0,0 +1,571 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CpuProfiler.h"
+
+#include "Basics/debugging.h"
+#include "Basics/voc-errors.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include <boost/core/demangle.hpp>
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define ARANGODB_CPU_PROFILER_SUPPORTED 1
+#include <pthread.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+#ifdef ARANGODB_HAVE_LIBUNWIND
+#define UNW_LOCAL_ONLY
+#include <libunwind.h>
+#endif
+
+using namespace arangodb;
+
+/// @brief a thread that can be sampled. the fields are set up by the thread
+/// itself before it is added to the registry, and are constant afterwards,
+/// except for samples and inHandler
+struct CpuProfiler::RegisteredThread {
+  std::string name;
+#ifdef ARANGODB_CPU_PROFILER_SUPPORTED
+  pid_t tid = 0;
+  pthread_t handle;
+#endif
+  uintptr_t stackLow = 0;
+  uintptr_t stackHigh = 0;
+  /// @brief buffer of the active profiler for this thread, if any
+  std::atomic<ThreadSamples*> samples{nullptr};
+  /// @brief whether the signal handler currently runs on this thread
+  std::atomic<bool> inHandler{false};
+};
+
+/// @brief the samples of one thread. written only by the signal handler
+/// running on that thread, and read only after the profiler was stopped.
+/// each sample is stored as the number of frames, followed by the frames,
+/// innermost frame first
+struct CpuProfiler::ThreadSamples {
+  std::string name;
+#ifdef ARANGODB_CPU_PROFILER_SUPPORTED
+  timer_t timer;
+#endif
+  bool hasTimer = false;
+  std::unique_ptr<uintptr_t[]> words;
+  size_t capacity = 0;
+  size_t maxSamples = 0;
+  size_t used = 0;
+  size_t numSamples = 0;
+  uint64_t dropped = 0;
+};
+
+namespace {
+
+#ifdef ARANGODB_CPU_PROFILER_SUPPORTED
+constexpr bool profilingSupported = true;
+#else
+constexpr bool profilingSupported = false;
+#endif
+
+/// @brief average number of frames we reserve buffer space for per sample
+constexpr size_t averageFrames = 24;
+
+/// @brief the currently active profiler, if any
+std::atomic<CpuProfiler*> activeProfiler{nullptr};
+
+/// @brief all threads that can be sampled
+std::mutex registryMutex;
+std::vector<CpuProfiler::RegisteredThread*> registry;
+
+/// @brief registration of the current thread, if any
+thread_local CpuProfiler::RegisteredThread* currentThread = nullptr;
+
+#ifdef ARANGODB_CPU_PROFILER_SUPPORTED
+/// @brief the signal handler is installed once and never removed, because
+/// a SIGPROF can still be pending after the timers have been deleted, and
+/// the default action for SIGPROF is to terminate the process. signals for
+/// threads that are not being sampled are passed on to the handler that
+/// was installed before, e.g. the one of V8's sampler
+std::once_flag installHandlerFlag;
+struct sigaction previousAction;
+
+void profilingSignalHandler(int signal, siginfo_t* info, void* ucontext) {
+  int savedErrno = errno;
+  if (!CpuProfiler::handleSignal(ucontext)) {
+    if (previousAction.sa_flags & SA_SIGINFO) {
+      if (previousAction.sa_sigaction != nullptr) {
+        previousAction.sa_sigaction(signal, info, ucontext);
+      }
+    } else if (previousAction.sa_handler != SIG_DFL &&
+               previousAction.sa_handler != SIG_IGN) {
+      previousAction.sa_handler(signal);
+    }
+  }
+  errno = savedErrno;
+}
+#endif
+
+#ifdef ARANGODB_HAVE_LIBUNWIND
+/// @brief maximum number of frames of the signal handler itself, which are
+/// on the stack on top of the interrupted frame
+constexpr size_t maxHandlerFrames = 8;
+
+/// @brief unwind the stack of the interrupted code with libunwind, which
+/// uses the unwind tables and thus also works for code compiled without
+/// frame pointers. libunwind's local unwinding is async-signal-safe. the
+/// trace starts in the signal handler, so all frames up to the interrupted
+/// pc are skipped. returns 0 if the interrupted pc is not found
+size_t unwindStack(uintptr_t pc, uintptr_t* frames) noexcept {
+  void* trace[CpuProfiler::maxFrames + maxHandlerFrames];
+  int n = unw_backtrace(&trace[0], static_cast<int>(std::size(trace)));
+  for (int i = 0; i < n && i <= static_cast<int>(maxHandlerFrames); ++i) {
+    if (reinterpret_cast<uintptr_t>(trace[i]) == pc) {
+      size_t depth = std::min<size_t>(n - i, CpuProfiler::maxFrames);
+      for (size_t frame = 0; frame < depth; ++frame) {
+        frames[frame] = reinterpret_cast<uintptr_t>(trace[i + frame]);
+      }
+      return depth;
+    }
+  }
+  return 0;
+}
+
+std::string symbolize(uintptr_t pc) {
+  // libunwind 1.5 has no API to look up the procedure name for an arbitrary
+  // address. so we create a cursor for the current frame and move it to the
+  // address in question
+  unw_context_t uc;
+  unw_cursor_t cursor;
+  if (unw_getcontext(&uc) == 0 && unw_init_local(&cursor, &uc) == 0 &&
+      unw_set_reg(&cursor, UNW_REG_IP, static_cast<unw_word_t>(pc)) == 0) {
+    char mangled[512];
+    unw_word_t offset = 0;
+    if (unw_get_proc_name(&cursor, &mangled[0], sizeof(mangled) - 1,
+                          &offset) == 0) {
+      mangled[sizeof(mangled) - 1] = '\0';
+      return boost::core::demangle(&mangled[0]);
+    }
+  }
+  std::ostringstream s;
+  s << "0x" << std::hex << pc;
+  return s.str();
+}
+#else
+std::string symbolize(uintptr_t pc) {
+  std::ostringstream s;
+  s << "0x" << std::hex << pc;
+  return s.str();
+}
+#endif
+
+/// @brief make a name usable as a frame in the collapsed stacks format
+void appendFrame(std::string& out, std::string_view name) {
+  out.push_back(';');
+  for (char c : name) {
+    out.push_back((c == ';' || c == '\n') ? '_' : c);
+  }
+}
+
+/// @brief call the callback for each sample of a thread with the number of
+/// frames and a pointer to the frames, innermost frame first
+template<typename F>
+void forEachSample(CpuProfiler::ThreadSamples const& samples, F&& callback) {
+  size_t pos = 0;
+  while (pos < samples.used) {
+    size_t depth = samples.words[pos];
+    callback(depth, &samples.words[pos + 1]);
+    pos += depth + 1;
+  }
+}
+
+}  // namespace
+
+CpuProfiler::ThreadRegistration::ThreadRegistration(
+    [[maybe_unused]] std::string_view name) {
+  if (!profilingSupported) {
+    return;
+  }
+#ifdef ARANGODB_CPU_PROFILER_SUPPORTED
+  auto thread = std::make_unique<RegisteredThread>();
+  thread->name = name;
+  thread->tid = static_cast<pid_t>(syscall(SYS_gettid));
+  thread->handle = pthread_self();
+
+  pthread_attr_t attr;
+  if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+    void* address = nullptr;
+    size_t size = 0;
+    if (pthread_attr_getstack(&attr, &address, &size) == 0) {
+      thread->stackLow = reinterpret_cast<uintptr_t>(address);
+      thread->stackHigh = thread->stackLow + size;
+    }
+    pthread_attr_destroy(&attr);
+  }
+  if (thread->stackLow == thread->stackHigh) {
+    // without the stack bounds we cannot walk the stack safely
+    return;
+  }
+
+  sigset_t set;
+  sigemptyset(&set);
+  sigaddset(&set, SIGPROF);
+  pthread_sigmask(SIG_UNBLOCK, &set, nullptr);
+
+  currentThread = thread.get();
+  std::lock_guard guard{registryMutex};
+  registry.push_back(thread.get());
+  _thread = std::move(thread);
+#endif
+}
+
+CpuProfiler::ThreadRegistration::~ThreadRegistration() {
+  if (_thread == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard guard{registryMutex};
+    registry.erase(std::find(registry.begin(), registry.end(), _thread.get()));
+    // the signal handler can only run on this very thread, so it cannot
+    // access the samples concurrently
+    _thread->samples.store(nullptr);
+  }
+  currentThread = nullptr;
+}
+
+CpuProfiler::CpuProfiler(uint32_t frequency, size_t samplesPerThread)
+    : _frequency(std::clamp<uint32_t>(frequency, 1, maxFrequency)),
+      _samplesPerThread(
+          std::clamp<size_t>(samplesPerThread, 1, maxSamplesPerThread)),
+      _running(false) {}
+
+CpuProfiler::~CpuProfiler() { stop(); }
+
+bool CpuProfiler::supported() noexcept { return profilingSupported; }
+
+Result CpuProfiler::start() {
+  if (!supported()) {
+    return {TRI_ERROR_NOT_IMPLEMENTED,
+            "CPU profiling is not supported on this platform"};
+  }
+  if (_running) {
+    return {TRI_ERROR_INTERNAL, "CPU profiler already started"};
+  }
+
+  CpuProfiler* expected = nullptr;
+  if (!activeProfiler.compare_exchange_strong(expected, this)) {
+    return {TRI_ERROR_LOCKED, "another CPU profile is currently being taken"};
+  }
+
+#ifdef ARANGODB_CPU_PROFILER_SUPPORTED
+  std::call_once(installHandlerFlag, []() {
+    struct sigaction act;
+    memset(&act, 0, sizeof(act));
+    sigemptyset(&act.sa_mask);
+    act.sa_flags = SA_SIGINFO | SA_RESTART;
+    act.sa_sigaction = profilingSignalHandler;
+    sigaction(SIGPROF, &act, &previousAction);
+  });
+
+  _threads.clear();
+
+  struct itimerspec interval;
+  interval.it_interval.tv_sec = 0;
+  interval.it_interval.tv_nsec = 1000000000 / _frequency;
+  interval.it_value = interval.it_interval;
+
+  std::lock_guard guard{registryMutex};
+
+  // the buffers of all threads together must not exceed maxBufferSize. the
+  // buffer of a thread always has room for at least one sample
+  size_t const capacity = std::max(
+      std::min(_samplesPerThread * (averageFrames + 1),
+               maxBufferSize / sizeof(uintptr_t) /
+                   std::max<size_t>(1, registry.size())),
+      maxFrames + 1);
+
+  try {
+    _threads.reserve(registry.size());
+    for (RegisteredThread* thread : registry) {
+      auto samples = std::make_unique<ThreadSamples>();
+      samples->name = thread->name;
+      // the buffer is not initialized, so that untouched pages are not
+      // backed by memory
+      samples->words.reset(new uintptr_t[capacity]);
+      samples->capacity = capacity;
+      samples->maxSamples = _samplesPerThread;
+
+      clockid_t clock;
+      if (pthread_getcpuclockid(thread->handle, &clock) != 0) {
+        continue;
+      }
+      struct sigevent event;
+      memset(&event, 0, sizeof(event));
+      event.sigev_notify = SIGEV_THREAD_ID;
+      event.sigev_signo = SIGPROF;
+      event.sigev_notify_thread_id = thread->tid;
+      if (timer_create(clock, &event, &samples->timer) != 0) {
+        continue;
+      }
+      samples->hasTimer = true;
+
+      thread->samples.store(samples.get());
+      _threads.emplace_back(std::move(samples));
+    }
+  } catch (...) {
+    for (auto& samples : _threads) {
+      timer_delete(samples->timer);
+    }
+    for (RegisteredThread* thread : registry) {
+      thread->samples.store(nullptr);
+    }
+    _threads.clear();
+    activeProfiler.store(nullptr);
+    return {TRI_ERROR_OUT_OF_MEMORY,
+            "unable to allocate CPU profile buffers"};
+  }
+
+  for (auto& samples : _threads) {
+    timer_settime(samples->timer, 0, &interval, nullptr);
+  }
+#endif
+
+  _running = true;
+  return {};
+}
+
+void CpuProfiler::stop() noexcept {
+  if (!_running) {
+    return;
+  }
+
+#ifdef ARANGODB_CPU_PROFILER_SUPPORTED
+  for (auto& samples : _threads) {
+    if (samples->hasTimer) {
+      timer_delete(samples->timer);
+      samples->hasTimer = false;
+    }
+  }
+
+  {
+    std::lock_guard guard{registryMutex};
+    for (RegisteredThread* thread : registry) {
+      thread->samples.store(nullptr);
+      // wait for a signal handler that may still write into the samples
+      while (thread->inHandler.load()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+#endif
+
+  TRI_ASSERT(activeProfiler.load() == this);
+  activeProfiler.store(nullptr);
+  _running = false;
+}
+
+size_t CpuProfiler::numSamples() const noexcept {
+  size_t result = 0;
+  for (auto const& samples : _threads) {
+    result += samples->numSamples;
+  }
+  return result;
+}
+
+uint64_t CpuProfiler::numDropped() const noexcept {
+  uint64_t result = 0;
+  for (auto const& samples : _threads) {
+    result += samples->dropped;
+  }
+  return result;
+}
+
+bool CpuProfiler::handleSignal([[maybe_unused]] void* ucontext) noexcept {
+#ifdef ARANGODB_CPU_PROFILER_SUPPORTED
+  RegisteredThread* thread = currentThread;
+  if (thread == nullptr) {
+    return false;
+  }
+
+  thread->inHandler.store(true);
+  ThreadSamples* samples = thread->samples.load();
+  if (samples != nullptr) {
+    auto const* context = static_cast<ucontext_t const*>(ucontext);
+#if defined(__x86_64__)
+    auto pc = static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_RIP]);
+    auto fp = static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_RBP]);
+#else
+    auto pc = static_cast<uintptr_t>(context->uc_mcontext.pc);
+    auto fp = static_cast<uintptr_t>(context->uc_mcontext.regs[29]);
+#endif
+
+    uintptr_t frames[maxFrames];
+    size_t depth = 0;
+#ifdef ARANGODB_HAVE_LIBUNWIND
+    depth = unwindStack(pc, &frames[0]);
+#endif
+    if (depth == 0) {
+      frames[depth++] = pc;
+      // follow the chain of frame pointers. each frame record consists of
+      // the caller's frame pointer followed by the return address. only
+      // memory inside the thread's stack is read, and the chain must move
+      // towards the stack bottom, so that garbage in the frame pointer
+      // register (code compiled without frame pointers) cannot make us
+      // fault or loop
+      while (depth < maxFrames && fp % sizeof(uintptr_t) == 0 &&
+             fp >= thread->stackLow &&
+             fp + 2 * sizeof(uintptr_t) <= thread->stackHigh) {
+        auto const* record = reinterpret_cast<uintptr_t const*>(fp);
+        uintptr_t next = record[0];
+        uintptr_t returnAddress = record[1];
+        if (returnAddress == 0) {
+          break;
+        }
+        frames[depth++] = returnAddress;
+        if (next <= fp) {
+          break;
+        }
+        fp = next;
+      }
+    }
+
+    if (samples->numSamples < samples->maxSamples &&
+        samples->used + depth + 1 <= samples->capacity) {
+      samples->words[samples->used] = depth;
+      memcpy(&samples->words[samples->used + 1], &frames[0],
+             depth * sizeof(uintptr_t));
+      samples->used += depth + 1;
+      ++samples->numSamples;
+    } else {
+      ++samples->dropped;
+    }
+  }
+  thread->inHandler.store(false);
+  return samples != nullptr;
+#else
+  return false;
+#endif
+}
+
+std::string CpuProfiler::toCollapsed() const {
+  TRI_ASSERT(!_running);
+
+  std::unordered_map<uintptr_t, std::string> symbols;
+  std::map<std::string, uint64_t> stacks;
+
+  std::string line;
+  for (auto const& samples : _threads) {
+    forEachSample(*samples, [&](size_t depth, uintptr_t const* frames) {
+      if (depth == 0) {
+        return;
+      }
+      line.clear();
+      for (char c : samples->name) {
+        line.push_back((c == ';' || c == ' ') ? '_' : c);
+      }
+      for (size_t frame = depth; frame-- > 0;) {
+        // all frames but the innermost one are return addresses, which
+        // point to the instruction after the call
+        uintptr_t pc = frames[frame] - (frame > 0 ? 1 : 0);
+        auto it = symbols.find(pc);
+        if (it == symbols.end()) {
+          it = symbols.emplace(pc, symbolize(pc)).first;
+        }
+        appendFrame(line, it->second);
+      }
+      ++stacks[line];
+    });
+  }
+
+  std::string out;
+  for (auto const& [stack, count] : stacks) {
+    out.append(stack);
+    out.push_back(' ');
+    out.append(std::to_string(count));
+    out.push_back('\n');
+  }
+  return out;
+}
+
+std::string CpuProfiler::toPprof() const {
+  TRI_ASSERT(!_running);
+
+  std::map<std::vector<uintptr_t>, uint64_t> stacks;
+  for (auto const& samples : _threads) {
+    forEachSample(*samples, [&](size_t depth, uintptr_t const* frames) {
+      if (depth > 0) {
+        ++stacks[std::vector<uintptr_t>(frames, frames + depth)];
+      }
+    });
+  }
+
+  std::string out;
+  auto append = [&out](uintptr_t value) {
+    out.append(reinterpret_cast<char const*>(&value), sizeof(value));
+  };
+
+  // header: header count, header words, version, sampling period (us), pad
+  append(0);
+  append(3);
+  append(0);
+  append(1000000 / _frequency);
+  append(0);
+
+  for (auto const& [pcs, count] : stacks) {
+    append(count);
+    append(pcs.size());
+    for (uintptr_t pc : pcs) {
+      append(pc);
+    }
+  }
+
+  // trailer
+  append(0);
+  append(1);
+  append(0);
+
+  // memory mappings, used by pprof to map addresses to binaries
+  std::ifstream maps("/proc/self/maps");
+  if (maps) {
+    std::ostringstream s;
+    s << maps.rdbuf();
+    out.append(s.str());
+  }
+  return out;
+}
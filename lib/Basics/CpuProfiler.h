@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Basics/Result.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace arangodb {
+
+/// @brief sampling CPU profiler for the threads of the current process.
+/// only threads that have registered themselves via a ThreadRegistration
+/// are sampled. when the profiler is started, it creates one timer per
+/// registered thread which measures the CPU time consumed by that thread
+/// and sends SIGPROF to that thread only, so busy threads are sampled
+/// proportionally to their CPU usage, and no other thread ever sees the
+/// signal. the signal handler unwinds the stack of the interrupted thread
+/// in an async-signal-safe way and writes the return addresses into a
+/// buffer preallocated for the thread. stacks are unwound with libunwind
+/// if available, which does not need frame pointers. otherwise the frame
+/// pointer chain is walked, and complete stacks require code compiled with
+/// frame pointers. samples are symbolized only after the profiler has been
+/// stopped.
+/// only one profiler can be active at a time.
+class CpuProfiler {
+ public:
+  /// @brief maximum number of stack frames recorded per sample
+  static constexpr size_t maxFrames = 64;
+  /// @brief upper bound for the number of samples recorded per thread
+  static constexpr size_t maxSamplesPerThread = 65536;
+  /// @brief upper bound for the memory used by the sample buffers of all
+  /// threads together. with many threads, fewer samples fit per thread
+  static constexpr size_t maxBufferSize = 64 * 1024 * 1024;
+  static constexpr uint32_t defaultFrequency = 99;
+  static constexpr uint32_t maxFrequency = 1000;
+
+  /// @brief internal state, defined in CpuProfiler.cpp
+  struct RegisteredThread;
+  struct ThreadSamples;
+
+  /// @brief makes the calling thread eligible for sampling for the lifetime
+  /// of the object. the thread unblocks SIGPROF, which it only receives
+  /// while a profile is being taken. threads registering while a profiler
+  /// is running are sampled by the next profiler
+  class ThreadRegistration {
+   public:
+    explicit ThreadRegistration(std::string_view name);
+    ~ThreadRegistration();
+
+    ThreadRegistration(ThreadRegistration const&) = delete;
+    ThreadRegistration& operator=(ThreadRegistration const&) = delete;
+
+   private:
+    std::unique_ptr<RegisteredThread> _thread;
+  };
+
+  /// @brief create a profiler which samples each thread with the given
+  /// frequency (in Hz, per second of CPU time of the thread) and can hold
+  /// up to samplesPerThread samples of each thread, as far as they fit into
+  /// maxBufferSize. samples that do not fit into the buffer anymore are
+  /// counted, but dropped
+  CpuProfiler(uint32_t frequency, size_t samplesPerThread);
+  ~CpuProfiler();
+
+  CpuProfiler(CpuProfiler const&) = delete;
+  CpuProfiler& operator=(CpuProfiler const&) = delete;
+
+  /// @brief whether or not CPU profiling is available in this build
+  static bool supported() noexcept;
+
+  /// @brief start sampling all registered threads. fails if another
+  /// profiler is currently active
+  Result start();
+
+  /// @brief stop sampling. waits until no signal handler accesses the sample
+  /// buffers anymore
+  void stop() noexcept;
+
+  /// @brief number of threads sampled
+  size_t numThreads() const noexcept { return _threads.size(); }
+
+  /// @brief number of recorded samples
+  size_t numSamples() const noexcept;
+
+  /// @brief number of samples dropped because a buffer was full
+  uint64_t numDropped() const noexcept;
+
+  /// @brief return the recorded samples in the "collapsed stacks" text format
+  /// understood by flamegraph.pl and speedscope: one line per distinct stack,
+  /// starting with the thread name and the outermost frame, followed by the
+  /// number of samples
+  std::string toCollapsed() const;
+
+  /// @brief return the recorded samples in the legacy binary CPU profile
+  /// format of gperftools, followed by the memory mappings of the process.
+  /// pprof symbolizes such profiles by itself using the arangod binary
+  std::string toPprof() const;
+
+  /// @brief record a sample of the interrupted thread. only to be called from
+  /// the SIGPROF signal handler. returns false if the thread is not being
+  /// sampled
+  static bool handleSignal(void* ucontext) noexcept;
+
+ private:
+  uint32_t const _frequency;
+  size_t const _samplesPerThread;
+  std::vector<std::unique_ptr<ThreadSamples>> _threads;
+  bool _running;
+};
+
+}  // namespace arangodb
@@ -104,6 +104,35 @@ void GlobalResourceMonitor::forceUpdateMemoryUsage(
   _current.fetch_add(value, std::memory_order_relaxed);
 }
 
+void GlobalResourceMonitor::trackSubsystemUsage(MemorySubsystem subsystem,
+                                                std::int64_t value) noexcept {
+  _subsystems[static_cast<std::size_t>(subsystem)].fetch_add(
+      value, std::memory_order_relaxed);
+}
+
+std::int64_t GlobalResourceMonitor::subsystemUsage(
+    MemorySubsystem subsystem) const noexcept {
+  return _subsystems[static_cast<std::size_t>(subsystem)].load(
+      std::memory_order_relaxed);
+}
+
+/*static*/ std::string_view GlobalResourceMonitor::subsystemName(
+    MemorySubsystem subsystem) noexcept {
+  switch (subsystem) {
+    case MemorySubsystem::Aql:
+      return "aql";
+    case MemorySubsystem::Operations:
+      return "operations";
+    case MemorySubsystem::Indexes:
+      return "indexes";
+    case MemorySubsystem::Pregel:
+      return "pregel";
+    case MemorySubsystem::Other:
+      break;
+  }
+  return "other";
+}
+
 /// @brief returns a reference to a global shared instance
 /*static*/ GlobalResourceMonitor& GlobalResourceMonitor::instance() noexcept {
   return ::instance;
@@ -25,11 +25,22 @@
 
 #include "Basics/Common.h"
 
+#include <array>
 #include <atomic>
 #include <cstdint>
+#include <string_view>
 
 namespace arangodb {
 
+/// @brief subsystems for which tracked memory usage is accounted separately
+enum class MemorySubsystem : std::uint8_t {
+  Other,
+  Aql,
+  Operations,
+  Indexes,
+  Pregel,
+};
+
 class alignas(64) GlobalResourceMonitor final {
   GlobalResourceMonitor(GlobalResourceMonitor const&) = delete;
   GlobalResourceMonitor& operator=(GlobalResourceMonitor const&) = delete;
@@ -39,7 +50,11 @@ class alignas(64) GlobalResourceMonitor final {
       : _current(0),
         _limit(0),
         _globalLimitReachedCounter(0),
-        _localLimitReachedCounter(0) {}
+        _localLimitReachedCounter(0),
+        _subsystems{} {}
+
+  static constexpr std::size_t numSubsystems =
+      static_cast<std::size_t>(MemorySubsystem::Pregel) + 1;
 
   struct Stats {
     std::uint64_t globalLimitReached;
@@ -79,6 +94,18 @@ class alignas(64) GlobalResourceMonitor final {
   /// decrease!
   void forceUpdateMemoryUsage(std::int64_t value) noexcept;
 
+  /// @brief adjust the memory usage accounted to a subsystem by <value>
+  /// bytes. this is only bookkeeping and is not checked against any limit.
+  /// the sum over all subsystems is the current global memory usage.
+  void trackSubsystemUsage(MemorySubsystem subsystem,
+                           std::int64_t value) noexcept;
+
+  /// @brief return the current memory usage accounted to a subsystem
+  std::int64_t subsystemUsage(MemorySubsystem subsystem) const noexcept;
+
+  /// @brief return the name of a subsystem, for reporting
+  static std::string_view subsystemName(MemorySubsystem subsystem) noexcept;
+
   /// @brief returns a reference to a global shared instance
   static GlobalResourceMonitor& instance() noexcept;
 
@@ -101,6 +128,9 @@ class alignas(64) GlobalResourceMonitor final {
 
   /// @brief number of times a local memory limit was reached
   std::atomic<std::uint64_t> _localLimitReachedCounter;
+
+  /// @brief memory usage per subsystem, with the same granularity as _current
+  std::array<std::atomic<std::int64_t>, numSubsystems> _subsystems;
 };
 
 }  // namespace arangodb
@@ -29,8 +29,16 @@
 
 using namespace arangodb;
 
+ResourceMonitor::ResourceMonitor(GlobalResourceMonitor& global,
+                                 MemorySubsystem subsystem) noexcept
+    : _current(0),
+      _peak(0),
+      _limit(0),
+      _global(global),
+      _subsystem(subsystem) {}
+
 ResourceMonitor::ResourceMonitor(GlobalResourceMonitor& global) noexcept
-    : _current(0), _peak(0), _limit(0), _global(global) {}
+    : ResourceMonitor(global, MemorySubsystem::Other) {}
 
 ResourceMonitor::~ResourceMonitor() {
   // this assertion is here to ensure that our memory usage tracking works
@@ -122,6 +130,7 @@ void ResourceMonitor::increaseMemoryUsage(std::uint64_t value) {
         // forceUpdateMemoryUsage takes a signed int64, so we can
         // increase/decrease
         _global.forceUpdateMemoryUsage(adjustedDiff * chunkSize);
+        _global.trackSubsystemUsage(_subsystem, adjustedDiff * chunkSize);
       }
     };
 
@@ -158,6 +167,7 @@ void ResourceMonitor::increaseMemoryUsage(std::uint64_t value) {
                                      "global memory limit exceeded");
     }
     // increasing the global counter has succeeded!
+    _global.trackSubsystemUsage(_subsystem, diff * chunkSize);
 
     // update the peak memory usage counter for the local instance. we do this
     // only when there was a change in the number of chunks.
@@ -191,6 +201,7 @@ void ResourceMonitor::decreaseMemoryUsage(std::uint64_t value) noexcept {
   if (diff != 0) {
     // number of chunks has changed. now we will update the global counter!
     _global.decreaseMemoryUsage(diff * chunkSize);
+    _global.trackSubsystemUsage(_subsystem, -diff * chunkSize);
     // no need to update the peak memory usage counter here
   }
 }
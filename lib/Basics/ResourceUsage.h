@@ -31,6 +31,7 @@
 
 namespace arangodb {
 class GlobalResourceMonitor;
+enum class MemorySubsystem : std::uint8_t;
 
 struct alignas(64) ResourceMonitor final {
   /// @brief: granularity of allocations that we track. this should be a
@@ -48,6 +49,10 @@ struct alignas(64) ResourceMonitor final {
   ResourceMonitor(ResourceMonitor const&) = delete;
   ResourceMonitor& operator=(ResourceMonitor const&) = delete;
 
+  /// @brief create a monitor that reports its memory usage to the global
+  /// monitor, accounted to the given subsystem
+  explicit ResourceMonitor(GlobalResourceMonitor& global,
+                           MemorySubsystem subsystem) noexcept;
   explicit ResourceMonitor(GlobalResourceMonitor& global) noexcept;
   ~ResourceMonitor();
 
@@ -90,6 +95,7 @@ struct alignas(64) ResourceMonitor final {
   std::atomic<std::uint64_t> _peak;
   std::uint64_t _limit;
   GlobalResourceMonitor& _global;
+  MemorySubsystem const _subsystem;
 };
 
 /// @brief RAII object for temporary resource tracking
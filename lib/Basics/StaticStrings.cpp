@@ -86,6 +86,8 @@ std::string const StaticStrings::ReplicationHeaderFromPresent(
     "x-arango-replication-frompresent");
 std::string const StaticStrings::ReplicationHeaderActive(
     "x-arango-replication-active");
+std::string const StaticStrings::ReplicationHeaderRange(
+    "x-arango-replication-range");
 
 // database names
 std::string const StaticStrings::SystemDatabase("_system");
@@ -273,6 +275,7 @@ std::string const StaticStrings::ObjectId("objectId");
 std::string const StaticStrings::ReplicationFactor("replicationFactor");
 std::string const StaticStrings::Satellite("satellite");
 std::string const StaticStrings::ShardKeys("shardKeys");
+std::string const StaticStrings::ShardSplitPoints("shardSplitPoints");
 std::string const StaticStrings::Sharding("sharding");
 std::string const StaticStrings::ShardingStrategy("shardingStrategy");
 std::string const StaticStrings::SmartJoinAttribute("smartJoinAttribute");
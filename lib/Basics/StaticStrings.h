@@ -83,6 +83,7 @@ class StaticStrings {
   static std::string const ReplicationHeaderLastTick;
   static std::string const ReplicationHeaderFromPresent;
   static std::string const ReplicationHeaderActive;
+  static std::string const ReplicationHeaderRange;
 
   // database names
   static std::string const SystemDatabase;
@@ -255,6 +256,7 @@ class StaticStrings {
   static std::string const ReplicationFactor;
   static std::string const Satellite;
   static std::string const ShardKeys;
+  static std::string const ShardSplitPoints;
   static std::string const Sharding;
   static std::string const ShardingStrategy;
   static std::string const SmartJoinAttribute;
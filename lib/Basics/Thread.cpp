@@ -37,6 +37,7 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/ConditionLocker.h"
+#include "Basics/CpuProfiler.h"
 #include "Basics/Exceptions.h"
 #include "Basics/ScopeGuard.h"
 #include "Basics/application-exit.h"
@@ -131,6 +132,9 @@ void Thread::startThread(void* arg) {
 
   LOCAL_THREAD_NAME = ptr->name().c_str();
 
+  // allow the thread to be sampled by the CPU profiler
+  CpuProfiler::ThreadRegistration profilerRegistration(ptr->name());
+
   // make sure we drop our reference when we are finished!
   auto guard = scopeGuard([ptr]() noexcept {
     LOCAL_THREAD_NAME = nullptr;
@@ -57,6 +57,7 @@
 #include "Basics/files.h"
 #include "Basics/memory.h"
 #include "Basics/system-compiler.h"
+#include "Basics/wyhash.h"
 #include "Logger/LogMacros.h"
 
 using namespace arangodb;
@@ -306,6 +307,41 @@ size_t VelocyPackHelper::VPackHash::operator()(VPackSlice const& slice) const {
   return static_cast<size_t>(slice.normalizedHash());
 }
 
+uint64_t VelocyPackHelper::fastNormalizedHash(VPackSlice slice,
+                                              uint64_t seed) {
+  // type tags, so that e.g. the string "" and the number 0 do not collide
+  constexpr uint64_t numberTag = 0x6e756d6265720000ULL;
+  constexpr uint64_t stringTag = 0x737472696e670000ULL;
+
+  switch (slice.type()) {
+    case VPackValueType::SmallInt:
+    case VPackValueType::Int:
+    case VPackValueType::UInt:
+    case VPackValueType::Double: {
+      // numbers of different representations compare equal if their values
+      // are equal, so hash them all as doubles. -0.0 == 0.0
+      double value = slice.getNumber<double>();
+      if (value == 0.0) {
+        value = 0.0;
+      }
+      uint64_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      return wyhash64_uint64(bits, seed ^ numberTag);
+    }
+    case VPackValueType::String: {
+      std::string_view value = slice.stringView();
+      return wyhash64(value.data(), value.size(), seed ^ stringTag);
+    }
+    case VPackValueType::Null:
+      return wyhash64_uint64(0x6e756c6cULL, seed);
+    case VPackValueType::Bool:
+      return wyhash64_uint64(
+          slice.getBoolean() ? 0x74727565ULL : 0x66616c7365ULL, seed);
+    default:
+      return slice.normalizedHash(seed);
+  }
+}
+
 size_t VelocyPackHelper::VPackStringHash::operator()(
     VPackSlice const& slice) const noexcept {
   return static_cast<size_t>(slice.hashString());
@@ -871,6 +907,62 @@ uint64_t VelocyPackHelper::extractIdValue(VPackSlice const& slice) {
   return 0;
 }
 
+/// @brief byte size of a velocypack value, without reading past length
+VPackValueLength VelocyPackHelper::byteSizeWithin(uint8_t const* data,
+                                                  size_t length) {
+  // determine how many bytes VPackSlice::byteSize() will look at
+  size_t offset = 0;
+  size_t header = 1;
+  while (true) {
+    if (offset >= length) {
+      return 0;
+    }
+    uint8_t head = data[offset];
+    if (head == 0xee || head == 0xef) {
+      // tagged value: 1 or 8 bytes of tag, followed by the actual value
+      offset += (head == 0xee) ? 2 : 9;
+      continue;
+    }
+    if (head >= 0x02 && head <= 0x09) {
+      // array with 1, 2, 4 or 8 bytes of byte length
+      header = 1 + (size_t(1) << ((head - 0x02) & 3));
+    } else if (head >= 0x0b && head <= 0x12) {
+      // object with 1, 2, 4 or 8 bytes of byte length
+      header = 1 + (size_t(1) << ((head - 0x0b) & 3));
+    } else if (head == 0x13 || head == 0x14) {
+      // compact array or object. the byte length is a varint of up to 10
+      // bytes
+      uint8_t b;
+      do {
+        if (offset + header >= length) {
+          return 0;
+        }
+        b = data[offset + header];
+        ++header;
+      } while ((b & 0x80) != 0);
+    } else if (head == 0xbf) {
+      // long string with 8 bytes of length
+      header = 9;
+    } else if (head >= 0xc0 && head <= 0xc7) {
+      // binary with 1 to 8 bytes of length
+      header = 1 + (head - 0xbf);
+    } else if (head >= 0xc8 && head <= 0xd7) {
+      // BCD with 1 to 8 bytes of length
+      header = 1 + ((head - 0xc8) & 7) + 1;
+    } else if (head >= 0xf4) {
+      // custom type with 1, 2, 4 or 8 bytes of length
+      header = 1 + (size_t(1) << ((head - 0xf4) / 3));
+    }
+    // all other types have a fixed size or store it in the head byte
+    break;
+  }
+
+  if (offset + header > length) {
+    return 0;
+  }
+  return VPackSlice(data).byteSize();
+}
+
 arangodb::LoggerStream& operator<<(arangodb::LoggerStream& logger,
                                    VPackSlice const& slice) {
   size_t const cutoff = 100;
@@ -371,6 +371,15 @@ class VelocyPackHelper {
     return compare(lhs, rhs, useUTF8, options, lhsBase, rhsBase) == 0;
   }
 
+  /// @brief hashes a VelocyPack value for in-memory hash tables, so that
+  /// values that compare equal have the same hash. numbers and strings are
+  /// hashed directly with wyhash, without the generic value traversal of
+  /// Slice::normalizedHash(). all other values fall back to normalizedHash().
+  /// the hash values are not stable across versions and platforms, so they
+  /// must never be persisted or be exposed to users
+  static uint64_t fastNormalizedHash(arangodb::velocypack::Slice slice,
+                                     uint64_t seed);
+
   static bool hasNonClientTypes(arangodb::velocypack::Slice,
                                 bool checkExternals, bool checkCustom);
 
@@ -384,6 +393,13 @@ class VelocyPackHelper {
 
   static uint64_t extractIdValue(VPackSlice const& slice);
 
+  /// @brief returns the byte size of the velocypack value at the start of
+  /// data, reading at most length bytes. returns 0 if the bytes encoding
+  /// the byte size are not all within length. the value itself may still
+  /// extend beyond length
+  static VPackValueLength byteSizeWithin(uint8_t const* data,
+                                         size_t length);
+
   static arangodb::velocypack::Options strictRequestValidationOptions;
   static arangodb::velocypack::Options looseRequestValidationOptions;
 
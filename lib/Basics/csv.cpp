@@ -23,12 +23,78 @@
 
 #include "csv.h"
 
+#include <bit>
 #include <cstring>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "Basics/debugging.h"
 #include "Basics/memory.h"
 #include "Basics/voc-errors.h"
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the position of the first occurrence of one of the
+/// characters a, b and c in the data, or length if there is none.
+/// compares 16 bytes at a time where SSE2 is available
+////////////////////////////////////////////////////////////////////////////////
+
+size_t findFirstOf(char const* data, size_t length, char a, char b, char c) {
+  size_t i = 0;
+#ifdef __SSE2__
+  __m128i const va = _mm_set1_epi8(a);
+  __m128i const vb = _mm_set1_epi8(b);
+  __m128i const vc = _mm_set1_epi8(c);
+  for (; i + 16 <= length; i += 16) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+    __m128i found = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)),
+        _mm_cmpeq_epi8(chunk, vc));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(found));
+    if (mask != 0) {
+      return i + std::countr_zero(mask);
+    }
+  }
+#endif
+  for (; i < length; ++i) {
+    if (data[i] == a || data[i] == b || data[i] == c) {
+      break;
+    }
+  }
+  return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the position of the end of an unquoted field
+////////////////////////////////////////////////////////////////////////////////
+
+size_t findFieldEnd(TRI_csv_parser_t const* parser, char const* data,
+                    size_t length) {
+  return findFirstOf(data, length, parser->_separator, '\r', '\n');
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the position of the next quote or escape character in a
+/// quoted field
+////////////////////////////////////////////////////////////////////////////////
+
+size_t findQuote(TRI_csv_parser_t const* parser, char const* data,
+                 size_t length) {
+  if (!parser->_useBackslash) {
+    void const* found = memchr(data, parser->_quote, length);
+    return found == nullptr
+               ? length
+               : static_cast<size_t>(static_cast<char const*>(found) - data);
+  }
+  return findFirstOf(data, length, parser->_quote, '\\', '\\');
+}
+
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief inits a CSV parser
 ////////////////////////////////////////////////////////////////////////////////
@@ -285,11 +351,13 @@ ErrorCode TRI_ParseCsvString(TRI_csv_parser_t* parser, char const* line,
 
           break;
 
-        case TRI_CSV_PARSER_WITHIN_FIELD:
-          while (ptr < parser->_stop && *ptr != parser->_separator &&
-                 *ptr != '\r' && *ptr != '\n') {
-            *qtr++ = *ptr++;
+        case TRI_CSV_PARSER_WITHIN_FIELD: {
+          size_t n = findFieldEnd(parser, ptr, parser->_stop - ptr);
+          if (qtr != ptr) {
+            memmove(qtr, ptr, n);
           }
+          qtr += n;
+          ptr += n;
 
           // found separator or eol
           if (ptr < parser->_stop) {
@@ -331,14 +399,17 @@ ErrorCode TRI_ParseCsvString(TRI_csv_parser_t* parser, char const* line,
           }
 
           break;
+        }
 
-        case TRI_CSV_PARSER_WITHIN_QUOTED_FIELD:
+        case TRI_CSV_PARSER_WITHIN_QUOTED_FIELD: {
           TRI_ASSERT(parser->_useQuote);
 
-          while (ptr < parser->_stop && *ptr != parser->_quote &&
-                 (!parser->_useBackslash || *ptr != '\\')) {
-            *qtr++ = *ptr++;
+          size_t n = findQuote(parser, ptr, parser->_stop - ptr);
+          if (qtr != ptr) {
+            memmove(qtr, ptr, n);
           }
+          qtr += n;
+          ptr += n;
 
           // found quote or a backslash, need at least another quote, a
           // separator, or an eol
@@ -409,9 +480,132 @@ ErrorCode TRI_ParseCsvString(TRI_csv_parser_t* parser, char const* line,
           }
 
           break;
+        }
       }
     }
   }
 
   return TRI_ERROR_CORRUPTED_CSV;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief scans CSV data for complete records
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_ScanCsvRecords(TRI_csv_parser_t const* parser, char const* data,
+                          size_t length, size_t* records) {
+  // this follows the state transitions of TRI_ParseCsvString, but neither
+  // copies nor reports any fields
+  char const* ptr = data;
+  char const* stop = data + length;
+  char const* boundary = data;
+  size_t const maxRecords = *records;
+  size_t found = 0;
+  TRI_csv_parser_states_e state = TRI_CSV_PARSER_BOF;
+
+  // handles the end of a record at ptr. returns false if we cannot tell
+  // yet where the record ends
+  auto endOfRecord = [&]() -> bool {
+    if (*ptr == '\r') {
+      // the parser skips a \n following the \r
+      if (ptr + 1 == stop) {
+        return false;
+      }
+      if (ptr[1] == '\n') {
+        ++ptr;
+      }
+    }
+    ++ptr;
+    boundary = ptr;
+    ++found;
+    state = TRI_CSV_PARSER_BOF;
+    return true;
+  };
+
+  while (ptr < stop && found < maxRecords) {
+    switch (state) {
+      case TRI_CSV_PARSER_BOF:
+        if (parser->_useQuote && *ptr == parser->_quote) {
+          if (ptr + 1 == stop) {
+            goto done;
+          }
+          ++ptr;
+          state = TRI_CSV_PARSER_WITHIN_QUOTED_FIELD;
+        } else {
+          state = TRI_CSV_PARSER_WITHIN_FIELD;
+        }
+        break;
+
+      case TRI_CSV_PARSER_WITHIN_FIELD:
+        ptr += findFieldEnd(parser, ptr, stop - ptr);
+        if (ptr == stop) {
+          goto done;
+        }
+        if (*ptr == parser->_separator) {
+          ++ptr;
+          state = TRI_CSV_PARSER_BOF;
+        } else if (!endOfRecord()) {
+          goto done;
+        }
+        break;
+
+      case TRI_CSV_PARSER_WITHIN_QUOTED_FIELD: {
+        ptr += findQuote(parser, ptr, stop - ptr);
+        if (ptr + 1 >= stop) {
+          goto done;
+        }
+        bool foundBackslash = (parser->_useBackslash && *ptr == '\\');
+        ++ptr;
+        if (foundBackslash) {
+          if (*ptr == parser->_quote || *ptr == '\\') {
+            ++ptr;
+            break;
+          }
+        } else if (*ptr == parser->_quote) {
+          ++ptr;
+          break;
+        }
+        while (*ptr == ' ' || *ptr == '\t') {
+          if (++ptr == stop) {
+            goto done;
+          }
+        }
+        if (*ptr == parser->_separator) {
+          ++ptr;
+          state = TRI_CSV_PARSER_BOF;
+        } else if (*ptr == '\r' || *ptr == '\n') {
+          if (!endOfRecord()) {
+            goto done;
+          }
+        } else {
+          state = TRI_CSV_PARSER_CORRUPTED;
+        }
+        break;
+      }
+
+      case TRI_CSV_PARSER_CORRUPTED:
+        ptr += findFirstOf(ptr, stop - ptr, parser->_separator, '\n', '\n');
+        if (ptr == stop) {
+          goto done;
+        }
+        if (*ptr == parser->_separator) {
+          ++ptr;
+          state = TRI_CSV_PARSER_BOF;
+        } else {
+          ++ptr;
+          boundary = ptr;
+          ++found;
+          state = TRI_CSV_PARSER_BOF;
+        }
+        break;
+
+      default:
+        TRI_ASSERT(false);
+        goto done;
+    }
+  }
+
+done:
+  *records = found;
+  return boundary - data;
+}
@@ -122,3 +122,17 @@ void TRI_UseBackslashCsvParser(TRI_csv_parser_t* parser, bool value);
 
 ErrorCode TRI_ParseCsvString(TRI_csv_parser_t* parser, char const* line,
                              size_t length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief scans CSV data for complete records, using the separator and
+/// quote settings of the parser, but without parsing the fields
+///
+/// the data must start at the beginning of a record. on input, records holds
+/// the maximum number of records to scan, on output the number of complete
+/// records found. returns the length of the data occupied by these records.
+/// the parser itself is not modified, so that the data can be split at the
+/// returned position and the parts be parsed independently
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_ScanCsvRecords(TRI_csv_parser_t const* parser, char const* data,
+                          size_t length, size_t* records);
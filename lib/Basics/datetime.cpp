@@ -29,10 +29,8 @@
 #include <iterator>
 #include <map>
 #include <ratio>
-#include <regex>
 #include <sstream>
 #include <string_view>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -55,7 +53,6 @@ std::string tail(std::string const& source, size_t const length) {
 
 typedef void (*format_func_t)(std::string& wrk,
                               arangodb::tp_sys_clock_ms const&);
-std::unordered_map<std::string, format_func_t> dateMap;
 auto const unixEpoch = date::sys_seconds{std::chrono::seconds{0}};
 
 std::vector<std::string> const monthNames = {
@@ -391,73 +388,144 @@ std::
                 {"%",
                  [](std::string& wrk, arangodb::tp_sys_clock_ms const& tp) {}}};
 
-// will be populated by DateRegexInitializer
-std::regex dateFormatRegex;
-
-std::regex const durationRegex(
-    "^P((\\d+)Y)?((\\d+)M)?((\\d+)W)?((\\d+)D)?(T((\\d+)H)?((\\d+)M)?((\\d+)(("
-    "\\.|,)"
-    "(\\d{1,3}))?S)?)?",
-    std::regex::optimize);
-
-struct DateRegexInitializer {
-  DateRegexInitializer() {
-    std::string myregex;
-
-    dateMap.reserve(sortedDateMap.size());
-    std::for_each(
-        sortedDateMap.begin(), sortedDateMap.end(),
-        [&myregex](std::pair<std::string const&, format_func_t> const& p) {
-          (myregex.length() > 0) ? myregex += "|" + p.first : myregex = p.first;
-          dateMap.insert(std::make_pair(p.first, p.second));
-        });
-    dateFormatRegex = std::regex(myregex);
+/// @brief returns the placeholder from sortedDateMap that starts at the
+/// beginning of the given format string part. the first matching entry
+/// wins, which is why longer placeholders are listed before their prefixes.
+/// the catch-all entry "%" makes sure that there is always a match for an
+/// input starting with '%'.
+std::pair<std::string, format_func_t> const& matchPlaceholder(
+    std::string_view formatPart) {
+  TRI_ASSERT(!formatPart.empty() && formatPart.front() == '%');
+  for (auto const& p : sortedDateMap) {
+    if (formatPart.starts_with(p.first)) {
+      return p;
+    }
   }
-};
-
-std::string executeDateFormatRegex(std::string const& search,
-                                   arangodb::tp_sys_clock_ms const& tp) {
-  std::string s;
+  // unreachable, because "%" always matches
+  TRI_ASSERT(false);
+  return sortedDateMap.back();
+}
 
-  auto first = search.begin();
-  auto last = search.end();
-  typename std::smatch::difference_type positionOfLastMatch = 0;
-  auto endOfLastMatch = first;
+/// @brief parses the digits at the start of the range [p, e) and advances
+/// p to the first non-digit character. returns false if there are no
+/// digits at all
+bool parseDurationNumber(char const*& p, char const* e, int& result) {
+  char const* start = p;
+  while (p != e && *p >= '0' && *p <= '9') {
+    ++p;
+  }
+  if (p == start) {
+    return false;
+  }
+  result = arangodb::NumberUtils::atoi_unchecked<int>(start, p);
+  return true;
+}
 
-  auto callback = [&tp, &endOfLastMatch, &positionOfLastMatch,
-                   &s](std::smatch const& match) {
-    auto positionOfThisMatch = match.position(0);
-    auto diff = positionOfThisMatch - positionOfLastMatch;
+using arangodb::basics::ParsedDuration;
 
-    auto startOfThisMatch = endOfLastMatch;
-    std::advance(startOfThisMatch, diff);
+struct DurationComponent {
+  char designator;
+  int ParsedDuration::*value;
+};
 
-    s.append(endOfLastMatch, startOfThisMatch);
-    auto got = dateMap.find(match.str(0));
-    if (got != dateMap.end()) {
-      got->second(s, tp);
+// components of the date part of an ISO 8601 duration, in the order in
+// which they must appear. each of them is optional
+DurationComponent const dateComponents[] = {
+    {'Y', &ParsedDuration::years},
+    {'M', &ParsedDuration::months},
+    {'W', &ParsedDuration::weeks},
+    {'D', &ParsedDuration::days}};
+
+// components of the time part of an ISO 8601 duration (after the 'T'), in
+// the order in which they must appear. each of them is optional
+DurationComponent const timeComponents[] = {
+    {'H', &ParsedDuration::hours},
+    {'M', &ParsedDuration::minutes},
+    {'S', &ParsedDuration::seconds}};
+
+/// @brief parses a sequence of <number><designator> components from the
+/// range [p, e), stopping at the first character that does not start a
+/// component. the designators must appear in the order given by
+/// components, and each may appear at most once. if allowFraction is
+/// set, the last component may have a fraction of up to 3 digits, which
+/// is stored as milliseconds
+template<size_t N>
+bool parseDurationComponents(char const*& p, char const* e,
+                             DurationComponent const (&components)[N],
+                             bool allowFraction, ParsedDuration& result) {
+  size_t next = 0;
+  while (p != e && *p >= '0' && *p <= '9') {
+    int number;
+    parseDurationNumber(p, e, number);
+    if (p == e) {
+      // number without a designator
+      return false;
     }
-    auto lengthOfMatch = match.length(0);
 
-    positionOfLastMatch = positionOfThisMatch + lengthOfMatch;
+    if (allowFraction && (*p == '.' || *p == ',')) {
+      // a fraction is only allowed for the last component (seconds), and
+      // must have 1 to 3 digits. the fraction can be shortened:
+      // .1 => 100ms
+      if (next == N) {
+        // the last component was already given
+        return false;
+      }
+      char const* start = ++p;
+      int millis;
+      if (!parseDurationNumber(p, e, millis) || p - start > 3) {
+        return false;
+      }
+      if (p - start == 2) {
+        millis *= 10;
+      } else if (p - start == 1) {
+        millis *= 100;
+      }
+      if (p == e || *p != components[N - 1].designator) {
+        return false;
+      }
+      result.*(components[N - 1].value) = number;
+      result.milliseconds = millis;
+      ++p;
+      // nothing can follow the last component
+      return true;
+    }
 
-    endOfLastMatch = startOfThisMatch;
-    std::advance(endOfLastMatch, lengthOfMatch);
-  };
+    while (next < N && components[next].designator != *p) {
+      ++next;
+    }
+    if (next == N) {
+      // unknown designator, or designator out of order
+      return false;
+    }
+    result.*(components[next].value) = number;
+    ++next;
+    ++p;
+  }
+  return true;
+}
 
-  std::regex_iterator<std::string::const_iterator> end;
-  std::regex_iterator<std::string::const_iterator> begin(first, last,
-                                                         dateFormatRegex);
-  std::for_each(begin, end, callback);
+/// @brief hand-written parser for ISO 8601 durations of the form
+/// P[nY][nM][nW][nD][T[nH][nM][n[.f]S]]
+bool parseIsoDuration(std::string_view duration, ParsedDuration& result) {
+  if (duration.size() <= 1 || duration.front() != 'P') {
+    return false;
+  }
 
-  s.append(endOfLastMatch, last);
+  char const* p = duration.data() + 1;
+  char const* e = duration.data() + duration.size();
 
-  return s;
+  if (!parseDurationComponents(p, e, dateComponents, false, result)) {
+    return false;
+  }
+  if (p != e && *p == 'T') {
+    ++p;
+    if (!parseDurationComponents(p, e, timeComponents, true, result)) {
+      return false;
+    }
+  }
+  return p == e;
 }
 
-// populates dateFormatRegex
-static DateRegexInitializer const initializer;
-
 struct ParsedDateTime {
   int year = 0;
   int month = 1;
@@ -646,17 +714,6 @@ bool parseDateTime(std::string_view dateTime, ParsedDateTime& result) {
   return dateTime.empty();
 }
 
-bool regexIsoDuration(
-    std::string_view isoDuration,
-    std::match_results<std::string_view::iterator>& durationParts) {
-  if (isoDuration.length() <= 1) {
-    return false;
-  }
-
-  return std::regex_match(isoDuration.begin(), isoDuration.end(), durationParts,
-                          durationRegex);
-}
-
 }  // namespace
 
 bool arangodb::basics::parseDateTime(std::string_view dateTime,
@@ -703,69 +760,81 @@ bool arangodb::basics::parseDateTime(std::string_view dateTime,
   return true;
 }
 
-std::string arangodb::basics::formatDate(
-    std::string const& formatString,
-    arangodb::tp_sys_clock_ms const& dateValue) {
-  return ::executeDateFormatRegex(formatString, dateValue);
+arangodb::basics::DateFormatProgram::DateFormatProgram(
+    std::string_view formatString) {
+  size_t literalStart = 0;
+  size_t pos = 0;
+  while (pos < formatString.size()) {
+    if (formatString[pos] != '%') {
+      ++pos;
+      continue;
+    }
+    addLiteral(formatString.substr(literalStart, pos - literalStart));
+
+    auto const& placeholder = ::matchPlaceholder(formatString.substr(pos));
+    if (placeholder.first == "%%") {
+      // literal percent sign
+      addLiteral("%");
+    } else if (placeholder.first != "%&" && placeholder.first != "%") {
+      // "%&" and a dangling "%" do not produce any output
+      _operations.push_back(Operation{placeholder.second, 0, 0});
+    }
+    pos += placeholder.first.size();
+    literalStart = pos;
+  }
+  addLiteral(formatString.substr(literalStart));
 }
 
-bool arangodb::basics::parseIsoDuration(std::string_view duration,
-                                        arangodb::basics::ParsedDuration& ret) {
-  using namespace arangodb;
-
-  std::match_results<std::string_view::iterator> durationParts;
-  if (!::regexIsoDuration(duration, durationParts)) {
-    return false;
+void arangodb::basics::DateFormatProgram::addLiteral(
+    std::string_view literal) {
+  if (literal.empty()) {
+    return;
   }
+  if (!_operations.empty() && _operations.back().function == nullptr) {
+    // extend previous literal, so that adjacent literals are appended
+    // in one go
+    TRI_ASSERT(_operations.back().offset + _operations.back().length ==
+               _literals.size());
+    _operations.back().length += static_cast<uint32_t>(literal.size());
+  } else {
+    _operations.push_back(
+        Operation{nullptr, static_cast<uint32_t>(_literals.size()),
+                  static_cast<uint32_t>(literal.size())});
+  }
+  _literals.append(literal);
+}
 
-  char const* begin;
-
-  begin = duration.data() + durationParts.position(2);
-  ret.years =
-      NumberUtils::atoi_unchecked<int>(begin, begin + durationParts.length(2));
-
-  begin = duration.data() + durationParts.position(4);
-  ret.months =
-      NumberUtils::atoi_unchecked<int>(begin, begin + durationParts.length(4));
-
-  begin = duration.data() + durationParts.position(6);
-  ret.weeks =
-      NumberUtils::atoi_unchecked<int>(begin, begin + durationParts.length(6));
-
-  begin = duration.data() + durationParts.position(8);
-  ret.days =
-      NumberUtils::atoi_unchecked<int>(begin, begin + durationParts.length(8));
-
-  begin = duration.data() + durationParts.position(11);
-  ret.hours =
-      NumberUtils::atoi_unchecked<int>(begin, begin + durationParts.length(11));
+void arangodb::basics::DateFormatProgram::execute(
+    std::string& out, arangodb::tp_sys_clock_ms const& dateValue) const {
+  for (auto const& op : _operations) {
+    if (op.function == nullptr) {
+      out.append(_literals, op.offset, op.length);
+    } else {
+      op.function(out, dateValue);
+    }
+  }
+}
 
-  begin = duration.data() + durationParts.position(13);
-  ret.minutes =
-      NumberUtils::atoi_unchecked<int>(begin, begin + durationParts.length(13));
+std::string arangodb::basics::DateFormatProgram::execute(
+    arangodb::tp_sys_clock_ms const& dateValue) const {
+  std::string out;
+  out.reserve(_literals.size() + 8 * _operations.size());
+  execute(out, dateValue);
+  return out;
+}
 
-  begin = duration.data() + durationParts.position(15);
-  ret.seconds =
-      NumberUtils::atoi_unchecked<int>(begin, begin + durationParts.length(15));
+std::string arangodb::basics::formatDate(
+    std::string_view formatString,
+    arangodb::tp_sys_clock_ms const& dateValue) {
+  return DateFormatProgram(formatString).execute(dateValue);
+}
 
-  // The Milli seconds can be shortened:
-  // .1 => 100ms
-  // so we append 00 but only take the first 3 digits
-  auto matchLength = durationParts.length(18);
-  int number = 0;
-  if (matchLength > 0) {
-    if (matchLength > 3) {
-      matchLength = 3;
-    }
-    begin = duration.data() + durationParts.position(18);
-    number = NumberUtils::atoi_unchecked<int>(begin, begin + matchLength);
-    if (matchLength == 2) {
-      number *= 10;
-    } else if (matchLength == 1) {
-      number *= 100;
-    }
+bool arangodb::basics::parseIsoDuration(std::string_view duration,
+                                        arangodb::basics::ParsedDuration& ret) {
+  ParsedDuration result;
+  if (!::parseIsoDuration(duration, result)) {
+    return false;
   }
-  ret.milliseconds = number;
-
+  ret = result;
   return true;
 }
@@ -24,9 +24,10 @@
 #pragma once
 
 #include <chrono>
-#include <regex>
+#include <cstdint>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "Basics/Common.h"
 
@@ -44,11 +45,43 @@ using d_sys_clock_ms = std::chrono::duration<std::chrono::milliseconds>;
 namespace basics {
 bool parseDateTime(std::string_view dateTime, tp_sys_clock_ms& date_tp);
 
-bool regexIsoDuration(std::string_view isoDuration,
-                      std::match_results<char const*>& durationParts);
+/// @brief a DATE_FORMAT format string, compiled into a sequence of
+/// formatting operations. compiling the format string once and executing
+/// the resulting program for many date values avoids rescanning the
+/// format string for every call.
+class DateFormatProgram {
+ public:
+  using FormatFunction = void (*)(std::string&, tp_sys_clock_ms const&);
+
+  explicit DateFormatProgram(std::string_view formatString);
+
+  DateFormatProgram(DateFormatProgram const&) = delete;
+  DateFormatProgram& operator=(DateFormatProgram const&) = delete;
+
+  /// @brief appends the formatted date value to out
+  void execute(std::string& out, tp_sys_clock_ms const& dateValue) const;
+
+  /// @brief returns the formatted date value
+  std::string execute(tp_sys_clock_ms const& dateValue) const;
+
+ private:
+  struct Operation {
+    // formatting function for a placeholder, or nullptr for a literal
+    FormatFunction function;
+    // position and length of the literal inside _literals
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  void addLiteral(std::string_view literal);
+
+  std::vector<Operation> _operations;
+  // all literal parts of the format string
+  std::string _literals;
+};
 
 /// @brief formats a date(time) value according to formatString
-std::string formatDate(std::string const& formatString,
+std::string formatDate(std::string_view formatString,
                        tp_sys_clock_ms const& dateValue);
 
 struct ParsedDuration {
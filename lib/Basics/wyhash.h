@@ -0,0 +1,152 @@
+/* This is free and unencumbered software released into the public domain
+   under The Unlicense (http://unlicense.org/).
+
+   main repo: https://github.com/wangyi-fudan/wyhash
+   author: 王一 Wang Yi <godspeed_china@yeah.net>
+
+   The code below is an adaptation of wyhash final version 4 for 64-bit
+   targets, reading input bytes in native byte order. Hash values are
+   therefore only meant for in-memory data structures and must not be
+   persisted or sent to other servers.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#pragma intrinsic(_umul128)
+#endif
+
+namespace arangodb::wyhash_detail {
+
+inline constexpr uint64_t secret[4] = {
+    0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL,
+    0x589965cc75374cc3ULL};
+
+// 64x64 -> 128 bit multiplication, returning the low part in a and the
+// high part in b
+inline void mum(uint64_t* a, uint64_t* b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = *a;
+  r *= *b;
+  *a = static_cast<uint64_t>(r);
+  *b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  *a = _umul128(*a, *b, b);
+#else
+  uint64_t ha = *a >> 32, hb = *b >> 32, la = static_cast<uint32_t>(*a),
+           lb = static_cast<uint32_t>(*b);
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb,
+           t = rl + (rm0 << 32), c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  *a = lo;
+  *b = hi;
+#endif
+}
+
+inline uint64_t mix(uint64_t a, uint64_t b) noexcept {
+  mum(&a, &b);
+  return a ^ b;
+}
+
+inline uint64_t read8(uint8_t const* p) noexcept {
+  uint64_t v;
+  memcpy(&v, p, 8);
+  return v;
+}
+
+inline uint64_t read4(uint8_t const* p) noexcept {
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+inline uint64_t read3(uint8_t const* p, size_t k) noexcept {
+  return (static_cast<uint64_t>(p[0]) << 16) |
+         (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+}  // namespace arangodb::wyhash_detail
+
+/**
+ * wyhash64 - 64-bit hash function based on wyhash. considerably faster than
+ * fasthash64 for inputs of more than a few bytes, with comparable quality.
+ * @buf:  data buffer
+ * @len:  data size
+ * @seed: the seed
+ */
+inline uint64_t wyhash64(void const* buf, size_t len, uint64_t seed) noexcept {
+  using namespace arangodb::wyhash_detail;
+
+  auto const* p = static_cast<uint8_t const*>(buf);
+  seed ^= mix(seed ^ secret[0], secret[1]);
+  uint64_t a;
+  uint64_t b;
+  if (len <= 16) {
+    if (len >= 4) {
+      a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+      b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+    } else if (len > 0) {
+      a = read3(p, len);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = len;
+    if (i > 48) {
+      uint64_t see1 = seed;
+      uint64_t see2 = seed;
+      do {
+        seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+        see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+        see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = read8(p + i - 16);
+    b = read8(p + i - 8);
+  }
+  a ^= secret[1];
+  b ^= seed;
+  mum(&a, &b);
+  return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+/**
+ * wyhash64_uint64 - hash a single 64-bit value
+ * @value: the value
+ * @seed:  the seed
+ */
+inline uint64_t wyhash64_uint64(uint64_t value, uint64_t seed) noexcept {
+  using namespace arangodb::wyhash_detail;
+
+  uint64_t a = value ^ secret[1];
+  uint64_t b = seed ^ secret[0];
+  mum(&a, &b);
+  return mix(a ^ secret[0] ^ 8, b ^ secret[1]);
+}
+
+/**
+ * wyhash32 - 32-bit hash, folded from wyhash64
+ * @buf:  data buffer
+ * @len:  data size
+ * @seed: the seed
+ */
+inline uint32_t wyhash32(void const* buf, size_t len, uint32_t seed) noexcept {
+  uint64_t h = wyhash64(buf, len, seed);
+  return static_cast<uint32_t>(h - (h >> 32));
+}
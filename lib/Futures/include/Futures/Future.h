@@ -166,6 +166,8 @@ class Future {
                 "use futures::Unit instead of void");
 
   friend class Promise<T>;
+  template<typename T2>
+  friend class Future;
   template<class T2>
   friend Future<T2> makeFuture(Try<T2>&&);
   friend Future<Unit> makeFuture();
@@ -305,6 +307,16 @@ class Future {
     static_assert(!std::is_same<B, void>::value, "");
     static_assert(!R::ReturnsFuture::value, "");
 
+    if (getState().hasResult()) {
+      Try<T> t = takeReadyResult();
+      if (t.hasException()) {
+        return makeReady<B>(Try<B>(std::move(t).exception()));
+      }
+      return makeReady<B>(detail::makeTryWith([&fn, &t] {
+        return std::invoke(std::forward<F>(fn), std::move(t).get());
+      }));
+    }
+
     Promise<B> promise;
     auto future = promise.getFuture();
     getState().setCallback([fn = std::forward<DF>(fn),
@@ -334,6 +346,19 @@ class Future {
     static_assert(std::is_invocable_r<Future<B>, F, T>::value,
                   "Function must be invocable with T");
 
+    if (getState().hasResult()) {
+      Try<T> t = takeReadyResult();
+      if (t.hasException()) {
+        return makeReady<B>(Try<B>(std::move(t).exception()));
+      }
+      try {
+        return checkValid(
+            std::invoke(std::forward<F>(fn), std::move(t).get()));
+      } catch (...) {
+        return makeReady<B>(Try<B>(std::current_exception()));
+      }
+    }
+
     Promise<B> promise;
     auto future = promise.getFuture();
     getState().setCallback([fn = std::forward<DF>(fn),
@@ -367,6 +392,13 @@ class Future {
     static_assert(!isFuture<B>::value, "");
     static_assert(!std::is_same<B, void>::value, "");
 
+    if (getState().hasResult()) {
+      Try<T> t = takeReadyResult();
+      return makeReady<B>(detail::makeTryWith([&func, &t] {
+        return std::invoke(std::forward<F>(func), std::move(t));
+      }));
+    }
+
     Promise<B> promise;
     auto future = promise.getFuture();
     getState().setCallback([fn = std::forward<DF>(func),
@@ -388,6 +420,15 @@ class Future {
     typedef typename R::ReturnsFuture::inner B;
     static_assert(!isFuture<B>::value, "");
 
+    if (getState().hasResult()) {
+      Try<T> t = takeReadyResult();
+      try {
+        return checkValid(std::invoke(std::forward<F>(func), std::move(t)));
+      } catch (...) {
+        return makeReady<B>(Try<B>(std::current_exception()));
+      }
+    }
+
     Promise<B> promise;
     auto future = promise.getFuture();
     getState().setCallback([fn = std::forward<F>(func),
@@ -411,6 +452,10 @@ class Future {
            typename R = typename std::invoke_result<F&&, Try<T>&&>::type>
   typename std::enable_if<std::is_same<R, void>::value>::type thenFinal(
       F&& fn) && {
+    if (getState().hasResult()) {
+      std::invoke(std::forward<F>(fn), takeReadyResult());
+      return;
+    }
     getState().setCallback(std::forward<detail::decay_t<F>>(fn));
   }
 
@@ -425,6 +470,11 @@ class Future {
     typedef std::decay_t<ExceptionType> ET;
     using DF = detail::decay_t<F>;
 
+    if (getState().hasResult() && !result().hasException()) {
+      // nothing to handle, pass on the value
+      return std::move(*this);
+    }
+
     Promise<B> promise;
     auto future = promise.getFuture();
     getState().setCallback([fn = std::forward<DF>(func),
@@ -457,6 +507,11 @@ class Future {
     typedef std::decay_t<ExceptionType> ET;
     using DF = detail::decay_t<F>;
 
+    if (getState().hasResult() && !result().hasException()) {
+      // nothing to handle, pass on the value
+      return std::move(*this);
+    }
+
     Promise<B> promise;
     auto future = promise.getFuture();
     getState().setCallback([fn = std::forward<DF>(fn),
@@ -487,6 +542,35 @@ class Future {
   explicit Future(detail::EmptyConstructor) : _state(nullptr) {}
   explicit Future(detail::SharedState<T>* state) : _state(state) {}
 
+  /// Fused continuation path: if the result is already available when a
+  /// continuation is attached, the continuation runs inline and its result
+  /// is put directly into a ready future. This avoids allocating a promise,
+  /// a second shared state and a type-erased callback for every step of a
+  /// chain that completes synchronously.
+  ///
+  /// Moves the result out of a ready future and releases the shared state.
+  Try<T> takeReadyResult() {
+    TRI_ASSERT(isReady());
+    Try<T> t(std::move(_state->getTry()));
+    detach();
+    return t;
+  }
+
+  template<typename B>
+  static Future<B> makeReady(Try<B>&& t) {
+    return Future<B>(detail::SharedState<B>::make(std::move(t)));
+  }
+
+  /// continuations that return an invalid future fail with NoState, just
+  /// like on the non-inline path
+  template<typename B>
+  static Future<B> checkValid(Future<B>&& f) {
+    if (!f.valid()) {
+      throw FutureException(ErrorCode::NoState);
+    }
+    return std::move(f);
+  }
+
   // convenience method that checks if _state is set
   inline detail::SharedState<T>& getState() {
     if (!_state) {
@@ -24,16 +24,25 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <function2.hpp>
+#include <new>
 
 #include "Assertions/Assert.h"
 
+#include "Futures/SharedStateAllocator.h"
 #include "Futures/Try.h"
 
 namespace arangodb {
 namespace futures {
 namespace detail {
 
+/// inline storage for continuations. callbacks created by Future::then and
+/// friends capture the user function plus a Promise, which fits into this
+/// buffer for all but the largest lambdas, so that attaching a callback does
+/// not need a separate heap allocation.
+inline constexpr std::size_t kCallbackInlineCapacity = 64;
+
 /// The FSM to manage the primary producer-to-consumer info-flow has these
 ///   allowed (atomic) transitions:
 ///
@@ -99,6 +108,21 @@ class SharedState {
   SharedState(SharedState&&) noexcept = delete;
   SharedState& operator=(SharedState&&) = delete;
 
+  // shared states are served from per-thread free lists
+  static void* operator new(std::size_t size) {
+    return SharedStateAllocator::allocate(size);
+  }
+  static void operator delete(void* p, std::size_t size) noexcept {
+    SharedStateAllocator::deallocate(p, size);
+  }
+  // over-aligned results bypass the free lists
+  static void* operator new(std::size_t size, std::align_val_t al) {
+    return ::operator new(size, al);
+  }
+  static void operator delete(void* p, std::align_val_t al) noexcept {
+    ::operator delete(p, al);
+  }
+
   /// True if state is OnlyCallback or Done.
   /// May call from any thread
   bool hasCallback() const noexcept {
@@ -271,7 +295,11 @@ class SharedState {
   }
 
  private:
-  using Callback = fu2::unique_function<void(Try<T>&&)>;
+  // like fu2::unique_function, but with a larger inline buffer
+  using Callback =
+      fu2::function_base<true, false,
+                         fu2::capacity_fixed<kCallbackInlineCapacity>, true,
+                         false, void(Try<T>&&)>;
   Callback _callback;
   union {  // avoids having to construct the result
     Try<T> _result;
@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace arangodb {
+namespace futures {
+namespace detail {
+
+/// Allocator for SharedState objects. Every Promise/Future pair and every
+/// continuation allocates a shared state, so the allocations are served
+/// from small per-thread free lists instead of going to the global allocator
+/// every time. Freed blocks are cached by the thread that frees them, which
+/// is usually the thread that will create the next shared state.
+///
+/// Blocks are grouped into size classes of kGranularity bytes. Larger
+/// allocations and over-aligned types bypass the cache. The cache is disabled
+/// in ASan builds so that use-after-free errors are still detected.
+struct SharedStateAllocator {
+  static constexpr std::size_t kGranularity = 32;
+  static constexpr std::size_t kNumSizeClasses = 8;
+  static constexpr std::size_t kMaxCachedPerSizeClass = 256;
+
+  static void* allocate(std::size_t size);
+  static void deallocate(void* p, std::size_t size) noexcept;
+
+  /// number of blocks cached by the current thread for all size classes
+  static std::size_t cachedBlocks() noexcept;
+};
+
+}  // namespace detail
+}  // namespace futures
+}  // namespace arangodb
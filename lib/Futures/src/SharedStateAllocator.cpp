@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Futures/SharedStateAllocator.h"
+
+#include <cstdint>
+
+#if defined(__SANITIZE_ADDRESS__)
+#define ARANGODB_FUTURES_NO_POOLING 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define ARANGODB_FUTURES_NO_POOLING 1
+#endif
+#endif
+
+using namespace arangodb::futures::detail;
+
+namespace {
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+struct FreeList {
+  FreeBlock* head;
+  std::uint32_t size;
+};
+
+/// per-thread cache. this is intentionally trivially destructible, so that
+/// its storage remains usable during thread shutdown, even after the cleanup
+/// below has run. futures destroyed late during thread exit then simply go
+/// to the global allocator.
+struct ThreadCache {
+  FreeList lists[SharedStateAllocator::kNumSizeClasses];
+  bool cleanupRegistered;
+  bool shutdown;
+};
+
+thread_local ThreadCache threadCache{};
+
+struct ThreadCacheCleanup {
+  ~ThreadCacheCleanup() {
+    threadCache.shutdown = true;
+    for (auto& list : threadCache.lists) {
+      while (list.head != nullptr) {
+        FreeBlock* block = list.head;
+        list.head = block->next;
+        ::operator delete(block);
+      }
+      list.size = 0;
+    }
+  }
+};
+
+void registerCleanup() {
+  // constructed on first use in every thread, and destroyed when the
+  // thread exits
+  thread_local ThreadCacheCleanup cleanup;
+  threadCache.cleanupRegistered = true;
+}
+
+constexpr std::size_t sizeClass(std::size_t size) noexcept {
+  return (size + SharedStateAllocator::kGranularity - 1) /
+             SharedStateAllocator::kGranularity -
+         1;
+}
+
+constexpr std::size_t sizeOfClass(std::size_t sizeClass) noexcept {
+  return (sizeClass + 1) * SharedStateAllocator::kGranularity;
+}
+
+}  // namespace
+
+void* SharedStateAllocator::allocate(std::size_t size) {
+#ifndef ARANGODB_FUTURES_NO_POOLING
+  std::size_t const sc = sizeClass(size);
+  if (sc < kNumSizeClasses) {
+    FreeList& list = threadCache.lists[sc];
+    if (list.head != nullptr) {
+      FreeBlock* block = list.head;
+      list.head = block->next;
+      --list.size;
+      return block;
+    }
+    // always allocate the full size class, so that the block can be
+    // reused for any other size in the same class
+    return ::operator new(sizeOfClass(sc));
+  }
+#endif
+  return ::operator new(size);
+}
+
+void SharedStateAllocator::deallocate(void* p, std::size_t size) noexcept {
+#ifndef ARANGODB_FUTURES_NO_POOLING
+  std::size_t const sc = sizeClass(size);
+  if (sc < kNumSizeClasses && !threadCache.shutdown) {
+    FreeList& list = threadCache.lists[sc];
+    if (list.size < kMaxCachedPerSizeClass) {
+      if (!threadCache.cleanupRegistered) {
+        registerCleanup();
+      }
+      auto* block = static_cast<FreeBlock*>(p);
+      block->next = list.head;
+      list.head = block;
+      ++list.size;
+      return;
+    }
+  }
+#endif
+  ::operator delete(p);
+}
+
+std::size_t SharedStateAllocator::cachedBlocks() noexcept {
+  std::size_t result = 0;
+  for (auto const& list : threadCache.lists) {
+    result += list.size;
+  }
+  return result;
+}
@@ -32,6 +32,7 @@
 #include <variant>
 
 #include "Inspection/InspectorBase.h"
+#include "Inspection/detail/FieldTable.h"
 
 namespace arangodb::inspection {
 
@@ -155,16 +156,14 @@ struct LoadInspectorBase : InspectorBase<Derived, Context> {
   Status applyFields(Args&&... args) {
     FieldsMap fields;
     this->self().doProcessObject([&](std::string_view key, ValueType value) {
-      fields.emplace(key, std::make_pair(value, false));
+      fields.add(key, value);
       return Status::Success{};
     });
 
     auto result = parseFields(fields, std::forward<Args>(args)...);
     if (result.ok() && !_options.ignoreUnknownFields) {
-      for (auto& [k, v] : fields) {
-        if (!v.second) {
-          return {"Found unexpected attribute '" + std::string(k) + "'"};
-        }
+      if (auto unknown = fields.findUnprocessed(); unknown.has_value()) {
+        return {"Found unexpected attribute '" + std::string(*unknown) + "'"};
       }
     }
     return result;
@@ -183,8 +182,7 @@ struct LoadInspectorBase : InspectorBase<Derived, Context> {
   }
 
  protected:
-  using FieldsMap =
-      std::unordered_map<std::string_view, std::pair<ValueType, bool>>;
+  using FieldsMap = detail::FieldTable<ValueType>;
 
   using EmbeddedParam = FieldsMap;
 
@@ -308,11 +306,11 @@ struct LoadInspectorBase : InspectorBase<Derived, Context> {
 
   [[nodiscard]] Status::Success parseField(FieldsMap& fields,
                                            typename Base::IgnoreField&& field) {
-    if (auto it = fields.find(field.name); it != fields.end()) {
-      assert(!it->second.second &&
+    if (auto* entry = fields.find(field.name); entry != nullptr) {
+      assert(!entry->processed &&
              "field processed twice during inspection. Make sure field names "
              "are unique!");
-      it->second.second = true;  // mark the field as processed
+      entry->processed = true;
     }
     return {};
   }
@@ -322,14 +320,14 @@ struct LoadInspectorBase : InspectorBase<Derived, Context> {
     auto name = Base::getFieldName(field);
     bool isPresent = false;
     auto getFieldData = [&]() -> ValueType {
-      if (auto it = fields.find(name); it != fields.end()) {
-        assert(!it->second.second &&
+      if (auto* entry = fields.find(name); entry != nullptr) {
+        assert(!entry->processed &&
                "field processed twice during inspection. Make sure field "
                "names "
                "are unique!");
         isPresent = true;
-        it->second.second = true;  // mark the field as processed
-        return it->second.first;
+        entry->processed = true;
+        return entry->value;
       }
       return {};
     };
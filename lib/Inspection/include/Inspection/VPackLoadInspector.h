@@ -189,7 +189,9 @@ struct VPackLoadInspectorImpl
   auto doProcessObject(Func&& func)
       -> decltype(func(std::string_view(), velocypack::Slice())) {
     assert(_slice.isObject());
-    for (auto [k, v] : VPackObjectIterator(slice())) {
+    // sequential iteration is cheaper than going through the index table,
+    // and yields the attributes in the order in which they were written
+    for (auto [k, v] : VPackObjectIterator(slice(), true)) {
       if (auto res = func(k.stringView(), v); not res.ok()) {
         return res;
       }
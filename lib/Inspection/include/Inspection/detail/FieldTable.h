@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <unordered_set>
+
+#include "Containers/SmallVector.h"
+
+namespace arangodb::inspection::detail {
+
+// The attributes of an object that is being loaded, in the order in which
+// the input provides them.
+//
+// Fields are looked up in the order in which the inspect() function declares
+// them. Lookups start at the position following the previous match, so when
+// the input has the same attribute order as the declaration (which is always
+// the case for data written by the save inspector), every lookup matches at
+// the first attempt and the whole object is matched in a single pass. Other
+// orders fall back to a linear scan, which is still cheap for the small
+// objects we typically deal with. Small objects do not need any heap
+// allocation at all.
+//
+// If the input contains an attribute more than once, only the first
+// occurrence is used, and the repeated ones are ignored.
+template<class ValueType>
+struct FieldTable {
+  struct Entry {
+    std::string_view name;
+    ValueType value;
+    bool processed;
+  };
+
+  void add(std::string_view name, ValueType value) {
+    if (isDuplicate(name)) {
+      return;
+    }
+    _entries.push_back(Entry{name, value, false});
+  }
+
+  // returns the entry for the attribute, or nullptr if there is none
+  [[nodiscard]] Entry* find(std::string_view name) noexcept {
+    std::size_t const size = _entries.size();
+    for (std::size_t i = 0; i < size; ++i) {
+      std::size_t idx = _cursor + i;
+      if (idx >= size) {
+        idx -= size;
+      }
+      Entry& entry = _entries[idx];
+      if (entry.name == name) {
+        _cursor = idx + 1;
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  // returns the name of the first attribute that was not processed
+  [[nodiscard]] std::optional<std::string_view> findUnprocessed()
+      const noexcept {
+    for (auto const& entry : _entries) {
+      if (!entry.processed) {
+        return entry.name;
+      }
+    }
+    return std::nullopt;
+  }
+
+ private:
+  // up to this number of attributes, duplicates are detected by a linear
+  // scan. larger objects use a hash set of the attribute names
+  static constexpr std::size_t kLinearScanLimit = 32;
+
+  [[nodiscard]] bool isDuplicate(std::string_view name) {
+    if (_entries.size() < kLinearScanLimit) {
+      for (auto const& entry : _entries) {
+        if (entry.name == name) {
+          return true;
+        }
+      }
+      return false;
+    }
+    if (_names.empty()) {
+      for (auto const& entry : _entries) {
+        _names.emplace(entry.name);
+      }
+    }
+    return !_names.emplace(name).second;
+  }
+
+  containers::SmallVector<Entry, 16> _entries;
+  std::unordered_set<std::string_view> _names;
+  std::size_t _cursor = 0;
+};
+
+}  // namespace arangodb::inspection::detail
@@ -31,6 +31,7 @@
 
 #include "Basics/operating-system.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/ScopeGuard.h"
 #include "Basics/StringUtils.h"
 #include "Basics/WriteLocker.h"
 #include "Basics/voc-errors.h"
@@ -176,10 +177,30 @@ void LogAppender::logGlobal(LogGroup const& group, LogMessage const& message) {
 }
 
 void LogAppender::log(LogGroup const& group, LogMessage const& message) {
+  WRITE_LOCKER(guard, _appendersLock);
+
+  logUnlocked(group, message, false);
+}
+
+void LogAppender::logBatch(std::span<MessageRef const> messages) {
+  WRITE_LOCKER(guard, _appendersLock);
+
+  // write out whatever has been deferred, even if an appender throws.
+  // the messages are owned by the caller and may be gone afterwards
+  auto writeGuard =
+      scopeGuard([]() noexcept { LogAppenderFile::writeDeferred(); });
+
+  for (auto const& ref : messages) {
+    logUnlocked(*ref.group, *ref.message, true);
+  }
+}
+
+void LogAppender::logUnlocked(LogGroup const& group, LogMessage const& message,
+                              bool deferred) {
   // output to appenders
   auto& topicsMap = _topics2appenders[group.id()];
-  auto output = [&topicsMap](LogGroup const& group, LogMessage const& message,
-                             size_t n) -> bool {
+  auto output = [&topicsMap, deferred](LogMessage const& message,
+                                       size_t n) -> bool {
     bool shown = false;
 
     auto const& it = topicsMap.find(n);
@@ -187,7 +208,11 @@ void LogAppender::log(LogGroup const& group, LogMessage const& message) {
       auto const& appenders = it->second;
 
       for (auto const& appender : appenders) {
-        appender->logMessage(message);
+        if (deferred) {
+          appender->logMessageDeferred(message);
+        } else {
+          appender->logMessage(message);
+        }
       }
       shown = true;
     }
@@ -200,15 +225,13 @@ void LogAppender::log(LogGroup const& group, LogMessage const& message) {
   // try to find a topic-specific appender
   size_t topicId = message._topicId;
 
-  WRITE_LOCKER(guard, _appendersLock);
-
   if (topicId < LogTopic::MAX_LOG_TOPICS) {
-    shown = output(group, message, topicId);
+    shown = output(message, topicId);
   }
 
   // otherwise use the general topic appender
   if (!shown) {
-    output(group, message, LogTopic::MAX_LOG_TOPICS);
+    output(message, LogTopic::MAX_LOG_TOPICS);
   }
 }
 
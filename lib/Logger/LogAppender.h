@@ -28,6 +28,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <span>
 #include <string>
 #include <typeindex>
 #include <utility>
@@ -46,6 +47,11 @@ class Mutex;
 
 class LogAppender {
  public:
+  struct MessageRef {
+    LogGroup const* group;
+    LogMessage const* message;
+  };
+
   static void addAppender(LogGroup const&, std::string const& definition);
 
   static void addGlobalAppender(LogGroup const&, std::shared_ptr<LogAppender>);
@@ -55,6 +61,10 @@ class LogAppender {
 
   static void logGlobal(LogGroup const&, LogMessage const&);
   static void log(LogGroup const&, LogMessage const&);
+  // output multiple messages at once. appenders may defer the actual output
+  // until the end of the batch, so all messages must stay valid until the
+  // call returns
+  static void logBatch(std::span<MessageRef const> messages);
 
   static void reopen();
   static void shutdown();
@@ -71,6 +81,12 @@ class LogAppender {
  public:
   virtual void logMessage(LogMessage const&) = 0;
 
+  // like logMessage(), but the appender may defer the output until the
+  // end of the current batch. only called from logBatch()
+  virtual void logMessageDeferred(LogMessage const& message) {
+    logMessage(message);
+  }
+
   virtual std::string details() const = 0;
 
   static bool allowStdLogging() { return _allowStdLogging; }
@@ -81,6 +97,8 @@ class LogAppender {
                                 LogTopic*& topic);
 
  private:
+  static void logUnlocked(LogGroup const&, LogMessage const&, bool deferred);
+
   static arangodb::basics::ReadWriteLock _appendersLock;
   static std::array<std::vector<std::shared_ptr<LogAppender>>, LogGroup::Count>
       _globalAppenders;
@@ -24,6 +24,8 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <algorithm>
+#include <array>
+#include <cerrno>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -34,6 +36,10 @@
 #include <unistd.h>
 #endif
 
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+
 #include "LogAppenderFile.h"
 
 #include "ApplicationFeatures/ShellColorsFeature.h"
@@ -47,9 +53,52 @@
 using namespace arangodb;
 using namespace arangodb::basics;
 
+std::vector<LogAppenderFile::DeferredWrite> LogAppenderFile::_deferredWrites;
 std::mutex LogAppenderFile::_openAppendersMutex;
 std::vector<LogAppenderFile*> LogAppenderFile::_openAppenders;
 
+namespace {
+#ifndef _WIN32
+// write all buffers to the file descriptor, taking care of partial writes
+void writeBuffers(int fd, iovec* buffers, int count) noexcept {
+  bool giveUp = false;
+
+  while (count > 0) {
+    auto n = ::writev(fd, buffers, count);
+
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (LogAppender::allowStdLogging()) {
+        fprintf(stderr, "cannot log data: %s\n", TRI_LAST_ERROR_STR);
+      }
+      return;  // give up, but do not try to log the failure via the Logger
+    }
+
+    // skip over all buffers that have been written completely
+    auto written = static_cast<size_t>(n);
+    while (count > 0 && written >= buffers->iov_len) {
+      written -= buffers->iov_len;
+      ++buffers;
+      --count;
+    }
+    if (count > 0) {
+      buffers->iov_base = static_cast<char*>(buffers->iov_base) + written;
+      buffers->iov_len -= written;
+    }
+
+    if (n == 0 && count > 0) {
+      if (giveUp) {
+        return;
+      }
+      giveUp = true;
+    }
+  }
+}
+#endif
+}  // namespace
+
 int LogAppenderFile::_fileMode = S_IRUSR | S_IWUSR | S_IRGRP;
 int LogAppenderFile::_fileGroup = 0;
 
@@ -152,6 +201,59 @@ void LogAppenderFile::writeLogMessage(LogLevel level, size_t /*topicId*/,
   }
 }
 
+void LogAppenderFile::logMessageDeferred(LogMessage const& message) {
+#ifdef _WIN32
+  logMessage(message);
+#else
+  if (message._level == LogLevel::FATAL || _fd < 0) {
+    // keep the order of messages, and make sure fatal messages are
+    // flushed to disk before we go down
+    writeDeferred();
+    logMessage(message);
+    return;
+  }
+
+  _deferredWrites.push_back(DeferredWrite{_fd, message._message});
+#endif
+}
+
+void LogAppenderFile::writeDeferred() noexcept {
+#ifndef _WIN32
+  // number of buffers handed to a single writev() call
+  constexpr int maxBuffers = 64;
+
+  std::array<iovec, maxBuffers> buffers;
+
+  // write the pending messages of one file descriptor after the other, in
+  // the order in which they were logged. there are normally only very few
+  // log files, so scanning the list once per file is cheap
+  for (std::size_t i = 0; i < _deferredWrites.size(); ++i) {
+    int const fd = _deferredWrites[i].fd;
+    if (fd < 0) {
+      // already written
+      continue;
+    }
+
+    int count = 0;
+    for (std::size_t j = i; j < _deferredWrites.size(); ++j) {
+      auto& pending = _deferredWrites[j];
+      if (pending.fd != fd) {
+        continue;
+      }
+      buffers[count].iov_base = const_cast<char*>(pending.data.data());
+      buffers[count].iov_len = pending.data.size();
+      pending.fd = -1;
+      if (++count == maxBuffers) {
+        writeBuffers(fd, buffers.data(), count);
+        count = 0;
+      }
+    }
+    writeBuffers(fd, buffers.data(), count);
+  }
+#endif
+  _deferredWrites.clear();
+}
+
 std::string LogAppenderFile::details() const {
   std::string buffer("More error details may be provided in the logfile '");
   buffer.append(_filename);
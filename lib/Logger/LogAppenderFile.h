@@ -74,6 +74,8 @@ class LogAppenderFile : public LogAppenderStream {
   void writeLogMessage(LogLevel level, size_t topicId,
                        std::string const& message) override final;
 
+  void logMessageDeferred(LogMessage const& message) override final;
+
   std::string details() const override final;
 
   std::string const& filename() const { return _filename; }
@@ -82,6 +84,11 @@ class LogAppenderFile : public LogAppenderStream {
   static void reopenAll();
   static void closeAll();
 
+  /// @brief write all messages collected via logMessageDeferred(), using
+  /// as few system calls as possible. must be called with the appenders
+  /// lock held, which also protects the deferred writes
+  static void writeDeferred() noexcept;
+
 #ifdef ARANGODB_USE_GOOGLE_TESTS
   static std::vector<std::tuple<int, std::string, LogAppenderFile*>>
   getAppenders();
@@ -94,8 +101,15 @@ class LogAppenderFile : public LogAppenderStream {
   static void setFileGroup(int group) { _fileGroup = group; }
 
  private:
+  struct DeferredWrite {
+    int fd;
+    std::string_view data;
+  };
+
   std::string const _filename;
 
+  static std::vector<DeferredWrite> _deferredWrites;
+
   static std::mutex _openAppendersMutex;
   static std::vector<LogAppenderFile*> _openAppenders;
 
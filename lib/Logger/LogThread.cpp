@@ -22,6 +22,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "LogThread.h"
+
+#include <algorithm>
+#include <array>
+#include <span>
+
 #include "Basics/ConditionLocker.h"
 #include "Basics/debugging.h"
 #include "Logger/LogAppender.h"
@@ -29,9 +34,15 @@
 
 using namespace arangodb;
 
+namespace {
+std::atomic<uint64_t> nextLogThreadId{1};
+}  // namespace
+
 LogThread::LogThread(application_features::ApplicationServer& server,
                      std::string const& name)
-    : Thread(server, name), _messages(64) {}
+    : Thread(server, name),
+      _id(nextLogThreadId.fetch_add(1, std::memory_order_relaxed)),
+      _messages(initialQueueCapacity) {}
 
 LogThread::~LogThread() {
   Logger::_active = false;
@@ -51,7 +62,15 @@ bool LogThread::log(LogGroup& group, std::unique_ptr<LogMessage>& message) {
       (message->_level == LogLevel::FATAL || message->_level == LogLevel::ERR ||
        message->_level == LogLevel::WARN);
 
-  if (!_messages.push({&group, message.get()})) {
+  MessageEnvelope env{&group, message.get()};
+  if (LogThreadBuffer* buffer = threadBuffer(); buffer != nullptr) {
+    // count before pushing, so that the count never drops below zero
+    _buffered.fetch_add(1, std::memory_order_relaxed);
+    if (!buffer->push(env)) {
+      _buffered.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+  } else if (!_messages.push(env)) {
     return false;
   }
 
@@ -79,11 +98,59 @@ void LogThread::wakeup() noexcept {
   guard.signal();
 }
 
-bool LogThread::hasMessages() const noexcept { return !_messages.empty(); }
+bool LogThread::hasMessages() const noexcept {
+  return _buffered.load(std::memory_order_acquire) > 0 || !_messages.empty();
+}
+
+LogThreadBuffer* LogThread::threadBuffer() {
+  // thread-local objects may log from their destructors, after ref is gone.
+  // exiting is trivially destructible, so it can still be checked then
+  static thread_local bool exiting = false;
+
+  struct BufferRef {
+    ~BufferRef() {
+      if (buffer != nullptr) {
+        buffer->abandon();
+      }
+      exiting = true;
+    }
+
+    std::shared_ptr<LogThreadBuffer> buffer;
+    uint64_t owner = 0;
+  };
+
+  static thread_local BufferRef ref;
+
+  if (exiting) {
+    return nullptr;
+  }
+
+  if (ref.owner != _id) {
+    // first message of this thread for this logging thread
+    try {
+      auto buffer = std::make_shared<LogThreadBuffer>();
+      {
+        std::lock_guard guard(_buffersMutex);
+        _buffers.push_back(buffer);
+      }
+      if (ref.buffer != nullptr) {
+        ref.buffer->abandon();
+      }
+      ref.buffer = std::move(buffer);
+      ref.owner = _id;
+    } catch (...) {
+      return nullptr;
+    }
+  }
+  return ref.buffer.get();
+}
 
 void LogThread::run() {
-  constexpr uint64_t initialWaitTime = 25 * 1000;
-  constexpr uint64_t maxWaitTime = 100 * 1000;
+  // queued messages are written out at the latest after the flush interval.
+  // warnings and errors wake us up immediately
+  uint64_t const maxWaitTime =
+      std::max<uint64_t>(1, Logger::_flushInterval) * 1000;
+  uint64_t const initialWaitTime = std::min<uint64_t>(25 * 1000, maxWaitTime);
 
   uint64_t waitTime = initialWaitTime;
   while (!isStopping() && Logger::_active.load()) {
@@ -104,19 +171,59 @@ void LogThread::run() {
 }
 
 bool LogThread::processPendingMessages() {
-  bool worked = false;
-  MessageEnvelope env{nullptr, nullptr};
+  // messages are handed to the appenders in batches, so that file appenders
+  // can write them with a single system call
+  std::array<LogAppender::MessageRef, maxBatchSize> batch;
+  std::size_t size = 0;
 
-  while (_messages.pop(env)) {
+  auto writeBatch = [&]() noexcept {
+    try {
+      LogAppender::logBatch(std::span(batch.data(), size));
+    } catch (...) {
+    }
+
+    for (std::size_t i = 0; i < size; ++i) {
+      delete batch[i].message;
+    }
+    size = 0;
+  };
+
+  bool worked = false;
+  auto add = [&](MessageEnvelope const& env) noexcept {
     worked = true;
     TRI_ASSERT(env.group != nullptr);
     TRI_ASSERT(env.msg != nullptr);
-    try {
-      LogAppender::log(*env.group, *env.msg);
-    } catch (...) {
+    batch[size++] = {env.group, env.msg};
+
+    if (size == batch.size()) {
+      writeBatch();
     }
+  };
+
+  std::vector<std::shared_ptr<LogThreadBuffer>> buffers;
+  try {
+    std::lock_guard guard(_buffersMutex);
+    // buffers of threads that have exited are dropped here. their
+    // remaining messages are still handled below
+    buffers.reserve(_buffers.size());
+    std::erase_if(_buffers, [&buffers](auto const& buffer) {
+      buffers.push_back(buffer);
+      return buffer->abandoned();
+    });
+  } catch (...) {
+  }
+
+  for (auto const& buffer : buffers) {
+    _buffered.fetch_sub(buffer->drain(add), std::memory_order_release);
+  }
+
+  MessageEnvelope env{nullptr, nullptr};
+  while (_messages.pop(env)) {
+    add(env);
+  }
 
-    delete env.msg;
+  if (size > 0) {
+    writeBatch();
   }
   return worked;
 }
@@ -25,6 +25,12 @@
 
 #include "Basics/ConditionVariable.h"
 #include "Basics/Thread.h"
+#include "Logger/LogThreadBuffer.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include <boost/lockfree/queue.hpp>
 
@@ -40,10 +46,7 @@ class ConditionVariable;
 struct LogMessage;
 
 class LogThread final : public Thread {
-  struct MessageEnvelope {
-    LogGroup* group;
-    LogMessage* msg;
-  };
+  using MessageEnvelope = LogThreadBuffer::Envelope;
 
  public:
   explicit LogThread(application_features::ApplicationServer& server,
@@ -69,7 +72,32 @@ class LogThread final : public Thread {
   bool processPendingMessages();
 
  private:
+  /// @brief returns the message buffer of the calling thread for this
+  /// logging thread, registering a new one if needed. returns nullptr if
+  /// the calling thread is already exiting
+  LogThreadBuffer* threadBuffer();
+
+  /// @brief number of queue nodes that are allocated upfront. the shared
+  /// queue is only used by threads that cannot use their own buffer
+  static constexpr std::size_t initialQueueCapacity = 64;
+
+  /// @brief maximum number of messages handed to the appenders at once
+  static constexpr std::size_t maxBatchSize = 256;
+
+  /// @brief unique id of this logging thread, used to tell whether the
+  /// calling thread has registered its buffer with us
+  uint64_t const _id;
+
   arangodb::basics::ConditionVariable _condition;
+
+  /// @brief queue for messages of threads that cannot use their own buffer
   boost::lockfree::queue<MessageEnvelope> _messages;
+
+  /// @brief the buffers of all threads that have logged something
+  std::mutex _buffersMutex;
+  std::vector<std::shared_ptr<LogThreadBuffer>> _buffers;
+
+  /// @brief number of messages in the thread buffers not yet processed
+  std::atomic<std::size_t> _buffered{0};
 };
 }  // namespace arangodb
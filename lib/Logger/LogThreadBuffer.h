@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <boost/lockfree/spsc_queue.hpp>
+
+namespace arangodb {
+class LogGroup;
+struct LogMessage;
+
+/// @brief buffer for the log messages of a single thread, which are picked
+/// up by the logging thread. messages are put into a preallocated ring
+/// first, so that logging does not contend with other threads and does not
+/// allocate. if the ring is full, messages go into an overflow list until
+/// the logging thread has caught up. the order of messages is retained.
+/// push() must only be called by the owning thread, and drain() only by
+/// the logging thread
+class LogThreadBuffer {
+ public:
+  struct Envelope {
+    LogGroup* group;
+    LogMessage* msg;
+  };
+
+  /// @brief number of messages that fit into the ring
+  static constexpr std::size_t capacity = 256;
+
+  LogThreadBuffer() = default;
+  LogThreadBuffer(LogThreadBuffer const&) = delete;
+  LogThreadBuffer& operator=(LogThreadBuffer const&) = delete;
+
+  /// @brief queue a message. returns false if the message could not be
+  /// queued, in which case the caller still owns it
+  bool push(Envelope env) noexcept {
+    // once the ring has overflowed, all following messages must go into
+    // the overflow list, too. otherwise they could overtake older messages
+    if (!_overflowed.load(std::memory_order_acquire) && _ring.push(env)) {
+      return true;
+    }
+
+    try {
+      std::lock_guard guard(_overflowMutex);
+      _overflow.push_back(env);
+      _overflowed.store(true, std::memory_order_release);
+    } catch (...) {
+      return false;
+    }
+    return true;
+  }
+
+  /// @brief hand all queued messages to cb, in the order in which they
+  /// were pushed. returns the number of messages
+  template<typename F>
+  std::size_t drain(F&& cb) {
+    std::size_t count = _ring.consume_all(cb);
+
+    if (_overflowed.load(std::memory_order_acquire)) {
+      std::vector<Envelope> overflow;
+      {
+        std::lock_guard guard(_overflowMutex);
+        // the owning thread does not use the ring while the overflow flag
+        // is set, so whatever is in the ring now is older than the overflow
+        count += _ring.consume_all(cb);
+        overflow.swap(_overflow);
+        _overflowed.store(false, std::memory_order_release);
+      }
+      for (auto const& env : overflow) {
+        cb(env);
+      }
+      count += overflow.size();
+    }
+    return count;
+  }
+
+  /// @brief flag the buffer as no longer used by its thread. the logging
+  /// thread drops it once it is drained
+  void abandon() noexcept { _abandoned.store(true, std::memory_order_release); }
+
+  bool abandoned() const noexcept {
+    return _abandoned.load(std::memory_order_acquire);
+  }
+
+ private:
+  boost::lockfree::spsc_queue<Envelope, boost::lockfree::capacity<capacity>>
+      _ring;
+
+  std::mutex _overflowMutex;
+  std::vector<Envelope> _overflow;
+  std::atomic<bool> _overflowed{false};
+
+  std::atomic<bool> _abandoned{false};
+};
+
+}  // namespace arangodb
@@ -130,6 +130,7 @@ bool Logger::_useColor(true);
 bool Logger::_useControlEscaped(true);
 bool Logger::_useUnicodeEscaped(false);
 bool Logger::_keepLogRotate(false);
+uint32_t Logger::_flushInterval(100);
 bool Logger::_logRequestParameters(true);
 bool Logger::_showRole(false);
 bool Logger::_useJson(false);
@@ -445,6 +446,16 @@ void Logger::setKeepLogrotate(bool keep) {
   _keepLogRotate = keep;
 }
 
+// NOTE: this function should not be called if the logging is active.
+void Logger::setFlushInterval(uint32_t interval) {
+  if (_active) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL, "cannot change settings once logging is active");
+  }
+
+  _flushInterval = interval;
+}
+
 // NOTE: this function should not be called if the logging is active.
 void Logger::setLogRequestParameters(bool log) {
   if (_active) {
@@ -271,6 +271,7 @@ class Logger {
   }
   static void setTimeFormat(LogTimeFormats::TimeFormat);
   static void setKeepLogrotate(bool);
+  static void setFlushInterval(uint32_t);
   static void setLogRequestParameters(bool);
   static bool logRequestParameters() { return _logRequestParameters; }
   static void setUseJson(bool);
@@ -329,6 +330,7 @@ class Logger {
   static bool _useControlEscaped;
   static bool _useUnicodeEscaped;
   static bool _keepLogRotate;
+  static uint32_t _flushInterval;  // in milliseconds
   static bool _logRequestParameters;
   static bool _showIds;
   static bool _useJson;
@@ -556,6 +556,26 @@ printed in the thread that triggered the log message. This is non-optimal for
 performance but can aid debugging. If set to `false`, log messages are handed
 off to an extra logging thread, which asynchronously writes the log messages.)");
 
+  options
+      ->addOption("--log.flush-interval",
+                  "The maximum time (in milliseconds) the logging thread "
+                  "waits before writing out queued log messages.",
+                  new UInt32Parameter(&_flushInterval, /*base*/ 1,
+                                      /*minValue*/ 1),
+                  arangodb::options::makeDefaultFlags(
+                      arangodb::options::Flags::Uncommon))
+      .setIntroducedIn(31100)
+      .setLongDescription(R"(Log messages are handed off to an extra logging
+thread, which writes them to the log files in batches. Messages with the log
+levels `fatal`, `error` and `warning` are written out immediately. Messages
+with other log levels are written out at the latest after the specified
+interval.
+
+Increasing the interval lets the logging thread collect larger batches and
+reduces the number of write operations if a lot of messages are logged, e.g.
+with debug logging turned on. This option has no effect if
+`--log.force-direct` is set to `true`.)");
+
   options->addOption(
       "--log.request-parameters",
       "include full URLs and HTTP request parameters in trace logs",
@@ -714,6 +734,7 @@ void LoggerFeature::prepare() {
   Logger::setOutputPrefix(_prefix);
   Logger::setHostname(_hostname);
   Logger::setKeepLogrotate(_keepLogRotate);
+  Logger::setFlushInterval(_flushInterval);
   Logger::setLogRequestParameters(_logRequestParameters);
   Logger::setUseJson(_useJson);
 
@@ -83,6 +83,7 @@ class LoggerFeature final : public application_features::ApplicationFeature {
   std::string _timeFormatString;
   std::vector<std::string> _structuredLogParams;
   uint32_t _maxEntryLength = 128U * 1048576U;
+  uint32_t _flushInterval = 100;
   bool _useJson = false;
   bool _useLocalTime = false;
   bool _useColor = true;
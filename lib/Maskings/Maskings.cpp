@@ -36,10 +36,12 @@
 
 #include "Maskings.h"
 
+#include "Basics/Exceptions.h"
 #include "Basics/FileUtils.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/VPackStringBufferAdapter.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Basics/debugging.h"
 #include "Logger/LogMacros.h"
 #include "Logger/Logger.h"
@@ -310,14 +312,8 @@ void Maskings::addMasked(Collection& collection, VPackBuilder& builder,
   addMaskedObject(collection, builder, path, data);
 }
 
-void Maskings::addMasked(Collection& collection, basics::StringBuffer& data,
-                         VPackSlice slice) {
-  if (!slice.isObject()) {
-    return;
-  }
-
-  VPackBuilder builder;
-
+VPackSlice Maskings::maskDocument(Collection& collection,
+                                  VPackBuilder& builder, VPackSlice slice) {
   if (slice.hasKey(StaticStrings::KeyString)) {
     // non-enveloped format - the document is at the top level
     {
@@ -327,28 +323,38 @@ void Maskings::addMasked(Collection& collection, basics::StringBuffer& data,
 
     // the maskings will generate a result object that contains a "data"
     // attribute at the top
-    slice = builder.slice().get("data");
-  } else {
-    // enveloped format -  the document is underneath the "data" attribute
-    std::string_view dataStr("data");
+    return builder.slice().get("data");
+  }
 
-    {
-      VPackObjectBuilder ob(&builder);
+  // enveloped format -  the document is underneath the "data" attribute
+  std::string_view dataStr("data");
+
+  {
+    VPackObjectBuilder ob(&builder);
 
-      for (auto const& entry : VPackObjectIterator(slice, false)) {
-        auto key = entry.key.stringView();
+    for (auto const& entry : VPackObjectIterator(slice, false)) {
+      auto key = entry.key.stringView();
 
-        if (key == dataStr) {
-          addMasked(collection, builder, entry.value);
-        } else {
-          builder.add(key, entry.value);
-        }
+      if (key == dataStr) {
+        addMasked(collection, builder, entry.value);
+      } else {
+        builder.add(key, entry.value);
       }
     }
+  }
+
+  return builder.slice();
+}
 
-    slice = builder.slice();
+void Maskings::addMasked(Collection& collection, basics::StringBuffer& data,
+                         VPackSlice slice) {
+  if (!slice.isObject()) {
+    return;
   }
 
+  VPackBuilder builder;
+  slice = maskDocument(collection, builder, slice);
+
   // directly emit JSON into result StringBuffer
   basics::VPackStringBufferAdapter adapter(data.stringBuffer());
   VPackDumper dumper(&adapter, &VPackOptions::Defaults);
@@ -357,25 +363,31 @@ void Maskings::addMasked(Collection& collection, basics::StringBuffer& data,
   data.appendChar('\n');
 }
 
-void Maskings::mask(std::string const& name, basics::StringBuffer const& data,
-                    basics::StringBuffer& result) {
-  result.clear();
-
+Collection* Maskings::collectionToMask(std::string const& name) {
   Collection* collection;
   auto const itr = _collections.find(name);
 
   if (itr == _collections.end()) {
-    if (_hasDefaultCollection) {
-      collection = &_defaultCollection;
-    } else {
-      result.copy(data);
-      return;
+    if (!_hasDefaultCollection) {
+      return nullptr;
     }
+    collection = &_defaultCollection;
   } else {
     collection = &(itr->second);
   }
 
   if (collection->selection() == CollectionSelection::FULL) {
+    return nullptr;
+  }
+  return collection;
+}
+
+void Maskings::mask(std::string const& name, basics::StringBuffer const& data,
+                    basics::StringBuffer& result) {
+  result.clear();
+
+  Collection* collection = collectionToMask(name);
+  if (collection == nullptr) {
     result.copy(data);
     return;
   }
@@ -402,3 +414,38 @@ void Maskings::mask(std::string const& name, basics::StringBuffer const& data,
     q = p;
   }
 }
+
+void Maskings::mask(std::string const& name, uint8_t const* data,
+                    size_t length, velocypack::Buffer<uint8_t>& result) {
+  result.clear();
+
+  Collection* collection = collectionToMask(name);
+  if (collection == nullptr) {
+    result.append(data, length);
+    return;
+  }
+
+  result.reserve(length);
+
+  uint8_t const* p = data;
+  uint8_t const* e = p + length;
+  VPackBuilder builder;
+
+  while (p < e) {
+    VPackSlice slice(p);
+    VPackValueLength size = basics::VelocyPackHelper::byteSizeWithin(
+        p, static_cast<size_t>(e - p));
+    if (size == 0 || size > static_cast<VPackValueLength>(e - p)) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                     "invalid velocypack data to mask");
+    }
+
+    if (slice.isObject()) {
+      builder.clear();
+      VPackSlice masked = maskDocument(*collection, builder, slice);
+      result.append(masked.start(), masked.byteSize());
+    }
+
+    p += size;
+  }
+}
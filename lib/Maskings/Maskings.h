@@ -71,11 +71,16 @@ class Maskings {
   bool shouldDumpData(std::string const& name);
   void mask(std::string const& name, basics::StringBuffer const& data,
             basics::StringBuffer& result);
+  /// @brief mask a sequence of velocypack documents, written one after
+  /// the other, into another such sequence
+  void mask(std::string const& name, uint8_t const* data, size_t length,
+            velocypack::Buffer<uint8_t>& result);
 
   uint64_t randomSeed() const noexcept { return _randomSeed; }
 
  private:
   ParseResult<Maskings> parse(VPackSlice const&);
+  Collection* collectionToMask(std::string const& name);
   VPackValue maskedItem(Collection& collection, std::vector<std::string>& path,
                         std::string& buffer, VPackSlice const& data);
   void addMaskedArray(Collection& collection, VPackBuilder& builder,
@@ -84,6 +89,8 @@ class Maskings {
                        std::vector<std::string>& path, VPackSlice const& data);
   void addMasked(Collection& collection, VPackBuilder& builder,
                  VPackSlice data);
+  VPackSlice maskDocument(Collection& collection, VPackBuilder& builder,
+                          VPackSlice slice);
   void addMasked(Collection& collection, basics::StringBuffer& data,
                  VPackSlice slice);
 
@@ -30,6 +30,7 @@
 #include "Random/UniformCharacter.h"
 
 #include <cstring>
+#include <openssl/crypto.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/hmac.h>
@@ -226,6 +227,63 @@ bool verifyHMAC(char const* challenge, size_t challengeLength,
   return false;
 }
 
+HmacKey::HmacKey(std::string_view key, Algorithm algorithm)
+    : _context(HMAC_CTX_new()) {
+  auto* context = static_cast<HMAC_CTX*>(_context);
+  if (context == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  EVP_MD const* evp_md = nullptr;
+  if (algorithm == Algorithm::ALGORITHM_SHA1) {
+    evp_md = EVP_sha1();
+  } else if (algorithm == Algorithm::ALGORITHM_SHA224) {
+    evp_md = EVP_sha224();
+  } else if (algorithm == Algorithm::ALGORITHM_MD5) {
+    evp_md = EVP_md5();
+  } else if (algorithm == Algorithm::ALGORITHM_SHA384) {
+    evp_md = EVP_sha384();
+  } else if (algorithm == Algorithm::ALGORITHM_SHA512) {
+    evp_md = EVP_sha512();
+  } else {
+    // default
+    evp_md = EVP_sha256();
+  }
+
+  if (HMAC_Init_ex(context, key.data(), static_cast<int>(key.size()), evp_md,
+                   nullptr) == 0) {
+    HMAC_CTX_free(context);
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "unable to initialize HMAC key");
+  }
+}
+
+HmacKey::~HmacKey() { HMAC_CTX_free(static_cast<HMAC_CTX*>(_context)); }
+
+bool HmacKey::verify(std::string_view message,
+                     std::string_view response) const {
+  // start from a copy of the keyed state, so that the key does not need to
+  // be hashed again
+  HMAC_CTX* context = HMAC_CTX_new();
+  if (context == nullptr) {
+    return false;
+  }
+  auto sg = arangodb::scopeGuard([&]() noexcept { HMAC_CTX_free(context); });
+
+  unsigned char md[EVP_MAX_MD_SIZE];
+  unsigned int md_len = 0;
+  if (HMAC_CTX_copy(context, static_cast<HMAC_CTX*>(_context)) == 0 ||
+      HMAC_Update(context,
+                  reinterpret_cast<unsigned char const*>(message.data()),
+                  message.size()) == 0 ||
+      HMAC_Final(context, &md[0], &md_len) == 0) {
+    return false;
+  }
+
+  return response.size() == md_len &&
+         CRYPTO_memcmp(&md[0], response.data(), md_len) == 0;
+}
+
 int sslRand(uint64_t* value) {
   if (!RAND_BYTES((unsigned char*)value, sizeof(uint64_t))) {
     return 1;
@@ -119,6 +119,30 @@ bool verifyHMAC(char const* challenge, size_t challengeLength,
                 char const* secret, size_t secretLen, char const* response,
                 size_t responseLen, Algorithm algorithm);
 
+//////////////////////////////////////////////////////////////////////////
+/// @brief HMAC key with precomputed state
+///
+/// the padded key is hashed once on construction, so that computing the
+/// HMAC of a message only needs to hash the message itself. a key can be
+/// used by multiple threads concurrently
+//////////////////////////////////////////////////////////////////////////
+
+class HmacKey {
+ public:
+  HmacKey(std::string_view key, Algorithm algorithm);
+  ~HmacKey();
+
+  HmacKey(HmacKey const&) = delete;
+  HmacKey& operator=(HmacKey const&) = delete;
+
+  /// @brief whether the HMAC of message equals response
+  bool verify(std::string_view message, std::string_view response) const;
+
+ private:
+  /// @brief HMAC_CTX initialized with the key
+  void* _context;
+};
+
 //////////////////////////////////////////////////////////////////////////
 /// @brief generate a random number using OpenSsl
 ///
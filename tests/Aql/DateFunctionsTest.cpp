@@ -26,11 +26,13 @@
 
 #include "fakeit.hpp"
 
+#include "Aql/AqlFunctionsInternalCache.h"
 #include "Aql/AqlValue.h"
 #include "Aql/AstNode.h"
 #include "Aql/ExpressionContext.h"
 #include "Aql/Function.h"
 #include "Aql/Functions.h"
+#include "Basics/datetime.h"
 #include "Containers/SmallVector.h"
 #include "Transaction/Methods.h"
 
@@ -474,6 +476,28 @@ TEST(DateFunctionsTest, DATE_SUBTRACT) {
 
 }  // namespace date_subtract
 
+namespace date_format {
+
+TEST(DateFunctionsTest, DATE_FORMAT_cache_is_bounded) {
+  tp_sys_clock_ms tp;
+  ASSERT_TRUE(basics::parseDateTime("2017-11-02T09:05:03.042Z", tp));
+
+  // data-dependent format strings must not make the cache grow without
+  // bounds. programs built earlier are rebuilt after the cache was cleared
+  AqlFunctionsInternalCache cache;
+  for (size_t round = 0; round < 2; ++round) {
+    size_t const n = 3 * AqlFunctionsInternalCache::maxDateFormatCacheSize;
+    for (size_t i = 0; i < n; ++i) {
+      auto const* program =
+          cache.buildDateFormat("%yyyy-" + std::to_string(i));
+      ASSERT_NE(nullptr, program);
+      EXPECT_EQ("2017-" + std::to_string(i), program->execute(tp));
+    }
+  }
+}
+
+}  // namespace date_format
+
 }  // namespace date_functions_aql
 }  // namespace tests
 }  // namespace arangodb
@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Aql/QueryFingerprints.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+QueryFingerprints::Sample makeSample(double runTime, uint64_t rows = 0) {
+  QueryFingerprints::Sample sample;
+  sample.runTime = runTime;
+  sample.rows = rows;
+  return sample;
+}
+
+/// @brief n different queries that end up in the same shard. the queries
+/// are normalized already
+std::vector<std::string> queriesInSameShard(size_t n) {
+  std::vector<std::string> queries;
+  size_t shard = 0;
+  for (size_t i = 0; queries.size() < n; ++i) {
+    std::string query = "RETURN a" + std::to_string(i);
+    size_t s = QueryFingerprints::fingerprint("db", query) %
+               QueryFingerprints::kNumShards;
+    if (queries.empty()) {
+      shard = s;
+    }
+    if (s == shard) {
+      queries.emplace_back(std::move(query));
+    }
+  }
+  return queries;
+}
+
+/// @brief number of calls of the query in database "db", 0 if the query is
+/// not tracked
+uint64_t callsOf(QueryFingerprints const& fingerprints,
+                 std::string_view query) {
+  velocypack::Builder out;
+  fingerprints.toVelocyPack(out, "db", false, 1000);
+  for (auto entry : velocypack::ArrayIterator(out.slice())) {
+    if (entry.get("query").copyString() == query) {
+      return entry.get("calls").getNumber<uint64_t>();
+    }
+  }
+  return 0;
+}
+}  // namespace
+
+TEST(QueryFingerprintsTest, normalizeLiterals) {
+  EXPECT_EQ("FOR d IN c FILTER d.a==? RETURN d",
+            QueryFingerprints::normalize(
+                "FOR d IN c FILTER d.a == 'abc' RETURN d"));
+  EXPECT_EQ("FOR d IN c FILTER d.a==? RETURN d",
+            QueryFingerprints::normalize(
+                "FOR d IN c FILTER d.a == \"a\\\"b\" RETURN d"));
+  EXPECT_EQ("RETURN[?,?,?,?,?,-?]",
+            QueryFingerprints::normalize(
+                "RETURN [1, 2.5, .5, 1e10, 0x1F, -0b101]"));
+  EXPECT_EQ("FOR i IN ?..? RETURN i",
+            QueryFingerprints::normalize("FOR i IN 1..10 RETURN i"));
+  EXPECT_EQ("RETURN doc1.value2",
+            QueryFingerprints::normalize("RETURN doc1.value2"));
+  EXPECT_EQ("FOR d IN c FILTER d.a==?&&d.b!=? RETURN[?,d.null,d.True]",
+            QueryFingerprints::normalize(
+                "FOR d IN c FILTER d.a == true && d.b != NULL "
+                "RETURN [False, d.null, d.True]"));
+  EXPECT_EQ("RETURN nullable", QueryFingerprints::normalize("RETURN nullable"));
+}
+
+TEST(QueryFingerprintsTest, normalizeKeepsBindParametersAndIdentifiers) {
+  EXPECT_EQ("FOR d IN @@c FILTER d.`a 1`==@value RETURN d",
+            QueryFingerprints::normalize(
+                "FOR d IN @@c FILTER d.`a 1` == @value RETURN d"));
+  EXPECT_EQ("RETURN d.\xc2\xb4x 1\xc2\xb4",
+            QueryFingerprints::normalize("RETURN d.\xc2\xb4x 1\xc2\xb4"));
+}
+
+TEST(QueryFingerprintsTest, normalizeCommentsAndWhitespace) {
+  EXPECT_EQ(
+      QueryFingerprints::normalize("FOR d IN c RETURN d"),
+      QueryFingerprints::normalize(
+          "  FOR d // comment 'x'\n IN\tc /* 1 \n 2 */ RETURN   d  \n"));
+}
+
+TEST(QueryFingerprintsTest, aggregatesByFingerprint) {
+  QueryFingerprints fingerprints(1024, 4096);
+
+  fingerprints.track("db", "RETURN 1", makeSample(0.5, 1));
+  fingerprints.track("db", "RETURN  2", makeSample(1.5, 1));
+  fingerprints.track("db", "RETURN 'x'", makeSample(1.0, 1));
+  fingerprints.track("other", "RETURN 1", makeSample(10.0, 1));
+  fingerprints.track("db", "FOR i IN 1..3 RETURN i", makeSample(0.1, 3));
+
+  EXPECT_EQ(3, fingerprints.size());
+
+  velocypack::Builder out;
+  fingerprints.toVelocyPack(out, "db", false, 100);
+  velocypack::Slice result = out.slice();
+  ASSERT_TRUE(result.isArray());
+  ASSERT_EQ(2, result.length());
+
+  // ordered by total time
+  velocypack::Slice first = result.at(0);
+  EXPECT_EQ("RETURN ?", first.get("query").copyString());
+  EXPECT_EQ("db", first.get("database").copyString());
+  EXPECT_EQ(3, first.get("calls").getNumber<uint64_t>());
+  EXPECT_EQ(3, first.get("rows").getNumber<uint64_t>());
+  EXPECT_DOUBLE_EQ(3.0, first.get("totalTime").getNumber<double>());
+  EXPECT_DOUBLE_EQ(1.0, first.get("meanTime").getNumber<double>());
+  EXPECT_DOUBLE_EQ(0.5, first.get("minTime").getNumber<double>());
+  EXPECT_DOUBLE_EQ(1.5, first.get("maxTime").getNumber<double>());
+  double p99 = first.get("p99Time").getNumber<double>();
+  EXPECT_GE(p99, 1.0);
+  EXPECT_LE(p99, 1.5);
+
+  velocypack::Slice second = result.at(1);
+  EXPECT_EQ("FOR i IN ?..? RETURN i", second.get("query").copyString());
+  EXPECT_EQ(1, second.get("calls").getNumber<uint64_t>());
+
+  out.clear();
+  fingerprints.toVelocyPack(out, "", true, 1);
+  ASSERT_EQ(1, out.slice().length());
+  EXPECT_EQ("other", out.slice().at(0).get("database").copyString());
+
+  fingerprints.clear("db", false);
+  EXPECT_EQ(1, fingerprints.size());
+  fingerprints.clear("", true);
+  EXPECT_EQ(0, fingerprints.size());
+}
+
+TEST(QueryFingerprintsTest, evictsLeastFrequentlyUsed) {
+  // the minimum of one entry per shard
+  QueryFingerprints fingerprints(1, 4096);
+
+  for (int i = 0; i < 1000; ++i) {
+    fingerprints.track("db", "RETURN a" + std::to_string(i), makeSample(0.1));
+  }
+
+  EXPECT_LE(fingerprints.size(), 16);
+  EXPECT_EQ(1000 - fingerprints.size(), fingerprints.evictions());
+}
+
+TEST(QueryFingerprintsTest, keepsQueriesWithSamePrefixApart) {
+  // only the first 16 bytes of the queries are returned
+  QueryFingerprints fingerprints(1024, 16);
+
+  fingerprints.track("db", "FOR d IN c FILTER d.a RETURN d",
+                     makeSample(1.0));
+  fingerprints.track("db", "FOR d IN c FILTER d.b RETURN d",
+                     makeSample(2.0));
+  fingerprints.track("db", "FOR d IN c FILTER d.b RETURN d",
+                     makeSample(2.0));
+
+  EXPECT_EQ(2, fingerprints.size());
+
+  velocypack::Builder out;
+  fingerprints.toVelocyPack(out, "db", false, 100);
+  ASSERT_EQ(2, out.slice().length());
+  EXPECT_EQ("FOR d IN c FILTE", out.slice().at(0).get("query").copyString());
+  EXPECT_EQ(2, out.slice().at(0).get("calls").getNumber<uint64_t>());
+  EXPECT_EQ("FOR d IN c FILTE", out.slice().at(1).get("query").copyString());
+  EXPECT_EQ(1, out.slice().at(1).get("calls").getNumber<uint64_t>());
+}
+
+TEST(QueryFingerprintsTest, protectsNewEntriesFromEviction) {
+  // four entries per shard
+  QueryFingerprints fingerprints(4 * QueryFingerprints::kNumShards, 4096);
+  auto queries = queriesInSameShard(6);
+
+  // fill the shard with queries that were called twice
+  for (size_t i = 0; i < 4; ++i) {
+    fingerprints.track("db", queries[i], makeSample(0.1));
+    fingerprints.track("db", queries[i], makeSample(0.1));
+  }
+  EXPECT_EQ(0, fingerprints.evictions());
+
+  // a new query replaces the least recently used of them
+  fingerprints.track("db", queries[4], makeSample(0.1));
+  EXPECT_EQ(1, fingerprints.evictions());
+  EXPECT_EQ(0, callsOf(fingerprints, queries[0]));
+
+  // the new query is not thrown out right away by the next one, although
+  // it was called less often than the others
+  fingerprints.track("db", queries[5], makeSample(0.1));
+  EXPECT_EQ(2, fingerprints.evictions());
+  EXPECT_EQ(0, callsOf(fingerprints, queries[1]));
+  EXPECT_EQ(1, callsOf(fingerprints, queries[4]));
+  EXPECT_EQ(1, callsOf(fingerprints, queries[5]));
+
+  fingerprints.track("db", queries[4], makeSample(0.1));
+  EXPECT_EQ(2, callsOf(fingerprints, queries[4]));
+}
+
+TEST(QueryFingerprintsTest, agesFrequencies) {
+  // four entries per shard
+  QueryFingerprints fingerprints(4 * QueryFingerprints::kNumShards, 4096);
+  auto queries = queriesInSameShard(5);
+
+  // a query that was hot once
+  for (size_t i = 0; i < 1000; ++i) {
+    fingerprints.track("db", queries[0], makeSample(0.1));
+  }
+  // queries that are called less often, but more recently
+  for (size_t i = 0; i < 300; ++i) {
+    fingerprints.track("db", queries[1 + i % 3], makeSample(0.1));
+  }
+
+  // the formerly hot query is evicted first
+  fingerprints.track("db", queries[4], makeSample(0.1));
+  EXPECT_EQ(1, fingerprints.evictions());
+  EXPECT_EQ(0, callsOf(fingerprints, queries[0]));
+  for (size_t i = 1; i < 5; ++i) {
+    EXPECT_LT(0, callsOf(fingerprints, queries[i]));
+  }
+}
@@ -0,0 +1,261 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/Ast.h"
+#include "Aql/AstNode.h"
+#include "Aql/Query.h"
+#include "Aql/QueryCache.h"
+#include "Aql/UserFunctionExpression.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/voc-errors.h"
+#include "IResearch/common.h"
+#include "Mocks/Servers.h"
+
+#include "gtest/gtest.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+class UserFunctionExpressionTest : public ::testing::Test {
+ public:
+  UserFunctionExpressionTest()
+      : _server{}, _query{_server.createFakeQuery()}, _ast{_query->ast()} {}
+
+  std::shared_ptr<UserFunctionExpression const> create(
+      std::vector<std::string> parameters, std::string_view expression) {
+    auto res = UserFunctionExpression::create(
+        _query->vocbase(), "TEST::FUNC", std::move(parameters), expression);
+    EXPECT_TRUE(res.ok()) << res.errorMessage();
+    return res.ok() ? res.get() : nullptr;
+  }
+
+  ErrorCode createError(std::vector<std::string> parameters,
+                        std::string_view expression) {
+    auto res = UserFunctionExpression::create(
+        _query->vocbase(), "TEST::FUNC", std::move(parameters), expression);
+    return res.errorNumber();
+  }
+
+ protected:
+  tests::mocks::MockAqlServer _server;
+  std::shared_ptr<Query> _query;
+  Ast* _ast;
+};
+
+}  // namespace
+
+TEST_F(UserFunctionExpressionTest, validExpressions) {
+  auto function = create({"a", "b"}, "@a * @b + LENGTH([1, @a])");
+  ASSERT_NE(nullptr, function);
+  EXPECT_EQ("TEST::FUNC", function->name());
+  EXPECT_EQ((std::vector<std::string>{"a", "b"}), function->parameters());
+  EXPECT_TRUE(function->isDeterministic());
+
+  function = create({}, "RAND() // comment");
+  ASSERT_NE(nullptr, function);
+  EXPECT_FALSE(function->isDeterministic());
+
+  function = create({"doc"}, "{ value: @doc.value, first: @doc.values[0] }");
+  ASSERT_NE(nullptr, function);
+}
+
+TEST_F(UserFunctionExpressionTest, invalidExpressions) {
+  auto const invalid = TRI_ERROR_QUERY_FUNCTION_INVALID_CODE;
+  // syntax errors and further statements
+  EXPECT_EQ(invalid, createError({"a"}, "@a +"));
+  EXPECT_EQ(invalid, createError({"a"}, "@a) RETURN (1"));
+  // unknown bind parameters
+  EXPECT_EQ(invalid, createError({"a"}, "@a + @b"));
+  EXPECT_EQ(invalid, createError({"a"}, "@@a"));
+  // invalid or duplicate parameter names
+  EXPECT_EQ(invalid, createError({"1a"}, "1"));
+  EXPECT_EQ(invalid, createError({"a-b"}, "1"));
+  EXPECT_EQ(invalid, createError({"a", "a"}, "@a"));
+  // document access, variables, subqueries
+  EXPECT_EQ(invalid, createError({"a"}, "DOCUMENT(@a)"));
+  EXPECT_EQ(invalid, createError({"a"}, "@a[* RETURN CURRENT.x]"));
+  EXPECT_EQ(invalid, createError({"a"}, "(FOR x IN @a RETURN x)"));
+  EXPECT_EQ(invalid, createError({"a"}, "OTHER::FUNC(@a)"));
+}
+
+TEST_F(UserFunctionExpressionTest, inlineCall) {
+  auto function = create({"a", "b"}, "@a * 2 + @b");
+  ASSERT_NE(nullptr, function);
+
+  AstNode* arguments = _ast->createNodeArray();
+  arguments->addMember(_ast->createNodeValueInt(3));
+  arguments->addMember(_ast->createNodeValueString("x", 1));
+
+  AstNode* body = function->inlineCall(*_ast, arguments);
+  ASSERT_NE(nullptr, body);
+  ASSERT_EQ(NODE_TYPE_OPERATOR_BINARY_PLUS, body->type);
+  EXPECT_EQ(arguments->getMember(1), body->getMember(1));
+  AstNode const* times = body->getMember(0);
+  ASSERT_EQ(NODE_TYPE_OPERATOR_BINARY_TIMES, times->type);
+  EXPECT_EQ(arguments->getMember(0), times->getMember(0));
+  EXPECT_EQ(2, times->getMember(1)->getIntValue());
+
+  // wrong number of arguments
+  arguments = _ast->createNodeArray();
+  arguments->addMember(_ast->createNodeValueInt(3));
+  try {
+    function->inlineCall(*_ast, arguments);
+    FAIL() << "expected an exception";
+  } catch (basics::Exception const& ex) {
+    EXPECT_EQ(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, ex.code());
+  }
+}
+
+TEST_F(UserFunctionExpressionTest, inlineCallWithRepeatedParameter) {
+  auto function = create({"a"}, "@a * @a");
+  ASSERT_NE(nullptr, function);
+
+  AstNode* arguments = _ast->createNodeArray();
+  arguments->addMember(_ast->createNodeValueInt(3));
+  AstNode* body = function->inlineCall(*_ast, arguments);
+  ASSERT_NE(nullptr, body);
+  ASSERT_EQ(NODE_TYPE_OPERATOR_BINARY_TIMES, body->type);
+  // the second reference gets a copy of the argument
+  EXPECT_EQ(arguments->getMember(0), body->getMember(0));
+  EXPECT_NE(arguments->getMember(0), body->getMember(1));
+  EXPECT_EQ(3, body->getMember(1)->getIntValue());
+
+  // attributes of variables can be evaluated more than once
+  AstNode* reference =
+      _ast->createNodeReference(_ast->variables()->createTemporaryVariable());
+  arguments = _ast->createNodeArray();
+  arguments->addMember(_ast->createNodeAttributeAccess(reference, "x"));
+  EXPECT_NE(nullptr, function->inlineCall(*_ast, arguments));
+
+  // other arguments must not be evaluated twice, regardless of whether
+  // they are deterministic or not
+  for (std::string_view name : {"RAND", "UPPER"}) {
+    AstNode* callArguments = _ast->createNodeArray();
+    if (name == "UPPER") {
+      callArguments->addMember(reference);
+    }
+    arguments = _ast->createNodeArray();
+    arguments->addMember(
+        _ast->createNodeFunctionCall(name, callArguments, false));
+    EXPECT_EQ(nullptr, function->inlineCall(*_ast, arguments)) << name;
+  }
+}
+
+TEST_F(UserFunctionExpressionTest, inlineCallWithConditionalParameter) {
+  AstNode* reference =
+      _ast->createNodeReference(_ast->variables()->createTemporaryVariable());
+  auto call = [&](std::string_view function) {
+    AstNode* arguments = _ast->createNodeArray();
+    arguments->addMember(reference);
+    return _ast->createNodeFunctionCall(function, arguments, false);
+  };
+
+  for (auto expression : {"@a ? @b : 1", "@a ?: @b", "@a && @b", "@a || @b",
+                          "@a || 1 || @b"}) {
+    auto function = create({"a", "b"}, expression);
+    ASSERT_NE(nullptr, function);
+
+    // the first operand is always evaluated
+    AstNode* arguments = _ast->createNodeArray();
+    arguments->addMember(call("UPPER"));
+    arguments->addMember(reference);
+    EXPECT_NE(nullptr, function->inlineCall(*_ast, arguments)) << expression;
+
+    // the other operands only depending on the first one
+    arguments = _ast->createNodeArray();
+    arguments->addMember(reference);
+    arguments->addMember(call("UPPER"));
+    EXPECT_EQ(nullptr, function->inlineCall(*_ast, arguments)) << expression;
+  }
+}
+
+TEST_F(UserFunctionExpressionTest, inlineCallWithUnusedParameter) {
+  auto function = create({"a"}, "42");
+  ASSERT_NE(nullptr, function);
+
+  AstNode* arguments = _ast->createNodeArray();
+  arguments->addMember(_ast->createNodeValueInt(3));
+  AstNode* body = function->inlineCall(*_ast, arguments);
+  ASSERT_NE(nullptr, body);
+  EXPECT_EQ(42, body->getIntValue());
+
+  // the call would evaluate the argument, e.g. to raise an error
+  arguments = _ast->createNodeArray();
+  arguments->addMember(_ast->createNodeFunctionCall(
+      "FAIL", _ast->createNodeArray(), false));
+  EXPECT_EQ(nullptr, function->inlineCall(*_ast, arguments));
+}
+
+TEST_F(UserFunctionExpressionTest, updateDefinitions) {
+  auto& vocbase = _query->vocbase();
+  auto cleanup = scopeGuard([&]() noexcept {
+    UserFunctionExpression::removeGroup(vocbase, "TEST::");
+  });
+
+  auto function = create({"a"}, "@a + 1");
+  ASSERT_NE(nullptr, function);
+  UserFunctionExpression::update(vocbase, "TEST::FUNC", function);
+  UserFunctionExpression::update(vocbase, "TEST::OTHER", function);
+  EXPECT_EQ(function, UserFunctionExpression::lookup(vocbase, "TEST::FUNC"));
+  EXPECT_EQ(function, UserFunctionExpression::lookup(vocbase, "TEST::OTHER"));
+
+  // e.g. replaced by a JavaScript function
+  UserFunctionExpression::update(vocbase, "TEST::FUNC", nullptr);
+  EXPECT_EQ(nullptr, UserFunctionExpression::lookup(vocbase, "TEST::FUNC"));
+  EXPECT_EQ(function, UserFunctionExpression::lookup(vocbase, "TEST::OTHER"));
+
+  UserFunctionExpression::removeGroup(vocbase, "TEST::");
+  EXPECT_EQ(nullptr, UserFunctionExpression::lookup(vocbase, "TEST::OTHER"));
+}
+
+TEST_F(UserFunctionExpressionTest, replaceFunctionWithQueryCache) {
+  auto& vocbase = _query->vocbase();
+  auto* queryCache = QueryCache::instance();
+  auto properties = queryCache->properties();
+  auto cleanup = scopeGuard([&]() noexcept {
+    queryCache->properties(properties);
+    queryCache->invalidate(&vocbase);
+    UserFunctionExpression::update(vocbase, "TEST::FUNC", nullptr);
+  });
+  auto alwaysOn = properties;
+  alwaysOn.mode = CACHE_ALWAYS_ON;
+  queryCache->properties(alwaysOn);
+
+  std::string const queryString = "RETURN TEST::FUNC(3)";
+  UserFunctionExpression::update(vocbase, "TEST::FUNC",
+                                 create({"a"}, "@a * 2"));
+  auto result = tests::executeQuery(vocbase, queryString);
+  ASSERT_TRUE(result.result.ok()) << result.result.errorMessage();
+  EXPECT_EQ(6, result.data->slice().at(0).getNumber<int>());
+
+  // the result of the inlined function must not come from the cache once
+  // the function was registered again
+  UserFunctionExpression::update(vocbase, "TEST::FUNC",
+                                 create({"a"}, "@a * 3"));
+  result = tests::executeQuery(vocbase, queryString);
+  ASSERT_TRUE(result.result.ok()) << result.result.errorMessage();
+  EXPECT_FALSE(result.cached);
+  EXPECT_EQ(9, result.data->slice().at(0).getNumber<int>());
+}
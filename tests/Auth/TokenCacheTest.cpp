@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Auth/TokenCache.h"
+#include "Basics/system-functions.h"
+#include "Metrics/Counter.h"
+#include "Metrics/MetricsFeature.h"
+#include "RestServer/arangod.h"
+#include "Ssl/SslInterface.h"
+
+#include <fuerte/jwt.h>
+#include <velocypack/Builder.h>
+#include <velocypack/Value.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+namespace {
+constexpr std::string_view secret = "the-jwt-secret";
+
+std::string makeToken(std::string const& serverId, double expiry) {
+  velocypack::Builder body;
+  body.openObject();
+  body.add("server_id", velocypack::Value(serverId));
+  body.add("iss", velocypack::Value("arangodb"));
+  body.add("exp", velocypack::Value(expiry));
+  body.close();
+  return fuerte::jwt::generateRawJwt(std::string(secret), body.slice());
+}
+
+/// @brief token cache with a clock that is advanced by the test
+class TestTokenCache : public auth::TokenCache {
+ public:
+  using auth::TokenCache::TokenCache;
+
+  double getTime() const override { return time; }
+
+  double time = TRI_microtime();
+};
+}  // namespace
+
+TEST(HmacKeyTest, test_verify_like_hmac) {
+  std::vector<SslInterface::Algorithm> const algorithms = {
+      SslInterface::Algorithm::ALGORITHM_SHA256,
+      SslInterface::Algorithm::ALGORITHM_SHA1,
+      SslInterface::Algorithm::ALGORITHM_MD5,
+      SslInterface::Algorithm::ALGORITHM_SHA224,
+      SslInterface::Algorithm::ALGORITHM_SHA384,
+      SslInterface::Algorithm::ALGORITHM_SHA512};
+  // keys shorter than, as long as and longer than the hash block size
+  std::vector<std::string> const keys = {"", "k", std::string(64, 'x'),
+                                         std::string(200, 'y')};
+  std::vector<std::string> const messages = {"", "abc",
+                                             std::string(1000, 'm')};
+
+  for (auto algorithm : algorithms) {
+    for (auto const& key : keys) {
+      SslInterface::HmacKey hmacKey(key, algorithm);
+      for (auto const& message : messages) {
+        std::string const hmac =
+            SslInterface::sslHMAC(key.data(), key.size(), message.data(),
+                                  message.size(), algorithm);
+
+        std::string flipped = hmac;
+        flipped.back() ^= 0x01;
+        std::vector<std::string> const responses = {
+            hmac, flipped, hmac.substr(0, hmac.size() - 1), hmac + "x", ""};
+        for (auto const& response : responses) {
+          bool const expected = SslInterface::verifyHMAC(
+              key.data(), key.size(), message.data(), message.size(),
+              response.data(), response.size(), algorithm);
+          EXPECT_EQ(expected, hmacKey.verify(message, response))
+              << "algorithm " << algorithm << ", key size " << key.size()
+              << ", message size " << message.size();
+        }
+        EXPECT_TRUE(hmacKey.verify(message, hmac));
+        EXPECT_FALSE(hmacKey.verify(message + "!", hmac));
+      }
+    }
+  }
+}
+
+class TokenCacheTest : public ::testing::Test {
+ protected:
+  ArangodServer server;
+  metrics::MetricsFeature& metrics;
+  TestTokenCache cache;
+
+  TokenCacheTest()
+      : server(nullptr, nullptr),
+        metrics(server.addFeature<metrics::MetricsFeature>()),
+        cache(metrics, nullptr, 60.0) {
+#ifdef USE_ENTERPRISE
+    cache.setJwtSecrets(std::string(secret), {});
+#else
+    cache.setJwtSecret(std::string(secret));
+#endif
+  }
+
+  uint64_t counter(std::string_view name) {
+    auto* metric = metrics.get({name, ""});
+    EXPECT_NE(nullptr, metric);
+    return metric == nullptr ? 0
+                             : static_cast<metrics::Counter*>(metric)->load();
+  }
+
+  uint64_t hits() { return counter("arangodb_auth_jwt_cache_hits_total"); }
+  uint64_t misses() { return counter("arangodb_auth_jwt_cache_misses_total"); }
+
+  bool check(std::string const& token) {
+    return cache
+        .checkAuthentication(AuthenticationMethod::JWT,
+                             ServerState::Mode::DEFAULT, token)
+        .authenticated();
+  }
+};
+
+TEST_F(TokenCacheTest, test_hit_and_miss) {
+  std::string const token = makeToken("PRMR-1", cache.time + 3600.0);
+
+  EXPECT_TRUE(check(token));
+  EXPECT_EQ(0U, hits());
+  EXPECT_EQ(1U, misses());
+
+  EXPECT_TRUE(check(token));
+  EXPECT_EQ(1U, hits());
+  EXPECT_EQ(1U, misses());
+
+  // a token with an invalid signature is never cached
+  std::string invalid = token;
+  char& c = invalid[invalid.rfind('.') + 1];
+  c = (c == 'A') ? 'B' : 'A';
+  EXPECT_FALSE(check(invalid));
+  EXPECT_FALSE(check(invalid));
+  EXPECT_EQ(1U, hits());
+  EXPECT_EQ(3U, misses());
+}
+
+TEST_F(TokenCacheTest, test_hits_and_misses_across_shards) {
+  // enough tokens to spread over all shards of the cache
+  std::vector<std::string> tokens;
+  for (int i = 0; i < 256; ++i) {
+    tokens.emplace_back(
+        makeToken("PRMR-" + std::to_string(i), cache.time + 3600.0));
+  }
+
+  for (auto const& token : tokens) {
+    EXPECT_TRUE(check(token));
+  }
+  EXPECT_EQ(0U, hits());
+  EXPECT_EQ(tokens.size(), misses());
+
+  for (auto const& token : tokens) {
+    EXPECT_TRUE(check(token));
+  }
+  EXPECT_EQ(tokens.size(), hits());
+  EXPECT_EQ(tokens.size(), misses());
+}
+
+TEST_F(TokenCacheTest, test_expiry_across_shards) {
+  double const now = cache.time;
+  std::vector<std::string> expiring;
+  std::vector<std::string> valid;
+  for (int i = 0; i < 64; ++i) {
+    expiring.emplace_back(makeToken("PRMR-e" + std::to_string(i), now + 1.0));
+    valid.emplace_back(makeToken("PRMR-v" + std::to_string(i), now + 3600.0));
+  }
+
+  for (auto const& token : expiring) {
+    ASSERT_TRUE(check(token));
+  }
+  for (auto const& token : valid) {
+    EXPECT_TRUE(check(token));
+  }
+  EXPECT_EQ(0U, hits());
+  EXPECT_EQ(128U, misses());
+
+  cache.time = now + 2.0;
+
+  // expired entries are rejected and count as misses, the other entries are
+  // still found
+  for (auto const& token : expiring) {
+    EXPECT_FALSE(check(token));
+  }
+  EXPECT_EQ(0U, hits());
+  EXPECT_EQ(192U, misses());
+
+  for (auto const& token : valid) {
+    EXPECT_TRUE(check(token));
+  }
+  EXPECT_EQ(64U, hits());
+  EXPECT_EQ(192U, misses());
+
+  // expired entries were removed from the cache, and are validated again
+  for (auto const& token : expiring) {
+    EXPECT_FALSE(check(token));
+  }
+  EXPECT_EQ(64U, hits());
+  EXPECT_EQ(256U, misses());
+}
@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "gtest/gtest.h"
+
+#include "Basics/CpuProfiler.h"
+#include "Basics/voc-errors.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
+using namespace arangodb;
+
+namespace {
+double burnCpu(std::chrono::milliseconds duration) {
+  auto end = std::chrono::steady_clock::now() + duration;
+  double x = 0.0;
+  while (std::chrono::steady_clock::now() < end) {
+    for (int i = 0; i < 10000; ++i) {
+      x += std::sqrt(static_cast<double>(i));
+    }
+  }
+  return x;
+}
+}  // namespace
+
+TEST(CpuProfilerTest, testUnsupported) {
+  if (CpuProfiler::supported()) {
+    GTEST_SKIP();
+  }
+  CpuProfiler profiler(CpuProfiler::defaultFrequency, 100);
+  ASSERT_TRUE(profiler.start().is(TRI_ERROR_NOT_IMPLEMENTED));
+}
+
+TEST(CpuProfilerTest, testOnlyOneActiveProfiler) {
+  if (!CpuProfiler::supported()) {
+    GTEST_SKIP();
+  }
+  CpuProfiler profiler(CpuProfiler::defaultFrequency, 100);
+  ASSERT_TRUE(profiler.start().ok());
+
+  CpuProfiler other(CpuProfiler::defaultFrequency, 100);
+  ASSERT_TRUE(other.start().is(TRI_ERROR_LOCKED));
+
+  profiler.stop();
+  ASSERT_TRUE(other.start().ok());
+}
+
+TEST(CpuProfilerTest, testSamples) {
+  if (!CpuProfiler::supported()) {
+    GTEST_SKIP();
+  }
+  CpuProfiler::ThreadRegistration registration("profiled-thread");
+
+  CpuProfiler profiler(CpuProfiler::maxFrequency, 10);
+  ASSERT_TRUE(profiler.start().ok());
+  burnCpu(std::chrono::milliseconds(200));
+  profiler.stop();
+
+  // 200ms of CPU time at 1000 Hz overflow the buffer of 10 samples
+  ASSERT_EQ(10, profiler.numSamples());
+  ASSERT_LT(0, profiler.numDropped());
+
+  std::string collapsed = profiler.toCollapsed();
+  ASSERT_FALSE(collapsed.empty());
+  ASSERT_EQ('\n', collapsed.back());
+  ASSERT_EQ(0, collapsed.find("profiled-thread;"));
+
+  std::string pprof = profiler.toPprof();
+  ASSERT_GT(pprof.size(), 8 * sizeof(uintptr_t));
+  uintptr_t header[5];
+  memcpy(&header[0], pprof.data(), sizeof(header));
+  ASSERT_EQ(0, header[0]);
+  ASSERT_EQ(3, header[1]);
+  ASSERT_EQ(0, header[2]);
+  ASSERT_EQ(1000, header[3]);
+}
+
+#ifdef ARANGODB_HAVE_LIBUNWIND
+TEST(CpuProfilerTest, testStacksAreComplete) {
+  if (!CpuProfiler::supported()) {
+    GTEST_SKIP();
+  }
+  CpuProfiler::ThreadRegistration registration("profiled-thread");
+
+  CpuProfiler profiler(CpuProfiler::maxFrequency, 1000);
+  ASSERT_TRUE(profiler.start().ok());
+  burnCpu(std::chrono::milliseconds(200));
+  profiler.stop();
+
+  // stacks are unwound beyond the innermost frame even if the code was
+  // compiled without frame pointers
+  std::string collapsed = profiler.toCollapsed();
+  bool found = false;
+  size_t pos = 0;
+  while (pos < collapsed.size()) {
+    size_t end = collapsed.find('\n', pos);
+    std::string_view line(collapsed.data() + pos, end - pos);
+    size_t burn = line.find("burnCpu");
+    if (burn != std::string_view::npos &&
+        line.find("testStacksAreComplete") < burn) {
+      found = true;
+    }
+    pos = end + 1;
+  }
+  ASSERT_TRUE(found) << collapsed;
+}
+#endif
+
+TEST(CpuProfilerTest, testOnlyRegisteredThreadsAreSampled) {
+  if (!CpuProfiler::supported()) {
+    GTEST_SKIP();
+  }
+  std::atomic<bool> registered{false};
+  std::atomic<bool> done{false};
+  std::thread thread([&]() {
+    CpuProfiler::ThreadRegistration registration("registered-thread");
+    registered.store(true);
+    while (!done.load()) {
+      burnCpu(std::chrono::milliseconds(10));
+    }
+  });
+  while (!registered.load()) {
+    std::this_thread::yield();
+  }
+
+  // the current thread is not registered, and is not sampled although it
+  // burns CPU as well
+  CpuProfiler profiler(CpuProfiler::maxFrequency, 1000);
+  ASSERT_TRUE(profiler.start().ok());
+  burnCpu(std::chrono::milliseconds(200));
+  profiler.stop();
+  done.store(true);
+  thread.join();
+
+  ASSERT_LT(0, profiler.numSamples());
+  ASSERT_EQ(0, profiler.numDropped());
+  std::string collapsed = profiler.toCollapsed();
+  size_t pos = 0;
+  while (pos < collapsed.size()) {
+    ASSERT_EQ(pos, collapsed.find("registered-thread;", pos));
+    pos = collapsed.find('\n', pos) + 1;
+  }
+}
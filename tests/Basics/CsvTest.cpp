@@ -339,3 +339,40 @@ TEST_F(CCsvTest, tst_csv_semicolon_noquote) {
 
   TRI_DestroyCsvParser(&parser);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test scanning for complete records
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CCsvTest, tst_csv_scan_records) {
+  INIT_PARSER
+  TRI_SetSeparatorCsvParser(&parser, ',');
+  TRI_SetQuoteCsvParser(&parser, '"', true);
+
+  const char* csv = "a,b" LF "\"c" LF "d\",e" CR LF "f,g";
+  size_t records = SIZE_MAX;
+  EXPECT_EQ(13, TRI_ScanCsvRecords(&parser, csv, strlen(csv), &records));
+  EXPECT_EQ(2, records);
+
+  records = 1;
+  EXPECT_EQ(4, TRI_ScanCsvRecords(&parser, csv, strlen(csv), &records));
+  EXPECT_EQ(1, records);
+
+  // a CR at the end may be followed by a LF
+  csv = "a,b" CR;
+  records = SIZE_MAX;
+  EXPECT_EQ(0, TRI_ScanCsvRecords(&parser, csv, strlen(csv), &records));
+  EXPECT_EQ(0, records);
+
+  csv = "\"a\"\"" LF "\",b" LF "c" LF;
+  records = SIZE_MAX;
+  EXPECT_EQ(11, TRI_ScanCsvRecords(&parser, csv, strlen(csv), &records));
+  EXPECT_EQ(2, records);
+
+  // the parts before and after the returned position parse like the whole
+  TRI_ParseCsvString(&parser, csv, 9);
+  TRI_ParseCsvString(&parser, csv + 9, 2);
+  EXPECT_EQ("0:ESCa\"\nESC,b\n1:c\n", out.str());
+
+  TRI_DestroyCsvParser(&parser);
+}
@@ -31,11 +31,15 @@
 #include "Basics/fasthash.h"
 #include "Basics/files.h"
 #include "Basics/hashes.h"
+#include "Basics/wyhash.h"
 
 #include "icu-helper.h"
 
 #include <absl/crc/crc32c.h>
 
+#include <set>
+#include <string>
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                        test suite
 // -----------------------------------------------------------------------------
@@ -176,6 +180,43 @@ TEST_F(CHashesTest, tst_fasthash64_unaligned) {
               fasthash64(buffer.c_str() + 7, buffer.size() - 7, 0x12345678));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test wyhash64
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CHashesTest, tst_wyhash64) {
+  std::string buffer;
+  std::set<uint64_t> seen;
+
+  // every prefix length exercises a different code path for short, medium
+  // and long inputs
+  for (size_t i = 0; i < 200; ++i) {
+    EXPECT_TRUE(seen.emplace(wyhash64(buffer.data(), buffer.size(), 0)).second);
+    EXPECT_NE(wyhash64(buffer.data(), buffer.size(), 0),
+              wyhash64(buffer.data(), buffer.size(), 1));
+    buffer.push_back(static_cast<char>('a' + (i % 26)));
+  }
+
+  for (uint64_t i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(seen.emplace(wyhash64_uint64(i, 0)).second);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test wyhash64 unaligned reads
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CHashesTest, tst_wyhash64_unaligned) {
+  std::string const value = "der kuckuck und der Esel, die hatten einen Streit";
+  uint64_t const expected = wyhash64(value.data(), value.size(), 0x12345678);
+
+  for (size_t offset = 1; offset < 8; ++offset) {
+    std::string buffer = std::string(offset, ' ') + value;
+    EXPECT_EQ(expected, wyhash64(buffer.data() + offset, buffer.size() - offset,
+                                 0x12345678));
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test fnv64 for simple strings
 ////////////////////////////////////////////////////////////////////////////////
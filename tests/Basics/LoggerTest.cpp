@@ -29,12 +29,14 @@
 #include "gtest/gtest.h"
 
 #include "Logger/LogAppenderFile.h"
+#include "Logger/LogThreadBuffer.h"
 #include "Logger/Logger.h"
 
 #include <date/date.h>
 
 #include <regex>
 #include <sstream>
+#include <thread>
 
 #ifdef TRI_HAVE_UNISTD_H
 #include <unistd.h>
@@ -156,6 +158,123 @@ TEST_F(LoggerTest, test_fds_after_reopen) {
   LogAppenderFile::closeAll();
 }
 
+TEST_F(LoggerTest, test_deferred_writes) {
+  LogAppenderFile logger1(logfile1);
+  LogAppenderFile logger2(logfile2);
+
+  std::vector<std::unique_ptr<LogMessage>> messages;
+  for (int i = 0; i < 200; ++i) {
+    messages.emplace_back(std::make_unique<LogMessage>(
+        __FUNCTION__, __FILE__, __LINE__, LogLevel::DEBUG, 0,
+        "message " + std::to_string(i) + "\n", 0, true));
+  }
+
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    // interleave the messages for both files
+    if (i % 3 == 0) {
+      logger2.logMessageDeferred(*messages[i]);
+    } else {
+      logger1.logMessageDeferred(*messages[i]);
+    }
+  }
+
+  // nothing is written before the end of the batch
+  EXPECT_EQ("", FileUtils::slurp(logfile1));
+  EXPECT_EQ("", FileUtils::slurp(logfile2));
+
+  LogAppenderFile::writeDeferred();
+
+  std::string expected1;
+  std::string expected2;
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    (i % 3 == 0 ? expected2 : expected1).append(messages[i]->_message);
+  }
+  EXPECT_EQ(expected1, FileUtils::slurp(logfile1));
+  EXPECT_EQ(expected2, FileUtils::slurp(logfile2));
+
+  // a fatal message writes out everything that is pending first
+  logger1.logMessageDeferred(*messages[0]);
+  logger1.logMessageDeferred(LogMessage(__FUNCTION__, __FILE__, __LINE__,
+                                        LogLevel::FATAL, 0, "fatal message\n",
+                                        0, true));
+  expected1.append(messages[0]->_message).append("fatal message\n");
+  EXPECT_EQ(expected1, FileUtils::slurp(logfile1));
+
+  LogAppenderFile::closeAll();
+}
+
+TEST_F(LoggerTest, test_thread_buffer_keeps_order_on_overflow) {
+  std::vector<std::unique_ptr<LogMessage>> messages;
+  for (std::size_t i = 0; i < 3 * LogThreadBuffer::capacity; ++i) {
+    messages.emplace_back(std::make_unique<LogMessage>(
+        __FUNCTION__, __FILE__, __LINE__, LogLevel::DEBUG, 0,
+        "message " + std::to_string(i) + "\n", 0, true));
+  }
+
+  LogThreadBuffer buffer;
+  std::vector<LogMessage*> drained;
+  auto collect = [&drained](LogThreadBuffer::Envelope const& env) {
+    EXPECT_EQ(&Logger::defaultLogGroup(), env.group);
+    drained.push_back(env.msg);
+  };
+
+  // more messages than fit into the ring
+  for (auto const& message : messages) {
+    ASSERT_TRUE(buffer.push({&Logger::defaultLogGroup(), message.get()}));
+  }
+
+  EXPECT_EQ(messages.size(), buffer.drain(collect));
+  ASSERT_EQ(messages.size(), drained.size());
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_EQ(messages[i].get(), drained[i]);
+  }
+
+  // after draining, the ring is used again
+  drained.clear();
+  ASSERT_TRUE(buffer.push({&Logger::defaultLogGroup(), messages[0].get()}));
+  EXPECT_EQ(1U, buffer.drain(collect));
+  ASSERT_EQ(1U, drained.size());
+  EXPECT_EQ(messages[0].get(), drained[0]);
+  EXPECT_EQ(0U, buffer.drain(collect));
+}
+
+TEST_F(LoggerTest, test_thread_buffer_concurrent_drain) {
+  std::vector<std::unique_ptr<LogMessage>> messages;
+  for (std::size_t i = 0; i < 20000; ++i) {
+    messages.emplace_back(std::make_unique<LogMessage>(
+        __FUNCTION__, __FILE__, __LINE__, LogLevel::DEBUG, 0,
+        "message " + std::to_string(i) + "\n", 0, true));
+  }
+
+  LogThreadBuffer buffer;
+  std::thread producer([&]() {
+    for (auto const& message : messages) {
+      ASSERT_TRUE(buffer.push({&Logger::defaultLogGroup(), message.get()}));
+    }
+    buffer.abandon();
+  });
+
+  std::vector<LogMessage*> drained;
+  auto collect = [&drained](LogThreadBuffer::Envelope const& env) {
+    drained.push_back(env.msg);
+  };
+
+  while (true) {
+    // check before draining, so that no message is left behind
+    bool const done = buffer.abandoned();
+    buffer.drain(collect);
+    if (done) {
+      break;
+    }
+  }
+  producer.join();
+
+  ASSERT_EQ(messages.size(), drained.size());
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_EQ(messages[i].get(), drained[i]);
+  }
+}
+
 TEST_F(LoggerTest, testTimeFormats) {
   using namespace std::chrono;
 
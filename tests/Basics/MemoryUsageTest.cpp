@@ -310,6 +310,41 @@ TEST(ResourceUsageTest, testMemoryLocalLimitViolationCounter) {
   ASSERT_EQ(2, stats.localLimitReached);
 }
 
+TEST(ResourceUsageTest, testSubsystemAccounting) {
+  GlobalResourceMonitor global;
+  global.memoryLimit(4 * ResourceMonitor::chunkSize);
+  ResourceMonitor aql(global, MemorySubsystem::Aql);
+  ResourceMonitor other(global);
+
+  aql.increaseMemoryUsage(2 * ResourceMonitor::chunkSize + 1);
+  other.increaseMemoryUsage(ResourceMonitor::chunkSize);
+
+  ASSERT_EQ(2 * ResourceMonitor::chunkSize,
+            global.subsystemUsage(MemorySubsystem::Aql));
+  ASSERT_EQ(ResourceMonitor::chunkSize,
+            global.subsystemUsage(MemorySubsystem::Other));
+  ASSERT_EQ(0, global.subsystemUsage(MemorySubsystem::Pregel));
+  ASSERT_EQ(3 * ResourceMonitor::chunkSize, global.current());
+
+  // a rejected allocation must not be accounted to the subsystem
+  try {
+    aql.increaseMemoryUsage(2 * ResourceMonitor::chunkSize);
+    throw "fail!";
+  } catch (basics::Exception const& ex) {
+    ASSERT_EQ(TRI_ERROR_RESOURCE_LIMIT, ex.code());
+  }
+  ASSERT_EQ(2 * ResourceMonitor::chunkSize,
+            global.subsystemUsage(MemorySubsystem::Aql));
+
+  aql.decreaseMemoryUsage(2 * ResourceMonitor::chunkSize + 1);
+  other.decreaseMemoryUsage(ResourceMonitor::chunkSize);
+
+  ASSERT_EQ(0, global.subsystemUsage(MemorySubsystem::Aql));
+  ASSERT_EQ(0, global.subsystemUsage(MemorySubsystem::Other));
+  ASSERT_EQ(0, global.current());
+  ASSERT_EQ("aql", GlobalResourceMonitor::subsystemName(MemorySubsystem::Aql));
+}
+
 TEST(ResourceUsageTest, testGlobalMemoryLimitViolationCounter) {
   GlobalResourceMonitor global;
   global.memoryLimit(65535);
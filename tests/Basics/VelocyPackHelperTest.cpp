@@ -258,3 +258,111 @@ TEST(VPackHelperTest, velocypack_string_literals) {
     ASSERT_TRUE(obj.slice()["edges"].isArray());
   }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that equal values have equal fast hashes
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(VPackHelperTest, tst_fast_normalized_hash) {
+  using arangodb::basics::VelocyPackHelper;
+
+  auto hash = [](VPackSlice slice) {
+    return VelocyPackHelper::fastNormalizedHash(slice, 0xdeadbeef);
+  };
+
+  VPackBuilder b;
+  b.openArray();
+  b.add(VPackValue(1));
+  b.add(VPackValue(1.0));
+  b.add(VPackValue(uint64_t(1)));
+  b.add(VPackValue(int64_t(1) << 40));
+  b.add(VPackValue(static_cast<double>(int64_t(1) << 40)));
+  b.add(VPackValue(0.0));
+  b.add(VPackValue(-0.0));
+  b.close();
+  VPackSlice numbers = b.slice();
+
+  EXPECT_EQ(hash(numbers[0]), hash(numbers[1]));
+  EXPECT_EQ(hash(numbers[0]), hash(numbers[2]));
+  EXPECT_EQ(hash(numbers[3]), hash(numbers[4]));
+  EXPECT_EQ(hash(numbers[5]), hash(numbers[6]));
+  EXPECT_NE(hash(numbers[0]), hash(numbers[3]));
+  EXPECT_NE(hash(numbers[0]), hash(numbers[5]));
+
+  auto values = R"(["", "a", "b", "abc", null, false, true, 0, [], {}])"_vpack;
+  for (size_t i = 0; i < values.slice().length(); ++i) {
+    for (size_t j = i + 1; j < values.slice().length(); ++j) {
+      EXPECT_NE(hash(values.slice()[i]), hash(values.slice()[j]));
+    }
+  }
+
+  // compound values must hash the same as their equivalents with different
+  // number representations
+  auto l = R"([1, {"a": 2.0}])"_vpack;
+  auto r = R"([1.0, {"a": 2}])"_vpack;
+  EXPECT_EQ(hash(l.slice()), hash(r.slice()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the byte size of a value is only determined if all bytes
+/// encoding it are available
+////////////////////////////////////////////////////////////////////////////////
+
+TEST(VPackHelperTest, tst_byte_size_within) {
+  using arangodb::basics::VelocyPackHelper;
+
+  auto check = [](VPackSlice value, size_t headerSize) {
+    uint8_t const* data = value.start();
+    VPackValueLength size = value.byteSize();
+    for (size_t i = 0; i < headerSize; ++i) {
+      EXPECT_EQ(0, VelocyPackHelper::byteSizeWithin(data, i))
+          << value.toJson() << " " << i;
+    }
+    EXPECT_EQ(size, VelocyPackHelper::byteSizeWithin(data, headerSize))
+        << value.toJson();
+    EXPECT_EQ(size, VelocyPackHelper::byteSizeWithin(data, size))
+        << value.toJson();
+  };
+
+  std::string const longString(300, 'x');
+
+  VPackBuilder b;
+  b.openArray();
+  b.add(VPackValue(1));
+  b.add(VPackValue("abc"));
+  b.add(VPackValue(longString));
+  b.close();
+  check(b.slice()[0], 1);
+  check(b.slice()[1], 1);
+  // 8 bytes of length
+  check(b.slice()[2], 9);
+  // 1 byte of byte length
+  check(R"([1, 2, 3])"_vpack.slice(), 2);
+  check(R"({"a": 1})"_vpack.slice(), 2);
+
+  // 4 bytes of byte length
+  b.clear();
+  b.openObject();
+  b.add("a", VPackValue(std::string(70000, 'x')));
+  b.close();
+  ASSERT_EQ(0x0d, b.slice().head());
+  check(b.slice(), 5);
+
+  // compact array with 2 bytes of varint byte length
+  VPackOptions options;
+  options.buildUnindexedArrays = true;
+  VPackBuilder compact(&options);
+  compact.openArray();
+  for (int i = 0; i < 200; ++i) {
+    compact.add(VPackValue(1));
+  }
+  compact.close();
+  ASSERT_EQ(0x13, compact.slice().head());
+  check(compact.slice(), 3);
+
+  // tagged long string: head, tag, then the header of the string
+  b.clear();
+  b.addTagged(42, VPackValue(longString));
+  ASSERT_EQ(0xee, b.slice().head());
+  check(b.slice(), 11);
+}
@@ -71,3 +71,62 @@ TEST(DateTimeTest, testing) {
     ASSERT_FALSE(ret);
   }
 }
+
+TEST(DateTimeTest, testFormatProgram) {
+  tp_sys_clock_ms tp;
+  ASSERT_TRUE(parseDateTime("2017-11-02T09:05:03.042Z", tp));
+
+  EXPECT_EQ("2017-11-02", DateFormatProgram("%yyyy-%mm-%dd").execute(tp));
+  EXPECT_EQ("09:05:03.042",
+            DateFormatProgram("%hh:%ii:%ss.%fff").execute(tp));
+  EXPECT_EQ("November Nov 2 11m",
+            DateFormatProgram("%mmmm %mmm %d %m%&m").execute(tp));
+  EXPECT_EQ("Thursday, Q4, 100%",
+            DateFormatProgram("%wwww, Q%q, 100%%").execute(tp));
+  EXPECT_EQ("+002017", DateFormatProgram("%yyyyyy").execute(tp));
+  EXPECT_EQ("2017-11-02T09:05:03.042Z", DateFormatProgram("%z").execute(tp));
+  EXPECT_EQ("no placeholders",
+            DateFormatProgram("no placeholders").execute(tp));
+  EXPECT_EQ("", DateFormatProgram("").execute(tp));
+  EXPECT_EQ("abc", DateFormatProgram("abc%").execute(tp));
+
+  // a program can be executed many times
+  DateFormatProgram program("%dd.%mm.%yy");
+  std::string out;
+  program.execute(out, tp);
+  out.push_back('|');
+  program.execute(out, tp);
+  EXPECT_EQ("02.11.17|02.11.17", out);
+  EXPECT_EQ(out.substr(0, 8), formatDate("%dd.%mm.%yy", tp));
+}
+
+TEST(DateTimeTest, testIsoDuration) {
+  ParsedDuration d;
+  ASSERT_TRUE(parseIsoDuration("P1Y2M3W4DT5H6M7.8S", d));
+  EXPECT_EQ(1, d.years);
+  EXPECT_EQ(2, d.months);
+  EXPECT_EQ(3, d.weeks);
+  EXPECT_EQ(4, d.days);
+  EXPECT_EQ(5, d.hours);
+  EXPECT_EQ(6, d.minutes);
+  EXPECT_EQ(7, d.seconds);
+  EXPECT_EQ(800, d.milliseconds);
+
+  d = ParsedDuration{};
+  ASSERT_TRUE(parseIsoDuration("PT1M", d));
+  EXPECT_EQ(0, d.months);
+  EXPECT_EQ(1, d.minutes);
+
+  d = ParsedDuration{};
+  ASSERT_TRUE(parseIsoDuration("PT0,25S", d));
+  EXPECT_EQ(250, d.milliseconds);
+
+  std::vector<std::string> durationsToFail{
+      "",         "P",       "1Y",      "P1",       "P1D2Y",
+      "P1Y1Y",    "PT1D",    "P1H",     "PT1.5M",   "PT1.1234S",
+      "PT1.S",    "P1YT1H ", "P-1D",    "xP1D",     "PT1S2.5S",
+      "PT1.5S2S"};
+  for (auto const& duration : durationsToFail) {
+    EXPECT_FALSE(parseIsoDuration(duration, d)) << duration;
+  }
+}
@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Benchmark/KeyDistribution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+using namespace arangodb::arangobench;
+
+namespace {
+
+constexpr uint64_t numSamples = 200000;
+
+// number of accesses of each key, for numSamples accesses
+std::vector<uint64_t> sample(KeyDistribution const& keys, uint64_t n) {
+  std::vector<uint64_t> counts(n, 0);
+  for (uint64_t i = 0; i < numSamples; ++i) {
+    uint64_t key = keys.key(KeyDistribution::uniform(2 * i),
+                            KeyDistribution::uniform(2 * i + 1));
+    EXPECT_LT(key, n);
+    if (key < n) {
+      ++counts[key];
+    }
+  }
+  return counts;
+}
+
+}  // namespace
+
+TEST(KeyDistributionTest, type_from_string) {
+  EXPECT_EQ(KeyDistribution::Type::Uniform,
+            KeyDistribution::typeFromString("uniform"));
+  EXPECT_EQ(KeyDistribution::Type::Zipfian,
+            KeyDistribution::typeFromString("zipfian"));
+  EXPECT_EQ(KeyDistribution::Type::Hotspot,
+            KeyDistribution::typeFromString("hotspot"));
+}
+
+TEST(KeyDistributionTest, uniform_values_are_in_unit_interval) {
+  double sum = 0.0;
+  for (uint64_t i = 0; i < numSamples; ++i) {
+    double u = KeyDistribution::uniform(i);
+    ASSERT_GE(u, 0.0);
+    ASSERT_LT(u, 1.0);
+    sum += u;
+  }
+  EXPECT_NEAR(0.5, sum / numSamples, 0.01);
+}
+
+TEST(KeyDistributionTest, keys_stay_in_range) {
+  for (auto type :
+       {KeyDistribution::Type::Uniform, KeyDistribution::Type::Zipfian,
+        KeyDistribution::Type::Hotspot}) {
+    for (uint64_t n : {1, 2, 3, 1000}) {
+      KeyDistribution keys(type, n, 0.99, 0.2, 0.8);
+      for (double u : {0.0, 0.25, 0.5, 0.999999, 1.0 - 0x1.0p-53}) {
+        for (double v : {0.0, 0.5, 1.0 - 0x1.0p-53}) {
+          EXPECT_LT(keys.key(u, v), n) << u << " " << v;
+        }
+      }
+    }
+  }
+}
+
+TEST(KeyDistributionTest, uniform_accesses_all_keys_evenly) {
+  uint64_t const n = 100;
+  KeyDistribution keys(KeyDistribution::Type::Uniform, n, 0.99, 0.2, 0.8);
+  auto counts = sample(keys, n);
+  double const expected = static_cast<double>(numSamples) / n;
+  for (uint64_t i = 0; i < n; ++i) {
+    EXPECT_NEAR(expected, counts[i], expected * 0.1) << i;
+  }
+}
+
+TEST(KeyDistributionTest, hotspot_accesses_hot_keys_more_often) {
+  uint64_t const n = 1000;
+  // 20% of the keys get 80% of the accesses
+  KeyDistribution keys(KeyDistribution::Type::Hotspot, n, 0.99, 0.2, 0.8);
+  auto counts = sample(keys, n);
+
+  uint64_t hot = 0;
+  for (uint64_t i = 0; i < 200; ++i) {
+    hot += counts[i];
+  }
+  EXPECT_NEAR(0.8, static_cast<double>(hot) / numSamples, 0.01);
+
+  // all keys within the hot and the cold set are accessed evenly
+  EXPECT_NEAR(counts[0], counts[199], numSamples * 0.8 / 200 * 0.25);
+  EXPECT_NEAR(counts[200], counts[999], numSamples * 0.2 / 800 * 0.5);
+}
+
+TEST(KeyDistributionTest, hotspot_with_all_keys_hot_is_uniform) {
+  uint64_t const n = 10;
+  KeyDistribution keys(KeyDistribution::Type::Hotspot, n, 0.99, 1.0, 0.5);
+  auto counts = sample(keys, n);
+  for (uint64_t i = 0; i < n; ++i) {
+    EXPECT_NEAR(numSamples / n, counts[i], numSamples / n * 0.1) << i;
+  }
+}
+
+TEST(KeyDistributionTest, zipfian_is_skewed) {
+  uint64_t const n = 1000;
+  KeyDistribution keys(KeyDistribution::Type::Zipfian, n, 0.99, 0.2, 0.8);
+  auto counts = sample(keys, n);
+
+  std::vector<uint64_t> sorted = counts;
+  std::sort(sorted.begin(), sorted.end(), std::greater<>());
+
+  // with a constant of 0.99 and 1000 keys, the most popular key gets about
+  // 1 / (1 + 1/2^0.99 + ... + 1/1000^0.99), i.e. 13%, of the accesses
+  double zetan = 0.0;
+  for (uint64_t i = 1; i <= n; ++i) {
+    zetan += 1.0 / std::pow(static_cast<double>(i), 0.99);
+  }
+  EXPECT_NEAR(1.0 / zetan, static_cast<double>(sorted[0]) / numSamples, 0.01);
+  EXPECT_GT(sorted[0], sorted[1]);
+  EXPECT_GT(sorted[1], sorted[9]);
+
+  // the 10% most popular keys get more than half of the accesses
+  uint64_t top = 0;
+  for (uint64_t i = 0; i < n / 10; ++i) {
+    top += sorted[i];
+  }
+  EXPECT_GT(top, numSamples / 2);
+}
+
+TEST(KeyDistributionTest, zipfian_scatters_popular_keys) {
+  uint64_t const n = 1000;
+  KeyDistribution keys(KeyDistribution::Type::Zipfian, n, 0.99, 0.2, 0.8);
+  auto counts = sample(keys, n);
+
+  // the most popular key is the one with rank 0, which is not key 0
+  uint64_t const first = KeyDistribution::hash(0) % n;
+  EXPECT_EQ(first, static_cast<uint64_t>(
+                       std::max_element(counts.begin(), counts.end()) -
+                       counts.begin()));
+  EXPECT_EQ(first, keys.key(0.0, 0.0));
+  EXPECT_NE(0, first);
+}
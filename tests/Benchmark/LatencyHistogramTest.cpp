@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Benchmark/LatencyHistogram.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace arangodb::arangobench;
+
+namespace {
+
+double micros(uint64_t value) { return static_cast<double>(value) / 1.0e6; }
+
+}  // namespace
+
+TEST(LatencyHistogramTest, empty_histogram) {
+  LatencyHistogram h;
+  EXPECT_EQ(0, h.count());
+  EXPECT_EQ(0.0, h.min());
+  EXPECT_EQ(0.0, h.avg());
+  EXPECT_EQ(0.0, h.max());
+  EXPECT_EQ(0.0, h.percentile(50.0));
+  EXPECT_EQ(0.0, h.percentile(99.9));
+}
+
+TEST(LatencyHistogramTest, small_values_are_exact) {
+  LatencyHistogram h;
+  for (uint64_t i = 1; i <= 200; ++i) {
+    h.track(micros(i));
+  }
+  EXPECT_EQ(200, h.count());
+  EXPECT_DOUBLE_EQ(micros(1), h.min());
+  EXPECT_DOUBLE_EQ(micros(200), h.max());
+  EXPECT_NEAR(micros(100) + micros(1) / 2, h.avg(), 1.0e-9);
+  EXPECT_DOUBLE_EQ(micros(100), h.percentile(50.0));
+  EXPECT_DOUBLE_EQ(micros(198), h.percentile(99.0));
+  EXPECT_DOUBLE_EQ(micros(200), h.percentile(100.0));
+  EXPECT_DOUBLE_EQ(micros(1), h.percentile(0.0));
+}
+
+TEST(LatencyHistogramTest, relative_error_is_below_one_percent) {
+  for (uint64_t value = 1; value < LatencyHistogram::maxValue;
+       value = value * 3 + 7) {
+    LatencyHistogram h;
+    h.track(micros(value));
+    // a larger value, so that the percentile is not capped at the maximum
+    h.track(micros(LatencyHistogram::maxValue));
+
+    double p = h.percentile(50.0);
+    EXPECT_GE(p, micros(value)) << value;
+    EXPECT_LE(p, micros(value) * 1.01) << value;
+  }
+}
+
+TEST(LatencyHistogramTest, percentile_does_not_exceed_maximum) {
+  LatencyHistogram h;
+  h.track(micros(123457));
+  EXPECT_DOUBLE_EQ(micros(123457), h.percentile(50.0));
+  EXPECT_DOUBLE_EQ(micros(123457), h.percentile(100.0));
+}
+
+TEST(LatencyHistogramTest, out_of_range_values_are_clamped) {
+  LatencyHistogram h;
+  h.track(-1.0);
+  h.track(0.0);
+  EXPECT_EQ(0.0, h.min());
+  EXPECT_EQ(0.0, h.percentile(100.0));
+
+  h.track(1.0e9);
+  EXPECT_EQ(3, h.count());
+  EXPECT_DOUBLE_EQ(micros(LatencyHistogram::maxValue), h.max());
+  EXPECT_DOUBLE_EQ(micros(LatencyHistogram::maxValue), h.percentile(100.0));
+}
+
+TEST(LatencyHistogramTest, merged_histograms_equal_combined_one) {
+  LatencyHistogram a;
+  LatencyHistogram b;
+  LatencyHistogram combined;
+  for (uint64_t i = 0; i < 10000; ++i) {
+    double value = micros((i * 7919) % 100000 + 1);
+    (i % 3 == 0 ? a : b).track(value);
+    combined.track(value);
+  }
+
+  a.add(b);
+  EXPECT_EQ(combined.count(), a.count());
+  EXPECT_DOUBLE_EQ(combined.min(), a.min());
+  EXPECT_DOUBLE_EQ(combined.max(), a.max());
+  EXPECT_DOUBLE_EQ(combined.avg(), a.avg());
+  for (double p : {1.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+    EXPECT_DOUBLE_EQ(combined.percentile(p), a.percentile(p)) << p;
+  }
+
+  // merging an empty histogram changes nothing
+  a.add(LatencyHistogram());
+  EXPECT_EQ(combined.count(), a.count());
+  EXPECT_DOUBLE_EQ(combined.min(), a.min());
+}
+
+TEST(LatencyHistogramTest, velocypack_report) {
+  LatencyHistogram h;
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    h.track(micros(i * 100));
+  }
+
+  arangodb::velocypack::Builder builder;
+  h.toVelocyPack(builder, {50.0, 99.0});
+  auto slice = builder.slice();
+
+  ASSERT_TRUE(slice.isObject());
+  EXPECT_EQ(1000, slice.get("count").getUInt());
+  EXPECT_DOUBLE_EQ(h.min(), slice.get("min").getDouble());
+  EXPECT_DOUBLE_EQ(h.avg(), slice.get("avg").getDouble());
+  EXPECT_DOUBLE_EQ(h.max(), slice.get("max").getDouble());
+
+  auto percentiles = slice.get("percentiles");
+  ASSERT_TRUE(percentiles.isObject());
+  EXPECT_EQ(2, percentiles.length());
+
+  // buckets are ascending, non-empty and hold all recorded values
+  auto buckets = slice.get("buckets");
+  ASSERT_TRUE(buckets.isArray());
+  uint64_t total = 0;
+  uint64_t previous = 0;
+  for (auto bucket : arangodb::velocypack::ArrayIterator(buckets)) {
+    ASSERT_TRUE(bucket.isArray());
+    ASSERT_EQ(2, bucket.length());
+    uint64_t upper = bucket.at(0).getUInt();
+    uint64_t count = bucket.at(1).getUInt();
+    EXPECT_GT(count, 0);
+    EXPECT_GT(upper, previous);
+    previous = upper;
+    total += count;
+  }
+  EXPECT_EQ(1000, total);
+}
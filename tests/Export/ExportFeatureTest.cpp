@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Basics/FileUtils.h"
+#include "Basics/files.h"
+#include "Basics/system-functions.h"
+#include "Export/ExportFeature.h"
+#include "Utils/ManagedDirectory.h"
+#include "VelocypackUtils/VelocyPackStringLiteral.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+
+TEST(ExportFeatureTest, split_keys_every_step) {
+  auto batch = R"(["a", "b", "c", "d", "e", "f", "g", "h", "i", "j"])"_vpack;
+  std::vector<std::string> keys;
+  uint64_t position = 0;
+  EXPECT_TRUE(
+      ExportFeature::collectSplitKeys(batch.slice(), 3, 4, position, keys));
+  EXPECT_EQ((std::vector<std::string>{"c", "f", "i"}), keys);
+}
+
+TEST(ExportFeatureTest, split_keys_across_batches) {
+  auto first = R"(["a", "b", "c", "d"])"_vpack;
+  auto second = R"(["e", "f", "g"])"_vpack;
+  auto third = R"(["h", "i", "j"])"_vpack;
+  std::vector<std::string> keys;
+  uint64_t position = 0;
+  EXPECT_FALSE(
+      ExportFeature::collectSplitKeys(first.slice(), 3, 4, position, keys));
+  EXPECT_EQ(4, position);
+  EXPECT_FALSE(
+      ExportFeature::collectSplitKeys(second.slice(), 3, 4, position, keys));
+  EXPECT_TRUE(
+      ExportFeature::collectSplitKeys(third.slice(), 3, 4, position, keys));
+  EXPECT_EQ((std::vector<std::string>{"c", "f", "i"}), keys);
+}
+
+TEST(ExportFeatureTest, split_keys_stop_when_complete) {
+  auto batch = R"(["a", "b", "c", "d", "e", "f"])"_vpack;
+  std::vector<std::string> keys;
+  uint64_t position = 0;
+  EXPECT_TRUE(
+      ExportFeature::collectSplitKeys(batch.slice(), 2, 2, position, keys));
+  EXPECT_EQ((std::vector<std::string>{"b"}), keys);
+  // the remaining keys are not looked at
+  EXPECT_EQ(2, position);
+}
+
+TEST(ExportFeatureTest, split_keys_fewer_keys_than_parts) {
+  auto batch = R"(["a", "b", "c"])"_vpack;
+  std::vector<std::string> keys;
+  uint64_t position = 0;
+  EXPECT_FALSE(
+      ExportFeature::collectSplitKeys(batch.slice(), 2, 4, position, keys));
+  EXPECT_EQ((std::vector<std::string>{"b"}), keys);
+  EXPECT_EQ(3, position);
+}
+
+TEST(ExportFeatureTest, range_request_with_bounds) {
+  ExportFeature::ExportJob job;
+  job.collection = "test";
+  job.shard = "s1234";
+  job.lowerKey = "abc";
+  job.upperKey = "xyz";
+
+  VPackBuilder post;
+  ExportFeature::buildRangeRequest(post, job, 500);
+  VPackSlice slice = post.slice();
+
+  EXPECT_EQ(
+      "FOR doc IN @@collection FILTER doc._key >= @lower && doc._key < @upper "
+      "RETURN doc",
+      slice.get("query").copyString());
+  VPackSlice bindVars = slice.get("bindVars");
+  EXPECT_EQ("test", bindVars.get("@collection").copyString());
+  EXPECT_EQ("abc", bindVars.get("lower").copyString());
+  EXPECT_EQ("xyz", bindVars.get("upper").copyString());
+  EXPECT_EQ(500, slice.get("batchSize").getUInt());
+  VPackSlice options = slice.get("options");
+  EXPECT_TRUE(options.get("stream").isTrue());
+  VPackSlice shardIds = options.get("shardIds");
+  ASSERT_TRUE(shardIds.isArray());
+  ASSERT_EQ(1, shardIds.length());
+  EXPECT_EQ("s1234", shardIds.at(0).copyString());
+}
+
+TEST(ExportFeatureTest, range_request_with_one_bound) {
+  ExportFeature::ExportJob job;
+  job.collection = "test";
+
+  job.lowerKey = "abc";
+  VPackBuilder lower;
+  ExportFeature::buildRangeRequest(lower, job, 1000);
+  EXPECT_EQ("FOR doc IN @@collection FILTER doc._key >= @lower RETURN doc",
+            lower.slice().get("query").copyString());
+  EXPECT_TRUE(lower.slice().get("bindVars").hasKey("lower"));
+  EXPECT_FALSE(lower.slice().get("bindVars").hasKey("upper"));
+
+  job.lowerKey.clear();
+  job.upperKey = "xyz";
+  VPackBuilder upper;
+  ExportFeature::buildRangeRequest(upper, job, 1000);
+  EXPECT_EQ("FOR doc IN @@collection FILTER doc._key < @upper RETURN doc",
+            upper.slice().get("query").copyString());
+  EXPECT_FALSE(upper.slice().get("bindVars").hasKey("lower"));
+  EXPECT_TRUE(upper.slice().get("bindVars").hasKey("upper"));
+}
+
+TEST(ExportFeatureTest, range_request_without_bounds) {
+  ExportFeature::ExportJob job;
+  job.collection = "test";
+
+  VPackBuilder post;
+  ExportFeature::buildRangeRequest(post, job, 1000);
+  VPackSlice slice = post.slice();
+  EXPECT_EQ("FOR doc IN @@collection RETURN doc",
+            slice.get("query").copyString());
+  EXPECT_EQ(1, slice.get("bindVars").length());
+  // single server: the cursor is not restricted to a shard
+  EXPECT_FALSE(slice.get("options").hasKey("shardIds"));
+}
+
+class ExportFeaturePartsTest : public ::testing::Test {
+ protected:
+  ExportFeaturePartsTest()
+      : _path(basics::FileUtils::buildFilename(
+            TRI_GetTempPath(),
+            "arangotest-export-" +
+                std::to_string(static_cast<uint64_t>(TRI_microtime() * 1e6)))),
+        _directory(nullptr, _path, true, true, false) {}
+
+  ~ExportFeaturePartsTest() { TRI_RemoveDirectory(_path.c_str()); }
+
+  std::string merge(std::vector<std::string> const& parts,
+                    bool stripSeparator) {
+    auto out = _directory.writableFile("out", true, 0, false);
+    EXPECT_TRUE(out != nullptr && out->status().ok());
+    ExportFeature::appendParts(_directory, *out, parts, stripSeparator);
+    out.reset();
+    return _directory.slurpFile("out");
+  }
+
+  std::string const _path;
+  ManagedDirectory _directory;
+};
+
+TEST_F(ExportFeaturePartsTest, merges_parts_in_order) {
+  ASSERT_TRUE(_directory.status().ok());
+  _directory.spitFile("part0", ",\n  {\"_key\":\"a\"},\n  {\"_key\":\"b\"}");
+  _directory.spitFile("part1", ",\n  {\"_key\":\"c\"}");
+  _directory.spitFile("part2", ",\n  {\"_key\":\"d\"}");
+
+  EXPECT_EQ(
+      "\n  {\"_key\":\"a\"},\n  {\"_key\":\"b\"},\n  {\"_key\":\"c\"},\n"
+      "  {\"_key\":\"d\"}",
+      merge({"part0", "part1", "part2"}, true));
+
+  // the parts are removed
+  for (char const* part : {"part0", "part1", "part2"}) {
+    EXPECT_FALSE(TRI_ExistsFile(_directory.pathToFile(part).c_str())) << part;
+  }
+}
+
+TEST_F(ExportFeaturePartsTest, skips_empty_parts) {
+  ASSERT_TRUE(_directory.status().ok());
+  // the first range has no documents. the separator of the first document
+  // of the second range must be removed
+  _directory.spitFile("part0", "");
+  _directory.spitFile("part1", ",\n  {\"_key\":\"c\"}");
+  _directory.spitFile("part2", "");
+  _directory.spitFile("part3", ",\n  {\"_key\":\"d\"}");
+
+  EXPECT_EQ("\n  {\"_key\":\"c\"},\n  {\"_key\":\"d\"}",
+            merge({"part0", "part1", "part2", "part3"}, true));
+}
+
+TEST_F(ExportFeaturePartsTest, keeps_data_without_separators) {
+  ASSERT_TRUE(_directory.status().ok());
+  _directory.spitFile("part0", "{\"_key\":\"a\"}\n");
+  _directory.spitFile("part1", "{\"_key\":\"b\"}\n");
+
+  EXPECT_EQ("{\"_key\":\"a\"}\n{\"_key\":\"b\"}\n",
+            merge({"part0", "part1"}, false));
+}
+
+TEST_F(ExportFeaturePartsTest, fails_on_missing_part) {
+  ASSERT_TRUE(_directory.status().ok());
+  auto out = _directory.writableFile("out", true, 0, false);
+  ASSERT_TRUE(out != nullptr);
+  EXPECT_ANY_THROW(
+      ExportFeature::appendParts(_directory, *out, {"missing"}, true));
+}
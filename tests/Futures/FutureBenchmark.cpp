@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+// Microbenchmark for future chains. Not part of the test suite, build it
+// explicitly with `make arangodbbench_futures` and run it on an otherwise
+// idle machine:
+//
+//   arangodbbench_futures [iterations]
+
+#include "Futures/Future.h"
+#include "Futures/Utilities.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+using namespace arangodb::futures;
+
+namespace {
+
+// prevent the compiler from optimizing away results
+std::uint64_t sink = 0;
+
+template<typename F>
+void run(std::string_view name, std::uint64_t iterations, F&& fn) {
+  // warm up thread-local caches
+  for (std::uint64_t i = 0; i < iterations / 10; ++i) {
+    fn(i);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    fn(i);
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  std::cout << std::left << std::setw(40) << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(1)
+            << static_cast<double>(elapsed.count()) / iterations << " ns/op"
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::uint64_t iterations = 1'000'000;
+  if (argc > 1) {
+    iterations = std::strtoull(argv[1], nullptr, 10);
+  }
+
+  run("promise/future pair", iterations, [](std::uint64_t i) {
+    Promise<std::uint64_t> p;
+    auto f = p.getFuture();
+    p.setValue(i);
+    sink += f.get();
+  });
+
+  run("ready future, 5 x thenValue", iterations, [](std::uint64_t i) {
+    sink += makeFuture(i)
+                .thenValue([](std::uint64_t x) { return x + 1; })
+                .thenValue([](std::uint64_t x) { return x + 1; })
+                .thenValue([](std::uint64_t x) { return x + 1; })
+                .thenValue([](std::uint64_t x) { return x + 1; })
+                .thenValue([](std::uint64_t x) { return x + 1; })
+                .get();
+  });
+
+  run("ready future, thenValue returning future", iterations,
+      [](std::uint64_t i) {
+        sink += makeFuture(i)
+                    .thenValue([](std::uint64_t x) { return makeFuture(x + 1); })
+                    .get();
+      });
+
+  run("pending future, 5 x thenValue", iterations, [](std::uint64_t i) {
+    Promise<std::uint64_t> p;
+    auto f = p.getFuture()
+                 .thenValue([](std::uint64_t x) { return x + 1; })
+                 .thenValue([](std::uint64_t x) { return x + 1; })
+                 .thenValue([](std::uint64_t x) { return x + 1; })
+                 .thenValue([](std::uint64_t x) { return x + 1; })
+                 .thenValue([](std::uint64_t x) { return x + 1; });
+    p.setValue(i);
+    sink += f.get();
+  });
+
+  run("pending future, large capture", iterations, [](std::uint64_t i) {
+    Promise<std::uint64_t> p;
+    std::uint64_t a = i, b = i + 1, c = i + 2, d = i + 3;
+    auto f = p.getFuture().thenValue(
+        [a, b, c, d](std::uint64_t x) { return x + a + b + c + d; });
+    p.setValue(i);
+    sink += f.get();
+  });
+
+  // futures created on one thread and completed on another, as it happens
+  // for network responses
+  run("cross-thread completion (batch of 1000)", iterations / 1000,
+      [](std::uint64_t i) {
+        std::vector<Promise<std::uint64_t>> promises(1000);
+        std::vector<Future<std::uint64_t>> futures;
+        futures.reserve(promises.size());
+        for (auto& p : promises) {
+          futures.emplace_back(p.getFuture().thenValue(
+              [](std::uint64_t x) { return x + 1; }));
+        }
+        std::thread producer([&] {
+          for (auto& p : promises) {
+            p.setValue(i);
+          }
+          promises.clear();
+        });
+        producer.join();
+        for (auto& f : futures) {
+          sink += f.get();
+        }
+      });
+
+  return sink == 42 ? 1 : 0;
+}
@@ -830,3 +830,46 @@ TEST(FutureTest, basic_example_fpointer) {
   p.setValue(42);
   ASSERT_TRUE(f2.get() == 43);
 }
+
+TEST(FutureTest, continuation_on_ready_future_runs_inline) {
+  bool called = false;
+  auto f = makeFuture<int>(1)
+               .thenValue([&](int x) {
+                 called = true;
+                 return x + 1;
+               })
+               .then([](Try<int>&& t) { return t.get() + 1; })
+               .thenValue([](int x) { return makeFuture(x + 1); })
+               .thenError<std::exception>([](auto const&) { return 0; });
+  ASSERT_TRUE(called);
+  ASSERT_TRUE(f.isReady());
+  ASSERT_EQ(4, f.get());
+
+  auto f2 = makeFuture<int>(1)
+                .thenValue([](int) -> int { throw eggs; })
+                .thenValue([](int x) { return x + 1; });
+  ASSERT_TRUE(f2.isReady());
+  ASSERT_TRUE(f2.hasException());
+  ASSERT_THROW(f2.get(), eggs_t);
+
+  auto f3 = makeFuture<int>(1).thenValue(
+      [](int) { return Future<int>::makeEmpty(); });
+  ASSERT_TRUE(f3.isReady());
+  ASSERT_THROW(f3.get(), FutureException);
+}
+
+TEST(FutureTest, shared_state_allocations_are_recycled) {
+  using detail::SharedStateAllocator;
+
+  void* p = SharedStateAllocator::allocate(40);
+  std::size_t cached = SharedStateAllocator::cachedBlocks();
+  SharedStateAllocator::deallocate(p, 40);
+  if (SharedStateAllocator::cachedBlocks() == cached) {
+    GTEST_SKIP() << "shared state pooling is disabled in this build";
+  }
+  // same size class
+  void* q = SharedStateAllocator::allocate(64);
+  ASSERT_EQ(p, q);
+  ASSERT_EQ(cached, SharedStateAllocator::cachedBlocks());
+  SharedStateAllocator::deallocate(q, 64);
+}
@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+// Microbenchmark for loading replication2 agency types with the inspection
+// framework, both from VelocyPack (as done for network messages and agency
+// reads on coordinators/DB servers) and from agency nodes (as done by the
+// supervision). Not part of the test suite, build it explicitly with
+// `make arangodbbench_inspection` and run it on an otherwise idle machine:
+//
+//   arangodbbench_inspection [iterations]
+
+#include "Agency/Node.h"
+#include "Agency/NodeDeserialization.h"
+#include "Inspection/VPack.h"
+#include "Replication2/ReplicatedLog/AgencyLogSpecification.h"
+#include "Replication2/ReplicatedLog/AgencySpecificationInspectors.h"
+#include "Replication2/ReplicatedLog/LogCommon.h"
+
+#include <velocypack/Builder.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+using namespace arangodb;
+using namespace arangodb::replication2;
+using namespace arangodb::replication2::agency;
+
+namespace {
+
+// prevent the compiler from optimizing away results
+std::uint64_t sink = 0;
+
+template<typename F>
+void run(std::string_view name, std::uint64_t iterations, F&& fn) {
+  for (std::uint64_t i = 0; i < iterations / 10; ++i) {
+    fn();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::uint64_t i = 0; i < iterations; ++i) {
+    fn();
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  std::cout << std::left << std::setw(40) << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(1)
+            << static_cast<double>(elapsed.count()) / iterations << " ns/op"
+            << std::endl;
+}
+
+auto makeLog() -> Log {
+  ParticipantsFlagsMap participants;
+  for (auto const& p : {"PRMR-1", "PRMR-2", "PRMR-3", "PRMR-4", "PRMR-5"}) {
+    participants.emplace(p, ParticipantFlags{});
+  }
+
+  auto target = LogTarget(LogId{12345}, participants,
+                          LogTargetConfig(3, 3, true));
+  target.leader = "PRMR-1";
+
+  auto participantsConfig = ParticipantsConfig{
+      .generation = 17, .participants = participants, .config = {3, true}};
+
+  auto plan = LogPlanSpecification(
+      LogId{12345},
+      LogPlanTermSpecification(LogTerm{8},
+                               ServerInstanceReference{"PRMR-1", RebootId{3}}),
+      participantsConfig);
+  plan.owner = "target";
+
+  auto current = LogCurrent();
+  for (auto const& [p, flags] : participants) {
+    current.localState.emplace(
+        p, LogCurrentLocalState(LogTerm{8},
+                                TermIndexPair{LogTerm{8}, LogIndex{1000}},
+                                true));
+  }
+  current.leader =
+      LogCurrent::Leader{.serverId = "PRMR-1",
+                         .term = LogTerm{8},
+                         .committedParticipantsConfig = participantsConfig,
+                         .leadershipEstablished = true,
+                         .commitStatus = std::nullopt};
+
+  return Log{.target = std::move(target),
+             .plan = std::move(plan),
+             .current = std::move(current)};
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::uint64_t iterations = 100'000;
+  if (argc > 1) {
+    iterations = std::strtoull(argv[1], nullptr, 10);
+  }
+
+  auto log = makeLog();
+
+  velocypack::Builder planBuilder;
+  velocypack::serialize(planBuilder, *log.plan);
+  velocypack::Builder targetBuilder;
+  velocypack::serialize(targetBuilder, log.target);
+  velocypack::Builder currentBuilder;
+  velocypack::serialize(currentBuilder, *log.current);
+  velocypack::Builder logBuilder;
+  velocypack::serialize(logBuilder, log);
+
+  run("LogPlanSpecification from VPack", iterations, [&] {
+    auto plan =
+        velocypack::deserialize<LogPlanSpecification>(planBuilder.slice());
+    sink += plan.participantsConfig.generation;
+  });
+
+  run("LogTarget from VPack", iterations, [&] {
+    auto target = velocypack::deserialize<LogTarget>(targetBuilder.slice());
+    sink += target.participants.size();
+  });
+
+  run("LogCurrent from VPack", iterations, [&] {
+    auto current = velocypack::deserialize<LogCurrent>(currentBuilder.slice());
+    sink += current.localState.size();
+  });
+
+  run("Log from VPack", iterations, [&] {
+    auto l = velocypack::deserialize<Log>(logBuilder.slice());
+    sink += l.target.participants.size();
+  });
+
+  consensus::Node node{""};
+  node.applies(logBuilder.slice());
+
+  run("Log from agency node", iterations, [&] {
+    auto l = consensus::deserialize<Log>(node);
+    sink += l.target.participants.size();
+  });
+
+  return sink == 42 ? 1 : 0;
+}
@@ -741,6 +741,79 @@ TEST_F(VPackLoadInspectorTest, error_found_unexpected_attribute) {
   EXPECT_EQ("Found unexpected attribute 'should_not_be_here'", result.error());
 }
 
+TEST_F(VPackLoadInspectorTest, load_object_with_attributes_in_any_order) {
+  builder.openObject();
+  builder.add("s", VPackValue("foobar"));
+  builder.add("b", VPackValue(true));
+  builder.add("i", VPackValue(42));
+  builder.add("d", VPackValue(123.456));
+  builder.close();
+  VPackLoadInspector inspector{builder};
+
+  Dummy d{};
+  auto result = inspector.apply(d);
+  ASSERT_TRUE(result.ok()) << "Error: " << result.error()
+                           << "\nPath: " << result.path();
+  EXPECT_EQ(42, d.i);
+  EXPECT_EQ(123.456, d.d);
+  EXPECT_EQ(true, d.b);
+  EXPECT_EQ("foobar", d.s);
+}
+
+TEST_F(VPackLoadInspectorTest, load_object_with_many_attributes) {
+  builder.openObject();
+  for (int i = 0; i < 40; ++i) {
+    builder.add(std::to_string(i), VPackValue(i));
+  }
+  builder.add("i", VPackValue(42));
+  builder.close();
+  VPackLoadInspector inspector{builder, {.ignoreUnknownFields = true}};
+
+  Container c;
+  auto result = inspector.apply(c);
+  ASSERT_TRUE(result.ok()) << "Error: " << result.error()
+                           << "\nPath: " << result.path();
+  EXPECT_EQ(42, c.i.value);
+}
+
+TEST_F(VPackLoadInspectorTest, load_object_with_duplicate_attribute) {
+  // the first occurrence of a repeated attribute is used, even if it comes
+  // before the position of the previous match
+  builder.openObject();
+  builder.add("s", VPackValue("first"));
+  builder.add("i", VPackValue(42));
+  builder.add("d", VPackValue(123.456));
+  builder.add("b", VPackValue(true));
+  builder.add("s", VPackValue("second"));
+  builder.close();
+  VPackLoadInspector inspector{builder};
+
+  Dummy d{};
+  auto result = inspector.apply(d);
+  ASSERT_TRUE(result.ok()) << "Error: " << result.error()
+                           << "\nPath: " << result.path();
+  EXPECT_EQ(42, d.i);
+  EXPECT_EQ("first", d.s);
+}
+
+TEST_F(VPackLoadInspectorTest,
+       load_object_with_many_attributes_and_duplicate_attribute) {
+  builder.openObject();
+  builder.add("i", VPackValue(42));
+  for (int i = 0; i < 40; ++i) {
+    builder.add(std::to_string(i), VPackValue(i));
+  }
+  builder.add("i", VPackValue(43));
+  builder.close();
+  VPackLoadInspector inspector{builder, {.ignoreUnknownFields = true}};
+
+  Container c;
+  auto result = inspector.apply(c);
+  ASSERT_TRUE(result.ok()) << "Error: " << result.error()
+                           << "\nPath: " << result.path();
+  EXPECT_EQ(42, c.i.value);
+}
+
 TEST_F(VPackLoadInspectorTest, load_object_ignoring_unknown_attributes) {
   builder.openObject();
   builder.add("i", VPackValue(42));
@@ -28,6 +28,7 @@
 #include "Metrics/Counter.h"
 #include "Metrics/Gauge.h"
 #include "Metrics/Histogram.h"
+#include "Metrics/ShardedGauge.h"
 #include "Metrics/LinScale.h"
 #include "Metrics/LogScale.h"
 #include "Basics/ThreadGuard.h"
@@ -522,6 +523,93 @@ TEST(MetricsTest, test_gauge_operations_double) {
   }
 }
 
+TEST(MetricsTest, test_sharded_gauge_concurrency) {
+  ShardedGauge<uint64_t> g(0, "gauge", "Gauge", "");
+
+  ASSERT_EQ(g.load(), 0);
+
+  std::atomic<bool> go = false;
+
+  auto threads = ThreadGuard(2 * ::numThreads);
+
+  // half of the threads increase the value, the other half decrease it
+  // again. on their own, the shards of the decreasing threads wrap around
+  for (size_t i = 0; i < 2 * ::numThreads; ++i) {
+    threads.emplace(
+        [&](bool increase) {
+          while (!go.load()) {
+            // wait until all threads are created, so they can
+            // start at the approximate same time
+          }
+          for (uint64_t i = 0; i < ::numOpsPerThread / 10; ++i) {
+            if (increase) {
+              ++g;
+              g += 2;
+            } else {
+              --g;
+            }
+          }
+        },
+        i % 2 == 0);
+  }
+
+  go.store(true);
+
+  threads.joinAll();
+
+  ASSERT_EQ(g.load(), 2 * ::numThreads * ::numOpsPerThread / 10);
+
+  std::string s;
+  g.toPrometheus(s, "");
+  ASSERT_EQ(s, "gauge{}" + std::to_string(g.load()) + "\n");
+}
+
+TEST(MetricsTest, test_sharded_gauge_double) {
+  ShardedGauge<double> g(1.5, "gauge", "Gauge", "");
+
+  ASSERT_DOUBLE_EQ(1.5, g.load());
+  g += 2.5;
+  ASSERT_DOUBLE_EQ(4.0, g.load());
+  g -= 5.0;
+  ASSERT_DOUBLE_EQ(-1.0, g.load());
+  ++g;
+  ASSERT_DOUBLE_EQ(0.0, g.load());
+}
+
+TEST(MetricsTest, test_histogram_sum_concurrency) {
+  LinScale scale(0, 100, 10);
+  Histogram h(scale, "histogram", "Histogram", "");
+
+  std::atomic<bool> go = false;
+
+  auto threads = ThreadGuard(::numThreads);
+
+  for (size_t i = 0; i < ::numThreads; ++i) {
+    threads.emplace(
+        [&](int value) {
+          while (!go.load()) {
+            // wait until all threads are created, so they can
+            // start at the approximate same time
+          }
+          for (uint64_t i = 0; i < ::numOpsPerThread / 10; ++i) {
+            h.count(value);
+          }
+        },
+        static_cast<int>(i * 10));
+  }
+
+  go.store(true);
+
+  threads.joinAll();
+
+  int expected = 0;
+  for (size_t i = 0; i < ::numThreads; ++i) {
+    ASSERT_EQ(h.load(i), ::numOpsPerThread / 10);
+    expected += static_cast<int>(i * 10 * ::numOpsPerThread / 10);
+  }
+  ASSERT_EQ(h.loadSum(), expected);
+}
+
 template<typename Scale>
 void histogram_test(Scale const& scale) {
   using T = typename Scale::Value;
@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "RestHandler/ImportBodyReader.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace arangodb;
+
+namespace {
+char const* findValueEnd(std::string_view value) {
+  return ImportBodyReader::findValueEnd(value.data(),
+                                        value.data() + value.size());
+}
+
+// reads all documents of body and returns their texts, or "<status>" for
+// everything that is not a document
+std::vector<std::string> readAll(std::string_view body, bool linewise) {
+  std::vector<std::string> result;
+  ImportBodyReader reader(body, linewise);
+  if (!reader.start()) {
+    result.emplace_back("<start>");
+    return result;
+  }
+  velocypack::Builder builder;
+  while (true) {
+    auto status = reader.next(builder);
+    if (status == ImportBodyReader::Status::kEnd) {
+      break;
+    }
+    if (status == ImportBodyReader::Status::kDocument) {
+      result.emplace_back(builder.slice().toJson());
+    } else if (status == ImportBodyReader::Status::kEmpty) {
+      result.emplace_back("<empty>");
+    } else if (status == ImportBodyReader::Status::kInvalid) {
+      result.emplace_back("<invalid>");
+    } else {
+      result.emplace_back("<malformed>");
+      break;
+    }
+  }
+  return result;
+}
+}  // namespace
+
+TEST(ImportBodyReaderTest, test_find_value_end) {
+  std::string_view value = R"({"a":[1,{"b":2}]},{"c":3})";
+  EXPECT_EQ(value.data() + 17, findValueEnd(value));
+
+  value = "[1,2,3] ,4";
+  EXPECT_EQ(value.data() + 7, findValueEnd(value));
+
+  value = "12345, 6";
+  EXPECT_EQ(value.data() + 5, findValueEnd(value));
+
+  value = "true]";
+  EXPECT_EQ(value.data() + 4, findValueEnd(value));
+
+  // a scalar at the end of the data ends there
+  value = "null";
+  EXPECT_EQ(value.data() + 4, findValueEnd(value));
+}
+
+TEST(ImportBodyReaderTest, test_find_value_end_delimiters_in_strings) {
+  std::string_view value = R"({"a":"x,]} [{"},"b")";
+  EXPECT_EQ(value.data() + 15, findValueEnd(value));
+
+  value = R"("a, b]"],1)";
+  EXPECT_EQ(value.data() + 7, findValueEnd(value));
+}
+
+TEST(ImportBodyReaderTest, test_find_value_end_escaped_quotes) {
+  std::string_view value = R"("a\"b,c\"",1)";
+  EXPECT_EQ(value.data() + 10, findValueEnd(value));
+
+  // an escaped backslash does not escape the closing quote
+  value = R"({"a":"\\"},1)";
+  EXPECT_EQ(value.data() + 10, findValueEnd(value));
+
+  value = R"({"a\"}":"\"]"},1)";
+  EXPECT_EQ(value.data() + 14, findValueEnd(value));
+}
+
+TEST(ImportBodyReaderTest, test_find_value_end_split_values) {
+  // a value that is cut off at any position inside of it is incomplete
+  std::vector<std::string_view> values = {
+      R"({"a":"b\"c","d":[1,{"e":"]"}]})",
+      R"(["x\\",{"y":"\""},[]])",
+      R"("some \"quoted\" text")",
+  };
+  for (auto value : values) {
+    for (size_t length = 1; length < value.size(); ++length) {
+      EXPECT_EQ(nullptr, ImportBodyReader::findValueEnd(
+                             value.data(), value.data() + length))
+          << value.substr(0, length);
+    }
+    EXPECT_EQ(value.data() + value.size(), findValueEnd(value));
+  }
+}
+
+TEST(ImportBodyReaderTest, test_read_array) {
+  auto docs = readAll(R"( [ {"a":"x,]"} , {"b":"\"}"},
+      {"c":[1,2]} ] )",
+                      false);
+  std::vector<std::string> expected = {R"({"a":"x,]"})", R"({"b":"\"}"})",
+                                       R"({"c":[1,2]})"};
+  EXPECT_EQ(expected, docs);
+
+  EXPECT_EQ(std::vector<std::string>{}, readAll("[]", false));
+  EXPECT_EQ(std::vector<std::string>{"<start>"}, readAll("{}", false));
+}
+
+TEST(ImportBodyReaderTest, test_read_array_invalid_document) {
+  auto docs = readAll(R"([{"a":1},{"a":tru},{"a":2}])", false);
+  std::vector<std::string> expected = {R"({"a":1})", "<invalid>",
+                                       R"({"a":2})"};
+  EXPECT_EQ(expected, docs);
+}
+
+TEST(ImportBodyReaderTest, test_read_array_truncated_final_value) {
+  std::vector<std::string> const expected = {R"({"a":1})", "<malformed>"};
+  EXPECT_EQ(expected, readAll(R"([{"a":1},{"a":)", false));
+  EXPECT_EQ(expected, readAll(R"([{"a":1},{"a":"b)", false));
+  EXPECT_EQ(expected, readAll(R"([{"a":1},{"a":"b\)", false));
+  EXPECT_EQ(expected, readAll(R"([{"a":1},{"a":2})", false));
+
+  // a truncated scalar is malformed too, because the array is not closed
+  std::vector<std::string> const numbers = {"1", "<malformed>"};
+  EXPECT_EQ(numbers, readAll("[1,23", false));
+}
+
+TEST(ImportBodyReaderTest, test_read_lines) {
+  auto docs = readAll("{\"a\":\"x\\n\"}\n\n  {\"b\":[1,\n2]}\n{\"c\":3}", true);
+  std::vector<std::string> expected = {R"({"a":"x\n"})", "<empty>",
+                                       "<invalid>", "<invalid>",
+                                       R"({"c":3})"};
+  EXPECT_EQ(expected, docs);
+}
+
+TEST(ImportBodyReaderTest, test_read_lines_truncated_final_value) {
+  auto docs = readAll("{\"a\":1}\n{\"a\":\"b", true);
+  std::vector<std::string> expected = {R"({"a":1})", "<invalid>"};
+  EXPECT_EQ(expected, docs);
+}
@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include "Basics/FileUtils.h"
+#include "Basics/files.h"
+#include "Basics/system-functions.h"
+#include "Restore/RestoreFeature.h"
+#include "Utils/ManagedDirectory.h"
+
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+
+namespace {
+
+class RestoreStreamsTest : public ::testing::Test {
+ protected:
+  RestoreStreamsTest()
+      : _path(basics::FileUtils::buildFilename(
+            TRI_GetTempPath(),
+            "arangotest-restore-" +
+                std::to_string(static_cast<uint64_t>(TRI_microtime() * 1e6)))),
+        _directory(nullptr, _path, true, true, false) {}
+
+  ~RestoreStreamsTest() { TRI_RemoveDirectory(_path.c_str()); }
+
+  void writeData(std::string const& data) {
+    _data = data;
+    basics::FileUtils::spit(basics::FileUtils::buildFilename(_path, _filename),
+                            data);
+  }
+
+  std::vector<size_t> boundaries(size_t begin, uint32_t streams) {
+    return RestoreFeature::findStreamBoundaries(_directory, _filename, begin,
+                                                _data.size(), streams);
+  }
+
+  // every range must start at the start of a line
+  void checkBoundaries(std::vector<size_t> const& boundaries, size_t begin) {
+    ASSERT_FALSE(boundaries.empty());
+    EXPECT_EQ(begin, boundaries.front());
+    for (size_t i = 1; i < boundaries.size(); ++i) {
+      ASSERT_LT(boundaries[i - 1], boundaries[i]);
+      ASSERT_LT(boundaries[i], _data.size());
+      EXPECT_EQ('\n', _data[boundaries[i] - 1]) << boundaries[i];
+    }
+  }
+
+  std::string const _path;
+  std::string const _filename = "test.data.json";
+  ManagedDirectory _directory;
+  std::string _data;
+};
+
+std::string lines(size_t count, size_t length) {
+  std::string result;
+  for (size_t i = 0; i < count; ++i) {
+    result.append(length - 1, static_cast<char>('a' + i % 26));
+    result.push_back('\n');
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST_F(RestoreStreamsTest, splits_at_line_boundaries) {
+  ASSERT_TRUE(_directory.status().ok());
+  writeData(lines(1000, 100));
+
+  auto result = boundaries(0, 4);
+  checkBoundaries(result, 0);
+  // the nominal range starts are at multiples of 25000, which are all line
+  // starts
+  EXPECT_EQ((std::vector<size_t>{0, 25000, 50000, 75000}), result);
+}
+
+TEST_F(RestoreStreamsTest, moves_boundaries_to_next_line) {
+  ASSERT_TRUE(_directory.status().ok());
+  writeData(lines(1000, 30));
+
+  auto result = boundaries(0, 7);
+  checkBoundaries(result, 0);
+  ASSERT_EQ(7, result.size());
+  size_t const rangeSize = _data.size() / 7;
+  for (size_t i = 1; i < result.size(); ++i) {
+    // a boundary is at most one line behind the nominal range start
+    EXPECT_GE(result[i], i * rangeSize);
+    EXPECT_LT(result[i], i * rangeSize + 30);
+  }
+}
+
+TEST_F(RestoreStreamsTest, starts_at_resume_offset) {
+  ASSERT_TRUE(_directory.status().ok());
+  writeData(lines(1000, 50));
+
+  auto result = boundaries(10000, 5);
+  checkBoundaries(result, 10000);
+  EXPECT_EQ((std::vector<size_t>{10000, 18000, 26000, 34000, 42000}), result);
+}
+
+TEST_F(RestoreStreamsTest, long_lines_reduce_number_of_ranges) {
+  ASSERT_TRUE(_directory.status().ok());
+  // one line spanning the first four nominal range starts
+  std::string data(7999, 'x');
+  data.push_back('\n');
+  data.append(lines(20, 100));
+  writeData(data);
+
+  auto result = boundaries(0, 5);
+  checkBoundaries(result, 0);
+  EXPECT_EQ((std::vector<size_t>{0, 8000}), result);
+}
+
+TEST_F(RestoreStreamsTest, no_line_break_after_range_start) {
+  ASSERT_TRUE(_directory.status().ok());
+  // the last line has no line break, and covers the second half
+  std::string data = lines(10, 100);
+  data.append(std::string(1000, 'x'));
+  writeData(data);
+
+  auto result = boundaries(0, 4);
+  checkBoundaries(result, 0);
+  EXPECT_EQ((std::vector<size_t>{0, 500, 1000}), result);
+}
+
+TEST_F(RestoreStreamsTest, single_stream) {
+  ASSERT_TRUE(_directory.status().ok());
+  writeData(lines(100, 10));
+
+  EXPECT_EQ((std::vector<size_t>{0}), boundaries(0, 1));
+}
+
+TEST(RestoreResumeOffsetTest, lowest_pending_offset) {
+  std::map<size_t, size_t> readOffsets;
+  std::map<size_t, size_t> streamOffsets;
+  EXPECT_EQ(std::numeric_limits<size_t>::max(),
+            RestoreFeature::resumeOffset(readOffsets, streamOffsets));
+
+  // chunks sent, but not yet acknowledged
+  readOffsets = {{300, 100}, {100, 200}};
+  EXPECT_EQ(100, RestoreFeature::resumeOffset(readOffsets, streamOffsets));
+
+  // streams that have dispatched everything up to 700 and 5000. the
+  // resume offset must not be behind data that was not read yet
+  streamOffsets = {{0, 700}, {4000, 5000}};
+  EXPECT_EQ(100, RestoreFeature::resumeOffset(readOffsets, streamOffsets));
+
+  readOffsets.clear();
+  EXPECT_EQ(700, RestoreFeature::resumeOffset(readOffsets, streamOffsets));
+
+  // a stream that has not dispatched anything yet
+  streamOffsets.emplace(2000, 2000);
+  readOffsets = {{3000, 100}};
+  EXPECT_EQ(700, RestoreFeature::resumeOffset(readOffsets, streamOffsets));
+  streamOffsets.erase(0);
+  EXPECT_EQ(2000, RestoreFeature::resumeOffset(readOffsets, streamOffsets));
+}
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include "Restore/RestoreFeature.h"
+#include "VelocypackUtils/VelocyPackStringLiteral.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <initializer_list>
+#include <string>
+
+using namespace arangodb;
+
+namespace {
+
+// documents written one after the other, as in a binary dump
+std::string concat(std::initializer_list<VPackSlice> documents) {
+  std::string result;
+  for (auto const& doc : documents) {
+    result.append(reinterpret_cast<char const*>(doc.start()),
+                  doc.byteSize());
+  }
+  return result;
+}
+
+size_t completeDocuments(std::string const& data, size_t chunkSize) {
+  return RestoreFeature::completeDocuments(
+      reinterpret_cast<uint8_t const*>(data.data()), data.size(), chunkSize);
+}
+
+}  // namespace
+
+TEST(RestoreVPackDataTest, empty_data) {
+  EXPECT_EQ(0, completeDocuments(std::string(), 1000));
+}
+
+TEST(RestoreVPackDataTest, takes_all_documents_up_to_chunk_size) {
+  auto a = R"({"_key": "a", "value": 1})"_vpack;
+  auto b = R"({"_key": "b", "value": [1, 2, 3]})"_vpack;
+  auto c = R"({"_key": "c"})"_vpack;
+  std::string data = concat({a.slice(), b.slice(), c.slice()});
+
+  EXPECT_EQ(data.size(), completeDocuments(data, data.size()));
+  EXPECT_EQ(data.size(), completeDocuments(data, 1000000));
+
+  // a chunk ends at the last document that fits completely
+  size_t const ab = a.slice().byteSize() + b.slice().byteSize();
+  EXPECT_EQ(ab, completeDocuments(data, ab));
+  EXPECT_EQ(ab, completeDocuments(data, data.size() - 1));
+  EXPECT_EQ(a.slice().byteSize(), completeDocuments(data, ab - 1));
+}
+
+TEST(RestoreVPackDataTest, first_document_larger_than_chunk_size) {
+  auto a = R"({"_key": "a", "value": "some longer string value"})"_vpack;
+  auto b = R"({"_key": "b"})"_vpack;
+  std::string data = concat({a.slice(), b.slice()});
+
+  // a chunk holds at least one document
+  EXPECT_EQ(a.slice().byteSize(), completeDocuments(data, 1));
+}
+
+TEST(RestoreVPackDataTest, stops_at_partial_document) {
+  auto a = R"({"_key": "a", "value": 1})"_vpack;
+  auto b = R"({"_key": "b", "value": 2})"_vpack;
+  std::string data = concat({a.slice(), b.slice()});
+
+  for (size_t cut = 1; cut < b.slice().byteSize(); ++cut) {
+    std::string partial = data.substr(0, data.size() - cut);
+    EXPECT_EQ(a.slice().byteSize(), completeDocuments(partial, 1000000))
+        << cut;
+  }
+  EXPECT_EQ(0, completeDocuments(data.substr(0, 1), 1000000));
+}
+
+TEST(RestoreVPackDataTest, stops_at_partial_header) {
+  auto a = R"({"_key": "a"})"_vpack;
+
+  // a document large enough to have a byte length of 4 bytes, and a long
+  // string with a length of 8 bytes. a chunk boundary may cut right
+  // through these lengths
+  VPackBuilder large;
+  large.openObject();
+  large.add("value", VPackValue(std::string(70000, 'x')));
+  large.close();
+  VPackBuilder longString;
+  longString.add(VPackValue(std::string(300, 'x')));
+
+  for (VPackSlice second : {large.slice(), longString.slice()}) {
+    std::string data = concat({a.slice(), second});
+    for (size_t keep = 1; keep < 10; ++keep) {
+      std::string partial = data.substr(0, a.slice().byteSize() + keep);
+      EXPECT_EQ(a.slice().byteSize(), completeDocuments(partial, 1000000))
+          << keep;
+      EXPECT_EQ(0, completeDocuments(partial.substr(a.slice().byteSize()),
+                                     1000000))
+          << keep;
+    }
+    EXPECT_EQ(data.size(), completeDocuments(data, 1000000));
+  }
+}
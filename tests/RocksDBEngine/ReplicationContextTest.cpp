@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RocksDBEngine/RocksDBReplicationContext.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace arangodb;
+
+namespace {
+
+using DumpRange = RocksDBReplicationContext::DumpRange;
+using PrefetchHandoff = RocksDBReplicationContext::PrefetchHandoff;
+
+// checks that the ranges are non-empty, disjoint and together cover all
+// document ids
+void checkRanges(uint64_t first, uint64_t last, uint64_t count) {
+  std::vector<std::pair<uint64_t, uint64_t>> ranges;
+  for (uint64_t i = 0; i < count; ++i) {
+    ranges.push_back(RocksDBReplicationContext::documentIdRange(
+        first, last, DumpRange{i, count}));
+  }
+
+  ASSERT_EQ(0, ranges.front().first);
+  ASSERT_EQ(UINT64_MAX, ranges.back().second);
+  for (std::size_t i = 1; i < ranges.size(); ++i) {
+    auto const& prev = ranges[i - 1];
+    auto const& cur = ranges[i];
+    ASSERT_LE(prev.first, prev.second) << "range " << i - 1;
+    ASSERT_EQ(prev.second + 1, cur.first) << "range " << i;
+  }
+}
+
+}  // namespace
+
+TEST(RocksDBReplicationContextTest, test_single_range_covers_everything) {
+  auto [lower, upper] =
+      RocksDBReplicationContext::documentIdRange(100, 200, DumpRange{0, 1});
+  EXPECT_EQ(0, lower);
+  EXPECT_EQ(UINT64_MAX, upper);
+}
+
+TEST(RocksDBReplicationContextTest, test_ranges_have_equal_width) {
+  // ids 1000 to 1999, split into 4 ranges of 250 ids each
+  auto r0 =
+      RocksDBReplicationContext::documentIdRange(1000, 1999, DumpRange{0, 4});
+  auto r1 =
+      RocksDBReplicationContext::documentIdRange(1000, 1999, DumpRange{1, 4});
+  auto r2 =
+      RocksDBReplicationContext::documentIdRange(1000, 1999, DumpRange{2, 4});
+  auto r3 =
+      RocksDBReplicationContext::documentIdRange(1000, 1999, DumpRange{3, 4});
+
+  EXPECT_EQ(0, r0.first);
+  EXPECT_EQ(1249, r0.second);
+  EXPECT_EQ(1250, r1.first);
+  EXPECT_EQ(1499, r1.second);
+  EXPECT_EQ(1500, r2.first);
+  EXPECT_EQ(1749, r2.second);
+  EXPECT_EQ(1750, r3.first);
+  EXPECT_EQ(UINT64_MAX, r3.second);
+}
+
+TEST(RocksDBReplicationContextTest, test_ranges_are_disjoint_and_complete) {
+  for (uint64_t count : {2, 3, 4, 7, 16}) {
+    checkRanges(1, 1000, count);
+    checkRanges(12345, 12345 + 999999, count);
+    checkRanges(0, UINT64_MAX - 1, count);
+  }
+}
+
+TEST(RocksDBReplicationContextTest, test_single_document) {
+  // only the first range contains the document
+  uint64_t const id = 4711;
+  for (uint64_t count : {2, 5}) {
+    std::size_t hits = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+      auto [lower, upper] = RocksDBReplicationContext::documentIdRange(
+          id, id, DumpRange{i, count});
+      if (lower <= id && id <= upper) {
+        ++hits;
+        EXPECT_EQ(0, i);
+      }
+    }
+    EXPECT_EQ(1, hits);
+    checkRanges(id, id, count);
+  }
+}
+
+TEST(RocksDBReplicationContextTest, test_more_ranges_than_documents) {
+  // 3 consecutive ids, split into 8 ranges
+  uint64_t const first = 500;
+  uint64_t const last = 502;
+  uint64_t const count = 8;
+  for (uint64_t id = first; id <= last; ++id) {
+    std::size_t hits = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+      auto [lower, upper] = RocksDBReplicationContext::documentIdRange(
+          first, last, DumpRange{i, count});
+      if (lower <= id && id <= upper) {
+        ++hits;
+      }
+    }
+    EXPECT_EQ(1, hits) << "id " << id;
+  }
+  checkRanges(first, last, count);
+}
+
+TEST(RocksDBReplicationContextTest, test_prefetch_claimed_before_start) {
+  PrefetchHandoff handoff;
+  // the request comes in before a scheduler thread picked up the prefetch.
+  // the request must not wait, and the prefetch must not run anymore
+  EXPECT_FALSE(handoff.claim());
+  EXPECT_FALSE(handoff.start());
+}
+
+TEST(RocksDBReplicationContextTest, test_prefetch_claimed_after_finish) {
+  PrefetchHandoff handoff;
+  ASSERT_TRUE(handoff.start());
+  handoff.finish();
+  EXPECT_TRUE(handoff.claim());
+}
+
+TEST(RocksDBReplicationContextTest, test_prefetch_claim_waits_for_finish) {
+  PrefetchHandoff handoff;
+  ASSERT_TRUE(handoff.start());
+
+  std::atomic<bool> finished{false};
+  std::thread prefetcher([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    finished.store(true);
+    handoff.finish();
+  });
+
+  EXPECT_TRUE(handoff.claim());
+  EXPECT_TRUE(finished.load());
+  prefetcher.join();
+}
+
+TEST(RocksDBReplicationContextTest, test_prefetch_races_with_claim) {
+  // whatever the interleaving, either the prefetch runs and the request
+  // waits for it, or the prefetch is skipped and the request produces the
+  // batch itself
+  for (int i = 0; i < 1000; ++i) {
+    PrefetchHandoff handoff;
+    std::atomic<bool> ran{false};
+    std::thread prefetcher([&]() {
+      if (handoff.start()) {
+        ran.store(true);
+        handoff.finish();
+      }
+    });
+
+    bool claimed = handoff.claim();
+    EXPECT_EQ(claimed, ran.load());
+    prefetcher.join();
+    EXPECT_EQ(claimed, ran.load());
+  }
+}
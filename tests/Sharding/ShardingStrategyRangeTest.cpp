@@ -0,0 +1,303 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+
+#include "Aql/Ast.h"
+#include "Aql/AstNode.h"
+#include "Aql/Query.h"
+#include "Aql/VariableGenerator.h"
+#include "Mocks/Servers.h"
+#include "Sharding/ShardingStrategyRange.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/Slice.h>
+
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+size_t shardIndex(std::string_view splitPoints, std::string_view value) {
+  auto sp = velocypack::Parser::fromJson(splitPoints);
+  auto v = velocypack::Parser::fromJson(value);
+  return ShardingStrategyRange::shardIndex(sp->slice(), v->slice());
+}
+
+Result validate(std::string_view splitPoints, size_t numberOfShards) {
+  auto sp = velocypack::Parser::fromJson(splitPoints);
+  return ShardingStrategyRange::validateSplitPoints(sp->slice(),
+                                                    numberOfShards);
+}
+}  // namespace
+
+TEST(ShardingStrategyRangeTest, shardIndexNumbers) {
+  EXPECT_EQ(0, shardIndex("[10, 20, 30]", "-5"));
+  EXPECT_EQ(0, shardIndex("[10, 20, 30]", "9.5"));
+  EXPECT_EQ(1, shardIndex("[10, 20, 30]", "10"));
+  EXPECT_EQ(1, shardIndex("[10, 20, 30]", "19"));
+  EXPECT_EQ(2, shardIndex("[10, 20, 30]", "20"));
+  EXPECT_EQ(3, shardIndex("[10, 20, 30]", "30"));
+  EXPECT_EQ(3, shardIndex("[10, 20, 30]", "1000"));
+}
+
+TEST(ShardingStrategyRangeTest, shardIndexUsesAqlOrder) {
+  // null and booleans sort before numbers, strings after them
+  EXPECT_EQ(0, shardIndex("[10, 20]", "null"));
+  EXPECT_EQ(0, shardIndex("[10, 20]", "true"));
+  EXPECT_EQ(2, shardIndex("[10, 20]", "\"abc\""));
+
+  EXPECT_EQ(0, shardIndex("[\"g\", \"p\"]", "\"abc\""));
+  EXPECT_EQ(1, shardIndex("[\"g\", \"p\"]", "\"g\""));
+  EXPECT_EQ(1, shardIndex("[\"g\", \"p\"]", "\"oz\""));
+  EXPECT_EQ(2, shardIndex("[\"g\", \"p\"]", "\"z\""));
+  EXPECT_EQ(0, shardIndex("[\"g\", \"p\"]", "99"));
+}
+
+TEST(ShardingStrategyRangeTest, shardIndexSingleShard) {
+  EXPECT_EQ(0, shardIndex("[]", "1"));
+  EXPECT_EQ(0, shardIndex("[]", "\"abc\""));
+}
+
+TEST(ShardingStrategyRangeTest, validateSplitPoints) {
+  EXPECT_TRUE(validate("[10, 20, 30]", 4).ok());
+  EXPECT_TRUE(validate("[\"a\", \"b\"]", 3).ok());
+  EXPECT_TRUE(validate("[]", 1).ok());
+  EXPECT_TRUE(validate("[null, 5, \"x\"]", 4).ok());
+
+  EXPECT_EQ(TRI_ERROR_BAD_PARAMETER, validate("{}", 2).errorNumber());
+  EXPECT_EQ(TRI_ERROR_BAD_PARAMETER, validate("[10, 20]", 4).errorNumber());
+  EXPECT_EQ(TRI_ERROR_BAD_PARAMETER, validate("[10, 20]", 0).errorNumber());
+  EXPECT_EQ(TRI_ERROR_BAD_PARAMETER, validate("[20, 10]", 3).errorNumber());
+  EXPECT_EQ(TRI_ERROR_BAD_PARAMETER, validate("[10, 10]", 3).errorNumber());
+  EXPECT_EQ(TRI_ERROR_BAD_PARAMETER, validate("[\"a\", 1]", 3).errorNumber());
+}
+
+namespace {
+/// @brief conditions on a collection with the split points [10, 20, 30],
+/// i.e. four shards
+class ShardRangeFinderTest : public ::testing::Test {
+ protected:
+  ShardRangeFinderTest()
+      : _query(_server.createFakeQuery()),
+        _ast(_query->ast()),
+        _doc(_ast->variables()->createTemporaryVariable()),
+        _splitPoints(velocypack::Parser::fromJson("[10, 20, 30]")) {}
+
+  AstNode* attribute(std::string_view name, Variable const* variable) {
+    return _ast->createNodeAttributeAccess(
+        _ast->createNodeReference(variable), name);
+  }
+
+  AstNode* compare(AstNodeType type, int64_t value) {
+    return _ast->createNodeBinaryOperator(type, attribute("value", _doc),
+                                          _ast->createNodeValueInt(value));
+  }
+
+  AstNode* in(std::vector<int64_t> const& values) {
+    AstNode* array = _ast->createNodeArray();
+    for (int64_t value : values) {
+      array->addMember(_ast->createNodeValueInt(value));
+    }
+    return _ast->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_IN,
+                                          attribute("value", _doc), array);
+  }
+
+  AstNode* logical(AstNodeType type, AstNode* lhs, AstNode* rhs) {
+    return _ast->createNodeBinaryOperator(type, lhs, rhs);
+  }
+
+  std::vector<bool> find(AstNode const* condition) {
+    ShardRangeFinder finder(_doc, "value", _splitPoints->slice());
+    return finder.find(condition);
+  }
+
+  tests::mocks::MockAqlServer _server;
+  std::shared_ptr<Query> _query;
+  Ast* _ast;
+  Variable const* _doc;
+  std::shared_ptr<velocypack::Builder> _splitPoints;
+};
+
+using Shards = std::vector<bool>;
+}  // namespace
+
+TEST_F(ShardRangeFinderTest, comparisons) {
+  EXPECT_EQ((Shards{true, false, false, false}),
+            find(compare(NODE_TYPE_OPERATOR_BINARY_EQ, 5)));
+  EXPECT_EQ((Shards{false, false, true, false}),
+            find(compare(NODE_TYPE_OPERATOR_BINARY_EQ, 25)));
+  EXPECT_EQ((Shards{true, true, false, false}),
+            find(compare(NODE_TYPE_OPERATOR_BINARY_LT, 15)));
+  EXPECT_EQ((Shards{true, true, false, false}),
+            find(compare(NODE_TYPE_OPERATOR_BINARY_LE, 15)));
+  EXPECT_EQ((Shards{false, true, true, true}),
+            find(compare(NODE_TYPE_OPERATOR_BINARY_GE, 15)));
+  EXPECT_EQ((Shards{false, false, false, true}),
+            find(compare(NODE_TYPE_OPERATOR_BINARY_GT, 35)));
+  EXPECT_EQ((Shards{true, false, false, false}),
+            find(compare(NODE_TYPE_OPERATOR_BINARY_LT, 0)));
+
+  // reversed comparison, i.e. 15 > doc.value
+  EXPECT_EQ((Shards{true, true, false, false}),
+            find(_ast->createNodeBinaryOperator(
+                NODE_TYPE_OPERATOR_BINARY_GT, _ast->createNodeValueInt(15),
+                attribute("value", _doc))));
+}
+
+TEST_F(ShardRangeFinderTest, valueEqualToSplitPoint) {
+  // the split point 20 is the lowest value of the third shard
+  EXPECT_EQ((Shards{false, false, true, false}),
+            find(compare(NODE_TYPE_OPERATOR_BINARY_EQ, 20)));
+  EXPECT_EQ((Shards{true, true, false, false}),
+            find(compare(NODE_TYPE_OPERATOR_BINARY_LT, 20)));
+  EXPECT_EQ((Shards{true, true, true, false}),
+            find(compare(NODE_TYPE_OPERATOR_BINARY_LE, 20)));
+  EXPECT_EQ((Shards{false, false, true, true}),
+            find(compare(NODE_TYPE_OPERATOR_BINARY_GE, 20)));
+  EXPECT_EQ((Shards{false, false, true, true}),
+            find(compare(NODE_TYPE_OPERATOR_BINARY_GT, 20)));
+  EXPECT_EQ((Shards{false, true, false, false}), find(in({10, 19})));
+}
+
+TEST_F(ShardRangeFinderTest, inLists) {
+  EXPECT_EQ((Shards{true, false, false, true}), find(in({5, 35, 3})));
+  EXPECT_EQ((Shards{false, true, true, false}), find(in({20, 10})));
+  // no document can match an empty list
+  EXPECT_EQ((Shards{false, false, false, false}), find(in({})));
+}
+
+TEST_F(ShardRangeFinderTest, logicalOperators) {
+  EXPECT_EQ((Shards{true, false, false, true}),
+            find(logical(NODE_TYPE_OPERATOR_BINARY_OR,
+                         compare(NODE_TYPE_OPERATOR_BINARY_EQ, 5),
+                         compare(NODE_TYPE_OPERATOR_BINARY_GE, 30))));
+  EXPECT_EQ((Shards{false, true, false, false}),
+            find(logical(NODE_TYPE_OPERATOR_BINARY_AND,
+                         compare(NODE_TYPE_OPERATOR_BINARY_GE, 10),
+                         compare(NODE_TYPE_OPERATOR_BINARY_LT, 20))));
+  EXPECT_EQ((Shards{true, false, true, false}),
+            find(logical(NODE_TYPE_OPERATOR_BINARY_OR, in({}),
+                         logical(NODE_TYPE_OPERATOR_BINARY_OR,
+                                 compare(NODE_TYPE_OPERATOR_BINARY_EQ, 1),
+                                 compare(NODE_TYPE_OPERATOR_BINARY_EQ, 21)))));
+
+  // an OR with a condition that cannot be analyzed matches all shards
+  AstNode* other = _ast->createNodeBinaryOperator(
+      NODE_TYPE_OPERATOR_BINARY_EQ, attribute("other", _doc),
+      _ast->createNodeValueInt(5));
+  EXPECT_EQ((Shards{true, true, true, true}),
+            find(logical(NODE_TYPE_OPERATOR_BINARY_OR,
+                         compare(NODE_TYPE_OPERATOR_BINARY_EQ, 5), other)));
+  EXPECT_EQ((Shards{true, false, false, false}),
+            find(logical(NODE_TYPE_OPERATOR_BINARY_AND,
+                         compare(NODE_TYPE_OPERATOR_BINARY_EQ, 5), other)));
+}
+
+TEST_F(ShardRangeFinderTest, conditionsThatCannotBeAnalyzed) {
+  Shards const all{true, true, true, true};
+  EXPECT_EQ(all, find(nullptr));
+  // other attributes and other variables
+  EXPECT_EQ(all, find(_ast->createNodeBinaryOperator(
+                     NODE_TYPE_OPERATOR_BINARY_EQ, attribute("other", _doc),
+                     _ast->createNodeValueInt(5))));
+  Variable const* other = _ast->variables()->createTemporaryVariable();
+  EXPECT_EQ(all, find(_ast->createNodeBinaryOperator(
+                     NODE_TYPE_OPERATOR_BINARY_EQ, attribute("value", other),
+                     _ast->createNodeValueInt(5))));
+  // comparisons with values that are not constant
+  EXPECT_EQ(all, find(_ast->createNodeBinaryOperator(
+                     NODE_TYPE_OPERATOR_BINARY_LT, attribute("value", _doc),
+                     attribute("value", other))));
+  EXPECT_EQ(all,
+            find(logical(NODE_TYPE_OPERATOR_BINARY_AND,
+                         compare(NODE_TYPE_OPERATOR_BINARY_NE, 5),
+                         compare(NODE_TYPE_OPERATOR_BINARY_GE, 0))));
+}
+
+TEST(ShardingStrategyRangeTest, restrictionsSameCollectionAccessedTwice) {
+  // two accesses of the same collection in one snippet get one shard set
+  ShardRangeRestrictions restrictions;
+  restrictions.add("100", {true, false, false, false});
+  restrictions.add("100", {false, false, true, false});
+  EXPECT_EQ((std::vector<size_t>{0, 2}), restrictions.shardIndexes("100"));
+}
+
+TEST(ShardingStrategyRangeTest, restrictionsCoLocatedCollections) {
+  // collections distributed like the same prototype are restricted to the
+  // same shard indexes, other groups independently
+  ShardRangeRestrictions restrictions;
+  restrictions.add("100", {false, true, false});
+  restrictions.add("100", {false, false, true});
+  restrictions.add("200", {true, false, false});
+  EXPECT_EQ((std::vector<size_t>{1, 2}), restrictions.shardIndexes("100"));
+  EXPECT_EQ((std::vector<size_t>{0}), restrictions.shardIndexes("200"));
+}
+
+TEST(ShardingStrategyRangeTest, restrictionsExcludedGroup) {
+  // a group with one access that needs all shards is not restricted at all
+  ShardRangeRestrictions restrictions;
+  restrictions.add("100", {true, false, false});
+  restrictions.exclude("100");
+  restrictions.exclude("200");
+  restrictions.add("200", {true, false, false});
+  restrictions.add("300", {true, false, false});
+  restrictions.add("300", {true, false});
+  EXPECT_TRUE(restrictions.shardIndexes("100").empty());
+  EXPECT_TRUE(restrictions.shardIndexes("200").empty());
+  EXPECT_TRUE(restrictions.shardIndexes("300").empty());
+}
+
+TEST(ShardingStrategyRangeTest, restrictionsAllOrNoShards) {
+  ShardRangeRestrictions restrictions;
+  restrictions.add("100", {true, false});
+  restrictions.add("100", {false, true});
+  restrictions.add("200", {false, false});
+  // all shards can match, so there is nothing to restrict
+  EXPECT_TRUE(restrictions.shardIndexes("100").empty());
+  // no shard can match, but the accesses still need to run on one shard
+  EXPECT_EQ((std::vector<size_t>{0}), restrictions.shardIndexes("200"));
+  EXPECT_TRUE(restrictions.shardIndexes("300").empty());
+}
+
+TEST(ShardingStrategyRangeTest, restrictionsCoLocatedCollectionModified) {
+  // a snippet reads from one collection and writes into a collection
+  // distributed like it. the rule sees the modification first, as it walks
+  // the snippet upwards from its end. the write may need all shards, so
+  // the read must not be restricted either, as the shards are paired
+  ShardRangeRestrictions restrictions;
+  restrictions.exclude("100");
+  restrictions.add("100", {false, true, false});
+  restrictions.add("200", {false, true, false});
+  EXPECT_TRUE(restrictions.shardIndexes("100").empty());
+  EXPECT_EQ((std::vector<size_t>{1}), restrictions.shardIndexes("200"));
+
+  // the same if the modification comes after the read in walking order
+  ShardRangeRestrictions reversed;
+  reversed.add("100", {false, true, false});
+  reversed.exclude("100");
+  EXPECT_TRUE(reversed.shardIndexes("100").empty());
+}
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "VocBase/CompiledSchema.h"
+
+#include "gtest/gtest.h"
+
+#include <tao/json/contrib/schema.hpp>
+#include <validation/validation.hpp>
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/Slice.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace arangodb;
+
+namespace {
+
+std::vector<std::string> const documents = {
+    R"({})",
+    R"({"a":1})",
+    R"({"a":11})",
+    R"({"a":-1})",
+    R"({"a":1.0})",
+    R"({"a":2.5})",
+    R"({"a":2.0})",
+    R"({"a":null})",
+    R"({"a":1,"b":"xy"})",
+    R"({"a":1,"b":"y"})",
+    R"({"a":1,"b":"xyzzz"})",
+    R"({"a":1,"b":"xää"})",
+    R"({"a":1,"z":true})",
+    R"({"a":1,"z":true,"q":false})",
+    R"({"a":1,"z":1})",
+    R"({"a":{"c":[1]}})",
+    R"({"a":{"c":1}})",
+    R"({"_key":"abc","n":{}})",
+    R"({"_key":"abc","n":{"_id":"x/abc"}})",
+    R"([])",
+    R"([1])",
+    R"([1,"x",null])",
+    R"([1,2])",
+    R"([1,1,1,1])",
+    R"("str")",
+    R"(3)",
+    R"(6)",
+    R"(7)",
+    R"(8)",
+    R"(5.5)",
+    R"(-1)",
+    R"(-1.5)",
+    R"(-6)",
+    R"(18446744073709551615)",
+    R"(-9223372036854775808)",
+    R"(null)",
+    R"(true)",
+};
+
+void expectSameAsGeneric(std::string const& schemaJson) {
+  auto schema = velocypack::Parser::fromJson(schemaJson);
+  tao::json::schema generic(validation::slice_to_value(schema->slice()));
+  auto compiled = CompiledSchema::compile(schema->slice());
+  ASSERT_NE(nullptr, compiled) << schemaJson;
+
+  for (auto const& json : documents) {
+    auto document = velocypack::Parser::fromJson(json);
+    bool expected =
+        validation::validate(generic, validation::SpecialProperties::None,
+                             document->slice(), &velocypack::Options::Defaults);
+    auto outcome = compiled->validate(document->slice());
+    ASSERT_NE(CompiledSchema::Outcome::kUnsupported, outcome);
+    EXPECT_EQ(expected, outcome == CompiledSchema::Outcome::kValid)
+        << schemaJson << " / " << json;
+  }
+}
+
+}  // namespace
+
+TEST(CompiledSchemaTest, typesAndNumbers) {
+  expectSameAsGeneric(
+      R"({"type":"object","properties":{"a":{"type":"integer","minimum":0,)"
+      R"("maximum":10}},"required":["a"]})");
+  expectSameAsGeneric(
+      R"({"properties":{"a":{"type":["number","null"],"minimum":1.5,)"
+      R"("exclusiveMinimum":true,"multipleOf":0.5}}})");
+  expectSameAsGeneric(R"({"maximum":18446744073709551615,"minimum":-3})");
+  expectSameAsGeneric(R"({"type":"integer","multipleOf":3})");
+  expectSameAsGeneric(R"({"enum":[1,"str",null,true]})");
+}
+
+TEST(CompiledSchemaTest, strings) {
+  expectSameAsGeneric(
+      R"({"properties":{"b":{"type":"string","minLength":2,"maxLength":4,)"
+      R"("pattern":"^x"}}})");
+}
+
+TEST(CompiledSchemaTest, arraysAndObjects) {
+  expectSameAsGeneric(
+      R"({"type":"array","items":{"enum":[1,"x",null]},"minItems":1,)"
+      R"("maxItems":3})");
+  expectSameAsGeneric(
+      R"({"required":["a","z"],"additionalProperties":{"type":"boolean"}})");
+  expectSameAsGeneric(
+      R"({"properties":{"a":{"type":"integer"}},)"
+      R"("additionalProperties":false})");
+  expectSameAsGeneric(
+      R"({"minProperties":1,"maxProperties":2,"properties":{"a":)"
+      R"({"properties":{"c":{"type":"array"}},"required":["c"]}}})");
+}
+
+TEST(CompiledSchemaTest, systemAttributesAreInvisible) {
+  expectSameAsGeneric(
+      R"({"properties":{"_key":{"type":"integer"},"n":{"type":"object",)"
+      R"("required":["_id"]}},"maxProperties":1})");
+}
+
+TEST(CompiledSchemaTest, combinators) {
+  expectSameAsGeneric(R"({"anyOf":[{"type":"string"},{"multipleOf":3}]})");
+  expectSameAsGeneric(
+      R"({"oneOf":[{"type":"number","minimum":5},{"type":"integer",)"
+      R"("maximum":7}]})");
+  expectSameAsGeneric(
+      R"({"not":{"type":"object"},"allOf":[{"maximum":-1,)"
+      R"("exclusiveMaximum":true},{"minimum":-5}]})");
+}
+
+TEST(CompiledSchemaTest, unsupportedKeywords) {
+  for (auto const& json : std::vector<std::string>{
+           R"({"properties":{"a":{"format":"email"}}})",
+           R"({"patternProperties":{"^a":{"type":"string"}}})",
+           R"({"dependencies":{"a":["b"]}})",
+           R"({"uniqueItems":true})",
+           R"({"items":[{"type":"string"}]})",
+           R"({"enum":[{"a":1}]})",
+       }) {
+    auto schema = velocypack::Parser::fromJson(json);
+    EXPECT_EQ(nullptr, CompiledSchema::compile(schema->slice())) << json;
+  }
+}
@@ -1007,3 +1007,43 @@ TEST_F(ComputedValuesTest, insertKeepNullTrue) {
                      })
                   .ok());
 }
+
+TEST_F(ComputedValuesTest, insertBatch) {
+  auto& vocbase = server->getSystemDatabase();
+  auto b = velocypack::Parser::fromJson(
+      "{\"name\":\"test\", \"computedValues\": [{\"name\":\"sum\", "
+      "\"expression\":\"RETURN @doc.a + @doc.b\", \"overwrite\": true}, "
+      "{\"name\":\"key\", \"expression\":\"RETURN @doc._key\", "
+      "\"overwrite\": false}]}");
+
+  auto c = vocbase.createCollection(b->slice());
+  ASSERT_NE(nullptr, c->computedValues());
+
+  std::vector<std::string> const EMPTY;
+  std::vector<std::string> collections{"test"};
+  transaction::Methods trx(transaction::StandaloneContext::Create(vocbase),
+                           EMPTY, collections, EMPTY, transaction::Options());
+
+  EXPECT_TRUE(trx.begin().ok());
+  auto docs = velocypack::Parser::fromJson(
+      "[{\"_key\":\"test1\", \"a\":1, \"b\":2}, "
+      "{\"_key\":\"test2\", \"a\":3, \"b\":4, \"sum\":0}, "
+      "{\"_key\":\"test3\", \"a\":5, \"b\":6, \"key\":\"abc\"}]");
+  auto res = trx.insert("test", docs->slice(), OperationOptions());
+  EXPECT_TRUE(res.ok());
+  EXPECT_TRUE(res.countErrorCodes.empty());
+
+  auto check = [&](std::string_view key, int sum, std::string_view k) {
+    EXPECT_TRUE(trx.documentFastPathLocal(
+                       "test", key,
+                       [&](LocalDocumentId const&, velocypack::Slice doc) {
+                         EXPECT_EQ(sum, doc.get("sum").getNumber<int>());
+                         EXPECT_EQ(k, doc.get("key").stringView());
+                         return true;
+                       })
+                    .ok());
+  };
+  check("test1", 3, "test1");
+  check("test2", 7, "test2");
+  check("test3", 11, "abc");
+}
@@ -286,7 +286,8 @@ TEST_F(PlanCollectionUserAPITest, test_shardingStrategy) {
                                              "enterprise-hash-smart-edge",
                                              "community-compat",
                                              "enterprise-compat",
-                                             "enterprise-smart-edge-compat"};
+                                             "enterprise-smart-edge-compat",
+                                             "range"};
 
   for (auto const& strategy : allowedStrategies) {
     shouldBeEvaluatedTo(
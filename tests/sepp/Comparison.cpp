@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Comparison.h"
+
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <velocypack/Iterator.h>
+
+namespace {
+
+using Key = std::pair<std::string, std::uint64_t>;
+
+// returns the latest result for each benchmark name and number of threads
+std::map<Key, arangodb::velocypack::Slice> latestResults(
+    arangodb::velocypack::Slice reports) {
+  if (!reports.isArray()) {
+    throw std::runtime_error("report file must contain an array of results");
+  }
+
+  std::map<Key, arangodb::velocypack::Slice> results;
+  for (auto report : arangodb::velocypack::ArrayIterator(reports)) {
+    // results written before the introduction of the schema version lack
+    // the name and the number of threads, and cannot be matched
+    if (!report.isObject() || !report.get("schemaVersion").isNumber()) {
+      continue;
+    }
+    Key key{report.get("name").copyString(),
+            report.get("numThreads").getNumber<std::uint64_t>()};
+    auto it = results.find(key);
+    if (it == results.end() ||
+        it->second.get("timestamp").getNumber<std::int64_t>() <=
+            report.get("timestamp").getNumber<std::int64_t>()) {
+      results.insert_or_assign(std::move(key), report);
+    }
+  }
+  return results;
+}
+
+double relativeChange(double baseline, double current) {
+  return baseline == 0.0 ? 0.0 : (current - baseline) / baseline;
+}
+
+}  // namespace
+
+namespace arangodb::sepp {
+
+std::size_t Comparison::run(velocypack::Slice baseline,
+                            velocypack::Slice current,
+                            std::ostream& out) const {
+  auto baselineResults = latestResults(baseline);
+  auto currentResults = latestResults(current);
+
+  std::size_t regressions = 0;
+  out << std::left << std::setw(32) << "benchmark" << std::right
+      << std::setw(8) << "threads" << std::setw(14) << "baseline"
+      << std::setw(14) << "current" << std::setw(10) << "change"
+      << std::setw(10) << "size" << "\n";
+  for (auto const& [key, result] : currentResults) {
+    auto it = baselineResults.find(key);
+    if (it == baselineResults.end()) {
+      out << std::left << std::setw(32) << key.first << std::right
+          << std::setw(8) << key.second << "  (no baseline)\n";
+      continue;
+    }
+
+    double baseThroughput = it->second.get("throughput").getNumber<double>();
+    double throughput = result.get("throughput").getNumber<double>();
+    double throughputChange = relativeChange(baseThroughput, throughput);
+    double sizeChange = relativeChange(
+        it->second.get("databaseSize").getNumber<double>(),
+        result.get("databaseSize").getNumber<double>());
+
+    bool regression = throughputChange < -tolerance || sizeChange > tolerance;
+    if (regression) {
+      ++regressions;
+    }
+
+    out << std::left << std::setw(32) << key.first << std::right
+        << std::setw(8) << key.second << std::fixed << std::setprecision(2)
+        << std::setw(14) << baseThroughput << std::setw(14) << throughput
+        << std::showpos << std::setw(9) << (throughputChange * 100) << "%"
+        << std::setw(9) << (sizeChange * 100) << "%" << std::noshowpos
+        << std::defaultfloat << (regression ? "  REGRESSION" : "") << "\n";
+  }
+
+  out << regressions << " regression(s) with a tolerance of "
+      << (tolerance * 100) << "%" << std::endl;
+  return regressions;
+}
+
+}  // namespace arangodb::sepp
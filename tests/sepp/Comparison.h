@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+
+#include <velocypack/Slice.h>
+
+namespace arangodb::sepp {
+
+/// @brief Compares the results in a report file against the results in a
+/// baseline report file. Results are matched by the name of the benchmark and
+/// the number of threads; if a report file contains several results for the
+/// same benchmark, the latest one is used. A result is flagged as regression
+/// if its throughput is lower than the baseline throughput by more than the
+/// tolerance, or if its database size is larger than the baseline size by
+/// more than the tolerance.
+struct Comparison {
+  // relative tolerance, e.g. 0.05 for 5%
+  double tolerance{0.05};
+
+  /// @brief Prints the comparison of all matching results and returns the
+  /// number of regressions.
+  std::size_t run(velocypack::Slice baseline, velocypack::Slice current,
+                  std::ostream& out) const;
+};
+
+}  // namespace arangodb::sepp
@@ -136,7 +136,9 @@ Report Execution::buildReport(double runtime) {
     threadReports.push_back(thread->report());
   }
 
-  Report report{.timestamp = {},
+  Report report{.name = {},
+                .workload = {},
+                .timestamp = {},
                 .config = {},
                 .configBuilder = {},
                 .threads = std::move(threadReports),
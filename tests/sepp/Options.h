@@ -33,9 +33,13 @@
 
 #include "Inspection/Types.h"
 #include "Inspection/VPackLoadInspector.h"
+#include "Workloads/AqlQuery.h"
+#include "Workloads/EdgeExpansion.h"
 #include "Workloads/GetByPrimaryKey.h"
+#include "Workloads/IndexLookup.h"
 #include "Workloads/InsertDocuments.h"
 #include "Workloads/IterateDocuments.h"
+#include "Workloads/TtlDeletion.h"
 #include "Workloads/WriteWriteConflict.h"
 
 namespace arangodb::sepp {
@@ -79,7 +83,9 @@ auto inspect(Inspector& f, Setup& o) {
 
 using WorkloadVariants = std::variant<
     workloads::WriteWriteConflict::Options, workloads::GetByPrimaryKey::Options,
-    workloads::InsertDocuments::Options, workloads::IterateDocuments::Options>;
+    workloads::InsertDocuments::Options, workloads::IterateDocuments::Options,
+    workloads::IndexLookup::Options, workloads::EdgeExpansion::Options,
+    workloads::AqlQuery::Options, workloads::TtlDeletion::Options>;
 namespace workloads {
 // this inspect function must be in namespace workloads for ADL to pick it up
 template<class Inspector>
@@ -89,11 +95,19 @@ inline auto inspect(Inspector& f, WorkloadVariants& o) {
       insp::type<workloads::WriteWriteConflict::Options>("writeWriteConflict"),
       insp::type<workloads::GetByPrimaryKey::Options>("getByPrimaryKey"),
       insp::type<workloads::InsertDocuments::Options>("insert"),
-      insp::type<workloads::IterateDocuments::Options>("iterate"));
+      insp::type<workloads::IterateDocuments::Options>("iterate"),
+      insp::type<workloads::IndexLookup::Options>("indexLookup"),
+      insp::type<workloads::EdgeExpansion::Options>("edgeExpansion"),
+      insp::type<workloads::AqlQuery::Options>("aql"),
+      insp::type<workloads::TtlDeletion::Options>("ttlDeletion"));
 }
 }  // namespace workloads
 
 struct Options {
+  // name of the benchmark, used to match results when comparing reports.
+  // defaults to the name of the workload
+  std::string name;
+
   std::string databaseDirectory;
   bool clearDatabaseDirectory{true};
 
@@ -101,12 +115,17 @@ struct Options {
 
   WorkloadVariants workload;
 
+  // if set, the workload is run once for each of these thread counts (in
+  // the same database), overriding the number of threads of the workload
+  std::vector<std::uint32_t> threadSweep;
+
   RocksDBOptions rocksdb;
 };
 
 template<class Inspector>
 auto inspect(Inspector& f, Options& o) {
   return f.object(o).fields(
+      f.field("name", o.name).fallback(f.keep()),  //
       f.field("databaseDirectory", o.databaseDirectory)
           .fallback(basics::FileUtils::buildFilename(
               TRI_GetTempPath(),
@@ -115,6 +134,7 @@ auto inspect(Inspector& f, Options& o) {
           .fallback(true),
       f.field("setup", o.setup).fallback(f.keep()),        //
       f.field("workload", o.workload).fallback(f.keep()),  //
+      f.field("threadSweep", o.threadSweep).fallback(f.keep()),
       f.field("rocksdb", o.rocksdb).fallback(f.keep()));
 }
 
@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
 #include <vector>
 #include "velocypack/SliceContainer.h"
 
@@ -31,7 +33,8 @@
 namespace arangodb::sepp {
 
 struct ThreadReport {
-  // a velocypack value containing arbitrary result data for this thread (TODO)
+  // a velocypack value containing arbitrary result data for this thread, may
+  // be empty
   velocypack::Builder data;
   // total number of operations performed by this thread
   std::uint64_t operations;
@@ -39,14 +42,23 @@ struct ThreadReport {
 
 template<class Inspector>
 auto inspect(Inspector& f, ThreadReport& o) {
-  // auto data = o.data.slice();
-  return f.object(o).fields(
-      // TODO - workloads need to actually provide data
-      // f.field("data", data),
-      f.field("operations", o.operations));
+  // data is only reported for workloads that provide it
+  std::optional<velocypack::Slice> data;
+  if (!o.data.isEmpty()) {
+    data = o.data.slice();
+  }
+  return f.object(o).fields(f.field("data", data),
+                            f.field("operations", o.operations));
 }
 
 struct Report {
+  // version of the report format, to be increased on incompatible changes
+  static constexpr std::uint32_t kSchemaVersion = 1;
+
+  std::uint32_t schemaVersion{kSchemaVersion};
+  // name of the benchmark and of its workload type
+  std::string name;
+  std::string workload;
   std::int64_t timestamp;
   // TODO - rocksdb statistics
   velocypack::Slice config;
@@ -64,6 +76,10 @@ struct Report {
     return result;
   }
 
+  [[nodiscard]] std::uint32_t numThreads() const {
+    return static_cast<std::uint32_t>(threads.size());
+  }
+
   [[nodiscard]] double throughput() const {
     if (runtime == 0) {
       return 0.0;
@@ -74,13 +90,18 @@ struct Report {
 
 template<class Inspector>
 auto inspect(Inspector& f, Report& o) {
-  return f.object(o).fields(f.field("timestamp", o.timestamp),        //
-                            f.field("config", o.config),              //
-                            f.field("threads", o.threads),            //
-                            f.field("runtime", o.runtime),            //
-                            f.field("databaseSize", o.databaseSize),  //
-                            f.field("operations", o.operations()),    //
-                            f.field("throughput", o.throughput()));
+  return f.object(o).fields(
+      f.field("schemaVersion", o.schemaVersion),  //
+      f.field("name", o.name),                    //
+      f.field("workload", o.workload),            //
+      f.field("timestamp", o.timestamp),          //
+      f.field("config", o.config),                //
+      f.field("threads", o.threads),              //
+      f.field("numThreads", o.numThreads()),      //
+      f.field("runtime", o.runtime),              //
+      f.field("databaseSize", o.databaseSize),    //
+      f.field("operations", o.operations()),      //
+      f.field("throughput", o.throughput()));
 }
 
 }  // namespace arangodb::sepp
@@ -23,8 +23,10 @@
 
 #include "Runner.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <numeric>
 #include <memory>
@@ -35,9 +37,13 @@
 #include "Basics/overload.h"
 #include "Execution.h"
 #include "Server.h"
+#include "Workloads/AqlQuery.h"
+#include "Workloads/EdgeExpansion.h"
 #include "Workloads/GetByPrimaryKey.h"
+#include "Workloads/IndexLookup.h"
 #include "Workloads/InsertDocuments.h"
 #include "Workloads/IterateDocuments.h"
+#include "Workloads/TtlDeletion.h"
 #include "Workloads/WriteWriteConflict.h"
 #include "velocypack/Collection.h"
 #include "velocypack/Parser.h"
@@ -73,19 +79,57 @@ Runner::Runner(std::string_view executable, std::string_view reportFile,
 Runner::~Runner() = default;
 
 void Runner::run() {
-  auto report = runBenchmark();
-  printSummary(report);
-  writeReport(report);
+  auto reports = runBenchmark();
+  for (auto const& report : reports) {
+    printSummary(report);
+  }
+  if (reports.size() > 1) {
+    printScaling(reports);
+  }
+  writeReports(reports);
 }
 
-auto Runner::runBenchmark() -> Report {
+auto Runner::runBenchmark() -> std::vector<Report> {
   auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
       std::chrono::system_clock::now().time_since_epoch());
 
+  // the name of the workload is the attribute name of its options
+  velocypack::Builder workloadBuilder;
+  velocypack::serialize(workloadBuilder, _options.workload);
+  std::string workloadName = workloadBuilder.slice().keyAt(0).copyString();
+
   startServer();
   setup();
 
-  std::cout << "Running benchmark...\n";
+  std::vector<Report> reports;
+  if (_options.threadSweep.empty()) {
+    std::cout << "Running benchmark...\n";
+    reports.emplace_back(runWorkload());
+  } else {
+    reports.reserve(_options.threadSweep.size());
+    for (auto threads : _options.threadSweep) {
+      std::cout << "Running benchmark with " << threads << " threads...\n";
+      std::visit([threads](auto& opts) { opts.threads = threads; },
+                 _options.workload);
+      reports.emplace_back(runWorkload());
+    }
+  }
+
+  // we need to stop the server before we calculate the size of the DB folder
+  // because otherwise RocksDB might still write/delete some files
+  _server.reset();
+
+  auto databaseSize = getFolderSize(_options.databaseDirectory);
+  for (auto& report : reports) {
+    report.name = _options.name.empty() ? workloadName : _options.name;
+    report.workload = workloadName;
+    report.timestamp = timestamp.count();
+    report.databaseSize = databaseSize;
+  }
+  return reports;
+}
+
+auto Runner::runWorkload() -> Report {
   auto workload = std::visit(
       overload{[](workloads::WriteWriteConflict::Options& opts)
                    -> std::shared_ptr<Workload> {
@@ -102,21 +146,28 @@ auto Runner::runBenchmark() -> Report {
                [](workloads::IterateDocuments::Options& opts)
                    -> std::shared_ptr<Workload> {
                  return std::make_shared<workloads::IterateDocuments>(opts);
+               },
+               [](workloads::IndexLookup::Options& opts)
+                   -> std::shared_ptr<Workload> {
+                 return std::make_shared<workloads::IndexLookup>(opts);
+               },
+               [](workloads::EdgeExpansion::Options& opts)
+                   -> std::shared_ptr<Workload> {
+                 return std::make_shared<workloads::EdgeExpansion>(opts);
+               },
+               [](workloads::AqlQuery::Options& opts)
+                   -> std::shared_ptr<Workload> {
+                 return std::make_shared<workloads::AqlQuery>(opts);
+               },
+               [](workloads::TtlDeletion::Options& opts)
+                   -> std::shared_ptr<Workload> {
+                 return std::make_shared<workloads::TtlDeletion>(opts);
                }},
       _options.workload);
 
   Execution exec(_options, workload);
   exec.createThreads(*_server);
-  auto report = exec.run();
-  report.timestamp = timestamp.count();
-
-  // we need to stop the server before we calculate the size of the DB folder
-  // because otherwise RocksDB might still write/delete some files
-  _server.reset();
-
-  report.databaseSize = getFolderSize(_options.databaseDirectory);
-
-  return report;
+  return exec.run();
 }
 
 void Runner::printSummary(Report const& report) {
@@ -127,7 +178,28 @@ void Runner::printSummary(Report const& report) {
             << std::endl;
 }
 
-void Runner::writeReport(Report const& report) {
+void Runner::printScaling(std::vector<Report> const& reports) {
+  // speedup and efficiency are relative to the first thread count
+  auto const& base = reports.front();
+  double baseThroughput = base.throughput();
+  std::cout << "Scaling:\n"
+            << std::setw(10) << "threads" << std::setw(16) << "ops/ms"
+            << std::setw(12) << "speedup" << std::setw(12) << "efficiency"
+            << "\n";
+  for (auto const& report : reports) {
+    double speedup =
+        baseThroughput > 0 ? report.throughput() / baseThroughput : 0.0;
+    double efficiency = speedup * base.numThreads() /
+                        std::max<std::uint32_t>(report.numThreads(), 1);
+    std::cout << std::fixed << std::setprecision(2) << std::setw(10)
+              << report.numThreads() << std::setw(16) << report.throughput()
+              << std::setw(12) << speedup << std::setw(11)
+              << (efficiency * 100) << "%\n";
+  }
+  std::cout << std::defaultfloat << std::flush;
+}
+
+void Runner::writeReports(std::vector<Report> const& reports) {
   if (_reportFile.empty()) {
     return;
   }
@@ -153,7 +225,9 @@ void Runner::writeReport(Report const& report) {
     }
   }
 
-  velocypack::serialize(reportBuilder, report);
+  for (auto const& report : reports) {
+    velocypack::serialize(reportBuilder, report);
+  }
   reportBuilder.close();
 
   std::ofstream out(_reportFile);
@@ -172,7 +246,7 @@ void Runner::startServer() {
 void Runner::setup() {
   std::cout << "Setting up collections\n";
   for (auto& col : _options.setup.collections) {
-    auto collection = createCollection(col.name);
+    auto collection = createCollection(col);
     for (auto& idx : col.indexes) {
       createIndex(*collection, idx);
     }
@@ -187,8 +261,18 @@ void Runner::setup() {
   }
 }
 
-auto Runner::createCollection(std::string const& name)
+auto Runner::createCollection(CollectionsSetup const& setup)
     -> std::shared_ptr<LogicalCollection> {
+  TRI_col_type_e type;
+  if (setup.type == "document") {
+    type = TRI_COL_TYPE_DOCUMENT;
+  } else if (setup.type == "edge") {
+    type = TRI_COL_TYPE_EDGE;
+  } else {
+    throw std::runtime_error("Invalid type '" + setup.type +
+                             "' for collection " + setup.name);
+  }
+
   VPackBuilder optionsBuilder;
   optionsBuilder.openObject();
   optionsBuilder.close();
@@ -197,8 +281,8 @@ auto Runner::createCollection(std::string const& name)
   auto res = methods::Collections::create(
       *_server->vocbase(),     // collection vocbase
       {},                      // operation options
-      name,                    // collection name
-      TRI_COL_TYPE_DOCUMENT,   // collection type
+      setup.name,              // collection name
+      type,                    // collection type
       optionsBuilder.slice(),  // collection properties
       false,                   // replication wait flag
       false,                   // replication factor flag
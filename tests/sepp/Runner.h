@@ -25,6 +25,7 @@
 
 #include <memory>
 #include <string_view>
+#include <vector>
 
 #include <velocypack/Slice.h>
 
@@ -49,12 +50,14 @@ class Runner {
  private:
   void startServer();
   void setup();
-  auto createCollection(std::string const& name)
+  auto createCollection(CollectionsSetup const& setup)
       -> std::shared_ptr<LogicalCollection>;
   void createIndex(LogicalCollection& col, IndexSetup const& index);
-  auto runBenchmark() -> Report;
+  auto runBenchmark() -> std::vector<Report>;
+  auto runWorkload() -> Report;
   void printSummary(Report const& report);
-  void writeReport(Report const& report);
+  void printScaling(std::vector<Report> const& reports);
+  void writeReports(std::vector<Report> const& reports);
 
   std::string_view _executable;
   std::string _reportFile;
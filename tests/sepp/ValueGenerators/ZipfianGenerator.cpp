@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ZipfianGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "velocypack/Builder.h"
+
+namespace {
+// ranks up to this number are summed up exactly when computing the zeta
+// constant, the remainder of the sum is approximated by an integral
+constexpr std::uint64_t exactZetaItems = 1 << 20;
+
+double zeta(std::uint64_t n, double theta) {
+  double sum = 0.0;
+  std::uint64_t exact = std::min(n, exactZetaItems);
+  for (std::uint64_t i = 1; i <= exact; ++i) {
+    sum += 1.0 / std::pow(static_cast<double>(i), theta);
+  }
+  if (n > exact) {
+    // integral of x^-theta over [exact + 0.5, n + 0.5]
+    sum += (std::pow(static_cast<double>(n) + 0.5, 1.0 - theta) -
+            std::pow(static_cast<double>(exact) + 0.5, 1.0 - theta)) /
+           (1.0 - theta);
+  }
+  return sum;
+}
+
+// finalizer of splitmix64
+std::uint64_t scramble(std::uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+}  // namespace
+
+namespace arangodb::sepp::generators {
+
+ZipfianGenerator::ZipfianGenerator(Options const& options, std::uint64_t seed)
+    : _options(options) {
+  if (_options.max < _options.min) {
+    throw std::runtime_error(
+        "zipfian generator: max must not be less than min");
+  }
+  if (!(_options.constant > 0.0 && _options.constant < 1.0)) {
+    throw std::runtime_error(
+        "zipfian generator: constant must be between 0 and 1 (exclusive)");
+  }
+  _items = _options.max - _options.min + 1;
+  if (_items == 0) {
+    // the range covers all 64-bit numbers
+    _items = std::numeric_limits<std::uint64_t>::max();
+  }
+  _theta = _options.constant;
+  _zetan = zeta(_items, _theta);
+  _alpha = 1.0 / (1.0 - _theta);
+  _eta = (1.0 - std::pow(2.0 / static_cast<double>(_items), 1.0 - _theta)) /
+         (1.0 - zeta(2, _theta) / _zetan);
+  _prng.seed(0xdeadbeefdeadbeefULL ^ scramble(seed),
+             0x9e3779b97f4a7c15ULL + seed);
+}
+
+std::uint64_t ZipfianGenerator::next() {
+  // uniformly distributed in [0, 1)
+  double u = static_cast<double>(_prng.next() >> 11) * 0x1.0p-53;
+  double uz = u * _zetan;
+
+  std::uint64_t rank;
+  if (uz < 1.0) {
+    rank = 0;
+  } else if (uz < 1.0 + std::pow(0.5, _theta)) {
+    rank = 1;
+  } else {
+    rank = static_cast<std::uint64_t>(static_cast<double>(_items) *
+                                      std::pow(_eta * u - _eta + 1.0, _alpha));
+  }
+  rank = std::min(rank, _items - 1);
+
+  if (_options.scrambled) {
+    rank = scramble(rank) % _items;
+  }
+  return _options.min + rank;
+}
+
+void ZipfianGenerator::apply(velocypack::Builder& builder) {
+  std::uint64_t value = next();
+  if (_options.prefix.empty()) {
+    builder.add(VPackValue(value));
+  } else {
+    builder.add(VPackValue(_options.prefix + std::to_string(value)));
+  }
+}
+
+}  // namespace arangodb::sepp::generators
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "ValueGenerator.h"
+
+#include "Basics/xoroshiro128plus.h"
+
+namespace arangodb::sepp::generators {
+
+/// @brief Generates integers from [min, max] following a Zipfian
+/// distribution, i.e., a few values are generated very often while most
+/// values are generated rarely. The popularity of the value with rank i is
+/// proportional to 1 / i^constant. Values are generated with the algorithm by
+/// Gray et al. ("Quickly Generating Billion-Record Synthetic Databases"), so
+/// the cost per value does not depend on the size of the range.
+/// If scrambled is set, the ranks are hashed onto the range (like YCSB's
+/// scrambled Zipfian generator does), so that the popular values are spread
+/// over the range instead of all being close to min. If prefix is set, the values are generated as strings consisting of
+/// the prefix followed by the number, e.g. to generate document keys.
+struct ZipfianGenerator : ValueGenerator {
+  struct Options {
+    std::uint64_t min{0};
+    std::uint64_t max{0};
+    double constant{0.99};
+    bool scrambled{true};
+    std::string prefix;
+
+    template<class Inspector>
+    friend inline auto inspect(Inspector& f, Options& o) {
+      return f.object(o).fields(
+          f.field("min", o.min).fallback(f.keep()),  //
+          f.field("max", o.max),                     //
+          f.field("constant", o.constant).fallback(f.keep()),
+          f.field("scrambled", o.scrambled).fallback(f.keep()),
+          f.field("prefix", o.prefix).fallback(f.keep()));
+    }
+  };
+
+  ZipfianGenerator(Options const& options, std::uint64_t seed);
+
+  /// @brief Generates a value and writes it to the given Builder.
+  void apply(velocypack::Builder&) override;
+
+  /// @brief Returns the next number from [min, max].
+  std::uint64_t next();
+
+ private:
+  Options _options;
+  std::uint64_t _items;
+  double _zetan;
+  double _theta;
+  double _alpha;
+  double _eta;
+  basics::xoroshiro128plus _prng;
+};
+
+}  // namespace arangodb::sepp::generators
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AqlQuery.h"
+
+#include <memory>
+#include <stdexcept>
+
+#include "Aql/Query.h"
+#include "Aql/QueryResult.h"
+#include "Aql/QueryString.h"
+#include "Transaction/StandaloneContext.h"
+#include "velocypack/Builder.h"
+#include "velocypack/Iterator.h"
+
+#include "Execution.h"
+#include "Server.h"
+
+namespace arangodb::sepp::workloads {
+
+auto AqlQuery::stoppingCriterion() const noexcept -> StoppingCriterion::type {
+  return _options.stop;
+}
+
+auto AqlQuery::createThreads(Execution& exec, Server& server)
+    -> WorkerThreadList {
+  ThreadOptions defaultThread;
+  defaultThread.stop = _options.stop;
+
+  if (_options.defaultThreadOptions) {
+    static_cast<AqlQuery::Options::Thread&>(defaultThread) =
+        _options.defaultThreadOptions.value();
+  }
+
+  WorkerThreadList result;
+  for (std::uint32_t i = 0; i < _options.threads; ++i) {
+    defaultThread.seed = i;
+    result.emplace_back(std::make_unique<Thread>(defaultThread, exec, server));
+  }
+  return result;
+}
+
+AqlQuery::Thread::Thread(ThreadOptions options, Execution& exec,
+                         Server& server)
+    : ExecutionThread(exec, server),
+      _options(std::move(options)),
+      _bindVarGenerator(_options.bindVarGenerators, _options.seed) {}
+
+AqlQuery::Thread::~Thread() = default;
+
+void AqlQuery::Thread::run() {
+  auto bindVars = std::make_shared<velocypack::Builder>();
+  bindVars->openObject();
+  if (_options.bindVars.isObject()) {
+    for (auto [k, v] : VPackObjectIterator(_options.bindVars)) {
+      bindVars->add(k);
+      bindVars->add(v);
+    }
+  }
+  _bindVarGenerator.apply(*bindVars);
+  bindVars->close();
+
+  auto query = aql::Query::create(
+      transaction::StandaloneContext::Create(*_server.vocbase()),
+      aql::QueryString(_options.query), std::move(bindVars));
+  aql::QueryResult queryResult = query->executeSync();
+  if (queryResult.result.fail()) {
+    throw std::runtime_error("Failed to execute query: " +
+                             std::string(queryResult.result.errorMessage()));
+  }
+  ++_operations;
+}
+
+auto AqlQuery::Thread::shouldStop() const noexcept -> bool {
+  if (execution().stopped()) {
+    return true;
+  }
+
+  using StopAfterOps = StoppingCriterion::NumberOfOperations;
+  if (std::holds_alternative<StopAfterOps>(_options.stop)) {
+    return _operations >= std::get<StopAfterOps>(_options.stop).count;
+  }
+  return false;
+}
+
+}  // namespace arangodb::sepp::workloads
@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "EdgeExpansion.h"
+
+#include <memory>
+#include <stdexcept>
+
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ScopeGuard.h"
+#include "Basics/StaticStrings.h"
+#include "Indexes/Index.h"
+#include "RestServer/arangod.h"
+#include "RocksDBEngine/RocksDBCollection.h"
+#include "RocksDBEngine/RocksDBColumnFamilyManager.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBIndex.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "velocypack/Builder.h"
+#include "velocypack/Value.h"
+
+#include "Execution.h"
+#include "Server.h"
+
+#include <rocksdb/db.h>
+#include <rocksdb/options.h>
+#include <rocksdb/status.h>
+
+namespace arangodb::sepp::workloads {
+
+auto EdgeExpansion::stoppingCriterion() const noexcept
+    -> StoppingCriterion::type {
+  return _options.stop;
+}
+
+auto EdgeExpansion::createThreads(Execution& exec, Server& server)
+    -> WorkerThreadList {
+  ThreadOptions defaultThread;
+  defaultThread.stop = _options.stop;
+
+  if (_options.defaultThreadOptions) {
+    static_cast<EdgeExpansion::Options::Thread&>(defaultThread) =
+        _options.defaultThreadOptions.value();
+  }
+
+  WorkerThreadList result;
+  for (std::uint32_t i = 0; i < _options.threads; ++i) {
+    defaultThread.seed = i;
+    result.emplace_back(std::make_unique<Thread>(defaultThread, exec, server));
+  }
+  return result;
+}
+
+EdgeExpansion::Thread::Thread(ThreadOptions options, Execution& exec,
+                              Server& server)
+    : ExecutionThread(exec, server),
+      _options(std::move(options)),
+      _generator(_options.vertex, _options.seed) {}
+
+EdgeExpansion::Thread::~Thread() = default;
+
+void EdgeExpansion::Thread::run() {
+  auto collection = _server.vocbase()->lookupCollection(_options.collection);
+  if (!collection) {
+    throw std::runtime_error("Could not find collection " +
+                             _options.collection);
+  }
+
+  std::string const& attribute = _options.direction == Direction::outbound
+                                     ? StaticStrings::FromString
+                                     : StaticStrings::ToString;
+  RocksDBIndex* edgeIndex = nullptr;
+  for (auto const& idx : collection->getIndexes()) {
+    if (idx->type() == arangodb::Index::TRI_IDX_TYPE_EDGE_INDEX &&
+        idx->fields()[0][0].name == attribute) {
+      edgeIndex = static_cast<RocksDBIndex*>(idx.get());
+      break;
+    }
+  }
+
+  if (!edgeIndex) {
+    throw std::runtime_error("Could not find edge index on " + attribute +
+                             " for collection " + _options.collection);
+  }
+
+  RocksDBCollection* rcoll =
+      static_cast<RocksDBCollection*>(collection->getPhysical());
+  std::uint64_t objectId = rcoll->objectId();
+  std::uint64_t indexId = edgeIndex->objectId();
+
+  rocksdb::ColumnFamilyHandle* docCF =
+      arangodb::RocksDBColumnFamilyManager::get(
+          arangodb::RocksDBColumnFamilyManager::Family::Documents);
+
+  auto& engine =
+      _server.vocbase()->server().getFeature<arangodb::RocksDBEngine>();
+  rocksdb::DB* rootDB = engine.db()->GetRootDB();
+
+  rocksdb::ReadOptions ro(/*cksum*/ false, /*cache*/ _options.fillBlockCache);
+  ro.snapshot = rootDB->GetSnapshot();
+  auto guard = scopeGuard([&]() noexcept {
+    if (ro.snapshot) {
+      rootDB->ReleaseSnapshot(ro.snapshot);
+    }
+  });
+  ro.prefix_same_as_start = true;
+
+  std::string vertexId;
+  RocksDBKey keyBuilder;
+  rocksdb::PinnableSlice val;
+
+  for (;;) {
+    vertexId.clear();
+    vertexId.append(_options.vertexCollection);
+    vertexId.push_back('/');
+    vertexId.append(_options.vertex.prefix);
+    vertexId.append(std::to_string(_generator.next()));
+
+    auto bounds = RocksDBKeyBounds::EdgeIndexVertex(indexId, vertexId);
+    rocksdb::Slice upper(bounds.end());
+    ro.iterate_upper_bound = &upper;
+
+    std::unique_ptr<rocksdb::Iterator> it(
+        rootDB->NewIterator(ro, edgeIndex->columnFamily()));
+    for (it->Seek(bounds.start()); it->Valid(); it->Next()) {
+      ++_edges;
+      if (_options.fetchFullDocument) {
+        keyBuilder.constructDocument(objectId,
+                                     RocksDBKey::edgeDocumentId(it->key()));
+
+        auto s = rootDB->Get(ro, docCF, keyBuilder.string(), &val);
+        if (!s.ok()) {
+          throw std::runtime_error("Failed to fetch edge document: " +
+                                   s.ToString());
+        }
+      }
+    }
+    if (!it->status().ok()) {
+      throw std::runtime_error("Failed to iterate edge index: " +
+                               it->status().ToString());
+    }
+    ++_operations;
+
+    if (_operations % 512 == 0 && shouldStop()) {
+      break;
+    }
+  }
+}
+
+auto EdgeExpansion::Thread::report() const -> ThreadReport {
+  velocypack::Builder data;
+  data.openObject();
+  data.add("edges", velocypack::Value(_edges));
+  data.close();
+  return {.data = std::move(data), .operations = _operations};
+}
+
+auto EdgeExpansion::Thread::shouldStop() const noexcept -> bool {
+  if (execution().stopped()) {
+    return true;
+  }
+
+  using StopAfterOps = StoppingCriterion::NumberOfOperations;
+  if (std::holds_alternative<StopAfterOps>(_options.stop)) {
+    return _operations >= std::get<StopAfterOps>(_options.stop).count;
+  }
+  return false;
+}
+
+}  // namespace arangodb::sepp::workloads
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <optional>
+#include <variant>
+
+#include "Inspection/Status.h"
+#include "Inspection/Types.h"
+
+#include "ExecutionThread.h"
+#include "StoppingCriterion.h"
+#include "ValueGenerators/ZipfianGenerator.h"
+#include "Workload.h"
+
+namespace arangodb::sepp::workloads {
+
+/// @brief Expands vertices via the edge index of an edge collection, i.e.,
+/// finds all edges starting (outbound) or ending (inbound) in a vertex, like
+/// a traversal step does. The vertex keys are taken from a Zipfian
+/// generator, so a few vertices are expanded much more often than others.
+struct EdgeExpansion : Workload {
+  enum class Direction {
+    outbound,
+    inbound,
+  };
+
+  struct Options;
+  struct ThreadOptions;
+  struct Thread;
+
+  explicit EdgeExpansion(Options const& options) : _options(options) {}
+
+  auto createThreads(Execution& exec, Server& server)
+      -> WorkerThreadList override;
+  auto stoppingCriterion() const noexcept -> StoppingCriterion::type override;
+
+ private:
+  Options const& _options;
+};
+
+template<class Inspector>
+auto inspect(Inspector& f, EdgeExpansion::Direction& d) {
+  return f.enumeration(d).values(
+      EdgeExpansion::Direction::outbound, "outbound",  //
+      EdgeExpansion::Direction::inbound, "inbound"     //
+  );
+}
+
+struct EdgeExpansion::Options {
+  struct Thread {
+    std::string collection;
+    std::string vertexCollection;
+    generators::ZipfianGenerator::Options vertex;
+    Direction direction{Direction::outbound};
+    bool fillBlockCache{false};
+    bool fetchFullDocument{false};
+
+    template<class Inspector>
+    friend inline auto inspect(Inspector& f, Thread& o) {
+      return f.object(o).fields(
+          f.field("collection", o.collection),
+          f.field("vertexCollection", o.vertexCollection),
+          f.field("vertex", o.vertex),
+          f.field("direction", o.direction).fallback(f.keep()),
+          f.field("fillBlockCache", o.fillBlockCache).fallback(f.keep()),
+          f.field("fetchFullDocument", o.fetchFullDocument)
+              .fallback(f.keep()));
+    }
+  };
+
+  std::optional<Thread> defaultThreadOptions;
+  std::uint32_t threads{1};  // TODO - make variant fixed number/array of Thread
+  StoppingCriterion::type stop;
+};
+
+struct EdgeExpansion::ThreadOptions : EdgeExpansion::Options::Thread {
+  StoppingCriterion::type stop;
+  std::uint64_t seed{0};
+};
+
+template<class Inspector>
+inline auto inspect(Inspector& f, EdgeExpansion::Options& o) {
+  return f.object(o).fields(f.field("default", o.defaultThreadOptions),
+                            f.field("threads", o.threads),
+                            f.field("stopAfter", o.stop));
+}
+
+struct EdgeExpansion::Thread : ExecutionThread {
+  Thread(ThreadOptions options, Execution& exec, Server& server);
+  ~Thread();
+  void run() override;
+  [[nodiscard]] virtual ThreadReport report() const override;
+  auto shouldStop() const noexcept -> bool override;
+
+ private:
+  std::uint64_t _operations{0};
+  // total number of edges found
+  std::uint64_t _edges{0};
+  ThreadOptions _options;
+  generators::ZipfianGenerator _generator;
+};
+
+}  // namespace arangodb::sepp::workloads
@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "IndexLookup.h"
+
+#include <memory>
+#include <stdexcept>
+
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ScopeGuard.h"
+#include "Indexes/Index.h"
+#include "RestServer/arangod.h"
+#include "RocksDBEngine/RocksDBCollection.h"
+#include "RocksDBEngine/RocksDBColumnFamilyManager.h"
+#include "RocksDBEngine/RocksDBEngine.h"
+#include "RocksDBEngine/RocksDBIndex.h"
+#include "RocksDBEngine/RocksDBKey.h"
+#include "RocksDBEngine/RocksDBKeyBounds.h"
+#include "RocksDBEngine/RocksDBValue.h"
+#include "velocypack/Builder.h"
+
+#include "Execution.h"
+#include "Server.h"
+
+#include <rocksdb/db.h>
+#include <rocksdb/options.h>
+#include <rocksdb/status.h>
+
+namespace arangodb::sepp::workloads {
+
+auto IndexLookup::stoppingCriterion() const noexcept
+    -> StoppingCriterion::type {
+  return _options.stop;
+}
+
+auto IndexLookup::createThreads(Execution& exec, Server& server)
+    -> WorkerThreadList {
+  ThreadOptions defaultThread;
+  defaultThread.stop = _options.stop;
+
+  if (_options.defaultThreadOptions) {
+    static_cast<IndexLookup::Options::Thread&>(defaultThread) =
+        _options.defaultThreadOptions.value();
+  }
+
+  WorkerThreadList result;
+  for (std::uint32_t i = 0; i < _options.threads; ++i) {
+    defaultThread.seed = i;
+    result.emplace_back(std::make_unique<Thread>(defaultThread, exec, server));
+  }
+  return result;
+}
+
+IndexLookup::Thread::Thread(ThreadOptions options, Execution& exec,
+                            Server& server)
+    : ExecutionThread(exec, server),
+      _options(std::move(options)),
+      _generator(_options.value, _options.seed) {}
+
+IndexLookup::Thread::~Thread() = default;
+
+void IndexLookup::Thread::run() {
+  auto collection = _server.vocbase()->lookupCollection(_options.collection);
+  if (!collection) {
+    throw std::runtime_error("Could not find collection " +
+                             _options.collection);
+  }
+
+  auto index = collection->lookupIndex(std::string_view(_options.index));
+  if (!index) {
+    throw std::runtime_error("Could not find index " + _options.index +
+                             " in collection " + _options.collection);
+  }
+  switch (index->type()) {
+    case Index::TRI_IDX_TYPE_HASH_INDEX:
+    case Index::TRI_IDX_TYPE_SKIPLIST_INDEX:
+    case Index::TRI_IDX_TYPE_TTL_INDEX:
+    case Index::TRI_IDX_TYPE_PERSISTENT_INDEX:
+      break;
+    default:
+      throw std::runtime_error("Index " + _options.index +
+                               " is not a persistent index");
+  }
+  if (index->fields().size() != 1) {
+    throw std::runtime_error("Index " + _options.index +
+                             " must cover exactly one attribute");
+  }
+
+  auto* rocksIndex = static_cast<RocksDBIndex*>(index.get());
+  bool const unique = index->unique();
+  std::uint64_t indexId = rocksIndex->objectId();
+
+  RocksDBCollection* rcoll =
+      static_cast<RocksDBCollection*>(collection->getPhysical());
+  std::uint64_t objectId = rcoll->objectId();
+
+  rocksdb::ColumnFamilyHandle* docCF =
+      arangodb::RocksDBColumnFamilyManager::get(
+          arangodb::RocksDBColumnFamilyManager::Family::Documents);
+
+  auto& engine =
+      _server.vocbase()->server().getFeature<arangodb::RocksDBEngine>();
+  rocksdb::DB* rootDB = engine.db()->GetRootDB();
+
+  rocksdb::ReadOptions ro(/*cksum*/ false, /*cache*/ _options.fillBlockCache);
+  ro.snapshot = rootDB->GetSnapshot();
+  auto guard = scopeGuard([&]() noexcept {
+    if (ro.snapshot) {
+      rootDB->ReleaseSnapshot(ro.snapshot);
+    }
+  });
+  ro.prefix_same_as_start = true;
+
+  RocksDBKey keyBuilder;
+  rocksdb::PinnableSlice val;
+  velocypack::Builder left;
+  velocypack::Builder right;
+
+  for (;;) {
+    // equality lookup, same bounds as built by RocksDBVPackIndex
+    left.clear();
+    left.openArray();
+    _generator.apply(left);
+    left.add(VPackSlice::minKeySlice());
+    left.close();
+
+    right.clear();
+    right.openArray();
+    right.add(left.slice().at(0));
+    right.add(VPackSlice::maxKeySlice());
+    right.close();
+
+    auto bounds =
+        unique ? RocksDBKeyBounds::UniqueVPackIndex(indexId, left.slice(),
+                                                    right.slice())
+               : RocksDBKeyBounds::VPackIndex(indexId, left.slice(),
+                                              right.slice());
+    rocksdb::Slice upper(bounds.end());
+    ro.iterate_upper_bound = &upper;
+
+    std::unique_ptr<rocksdb::Iterator> it(
+        rootDB->NewIterator(ro, rocksIndex->columnFamily()));
+    for (it->Seek(bounds.start()); it->Valid(); it->Next()) {
+      if (_options.fetchFullDocument) {
+        LocalDocumentId documentId =
+            unique ? RocksDBValue::documentId(it->value())
+                   : RocksDBKey::indexDocumentId(it->key());
+        keyBuilder.constructDocument(objectId, documentId);
+
+        auto s = rootDB->Get(ro, docCF, keyBuilder.string(), &val);
+        if (!s.ok()) {
+          throw std::runtime_error("Failed to fetch document value: " +
+                                   s.ToString());
+        }
+      }
+    }
+    if (!it->status().ok()) {
+      throw std::runtime_error("Failed to iterate index: " +
+                               it->status().ToString());
+    }
+    ++_operations;
+
+    if (_operations % 512 == 0 && shouldStop()) {
+      break;
+    }
+  }
+}
+
+auto IndexLookup::Thread::shouldStop() const noexcept -> bool {
+  if (execution().stopped()) {
+    return true;
+  }
+
+  using StopAfterOps = StoppingCriterion::NumberOfOperations;
+  if (std::holds_alternative<StopAfterOps>(_options.stop)) {
+    return _operations >= std::get<StopAfterOps>(_options.stop).count;
+  }
+  return false;
+}
+
+}  // namespace arangodb::sepp::workloads
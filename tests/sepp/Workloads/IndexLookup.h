@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <optional>
+#include <variant>
+
+#include "Inspection/Status.h"
+#include "Inspection/Types.h"
+
+#include "ExecutionThread.h"
+#include "StoppingCriterion.h"
+#include "ValueGenerators/ZipfianGenerator.h"
+#include "Workload.h"
+
+namespace arangodb::sepp::workloads {
+
+/// @brief Looks up documents via a secondary (persistent, hash, skiplist or
+/// ttl) index of a single attribute. The looked up values are taken from a
+/// Zipfian generator, so a few values are looked up much more often than
+/// others.
+struct IndexLookup : Workload {
+  struct Options;
+  struct ThreadOptions;
+  struct Thread;
+
+  explicit IndexLookup(Options const& options) : _options(options) {}
+
+  auto createThreads(Execution& exec, Server& server)
+      -> WorkerThreadList override;
+  auto stoppingCriterion() const noexcept -> StoppingCriterion::type override;
+
+ private:
+  Options const& _options;
+};
+
+struct IndexLookup::Options {
+  struct Thread {
+    std::string collection;
+    std::string index;
+    generators::ZipfianGenerator::Options value;
+    bool fillBlockCache{false};
+    bool fetchFullDocument{true};
+
+    template<class Inspector>
+    friend inline auto inspect(Inspector& f, Thread& o) {
+      return f.object(o).fields(
+          f.field("collection", o.collection), f.field("index", o.index),
+          f.field("value", o.value),
+          f.field("fillBlockCache", o.fillBlockCache).fallback(f.keep()),
+          f.field("fetchFullDocument", o.fetchFullDocument)
+              .fallback(f.keep()));
+    }
+  };
+
+  std::optional<Thread> defaultThreadOptions;
+  std::uint32_t threads{1};  // TODO - make variant fixed number/array of Thread
+  StoppingCriterion::type stop;
+};
+
+struct IndexLookup::ThreadOptions : IndexLookup::Options::Thread {
+  StoppingCriterion::type stop;
+  std::uint64_t seed{0};
+};
+
+template<class Inspector>
+inline auto inspect(Inspector& f, IndexLookup::Options& o) {
+  return f.object(o).fields(f.field("default", o.defaultThreadOptions),
+                            f.field("threads", o.threads),
+                            f.field("stopAfter", o.stop));
+}
+
+struct IndexLookup::Thread : ExecutionThread {
+  Thread(ThreadOptions options, Execution& exec, Server& server);
+  ~Thread();
+  void run() override;
+  [[nodiscard]] virtual ThreadReport report() const override {
+    return {.data = {}, .operations = _operations};
+  }
+  auto shouldStop() const noexcept -> bool override;
+
+ private:
+  std::uint64_t _operations{0};
+  ThreadOptions _options;
+  generators::ZipfianGenerator _generator;
+};
+
+}  // namespace arangodb::sepp::workloads
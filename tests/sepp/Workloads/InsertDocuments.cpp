@@ -40,6 +40,7 @@
 #include "Execution.h"
 #include "Server.h"
 #include "ValueGenerators/RandomStringGenerator.h"
+#include "ValueGenerators/ZipfianGenerator.h"
 
 namespace arangodb::sepp::workloads {
 
@@ -80,6 +81,7 @@ auto InsertDocuments::createThreads(Execution& exec, Server& server)
 
   WorkerThreadList result;
   for (std::uint32_t i = 0; i < _options.threads; ++i) {
+    defaultThread.seed = i;
     result.emplace_back(std::make_unique<Thread>(defaultThread, exec, server));
   }
   return result;
@@ -89,7 +91,7 @@ InsertDocuments::Thread::Thread(ThreadOptions options, Execution& exec,
                                 Server& server)
     : ExecutionThread(exec, server),
       _options(std::move(options)),
-      _modifier(_options.documentModifier) {}
+      _modifier(_options.documentModifier, _options.seed) {}
 
 InsertDocuments::Thread::~Thread() = default;
 
@@ -147,15 +149,22 @@ auto InsertDocuments::Thread::shouldStop() const noexcept -> bool {
 
 InsertDocuments::Thread::DocumentModifier::DocumentModifier(
     std::unordered_map<std::string, Options::DocumentModifier> const&
-        modifiers) {
+        modifiers,
+    std::uint64_t seed) {
   for (auto& [attr, mod] : modifiers) {
     _generators.emplace(
-        attr,
-        std::visit(overload{[](Options::RandomStringGenerator const& g) {
-                     return std::make_unique<generators::RandomStringGenerator>(
-                         g.size);
-                   }},
-                   mod.value));
+        attr, std::visit(
+                  overload{[](Options::RandomStringGenerator const& g)
+                               -> std::unique_ptr<ValueGenerator> {
+                             return std::make_unique<
+                                 generators::RandomStringGenerator>(g.size);
+                           },
+                           [seed](Options::ZipfianGenerator const& g)
+                               -> std::unique_ptr<ValueGenerator> {
+                             return std::make_unique<
+                                 generators::ZipfianGenerator>(g, seed);
+                           }},
+                  mod.value));
   }
 }
 
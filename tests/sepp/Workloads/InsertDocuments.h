@@ -30,6 +30,7 @@
 #include "Inspection/Status.h"
 #include "Inspection/Types.h"
 #include "ValueGenerators/RandomStringGenerator.h"
+#include "ValueGenerators/ZipfianGenerator.h"
 #include "velocypack/SliceContainer.h"
 
 #include "ExecutionThread.h"
@@ -74,15 +75,18 @@ struct InsertDocuments::Options {
     }
   };
 
+  using ZipfianGenerator = generators::ZipfianGenerator::Options;
+
   struct DocumentModifier {
     template<class Inspector>
     friend inline auto inspect(Inspector& f, DocumentModifier& o) {
       namespace insp = arangodb::inspection;
       return f.variant(o.value).unqualified().alternatives(
-          insp::type<RandomStringGenerator>("randomString"));
+          insp::type<RandomStringGenerator>("randomString"),
+          insp::type<ZipfianGenerator>("zipfian"));
     }
 
-    std::variant<RandomStringGenerator> value;
+    std::variant<RandomStringGenerator, ZipfianGenerator> value;
   };
 
   struct Thread {
@@ -119,6 +123,8 @@ struct InsertDocuments::ThreadOptions {
   std::shared_ptr<velocypack::Builder> document;
   std::unordered_map<std::string, Options::DocumentModifier> documentModifier;
   StoppingCriterion::type stop;
+  // seed for the value generators, different for each thread
+  std::uint64_t seed{0};
 };
 
 struct InsertDocuments::Thread : ExecutionThread {
@@ -132,8 +138,9 @@ struct InsertDocuments::Thread : ExecutionThread {
   auto shouldStop() const noexcept -> bool override;
 
   struct DocumentModifier {
-    explicit DocumentModifier(
-        std::unordered_map<std::string, Options::DocumentModifier> const&);
+    DocumentModifier(
+        std::unordered_map<std::string, Options::DocumentModifier> const&,
+        std::uint64_t seed);
     void apply(velocypack::Builder&);
 
    private:
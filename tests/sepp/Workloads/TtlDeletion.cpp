@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TtlDeletion.h"
+
+#include <memory>
+#include <stdexcept>
+
+#include "Aql/Collection.h"
+#include "Aql/Query.h"
+#include "Aql/QueryResult.h"
+#include "Aql/QueryString.h"
+#include "Basics/system-functions.h"
+#include "Transaction/StandaloneContext.h"
+#include "velocypack/Builder.h"
+
+#include "Execution.h"
+#include "Server.h"
+
+namespace {
+// same query as used by the TtlFeature
+std::string const removeQuery(
+    "/*ttl cleanup*/ FOR doc IN @@collection OPTIONS { forceIndexHint: true, "
+    "indexHint: @indexHint } FILTER doc.@indexAttribute >= 0 && "
+    "doc.@indexAttribute <= @stamp SORT doc.@indexAttribute LIMIT @limit "
+    "REMOVE doc IN @@collection OPTIONS { ignoreErrors: true }");
+}  // namespace
+
+namespace arangodb::sepp::workloads {
+
+auto TtlDeletion::stoppingCriterion() const noexcept
+    -> StoppingCriterion::type {
+  return _options.stop;
+}
+
+auto TtlDeletion::createThreads(Execution& exec, Server& server)
+    -> WorkerThreadList {
+  ThreadOptions defaultThread;
+  defaultThread.stop = _options.stop;
+
+  if (_options.defaultThreadOptions) {
+    static_cast<TtlDeletion::Options::Thread&>(defaultThread) =
+        _options.defaultThreadOptions.value();
+  }
+
+  WorkerThreadList result;
+  for (std::uint32_t i = 0; i < _options.threads; ++i) {
+    result.emplace_back(std::make_unique<Thread>(defaultThread, exec, server));
+  }
+  return result;
+}
+
+TtlDeletion::Thread::Thread(ThreadOptions options, Execution& exec,
+                            Server& server)
+    : ExecutionThread(exec, server), _options(std::move(options)) {}
+
+TtlDeletion::Thread::~Thread() = default;
+
+void TtlDeletion::Thread::run() {
+  auto bindVars = std::make_shared<velocypack::Builder>();
+  bindVars->openObject();
+  bindVars->add("indexHint", VPackValue(_options.index));
+  bindVars->add("@collection", VPackValue(_options.collection));
+  bindVars->add("indexAttribute", VPackValue(_options.attribute));
+  bindVars->add("stamp", VPackValue(TRI_microtime()));
+  bindVars->add("limit", VPackValue(_options.batchSize));
+  bindVars->close();
+
+  auto query = aql::Query::create(
+      transaction::StandaloneContext::Create(*_server.vocbase()),
+      aql::QueryString(::removeQuery), std::move(bindVars));
+  query->collections().add(_options.collection, AccessMode::Type::WRITE,
+                           aql::Collection::Hint::Shard);
+  aql::QueryResult queryResult = query->executeSync();
+  if (queryResult.result.fail()) {
+    throw std::runtime_error("Failed to remove expired documents: " +
+                             std::string(queryResult.result.errorMessage()));
+  }
+
+  std::uint64_t removed = 0;
+  if (queryResult.extra != nullptr) {
+    VPackSlice v = queryResult.extra->slice().get({"stats", "writesExecuted"});
+    if (v.isNumber()) {
+      removed = v.getNumericValue<std::uint64_t>();
+    }
+  }
+  _operations += removed;
+  _exhausted = (removed == 0);
+}
+
+auto TtlDeletion::Thread::shouldStop() const noexcept -> bool {
+  if (execution().stopped() || _exhausted) {
+    return true;
+  }
+
+  using StopAfterOps = StoppingCriterion::NumberOfOperations;
+  if (std::holds_alternative<StopAfterOps>(_options.stop)) {
+    return _operations >= std::get<StopAfterOps>(_options.stop).count;
+  }
+  return false;
+}
+
+}  // namespace arangodb::sepp::workloads
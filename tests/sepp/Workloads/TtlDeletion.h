@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2023 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2023, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <optional>
+#include <variant>
+
+#include "Inspection/Status.h"
+#include "Inspection/Types.h"
+
+#include "ExecutionThread.h"
+#include "StoppingCriterion.h"
+#include "Workload.h"
+
+namespace arangodb::sepp::workloads {
+
+/// @brief Removes expired documents in batches, using the same query as the
+/// TTL background thread of arangod. A document is expired if the value of
+/// its expiry attribute (a number of seconds since the epoch) is not greater
+/// than the current time. Threads stop as soon as there are no more expired
+/// documents.
+struct TtlDeletion : Workload {
+  struct Options;
+  struct ThreadOptions;
+  struct Thread;
+
+  explicit TtlDeletion(Options const& options) : _options(options) {}
+
+  auto createThreads(Execution& exec, Server& server)
+      -> WorkerThreadList override;
+  auto stoppingCriterion() const noexcept -> StoppingCriterion::type override;
+
+ private:
+  Options const& _options;
+};
+
+struct TtlDeletion::Options {
+  struct Thread {
+    std::string collection;
+    // name of the TTL (or persistent) index on the expiry attribute
+    std::string index;
+    std::string attribute{"expireAt"};
+    std::uint64_t batchSize{1000};
+
+    template<class Inspector>
+    friend inline auto inspect(Inspector& f, Thread& o) {
+      return f.object(o).fields(
+          f.field("collection", o.collection), f.field("index", o.index),
+          f.field("attribute", o.attribute).fallback(f.keep()),
+          f.field("batchSize", o.batchSize).fallback(f.keep()));
+    }
+  };
+
+  std::optional<Thread> defaultThreadOptions;
+  std::uint32_t threads{1};  // TODO - make variant fixed number/array of Thread
+  StoppingCriterion::type stop;
+};
+
+struct TtlDeletion::ThreadOptions : TtlDeletion::Options::Thread {
+  StoppingCriterion::type stop;
+};
+
+template<class Inspector>
+inline auto inspect(Inspector& f, TtlDeletion::Options& o) {
+  return f.object(o).fields(f.field("default", o.defaultThreadOptions),
+                            f.field("threads", o.threads),
+                            f.field("stopAfter", o.stop));
+}
+
+struct TtlDeletion::Thread : ExecutionThread {
+  Thread(ThreadOptions options, Execution& exec, Server& server);
+  ~Thread();
+  void run() override;
+  [[nodiscard]] virtual ThreadReport report() const override {
+    return {.data = {}, .operations = _operations};
+  }
+  auto shouldStop() const noexcept -> bool override;
+
+ private:
+  // number of removed documents
+  std::uint64_t _operations{0};
+  // set once a batch did not remove any documents
+  bool _exhausted{false};
+  ThreadOptions _options;
+};
+
+}  // namespace arangodb::sepp::workloads
@@ -34,6 +34,7 @@
 
 #include "Logger/LogMacros.h"
 
+#include "Comparison.h"
 #include "Runner.h"
 
 namespace {
@@ -128,11 +129,47 @@ void parseOptions(int argc, char const* argv[], Options& opts) {
   }
 }
 
+auto readReportFile(std::string const& file) {
+  std::ifstream t(file);
+  if (!t.is_open()) {
+    throw std::runtime_error("Failed to open report file " + file);
+  }
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+  return arangodb::velocypack::Parser::fromJson(buffer.str());
+}
+
+// compares a report file against a baseline report file, returns the
+// number of regressions
+std::size_t compareReports(int argc, char const* argv[]) {
+  if (argc < 4) {
+    throw InvalidArgumentException(argc < 3 ? "missing baseline report file"
+                                            : "missing report file");
+  }
+
+  arangodb::sepp::Comparison comparison;
+  for (int i = 4; i < argc; ++i) {
+    auto [key, value] = splitKeyValue(argv[i]);
+    if (key == "--tolerance") {
+      comparison.tolerance = std::stod(std::string(value)) / 100.0;
+    } else {
+      throw InvalidArgumentException(argv[i]);
+    }
+  }
+
+  auto baseline = readReportFile(argv[2]);
+  auto current = readReportFile(argv[3]);
+  return comparison.run(baseline->slice(), current->slice(), std::cout);
+}
+
 void printUsage() {
   std::cout << "Usage: sepp"
             << " <config-file>"
             << " [--report=<report-file>]"
-            << " [-- <some.attribute.path>=<value> ...]" << std::endl;
+            << " [-- <some.attribute.path>=<value> ...]\n"
+            << "       sepp compare"
+            << " <baseline-report-file> <report-file>"
+            << " [--tolerance=<percent>]" << std::endl;
 }
 
 }  // namespace
@@ -146,6 +183,11 @@ int main(int argc, char const* argv[]) {
   }
 
   try {
+    if (argv[1] == std::string("compare")) {
+      // exit code 3 signals regressions
+      return compareReports(argc, argv) == 0 ? 0 : 3;
+    }
+
     Options options;
     parseOptions(argc, argv, options);
 